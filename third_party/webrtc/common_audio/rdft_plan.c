@@ -0,0 +1,297 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// The real transform of n points runs as a complex FFT of n / 2 points over
+// the even and odd samples as real and imaginary parts, followed by a split
+// of its spectrum into the real one. The complex FFT is a self-sorting
+// (Stockham) decimation in frequency FFT with radix-4 passes, and one radix-2
+// pass last for even orders, which needs no multiplications. The inverse
+// merges the real spectrum into a complex one and runs the same FFT on its
+// conjugate.
+
+#include "common_audio/rdft_plan.h"
+
+#include <math.h>
+
+#include "common_audio/signal_processing/spl_init.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+// Size of the twiddle factors of all plans, in floats: at most n / 2 complex
+// factors for the passes of the n / 2 point FFTs, and n / 4 + 1 cosines and
+// sines for the splits of the n point transforms.
+enum {
+  kPassTwiddlesSize = 2 << kRdftMaxOrder,
+  kSplitTwiddlesSize = 1 << kRdftMaxOrder
+};
+
+static RdftPlan plans[kRdftMaxOrder + 1];
+static float pass_twiddles[kPassTwiddlesSize];
+static float split_cos[kSplitTwiddlesSize];
+static float split_sin[kSplitTwiddlesSize];
+
+typedef float* (*ComplexFFT)(const RdftPlan* plan, float* data, float* work);
+typedef void (*Split)(const RdftPlan* plan,
+                      const float* spectrum,
+                      float* data);
+typedef void (*Merge)(const RdftPlan* plan,
+                      const float* data,
+                      float* spectrum);
+typedef void (*Conjugate)(size_t length, float* data);
+
+static ComplexFFT complex_fft;
+static Split split;
+static Merge merge;
+static Conjugate conjugate;
+
+// The last radix-2 pass, over 2 points with stride |s|, from |x| to |y|.
+static void Radix2LastPassC(size_t s, const float* x, float* y) {
+  size_t q;
+
+  for (q = 0; q < 2 * s; ++q) {
+    y[q] = x[q] + x[2 * s + q];
+    y[2 * s + q] = x[q] - x[2 * s + q];
+  }
+}
+
+// Radix-4 pass over |n| points with stride |s|, from |x| to |y|.
+static void Radix4PassC(size_t n,
+                        size_t s,
+                        const float* w,
+                        const float* x,
+                        float* y) {
+  const size_t n1 = n / 4;
+  size_t p, q;
+
+  for (p = 0; p < n1; ++p) {
+    const float w1r = w[2 * p];
+    const float w1i = w[2 * p + 1];
+    const float w2r = w[2 * (n1 + p)];
+    const float w2i = w[2 * (n1 + p) + 1];
+    const float w3r = w[2 * (2 * n1 + p)];
+    const float w3i = w[2 * (2 * n1 + p) + 1];
+    for (q = 0; q < s; ++q) {
+      const float* a = &x[2 * (q + s * p)];
+      const float* b = &x[2 * (q + s * (p + n1))];
+      const float* c = &x[2 * (q + s * (p + 2 * n1))];
+      const float* d = &x[2 * (q + s * (p + 3 * n1))];
+      float* y0 = &y[2 * (q + s * 4 * p)];
+      float* y1 = &y[2 * (q + s * (4 * p + 1))];
+      float* y2 = &y[2 * (q + s * (4 * p + 2))];
+      float* y3 = &y[2 * (q + s * (4 * p + 3))];
+      const float apc_r = a[0] + c[0];
+      const float apc_i = a[1] + c[1];
+      const float amc_r = a[0] - c[0];
+      const float amc_i = a[1] - c[1];
+      const float bpd_r = b[0] + d[0];
+      const float bpd_i = b[1] + d[1];
+      // j * (b - d).
+      const float jbmd_r = d[1] - b[1];
+      const float jbmd_i = b[0] - d[0];
+      float tr, ti;
+      y0[0] = apc_r + bpd_r;
+      y0[1] = apc_i + bpd_i;
+      tr = amc_r - jbmd_r;
+      ti = amc_i - jbmd_i;
+      y1[0] = tr * w1r - ti * w1i;
+      y1[1] = tr * w1i + ti * w1r;
+      tr = apc_r - bpd_r;
+      ti = apc_i - bpd_i;
+      y2[0] = tr * w2r - ti * w2i;
+      y2[1] = tr * w2i + ti * w2r;
+      tr = amc_r + jbmd_r;
+      ti = amc_i + jbmd_i;
+      y3[0] = tr * w3r - ti * w3i;
+      y3[1] = tr * w3i + ti * w3r;
+    }
+  }
+}
+
+static float* ComplexFFTC(const RdftPlan* plan, float* data, float* work) {
+  size_t n = plan->length / 2;
+  size_t s = 1;
+  const float* w = plan->pass_twiddles;
+  float* x = data;
+  float* y = work;
+  float* t;
+  int pass;
+
+  for (pass = 0; pass < plan->num_passes; ++pass) {
+    if (n == 2) {
+      Radix2LastPassC(s, x, y);
+    } else {
+      Radix4PassC(n, s, w, x, y);
+      w += 3 * n / 2;
+      n /= 4;
+      s *= 4;
+    }
+    t = x;
+    x = y;
+    y = t;
+  }
+  return x;
+}
+
+// The spectrum X of the real signal follows from the spectrum Z of the
+// complex one as X[k] = E[k] + W^k * O[k] and X[m - k] = conj(E[k] - W^k *
+// O[k]), with E[k] = (Z[k] + conj(Z[m - k])) / 2, O[k] = -j * (Z[k] -
+// conj(Z[m - k])) / 2 and W = exp(-2 * pi * j / n). The output holds
+// conj(X).
+static void SplitC(const RdftPlan* plan, const float* spectrum, float* data) {
+  const size_t m = plan->length / 2;
+  const float z0r = spectrum[0];
+  const float z0i = spectrum[1];
+  size_t k;
+
+  data[0] = z0r + z0i;
+  data[1] = z0r - z0i;
+  for (k = 1; k <= m / 2; ++k) {
+    const size_t l = m - k;
+    const float zr = spectrum[2 * k];
+    const float zi = spectrum[2 * k + 1];
+    const float yr = spectrum[2 * l];
+    const float yi = spectrum[2 * l + 1];
+    const float er = 0.5f * (zr + yr);
+    const float ei = 0.5f * (zi - yi);
+    const float dr = zr - yr;
+    const float di = zi + yi;
+    const float tr = plan->split_cos[k] * di - plan->split_sin[k] * dr;
+    const float ti = -plan->split_cos[k] * dr - plan->split_sin[k] * di;
+    data[2 * l] = er - tr;
+    data[2 * l + 1] = ei - ti;
+    data[2 * k] = er + tr;
+    data[2 * k + 1] = -(ei + ti);
+  }
+}
+
+// The inverse of SplitC() up to the scaling, with E[k] = (X[k] +
+// conj(X[m - k])) / 2 and O[k] = conj(W^k) * (X[k] - conj(X[m - k])) / 2,
+// and Z[k] = E[k] + j * O[k]. The output holds conj(Z).
+static void MergeC(const RdftPlan* plan, const float* data, float* spectrum) {
+  const size_t m = plan->length / 2;
+  const float r0 = data[0];
+  const float rm = data[1];
+  size_t k;
+
+  spectrum[0] = 0.5f * (r0 + rm);
+  spectrum[1] = -0.5f * (r0 - rm);
+  for (k = 1; k <= m / 2; ++k) {
+    const size_t l = m - k;
+    const float ar = data[2 * k];
+    const float ai = data[2 * k + 1];
+    const float br = data[2 * l];
+    const float bi = data[2 * l + 1];
+    const float er = 0.5f * (ar + br);
+    const float ei = 0.5f * (bi - ai);
+    const float dr = ar - br;
+    const float di = -(ai + bi);
+    const float ur = -(plan->split_cos[k] * di + plan->split_sin[k] * dr);
+    const float ui = plan->split_cos[k] * dr - plan->split_sin[k] * di;
+    spectrum[2 * l] = er - ur;
+    spectrum[2 * l + 1] = ei - ui;
+    spectrum[2 * k] = er + ur;
+    spectrum[2 * k + 1] = -(ei + ui);
+  }
+}
+
+static void ConjugateC(size_t length, float* data) {
+  size_t i;
+
+  for (i = 1; i < length; i += 2) {
+    data[i] = -data[i];
+  }
+}
+
+// Fills in the plan of order |order|, with its twiddle factors from
+// |*pass_w| and |*split_w| onwards, which are advanced past them.
+static void InitPlan(int order, size_t* pass_w, size_t* split_w) {
+  const double kPi = 3.14159265358979323846;
+  RdftPlan* plan = &plans[order];
+  const size_t length = (size_t)1 << order;
+  size_t n = length / 2;
+  size_t k, p;
+  int log2_n = order - 1;
+
+  plan->length = length;
+  plan->last_radix = log2_n % 2 ? 2 : 4;
+  plan->num_passes = log2_n / 2 + log2_n % 2;
+  plan->pass_twiddles = &pass_twiddles[*pass_w];
+  plan->split_cos = &split_cos[*split_w];
+  plan->split_sin = &split_sin[*split_w];
+
+  for (; n > 2; n /= 4) {
+    for (k = 1; k <= 3; ++k) {
+      for (p = 0; p < n / 4; ++p) {
+        const double angle = 2 * kPi * k * p / n;
+        pass_twiddles[(*pass_w)++] = (float)cos(angle);
+        pass_twiddles[(*pass_w)++] = (float)-sin(angle);
+      }
+    }
+  }
+
+  for (k = 0; k <= length / 4; ++k) {
+    const double angle = 2 * kPi * k / length;
+    split_cos[*split_w] = (float)(0.5 * cos(angle));
+    split_sin[*split_w] = (float)(0.5 * sin(angle));
+    ++*split_w;
+  }
+}
+
+static void InitPlans(void) {
+  size_t pass_w = 0;
+  size_t split_w = 0;
+  int order;
+
+  for (order = kRdftMinOrder; order <= kRdftMaxOrder; ++order) {
+    InitPlan(order, &pass_w, &split_w);
+  }
+
+  complex_fft = ComplexFFTC;
+  split = SplitC;
+  merge = MergeC;
+  conjugate = ConjugateC;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    complex_fft = WebRtc_RdftComplexFFTSSE2;
+    split = WebRtc_RdftSplitSSE2;
+    merge = WebRtc_RdftMergeSSE2;
+    conjugate = WebRtc_RdftConjugateSSE2;
+  }
+#endif
+}
+
+const RdftPlan* WebRtc_GetRdftPlan(size_t length) {
+  static int plans_done = 0;
+  int order = 0;
+
+  while (((size_t)1 << order) < length && order < kRdftMaxOrder) {
+    ++order;
+  }
+  if (order < kRdftMinOrder || ((size_t)1 << order) != length) {
+    return NULL;
+  }
+  WebRtcSpl_CallOnce(&plans_done, InitPlans);
+  return &plans[order];
+}
+
+void WebRtc_RdftForward(const RdftPlan* plan, float* data) {
+  float work[1 << kRdftMaxOrder];
+
+  split(plan, complex_fft(plan, data, work), data);
+}
+
+void WebRtc_RdftInverse(const RdftPlan* plan, float* data) {
+  float work[1 << kRdftMaxOrder];
+  // Merge into the buffer from which the complex FFT ends in |data|.
+  float* spectrum = plan->num_passes % 2 ? work : data;
+
+  merge(plan, data, spectrum);
+  complex_fft(plan, spectrum, spectrum == data ? work : data);
+  conjugate(plan->length, data);
+}
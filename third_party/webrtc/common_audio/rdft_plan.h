@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Planned real FFT in float, a drop-in replacement for WebRtc_rdft() of
+// common_audio/third_party/fft4g with the same data layout and scaling. The
+// plans hold the twiddle factors for one length. They are created once per
+// process, are never modified afterwards, and are shared by all users of the
+// same length, which therefore need no work arrays of their own. The plans
+// and the transforms are thread safe.
+
+#ifndef COMMON_AUDIO_RDFT_PLAN_H_
+#define COMMON_AUDIO_RDFT_PLAN_H_
+
+#include <stddef.h>
+
+#include "rtc_base/system/arch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { kRdftMinOrder = 1, kRdftMaxOrder = 10 };
+
+typedef struct RdftPlan {
+  size_t length;  // Length of the real transform, 2^order.
+  // The length / 2 point complex FFT runs |num_passes| passes, radix-4 ones
+  // and, if |last_radix| is 2, a last radix-2 pass.
+  int num_passes;
+  int last_radix;
+  // Twiddle factors of the radix-4 passes, in complex (re, im) pairs. A pass
+  // of n points has 3 * n / 4 factors: all factors of the second butterfly
+  // input, then of the third and of the fourth. Those of the last radix-2
+  // pass are all 1.
+  const float* pass_twiddles;
+  // Half the cosine and sine of 2 * pi * k / |length|, 0 <= k <= length / 4,
+  // for the split of the complex spectrum into the real one.
+  const float* split_cos;
+  const float* split_sin;
+} RdftPlan;
+
+// Returns the shared plan for real transforms of |length| points, which is
+// a power of two from 2^kRdftMinOrder to 2^kRdftMaxOrder. Returns NULL for
+// other lengths.
+const RdftPlan* WebRtc_GetRdftPlan(size_t length);
+
+// Transforms the |plan->length| samples of |data| in place, like
+// WebRtc_rdft(length, 1, data, ip, w):
+//   data[2 * k] = R[k], 0 <= k < length / 2
+//   data[2 * k + 1] = I[k], 0 < k < length / 2
+//   data[1] = R[length / 2]
+// with R[k] + j * I[k] = sum_n data[n] * exp(2 * pi * j * n * k / length).
+void WebRtc_RdftForward(const RdftPlan* plan, float* data);
+
+// The inverse of WebRtc_RdftForward() scaled by length / 2, like
+// WebRtc_rdft(length, -1, data, ip, w).
+void WebRtc_RdftInverse(const RdftPlan* plan, float* data);
+
+// For the kernels, functions for generic platforms are declared and defined as
+// static in file rdft_plan.c, while those for x86 platforms with SSE2 are
+// declared below and defined in file rdft_plan_sse2.c.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Runs the complex FFT of |plan->length| / 2 points of |data|, using |work| of
+// the same size. Returns |data| or |work|, whichever holds the result.
+float* WebRtc_RdftComplexFFTSSE2(const RdftPlan* plan,
+                                 float* data,
+                                 float* work);
+// Splits the complex spectrum |spectrum| into the real one in |data|, which
+// may be the same buffer.
+void WebRtc_RdftSplitSSE2(const RdftPlan* plan,
+                          const float* spectrum,
+                          float* data);
+// Merges the real spectrum |data| into the conjugate of the complex spectrum
+// in |spectrum|, which may be the same buffer.
+void WebRtc_RdftMergeSSE2(const RdftPlan* plan,
+                          const float* data,
+                          float* spectrum);
+// Negates the imaginary parts of the |length| / 2 complex values of |data|.
+void WebRtc_RdftConjugateSSE2(size_t length, float* data);
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // COMMON_AUDIO_RDFT_PLAN_H_
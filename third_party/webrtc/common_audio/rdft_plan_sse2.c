@@ -0,0 +1,354 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/rdft_plan.h"
+
+#include <emmintrin.h>
+
+// Complex values are kept interleaved, two in a register. The radix-4 passes
+// run two butterflies at a time: of neighbouring p in the first pass, where
+// the stride is 1, and of neighbouring q in the others.
+
+// Multiplies the two complex values of |a| with those of |w|, given as their
+// real parts |wr| and imaginary parts |wi| duplicated.
+static __inline __m128 MulComplex(__m128 a, __m128 wr, __m128 wi) {
+  const __m128 kNegateReal = _mm_castsi128_ps(
+      _mm_set_epi32(0, (int)0x80000000, 0, (int)0x80000000));
+  const __m128 a_swapped = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_add_ps(_mm_mul_ps(a, wr),
+                    _mm_xor_ps(_mm_mul_ps(a_swapped, wi), kNegateReal));
+}
+
+// Multiplies the two complex values of |a| with j.
+static __inline __m128 MulJ(__m128 a) {
+  const __m128 kNegateReal = _mm_castsi128_ps(
+      _mm_set_epi32(0, (int)0x80000000, 0, (int)0x80000000));
+  return _mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+                    kNegateReal);
+}
+
+static __inline __m128 RealParts(__m128 w) {
+  return _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0));
+}
+
+static __inline __m128 ImagParts(__m128 w) {
+  return _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+static void Radix4FirstPassSSE2(size_t n,
+                                const float* w,
+                                const float* x,
+                                float* y) {
+  const size_t n1 = n / 4;
+  size_t p;
+
+  for (p = 0; p < n1; p += 2) {
+    const __m128 a = _mm_loadu_ps(&x[2 * p]);
+    const __m128 b = _mm_loadu_ps(&x[2 * (p + n1)]);
+    const __m128 c = _mm_loadu_ps(&x[2 * (p + 2 * n1)]);
+    const __m128 d = _mm_loadu_ps(&x[2 * (p + 3 * n1)]);
+    const __m128 w1 = _mm_loadu_ps(&w[2 * p]);
+    const __m128 w2 = _mm_loadu_ps(&w[2 * (n1 + p)]);
+    const __m128 w3 = _mm_loadu_ps(&w[2 * (2 * n1 + p)]);
+    const __m128 apc = _mm_add_ps(a, c);
+    const __m128 amc = _mm_sub_ps(a, c);
+    const __m128 bpd = _mm_add_ps(b, d);
+    const __m128 jbmd = MulJ(_mm_sub_ps(b, d));
+    const __m128 y0 = _mm_add_ps(apc, bpd);
+    const __m128 y1 =
+        MulComplex(_mm_sub_ps(amc, jbmd), RealParts(w1), ImagParts(w1));
+    const __m128 y2 =
+        MulComplex(_mm_sub_ps(apc, bpd), RealParts(w2), ImagParts(w2));
+    const __m128 y3 =
+        MulComplex(_mm_add_ps(amc, jbmd), RealParts(w3), ImagParts(w3));
+    _mm_storeu_ps(&y[8 * p], _mm_movelh_ps(y0, y1));
+    _mm_storeu_ps(&y[8 * p + 4], _mm_movelh_ps(y2, y3));
+    _mm_storeu_ps(&y[8 * p + 8], _mm_movehl_ps(y1, y0));
+    _mm_storeu_ps(&y[8 * p + 12], _mm_movehl_ps(y3, y2));
+  }
+}
+
+static void Radix4PassSSE2(size_t n,
+                           size_t s,
+                           const float* w,
+                           const float* x,
+                           float* y) {
+  const size_t n1 = n / 4;
+  size_t p, q;
+
+  for (p = 0; p < n1; ++p) {
+    const float* xa = &x[2 * s * p];
+    const float* xb = &x[2 * s * (p + n1)];
+    const float* xc = &x[2 * s * (p + 2 * n1)];
+    const float* xd = &x[2 * s * (p + 3 * n1)];
+    float* y0 = &y[2 * s * 4 * p];
+    float* y1 = &y[2 * s * (4 * p + 1)];
+    float* y2 = &y[2 * s * (4 * p + 2)];
+    float* y3 = &y[2 * s * (4 * p + 3)];
+    if (p == 0) {
+      // All twiddle factors are 1, which includes the whole last pass.
+      for (q = 0; q < 2 * s; q += 4) {
+        const __m128 a = _mm_loadu_ps(&xa[q]);
+        const __m128 b = _mm_loadu_ps(&xb[q]);
+        const __m128 c = _mm_loadu_ps(&xc[q]);
+        const __m128 d = _mm_loadu_ps(&xd[q]);
+        const __m128 apc = _mm_add_ps(a, c);
+        const __m128 amc = _mm_sub_ps(a, c);
+        const __m128 bpd = _mm_add_ps(b, d);
+        const __m128 jbmd = MulJ(_mm_sub_ps(b, d));
+        _mm_storeu_ps(&y0[q], _mm_add_ps(apc, bpd));
+        _mm_storeu_ps(&y1[q], _mm_sub_ps(amc, jbmd));
+        _mm_storeu_ps(&y2[q], _mm_sub_ps(apc, bpd));
+        _mm_storeu_ps(&y3[q], _mm_add_ps(amc, jbmd));
+      }
+    } else {
+      const __m128 w1r = _mm_set1_ps(w[2 * p]);
+      const __m128 w1i = _mm_set1_ps(w[2 * p + 1]);
+      const __m128 w2r = _mm_set1_ps(w[2 * (n1 + p)]);
+      const __m128 w2i = _mm_set1_ps(w[2 * (n1 + p) + 1]);
+      const __m128 w3r = _mm_set1_ps(w[2 * (2 * n1 + p)]);
+      const __m128 w3i = _mm_set1_ps(w[2 * (2 * n1 + p) + 1]);
+      for (q = 0; q < 2 * s; q += 4) {
+        const __m128 a = _mm_loadu_ps(&xa[q]);
+        const __m128 b = _mm_loadu_ps(&xb[q]);
+        const __m128 c = _mm_loadu_ps(&xc[q]);
+        const __m128 d = _mm_loadu_ps(&xd[q]);
+        const __m128 apc = _mm_add_ps(a, c);
+        const __m128 amc = _mm_sub_ps(a, c);
+        const __m128 bpd = _mm_add_ps(b, d);
+        const __m128 jbmd = MulJ(_mm_sub_ps(b, d));
+        _mm_storeu_ps(&y0[q], _mm_add_ps(apc, bpd));
+        _mm_storeu_ps(&y1[q], MulComplex(_mm_sub_ps(amc, jbmd), w1r, w1i));
+        _mm_storeu_ps(&y2[q], MulComplex(_mm_sub_ps(apc, bpd), w2r, w2i));
+        _mm_storeu_ps(&y3[q], MulComplex(_mm_add_ps(amc, jbmd), w3r, w3i));
+      }
+    }
+  }
+}
+
+static void Radix2LastPassSSE2(size_t s, const float* x, float* y) {
+  size_t q;
+
+  for (q = 0; q < 2 * s; q += 4) {
+    const __m128 a = _mm_loadu_ps(&x[q]);
+    const __m128 b = _mm_loadu_ps(&x[2 * s + q]);
+    _mm_storeu_ps(&y[q], _mm_add_ps(a, b));
+    _mm_storeu_ps(&y[2 * s + q], _mm_sub_ps(a, b));
+  }
+}
+
+// The FFTs of 1, 2 and 4 points, from |x| to |y|, which are too short for the
+// SSE2 passes.
+static void ComplexFFTShort(size_t n, const float* x, float* y) {
+  if (n == 2) {
+    y[0] = x[0] + x[2];
+    y[1] = x[1] + x[3];
+    y[2] = x[0] - x[2];
+    y[3] = x[1] - x[3];
+  } else if (n == 4) {
+    const float apc_r = x[0] + x[4];
+    const float apc_i = x[1] + x[5];
+    const float amc_r = x[0] - x[4];
+    const float amc_i = x[1] - x[5];
+    const float bpd_r = x[2] + x[6];
+    const float bpd_i = x[3] + x[7];
+    const float jbmd_r = x[7] - x[3];
+    const float jbmd_i = x[2] - x[6];
+    y[0] = apc_r + bpd_r;
+    y[1] = apc_i + bpd_i;
+    y[2] = amc_r - jbmd_r;
+    y[3] = amc_i - jbmd_i;
+    y[4] = apc_r - bpd_r;
+    y[5] = apc_i - bpd_i;
+    y[6] = amc_r + jbmd_r;
+    y[7] = amc_i + jbmd_i;
+  }
+}
+
+float* WebRtc_RdftComplexFFTSSE2(const RdftPlan* plan,
+                                 float* data,
+                                 float* work) {
+  size_t n = plan->length / 2;
+  size_t s = 1;
+  const float* w = plan->pass_twiddles;
+  float* x = data;
+  float* y = work;
+  float* t;
+  int pass;
+
+  if (n < 8) {
+    ComplexFFTShort(n, data, work);
+    return plan->num_passes % 2 ? work : data;
+  }
+  for (pass = 0; pass < plan->num_passes; ++pass) {
+    if (n == 2) {
+      Radix2LastPassSSE2(s, x, y);
+    } else {
+      if (s == 1) {
+        Radix4FirstPassSSE2(n, w, x, y);
+      } else {
+        Radix4PassSSE2(n, s, w, x, y);
+      }
+      w += 3 * n / 2;
+      n /= 4;
+      s *= 4;
+    }
+    t = x;
+    x = y;
+    y = t;
+  }
+  return x;
+}
+
+// Loads the four complex values from |data|, as real and imaginary parts.
+static __inline void LoadComplex4(const float* data, __m128* re, __m128* im) {
+  const __m128 lo = _mm_loadu_ps(data);
+  const __m128 hi = _mm_loadu_ps(data + 4);
+  *re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+  *im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+// Like LoadComplex4(), but in reversed order.
+static __inline void LoadComplex4Reversed(const float* data,
+                                          __m128* re,
+                                          __m128* im) {
+  const __m128 lo = _mm_loadu_ps(data);
+  const __m128 hi = _mm_loadu_ps(data + 4);
+  *re = _mm_shuffle_ps(hi, lo, _MM_SHUFFLE(0, 2, 0, 2));
+  *im = _mm_shuffle_ps(hi, lo, _MM_SHUFFLE(1, 3, 1, 3));
+}
+
+static __inline void StoreComplex4(__m128 re, __m128 im, float* data) {
+  _mm_storeu_ps(data, _mm_unpacklo_ps(re, im));
+  _mm_storeu_ps(data + 4, _mm_unpackhi_ps(re, im));
+}
+
+static __inline void StoreComplex4Reversed(__m128 re, __m128 im, float* data) {
+  re = _mm_shuffle_ps(re, re, _MM_SHUFFLE(0, 1, 2, 3));
+  im = _mm_shuffle_ps(im, im, _MM_SHUFFLE(0, 1, 2, 3));
+  _mm_storeu_ps(data, _mm_unpacklo_ps(re, im));
+  _mm_storeu_ps(data + 4, _mm_unpackhi_ps(re, im));
+}
+
+void WebRtc_RdftSplitSSE2(const RdftPlan* plan,
+                          const float* spectrum,
+                          float* data) {
+  const size_t m = plan->length / 2;
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  const float z0r = spectrum[0];
+  const float z0i = spectrum[1];
+  size_t k;
+
+  data[0] = z0r + z0i;
+  data[1] = z0r - z0i;
+  // Four values from each end, as long as they do not meet.
+  for (k = 1; k + 4 <= m / 2; k += 4) {
+    const size_t l = m - k - 3;
+    const __m128 c = _mm_loadu_ps(&plan->split_cos[k]);
+    const __m128 s = _mm_loadu_ps(&plan->split_sin[k]);
+    __m128 zr, zi, yr, yi;
+    __m128 er, ei, dr, di, tr, ti;
+    LoadComplex4(&spectrum[2 * k], &zr, &zi);
+    LoadComplex4Reversed(&spectrum[2 * l], &yr, &yi);
+    er = _mm_mul_ps(kHalf, _mm_add_ps(zr, yr));
+    ei = _mm_mul_ps(kHalf, _mm_sub_ps(zi, yi));
+    dr = _mm_sub_ps(zr, yr);
+    di = _mm_add_ps(zi, yi);
+    tr = _mm_sub_ps(_mm_mul_ps(c, di), _mm_mul_ps(s, dr));
+    ti = _mm_sub_ps(_mm_setzero_ps(),
+                    _mm_add_ps(_mm_mul_ps(c, dr), _mm_mul_ps(s, di)));
+    StoreComplex4Reversed(_mm_sub_ps(er, tr), _mm_sub_ps(ei, ti),
+                          &data[2 * l]);
+    StoreComplex4(_mm_add_ps(er, tr),
+                  _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(ei, ti)),
+                  &data[2 * k]);
+  }
+  for (; k <= m / 2; ++k) {
+    const size_t l = m - k;
+    const float zr = spectrum[2 * k];
+    const float zi = spectrum[2 * k + 1];
+    const float yr = spectrum[2 * l];
+    const float yi = spectrum[2 * l + 1];
+    const float er = 0.5f * (zr + yr);
+    const float ei = 0.5f * (zi - yi);
+    const float dr = zr - yr;
+    const float di = zi + yi;
+    const float tr = plan->split_cos[k] * di - plan->split_sin[k] * dr;
+    const float ti = -plan->split_cos[k] * dr - plan->split_sin[k] * di;
+    data[2 * l] = er - tr;
+    data[2 * l + 1] = ei - ti;
+    data[2 * k] = er + tr;
+    data[2 * k + 1] = -(ei + ti);
+  }
+}
+
+void WebRtc_RdftMergeSSE2(const RdftPlan* plan,
+                          const float* data,
+                          float* spectrum) {
+  const size_t m = plan->length / 2;
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  const float r0 = data[0];
+  const float rm = data[1];
+  size_t k;
+
+  spectrum[0] = 0.5f * (r0 + rm);
+  spectrum[1] = -0.5f * (r0 - rm);
+  for (k = 1; k + 4 <= m / 2; k += 4) {
+    const size_t l = m - k - 3;
+    const __m128 c = _mm_loadu_ps(&plan->split_cos[k]);
+    const __m128 s = _mm_loadu_ps(&plan->split_sin[k]);
+    __m128 ar, ai, br, bi;
+    __m128 er, ei, dr, di, ur, ui;
+    LoadComplex4(&data[2 * k], &ar, &ai);
+    LoadComplex4Reversed(&data[2 * l], &br, &bi);
+    er = _mm_mul_ps(kHalf, _mm_add_ps(ar, br));
+    ei = _mm_mul_ps(kHalf, _mm_sub_ps(bi, ai));
+    dr = _mm_sub_ps(ar, br);
+    di = _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(ai, bi));
+    ur = _mm_sub_ps(_mm_setzero_ps(),
+                    _mm_add_ps(_mm_mul_ps(c, di), _mm_mul_ps(s, dr)));
+    ui = _mm_sub_ps(_mm_mul_ps(c, dr), _mm_mul_ps(s, di));
+    StoreComplex4Reversed(_mm_sub_ps(er, ur), _mm_sub_ps(ei, ui),
+                          &spectrum[2 * l]);
+    StoreComplex4(_mm_add_ps(er, ur),
+                  _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(ei, ui)),
+                  &spectrum[2 * k]);
+  }
+  for (; k <= m / 2; ++k) {
+    const size_t l = m - k;
+    const float ar = data[2 * k];
+    const float ai = data[2 * k + 1];
+    const float br = data[2 * l];
+    const float bi = data[2 * l + 1];
+    const float er = 0.5f * (ar + br);
+    const float ei = 0.5f * (bi - ai);
+    const float dr = ar - br;
+    const float di = -(ai + bi);
+    const float ur = -(plan->split_cos[k] * di + plan->split_sin[k] * dr);
+    const float ui = plan->split_cos[k] * dr - plan->split_sin[k] * di;
+    spectrum[2 * l] = er - ur;
+    spectrum[2 * l + 1] = ei - ui;
+    spectrum[2 * k] = er + ur;
+    spectrum[2 * k + 1] = -(ei + ui);
+  }
+}
+
+void WebRtc_RdftConjugateSSE2(size_t length, float* data) {
+  const __m128 kNegateImag = _mm_castsi128_ps(
+      _mm_set_epi32((int)0x80000000, 0, (int)0x80000000, 0));
+  size_t i;
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    _mm_storeu_ps(&data[i], _mm_xor_ps(_mm_loadu_ps(&data[i]), kNegateImag));
+  }
+  for (; i < length; i += 2) {
+    data[i + 1] = -data[i + 1];
+  }
+}
@@ -10,8 +10,13 @@
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 #include "rtc_base/checks.h"
 
+// Maximum order supported by WebRtcSpl_LevinsonDurbin().
+enum { kMaxLevinsonOrder = 20 };
+
 size_t WebRtcSpl_AutoCorrelation(const int16_t* in_vector,
                                  size_t in_vector_length,
                                  size_t order,
@@ -44,6 +49,15 @@ size_t WebRtcSpl_AutoCorrelation(const int16_t* in_vector,
     }
   }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtcSpl_AutoCorrelationSSE2(in_vector, in_vector_length, order, scaling,
+                                  result);
+    *scale = scaling;
+    return order + 1;
+  }
+#endif
+
   // Perform the actual correlation calculation.
   for (i = 0; i < order + 1; i++) {
     sum = 0;
@@ -63,3 +77,24 @@ size_t WebRtcSpl_AutoCorrelation(const int16_t* in_vector,
   *scale = scaling;
   return order + 1;
 }
+
+int16_t WebRtcSpl_AutoCorrelationToLpc(const int16_t* in_vector,
+                                       size_t in_vector_length,
+                                       size_t order,
+                                       const int32_t* lag_window,
+                                       int16_t* lpc_coef,
+                                       int16_t* refl_coef,
+                                       int* scale) {
+  int32_t auto_corr[kMaxLevinsonOrder + 1];
+
+  if (order > kMaxLevinsonOrder) {
+    return -1;
+  }
+
+  WebRtcSpl_AutoCorrelation(in_vector, in_vector_length, order, auto_corr,
+                            scale);
+  if (lag_window) {
+    WebRtcSpl_WindowW32(auto_corr, auto_corr, lag_window, order + 1);
+  }
+  return WebRtcSpl_LevinsonDurbin(auto_corr, lpc_coef, refl_coef, order);
+}
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+
+// Number of lags computed per pass over the input.
+enum { kLagsPerPass = 4 };
+
+// Products of eight pairs of samples, each shifted right by |scaling|, summed
+// pairwise into four 32-bit lanes.
+static __inline __m128i ScaledProducts(__m128i a, __m128i b, __m128i scaling) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  const __m128i high = _mm_mulhi_epi16(a, b);
+  return _mm_add_epi32(_mm_sra_epi32(_mm_unpacklo_epi16(low, high), scaling),
+                       _mm_sra_epi32(_mm_unpackhi_epi16(low, high), scaling));
+}
+
+static __inline int32_t HorizontalSum(__m128i v) {
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0x4e));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0xb1));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Computes the sums of x[j] * y[j + k] for k = 0, 1, 2, 3 into |sum|, over
+// |length| values of j rounded down to a multiple of 8. Returns the number of
+// values of j processed.
+static size_t CorrelateFourLags(const int16_t* x,
+                                const int16_t* y,
+                                size_t length,
+                                int scaling,
+                                __m128i sum[kLagsPerPass]) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i sum0 = _mm_setzero_si128();
+  __m128i sum1 = _mm_setzero_si128();
+  __m128i sum2 = _mm_setzero_si128();
+  __m128i sum3 = _mm_setzero_si128();
+  size_t j = 0;
+
+  if (scaling == 0) {
+    for (j = 0; j + 8 <= length; j += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&x[j]);
+      sum0 = _mm_add_epi32(
+          sum0, _mm_madd_epi16(v, _mm_loadu_si128((const __m128i*)&y[j])));
+      sum1 = _mm_add_epi32(
+          sum1, _mm_madd_epi16(v, _mm_loadu_si128((const __m128i*)&y[j + 1])));
+      sum2 = _mm_add_epi32(
+          sum2, _mm_madd_epi16(v, _mm_loadu_si128((const __m128i*)&y[j + 2])));
+      sum3 = _mm_add_epi32(
+          sum3, _mm_madd_epi16(v, _mm_loadu_si128((const __m128i*)&y[j + 3])));
+    }
+  } else {
+    for (j = 0; j + 8 <= length; j += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&x[j]);
+      sum0 = _mm_add_epi32(
+          sum0,
+          ScaledProducts(v, _mm_loadu_si128((const __m128i*)&y[j]), shift));
+      sum1 = _mm_add_epi32(
+          sum1, ScaledProducts(v, _mm_loadu_si128((const __m128i*)&y[j + 1]),
+                               shift));
+      sum2 = _mm_add_epi32(
+          sum2, ScaledProducts(v, _mm_loadu_si128((const __m128i*)&y[j + 2]),
+                               shift));
+      sum3 = _mm_add_epi32(
+          sum3, ScaledProducts(v, _mm_loadu_si128((const __m128i*)&y[j + 3]),
+                               shift));
+    }
+  }
+  sum[0] = sum0;
+  sum[1] = sum1;
+  sum[2] = sum2;
+  sum[3] = sum3;
+  return j;
+}
+
+// The sums wrap around like the 32-bit sums of the C code. Since addition
+// modulo 2^32 is associative, the order of accumulation (and the wrap around
+// in _mm_madd_epi16() for 2 * (-32768)^2) does not change the result.
+void WebRtcSpl_AutoCorrelationSSE2(const int16_t* in_vector,
+                                   size_t in_vector_length,
+                                   size_t order,
+                                   int scaling,
+                                   int32_t* result) {
+  size_t i = 0, j = 0, k = 0;
+
+  for (i = 0; i < order + 1; i += kLagsPerPass) {
+    __m128i sum[kLagsPerPass];
+    const size_t num_lags = WEBRTC_SPL_MIN(order + 1 - i, kLagsPerPass);
+    // Vectorize over the samples that all four lags have available.
+    j = 0;
+    if (in_vector_length >= i + kLagsPerPass - 1) {
+      j = CorrelateFourLags(in_vector, &in_vector[i],
+                            in_vector_length - i - (kLagsPerPass - 1), scaling,
+                            sum);
+    }
+
+    for (k = 0; k < num_lags; k++) {
+      const size_t lag = i + k;
+      size_t n = j;
+      // Accumulate as unsigned to wrap around without undefined behavior.
+      uint32_t total = j > 0 ? (uint32_t)HorizontalSum(sum[k]) : 0;
+      for (; n < in_vector_length - lag; n++) {
+        total += (uint32_t)((in_vector[n] * in_vector[lag + n]) >> scaling);
+      }
+      result[lag] = (int32_t)total;
+    }
+  }
+}
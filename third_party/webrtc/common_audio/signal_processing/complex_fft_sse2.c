@@ -0,0 +1,258 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file contains the functions WebRtcSpl_ComplexFFTSSE2() and
+ * WebRtcSpl_ComplexIFFTSSE2(). The description header can be found in
+ * complex_fft_sse2.h
+ *
+ * Every __m128i holds four complex values as {re, im} 16-bit pairs, so that
+ * one _mm_madd_epi16() computes four complex products with the exact 32-bit
+ * intermediate results of the C code in complex_fft.c.
+ */
+
+#include "common_audio/signal_processing/complex_fft_sse2.h"
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+#define CFFTSFT 14
+#define CFFTRND 1
+#define CFFTRND2 16384
+
+#define CIFFTSFT 14
+
+// One radix-2 butterfly on four complex values in each of |x_i| and |x_j|:
+//   t = w * x_j, x_i = (x_i + t) / 2^shift, x_j = (x_i - t) / 2^shift,
+// with the rounding and 16-bit truncation of complex_fft.c.
+static __inline void Butterfly(__m128i* x_i,
+                               __m128i* x_j,
+                               __m128i w_re,
+                               __m128i w_im,
+                               __m128i round,
+                               __m128i shift) {
+  const __m128i rnd = _mm_set1_epi32(CFFTRND);
+  const __m128i low_mask = _mm_set1_epi32(0x0000ffff);
+  const __m128i high_mask = _mm_set1_epi32((int32_t)0xffff0000);
+
+  // tr32 = (wr * xr - wi * xi + 1) >> 1, ti32 = (wr * xi + wi * xr + 1) >> 1.
+  __m128i tr = _mm_madd_epi16(*x_j, w_re);
+  __m128i ti = _mm_madd_epi16(*x_j, w_im);
+  tr = _mm_srai_epi32(_mm_add_epi32(tr, rnd), 15 - CFFTSFT);
+  ti = _mm_srai_epi32(_mm_add_epi32(ti, rnd), 15 - CFFTSFT);
+
+  // qr32 = xr << 14 and qi32 = xi << 14, sign extended.
+  __m128i qr = _mm_srai_epi32(_mm_slli_epi32(*x_i, 16), 16 - CFFTSFT);
+  __m128i qi = _mm_srai_epi32(_mm_and_si128(*x_i, high_mask), 16 - CFFTSFT);
+  qr = _mm_add_epi32(qr, round);
+  qi = _mm_add_epi32(qi, round);
+
+  const __m128i sum_r = _mm_sra_epi32(_mm_add_epi32(qr, tr), shift);
+  const __m128i sum_i = _mm_sra_epi32(_mm_add_epi32(qi, ti), shift);
+  const __m128i diff_r = _mm_sra_epi32(_mm_sub_epi32(qr, tr), shift);
+  const __m128i diff_i = _mm_sra_epi32(_mm_sub_epi32(qi, ti), shift);
+
+  // Truncate to 16 bits (not saturate) and interleave back to {re, im}.
+  *x_i = _mm_or_si128(_mm_and_si128(sum_r, low_mask), _mm_slli_epi32(sum_i, 16));
+  *x_j = _mm_or_si128(_mm_and_si128(diff_r, low_mask),
+                      _mm_slli_epi32(diff_i, 16));
+}
+
+// Stage with span 1: butterflies between neighbouring complex values.
+static void Stage1(int16_t* frfi,
+                   int n,
+                   const int16_t* twiddles,
+                   __m128i round,
+                   __m128i shift) {
+  const __m128i w = _mm_loadl_epi64((const __m128i*)twiddles);
+  const __m128i w_re = _mm_shuffle_epi32(w, 0x00);
+  const __m128i w_im = _mm_shuffle_epi32(w, 0x55);
+  int i;
+
+  for (i = 0; i < n; i += 8) {
+    __m128i* p = (__m128i*)&frfi[2 * i];
+    const __m128 v0 = _mm_castsi128_ps(_mm_loadu_si128(p));
+    const __m128 v1 = _mm_castsi128_ps(_mm_loadu_si128(p + 1));
+    __m128i x_i = _mm_castps_si128(_mm_shuffle_ps(v0, v1, 0x88));
+    __m128i x_j = _mm_castps_si128(_mm_shuffle_ps(v0, v1, 0xdd));
+    Butterfly(&x_i, &x_j, w_re, w_im, round, shift);
+    _mm_storeu_si128(p, _mm_unpacklo_epi32(x_i, x_j));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi32(x_i, x_j));
+  }
+}
+
+// Stage with span 2: butterflies between pairs of complex values.
+static void Stage2(int16_t* frfi,
+                   int n,
+                   const int16_t* twiddles,
+                   __m128i round,
+                   __m128i shift) {
+  const __m128i w_re = _mm_loadl_epi64((const __m128i*)&twiddles[4]);
+  const __m128i w_im = _mm_loadl_epi64((const __m128i*)&twiddles[8]);
+  const __m128i w_re2 = _mm_unpacklo_epi64(w_re, w_re);
+  const __m128i w_im2 = _mm_unpacklo_epi64(w_im, w_im);
+  int i;
+
+  for (i = 0; i < n; i += 8) {
+    __m128i* p = (__m128i*)&frfi[2 * i];
+    const __m128i v0 = _mm_loadu_si128(p);
+    const __m128i v1 = _mm_loadu_si128(p + 1);
+    __m128i x_i = _mm_unpacklo_epi64(v0, v1);
+    __m128i x_j = _mm_unpackhi_epi64(v0, v1);
+    Butterfly(&x_i, &x_j, w_re2, w_im2, round, shift);
+    _mm_storeu_si128(p, _mm_unpacklo_epi64(x_i, x_j));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(x_i, x_j));
+  }
+}
+
+// Stages with span 1 and 2 fused, on blocks of eight complex values.
+static void Stage1And2(int16_t* frfi, int n, const int16_t* twiddles) {
+  const __m128i round = _mm_set1_epi32(CFFTRND2);
+  const __m128i shift = _mm_cvtsi32_si128(1 + CFFTSFT);
+  const __m128i w1 = _mm_loadl_epi64((const __m128i*)twiddles);
+  const __m128i w1_re = _mm_shuffle_epi32(w1, 0x00);
+  const __m128i w1_im = _mm_shuffle_epi32(w1, 0x55);
+  const __m128i w2_re = _mm_loadl_epi64((const __m128i*)&twiddles[4]);
+  const __m128i w2_im = _mm_loadl_epi64((const __m128i*)&twiddles[8]);
+  const __m128i w2_re2 = _mm_unpacklo_epi64(w2_re, w2_re);
+  const __m128i w2_im2 = _mm_unpacklo_epi64(w2_im, w2_im);
+  int i;
+
+  for (i = 0; i < n; i += 8) {
+    __m128i* p = (__m128i*)&frfi[2 * i];
+    const __m128 v0 = _mm_castsi128_ps(_mm_loadu_si128(p));
+    const __m128 v1 = _mm_castsi128_ps(_mm_loadu_si128(p + 1));
+    __m128i x_i = _mm_castps_si128(_mm_shuffle_ps(v0, v1, 0x88));
+    __m128i x_j = _mm_castps_si128(_mm_shuffle_ps(v0, v1, 0xdd));
+    __m128i u0, u1;
+    Butterfly(&x_i, &x_j, w1_re, w1_im, round, shift);
+    u0 = _mm_unpacklo_epi32(x_i, x_j);
+    u1 = _mm_unpackhi_epi32(x_i, x_j);
+    x_i = _mm_unpacklo_epi64(u0, u1);
+    x_j = _mm_unpackhi_epi64(u0, u1);
+    Butterfly(&x_i, &x_j, w2_re2, w2_im2, round, shift);
+    _mm_storeu_si128(p, _mm_unpacklo_epi64(x_i, x_j));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(x_i, x_j));
+  }
+}
+
+// Generic radix-2 stage with span |l| >= 4.
+static void StageRadix2(int16_t* frfi,
+                        int n,
+                        int l,
+                        const int16_t* twiddles,
+                        __m128i round,
+                        __m128i shift) {
+  const int16_t* w_re = &twiddles[4 * (l - 1)];
+  const int16_t* w_im = w_re + 2 * l;
+  int i, m;
+
+  for (i = 0; i < n; i += 2 * l) {
+    __m128i* p_i = (__m128i*)&frfi[2 * i];
+    __m128i* p_j = (__m128i*)&frfi[2 * (i + l)];
+    for (m = 0; m < l; m += 4) {
+      __m128i x_i = _mm_loadu_si128(p_i);
+      __m128i x_j = _mm_loadu_si128(p_j);
+      Butterfly(&x_i, &x_j, _mm_loadu_si128((const __m128i*)&w_re[2 * m]),
+                _mm_loadu_si128((const __m128i*)&w_im[2 * m]), round, shift);
+      _mm_storeu_si128(p_i++, x_i);
+      _mm_storeu_si128(p_j++, x_j);
+    }
+  }
+}
+
+// Two consecutive forward stages with spans |l| and 2 * |l| (|l| >= 4), done
+// as one radix-4 pass over four values that stay in registers.
+static void StageRadix4(int16_t* frfi,
+                        int n,
+                        int l,
+                        const int16_t* twiddles) {
+  const __m128i round = _mm_set1_epi32(CFFTRND2);
+  const __m128i shift = _mm_cvtsi32_si128(1 + CFFTSFT);
+  const int16_t* w1_re = &twiddles[4 * (l - 1)];
+  const int16_t* w1_im = w1_re + 2 * l;
+  const int16_t* w2_re = &twiddles[4 * (2 * l - 1)];
+  const int16_t* w2_im = w2_re + 4 * l;
+  int i, m;
+
+  for (i = 0; i < n; i += 4 * l) {
+    __m128i* p = (__m128i*)&frfi[2 * i];
+    for (m = 0; m < l; m += 4) {
+      const __m128i w1r = _mm_loadu_si128((const __m128i*)&w1_re[2 * m]);
+      const __m128i w1i = _mm_loadu_si128((const __m128i*)&w1_im[2 * m]);
+      __m128i a = _mm_loadu_si128(p);
+      __m128i b = _mm_loadu_si128(p + l / 4);
+      __m128i c = _mm_loadu_si128(p + l / 2);
+      __m128i d = _mm_loadu_si128(p + 3 * l / 4);
+      Butterfly(&a, &b, w1r, w1i, round, shift);
+      Butterfly(&c, &d, w1r, w1i, round, shift);
+      Butterfly(&a, &c, _mm_loadu_si128((const __m128i*)&w2_re[2 * m]),
+                _mm_loadu_si128((const __m128i*)&w2_im[2 * m]), round, shift);
+      Butterfly(&b, &d, _mm_loadu_si128((const __m128i*)&w2_re[2 * (m + l)]),
+                _mm_loadu_si128((const __m128i*)&w2_im[2 * (m + l)]), round,
+                shift);
+      _mm_storeu_si128(p, a);
+      _mm_storeu_si128(p + l / 4, b);
+      _mm_storeu_si128(p + l / 2, c);
+      _mm_storeu_si128(p + 3 * l / 4, d);
+      p++;
+    }
+  }
+}
+
+void WebRtcSpl_ComplexFFTSSE2(int16_t* frfi,
+                              int stages,
+                              const int16_t* twiddles) {
+  const __m128i round = _mm_set1_epi32(CFFTRND2);
+  const __m128i shift = _mm_cvtsi32_si128(1 + CFFTSFT);
+  const int n = 1 << stages;
+  int l = 4;
+
+  Stage1And2(frfi, n, twiddles);
+  for (; 2 * l < n; l <<= 2) {
+    StageRadix4(frfi, n, l, twiddles);
+  }
+  if (l < n) {
+    StageRadix2(frfi, n, l, twiddles, round, shift);
+  }
+}
+
+int WebRtcSpl_ComplexIFFTSSE2(int16_t* frfi,
+                              int stages,
+                              const int16_t* twiddles) {
+  const int n = 1 << stages;
+  int scale = 0;
+  int l;
+
+  for (l = 1; l < n; l <<= 1) {
+    // Variable scaling, depending upon data.
+    int shift = 0;
+    const int16_t max_abs = WebRtcSpl_MaxAbsValueW16(frfi, 2 * n);
+    if (max_abs > 13573) {
+      shift++;
+    }
+    if (max_abs > 27146) {
+      shift++;
+    }
+    scale += shift;
+
+    const __m128i round = _mm_set1_epi32(8192 << shift);
+    const __m128i sra = _mm_cvtsi32_si128(shift + CIFFTSFT);
+    if (l == 1) {
+      Stage1(frfi, n, twiddles, round, sra);
+    } else if (l == 2) {
+      Stage2(frfi, n, twiddles, round, sra);
+    } else {
+      StageRadix2(frfi, n, l, twiddles, round, sra);
+    }
+  }
+  return scale;
+}
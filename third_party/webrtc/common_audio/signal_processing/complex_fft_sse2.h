@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 versions of WebRtcSpl_ComplexFFT() and WebRtcSpl_ComplexIFFT() in the
+// high-accuracy mode (mode == 1), operating on the twiddle tables precomputed
+// by WebRtcSpl_CreateRealFFT(). Only for use by real_fft.c.
+
+#ifndef COMMON_AUDIO_SIGNAL_PROCESSING_COMPLEX_FFT_SSE2_H_
+#define COMMON_AUDIO_SIGNAL_PROCESSING_COMPLEX_FFT_SSE2_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Smallest number of stages handled by the SSE2 kernels. Each vector holds
+// four complex values and the first stage pairs up two vectors.
+enum { kComplexFFTSSE2MinStages = 3 };
+
+// Twiddle table layout: for every stage, in increasing butterfly span
+// l = 1, 2, 4, ..., 2^(stages-1), there are 4 * l values, starting at offset
+// 4 * (l - 1). The first 2 * l values are the pairs {wr, -wi} for the real
+// part of the product and the next 2 * l values the pairs {wi, wr} for the
+// imaginary part, where wr and wi are taken from kSinTable1024[] as in
+// complex_fft.c (wi differs in sign between the forward and the inverse
+// transform). The table has 4 * (2^stages - 1) values in total.
+//
+// Both functions expect |frfi| to be bit reversed already, and produce output
+// identical to WebRtcSpl_ComplexFFT(frfi, stages, 1) and
+// WebRtcSpl_ComplexIFFT(frfi, stages, 1), respectively.
+void WebRtcSpl_ComplexFFTSSE2(int16_t* frfi,
+                              int stages,
+                              const int16_t* twiddles);
+int WebRtcSpl_ComplexIFFTSSE2(int16_t* frfi,
+                              int stages,
+                              const int16_t* twiddles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // COMMON_AUDIO_SIGNAL_PROCESSING_COMPLEX_FFT_SSE2_H_
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Adds the shifted products of eight samples of |seq1| and |seq2| to |sum|.
+// Without a shift, the products are summed in pairs by _mm_madd_epi16(),
+// which wraps around like the 32-bit sum of the C code.
+static __inline __m128i AddProducts(__m128i sum,
+                                    __m128i seq1,
+                                    __m128i seq2,
+                                    int right_shifts,
+                                    __m128i shift) {
+  __m128i low, high;
+  if (right_shifts == 0) {
+    return _mm_add_epi32(sum, _mm_madd_epi16(seq1, seq2));
+  }
+  low = _mm_mullo_epi16(seq1, seq2);
+  high = _mm_mulhi_epi16(seq1, seq2);
+  sum = _mm_add_epi32(sum, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+  return _mm_add_epi32(sum,
+                       _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+}
+
+// Adds up the four lanes of each of |s0|, ..., |s3| into one lane.
+static __inline __m128i HorizontalSums(__m128i s0,
+                                       __m128i s1,
+                                       __m128i s2,
+                                       __m128i s3) {
+  const __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(s0, s1),
+                                    _mm_unpackhi_epi32(s0, s1));
+  const __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(s2, s3),
+                                    _mm_unpackhi_epi32(s2, s3));
+  return _mm_add_epi32(_mm_unpacklo_epi64(s01, s23),
+                       _mm_unpackhi_epi64(s01, s23));
+}
+
+// Four correlations are computed at a time, sharing the loads of |seq1|.
+void WebRtcSpl_CrossCorrelationSSE2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  const __m128i zero = _mm_setzero_si128();
+  const size_t dim_vector = dim_seq & ~(size_t)7;
+  size_t i = 0, j = 0;
+  int k = 0;
+
+  for (i = 0; i + 4 <= dim_cross_correlation; i += 4) {
+    __m128i sum[4] = {zero, zero, zero, zero};
+    for (j = 0; j < dim_vector; j += 8) {
+      const __m128i x = _mm_loadu_si128((const __m128i*)&seq1[j]);
+      for (k = 0; k < 4; k++) {
+        const __m128i y =
+            _mm_loadu_si128((const __m128i*)&seq2[k * step_seq2 + j]);
+        sum[k] = AddProducts(sum[k], x, y, right_shifts, shift);
+      }
+    }
+    _mm_storeu_si128((__m128i*)&cross_correlation[i],
+                     HorizontalSums(sum[0], sum[1], sum[2], sum[3]));
+    for (; j < dim_seq; j++) {
+      for (k = 0; k < 4; k++) {
+        cross_correlation[i + k] +=
+            (seq1[j] * seq2[k * step_seq2 + j]) >> right_shifts;
+      }
+    }
+    seq2 += 4 * step_seq2;
+  }
+
+  for (; i < dim_cross_correlation; i++) {
+    __m128i sum = zero;
+    int32_t corr = 0;
+    for (j = 0; j < dim_vector; j += 8) {
+      sum = AddProducts(sum, _mm_loadu_si128((const __m128i*)&seq1[j]),
+                        _mm_loadu_si128((const __m128i*)&seq2[j]),
+                        right_shifts, shift);
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+    corr = _mm_cvtsi128_si32(sum);
+    for (; j < dim_seq; j++)
+      corr += (seq1[j] * seq2[j]) >> right_shifts;
+    seq2 += step_seq2;
+    cross_correlation[i] = corr;
+  }
+}
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Longest filter that is kept in registers.
+enum { kMaxCoefficientPairs = 8 };
+// Longest filter of the dot product version, in blocks of eight taps.
+enum { kMaxCoefficientBlocks = 12 };
+
+// Filters of at least eight taps, for any factor, compute each output as a
+// dot product of the input samples x[i - coefficients_length + 1] to x[i] and
+// the reversed taps, eight at a time. The last block is padded with zero taps
+// after x[i], so four outputs are computed at a time only as long as that
+// stays within |data_in|. The 32-bit sums wrap around like those of the C
+// code, in which the order of the additions makes no difference.
+static int DownsampleFastDotProductSSE2(const int16_t* data_in,
+                                        size_t data_in_length,
+                                        int16_t* data_out,
+                                        size_t data_out_length,
+                                        const int16_t* coefficients,
+                                        size_t coefficients_length,
+                                        int factor,
+                                        size_t delay) {
+  const size_t blocks = (coefficients_length + 7) / 8;
+  const size_t padding = 8 * blocks - coefficients_length;
+  const ptrdiff_t first = -(ptrdiff_t)(coefficients_length - 1);
+  int16_t reversed[8 * kMaxCoefficientBlocks] = { 0 };
+  __m128i taps[kMaxCoefficientBlocks];
+  const __m128i round = _mm_set1_epi32(2048);
+  size_t i = 0, k = 0, b = 0, n = 0;
+
+  for (n = 0; n < coefficients_length; n++) {
+    reversed[n] = coefficients[coefficients_length - 1 - n];
+  }
+  for (b = 0; b < blocks; b++) {
+    taps[b] = _mm_loadu_si128((const __m128i*)&reversed[8 * b]);
+  }
+
+  for (k = 0, i = delay;
+       k + 4 <= data_out_length && i + 3 * factor + padding < data_in_length;
+       k += 4, i += 4 * factor) {
+    __m128i sum[4];
+    __m128i low, high;
+    for (n = 0; n < 4; n++) {
+      const int16_t* x = &data_in[(ptrdiff_t)(i + n * factor) + first];
+      sum[n] = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)x), taps[0]);
+      for (b = 1; b < blocks; b++) {
+        sum[n] = _mm_add_epi32(
+            sum[n], _mm_madd_epi16(
+                        _mm_loadu_si128((const __m128i*)&x[8 * b]), taps[b]));
+      }
+    }
+    // Add up the four partial sums of each output.
+    low = _mm_add_epi32(_mm_unpacklo_epi32(sum[0], sum[1]),
+                        _mm_unpackhi_epi32(sum[0], sum[1]));
+    high = _mm_add_epi32(_mm_unpacklo_epi32(sum[2], sum[3]),
+                         _mm_unpackhi_epi32(sum[2], sum[3]));
+    low = _mm_add_epi32(_mm_unpacklo_epi64(low, high),
+                        _mm_unpackhi_epi64(low, high));
+    low = _mm_srai_epi32(_mm_add_epi32(low, round), 12);
+    _mm_storel_epi64((__m128i*)&data_out[k], _mm_packs_epi32(low, low));
+  }
+
+  if (k < data_out_length) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, &data_out[k],
+                                     data_out_length - k, coefficients,
+                                     coefficients_length, factor, i);
+  }
+  return 0;
+}
+
+// Decimation by two, which is what the callers use, computes four outputs at
+// a time. Taps j + 1 and j are paired so that _mm_madd_epi16() multiplies the
+// adjacent samples x[i - j - 1] and x[i - j] of four outputs i at once. An odd
+// last tap is paired with a zero after it instead, so that no sample before
+// x[i - coefficients_length + 1] is read. The 32-bit sums wrap around like
+// those of the C code, in which the order of the additions makes no
+// difference. Other factors and longer filters use the dot product version
+// above if they have at least eight taps. Other short filters, single taps,
+// and the outputs for which a vector load would read past the end of
+// |data_in|, use the C code.
+int WebRtcSpl_DownsampleFastSSE2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay) {
+  const size_t endpos = delay + factor * (data_out_length - 1) + 1;
+  const size_t pairs = (coefficients_length + 1) / 2;
+  __m128i taps[kMaxCoefficientPairs];
+  ptrdiff_t offsets[kMaxCoefficientPairs];
+  const __m128i round = _mm_set1_epi32(2048);
+  size_t i = 0, k = 0, p = 0;
+
+  if (data_out_length == 0 || coefficients_length == 0 ||
+      data_in_length < endpos) {
+    return -1;
+  }
+  if ((factor != 2 || pairs > kMaxCoefficientPairs) &&
+      coefficients_length >= 8 &&
+      coefficients_length <= 8 * kMaxCoefficientBlocks) {
+    return DownsampleFastDotProductSSE2(data_in, data_in_length, data_out,
+                                        data_out_length, coefficients,
+                                        coefficients_length, factor, delay);
+  }
+  if (factor != 2 || coefficients_length < 2 ||
+      pairs > kMaxCoefficientPairs) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, data_out,
+                                     data_out_length, coefficients,
+                                     coefficients_length, factor, delay);
+  }
+
+  for (p = 0; p < pairs; p++) {
+    int16_t low = 0, high = 0;
+    if (2 * p + 1 < coefficients_length) {
+      low = coefficients[2 * p + 1];
+      high = coefficients[2 * p];
+      offsets[p] = -(ptrdiff_t)(2 * p + 1);
+    } else {
+      low = coefficients[2 * p];
+      offsets[p] = -(ptrdiff_t)(2 * p);
+    }
+    taps[p] = _mm_set1_epi32((int32_t)((uint16_t)low |
+                                       ((uint32_t)(uint16_t)high << 16)));
+  }
+
+  // Four outputs read up to data_in[i + 6].
+  for (k = 0, i = delay; k + 4 <= data_out_length && i + 7 <= data_in_length;
+       k += 4, i += 8) {
+    __m128i sum = round;
+    for (p = 0; p < pairs; p++) {
+      const __m128i x = _mm_loadu_si128(
+          (const __m128i*)&data_in[(ptrdiff_t)i + offsets[p]]);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(x, taps[p]));
+    }
+    sum = _mm_srai_epi32(sum, 12);
+    _mm_storel_epi64((__m128i*)&data_out[k], _mm_packs_epi32(sum, sum));
+  }
+
+  if (k < data_out_length) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, &data_out[k],
+                                     data_out_length - k, coefficients,
+                                     coefficients_length, factor, i);
+  }
+  return 0;
+}
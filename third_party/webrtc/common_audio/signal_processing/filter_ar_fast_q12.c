@@ -12,6 +12,8 @@
 
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 // TODO(bjornv): Change the return type to report errors.
 
@@ -26,7 +28,15 @@ void WebRtcSpl_FilterARFastQ12(const int16_t* data_in,
   RTC_DCHECK_GT(data_length, 0);
   RTC_DCHECK_GT(coefficients_length, 1);
 
-  for (i = 0; i < data_length; i++) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    // Filters blocks of eight samples, leaving the rest to the C code.
+    i = WebRtcSpl_FilterARFastQ12SSE2(data_in, data_out, coefficients,
+                                      coefficients_length, data_length);
+  }
+#endif
+
+  for (; i < data_length; i++) {
     int64_t output = 0;
     int64_t sum = 0;
 
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <string.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+
+// The output is produced in blocks of eight samples. For every block, the
+// part of the recursion that depends on the outputs of earlier blocks is an
+// MA filter, which is computed for all eight samples at once. Only the
+// dependencies on earlier outputs within the block, at most seven products
+// per sample, remain sequential.
+enum { kBlockLength = 8 };
+enum { kMaxOrder = kFilterARFastQ12SSE2MaxLength - 1 };
+// Outputs are kept in a local buffer, preceded by the |kMaxOrder| latest
+// outputs of the previous chunk, and copied to |data_out| as well.
+enum { kChunkLength = 8 * kBlockLength };
+
+size_t WebRtcSpl_FilterARFastQ12SSE2(const int16_t* data_in,
+                                     int16_t* data_out,
+                                     const int16_t* coefficients,
+                                     size_t coefficients_length,
+                                     size_t data_length) {
+  // Coefficient pairs for taps (1, 2), (3, 4), ... for the first and the last
+  // four samples of a block. A tap j only applies to outputs of earlier
+  // blocks, so it is zero for samples k >= j of the block.
+  __m128i coef_pairs[kMaxOrder / 2][2];
+  int16_t buffer[kMaxOrder + kChunkLength];
+  int32_t target[kBlockLength];
+  const size_t order = coefficients_length - 1;
+  const size_t num_pairs = (order + 1) / 2;
+  const __m128i coef0 = _mm_set1_epi16(coefficients[0]);
+  int32_t abs_sum = 0;
+  size_t i = 0, j = 0, k = 0, n = 0;
+
+  // The C code accumulates in 64 bits. Filter only where no 32-bit sum can
+  // overflow, i.e. where the absolute values of all the coefficients sum to
+  // less than 2^16.
+  if (coefficients_length < kFilterARFastQ12SSE2MinLength ||
+      coefficients_length > kFilterARFastQ12SSE2MaxLength) {
+    return 0;
+  }
+  for (j = 0; j < coefficients_length; j++) {
+    abs_sum += WEBRTC_SPL_ABS_W32(coefficients[j]);
+  }
+  if (abs_sum > WEBRTC_SPL_WORD16_MAX * 2 + 1) {
+    return 0;
+  }
+  // Inputs are read a chunk ahead of the outputs being written. Leave it to
+  // the C code to filter in place where it reads back its own output as
+  // input.
+  if ((uintptr_t)data_in < (uintptr_t)data_out &&
+      (uintptr_t)data_out < (uintptr_t)(data_in + data_length)) {
+    return 0;
+  }
+
+  for (j = 0; j < num_pairs; j++) {
+    int16_t pair[2][8];
+    for (k = 0; k < kBlockLength; k++) {
+      const size_t tap = 2 * j + 1;
+      int16_t* dst = &pair[k / 4][2 * (k % 4)];
+      dst[0] = k < tap ? coefficients[tap] : 0;
+      dst[1] = (k < tap + 1 && tap + 1 <= order) ? coefficients[tap + 1] : 0;
+    }
+    coef_pairs[j][0] = _mm_loadu_si128((const __m128i*)pair[0]);
+    coef_pairs[j][1] = _mm_loadu_si128((const __m128i*)pair[1]);
+  }
+
+  memset(buffer, 0, sizeof(buffer[0]) * (kMaxOrder - order));
+  memcpy(&buffer[kMaxOrder - order], data_out - order,
+         sizeof(buffer[0]) * order);
+
+  for (i = 0; i + kBlockLength <= data_length; i += n) {
+    int16_t* out = &buffer[kMaxOrder];
+    n = WEBRTC_SPL_MIN(data_length - i, kChunkLength) & ~(kBlockLength - 1);
+
+    for (k = 0; k < n; k += kBlockLength) {
+      const __m128i in = _mm_loadu_si128((const __m128i*)&data_in[i + k]);
+      const __m128i low = _mm_mullo_epi16(in, coef0);
+      const __m128i high = _mm_mulhi_epi16(in, coef0);
+      __m128i sum_lo = _mm_unpacklo_epi16(low, high);
+      __m128i sum_hi = _mm_unpackhi_epi16(low, high);
+      size_t m = 0;
+
+      for (j = 0; j < num_pairs; j++) {
+        const int16_t* past = &out[k - 2 * j - 1];
+        const __m128i x0 = _mm_loadu_si128((const __m128i*)past);
+        const __m128i x1 = _mm_loadu_si128((const __m128i*)(past - 1));
+        sum_lo = _mm_sub_epi32(
+            sum_lo,
+            _mm_madd_epi16(_mm_unpacklo_epi16(x0, x1), coef_pairs[j][0]));
+        sum_hi = _mm_sub_epi32(
+            sum_hi,
+            _mm_madd_epi16(_mm_unpackhi_epi16(x0, x1), coef_pairs[j][1]));
+      }
+      _mm_storeu_si128((__m128i*)&target[0], sum_lo);
+      _mm_storeu_si128((__m128i*)&target[4], sum_hi);
+
+      for (m = 0; m < kBlockLength; m++) {
+        int32_t output = target[m];
+        int16_t* y = &out[k + m];
+        for (j = WEBRTC_SPL_MIN(m, order); j > 0; j--) {
+          output -= coefficients[j] * y[-(ptrdiff_t)j];
+        }
+        output = WEBRTC_SPL_SAT(134215679, output, -134217728);
+        *y = (int16_t)((output + 2048) >> 12);
+      }
+    }
+
+    memcpy(&data_out[i], out, sizeof(data_out[0]) * n);
+    memmove(&buffer[kMaxOrder - order], &out[n - order],
+            sizeof(buffer[0]) * order);
+  }
+  return i;
+}
@@ -17,6 +17,8 @@
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 #include "rtc_base/sanitizer.h"
 
 void WebRtcSpl_FilterMAFastQ12(const int16_t* in_ptr,
@@ -25,13 +27,23 @@ void WebRtcSpl_FilterMAFastQ12(const int16_t* in_ptr,
                                size_t B_length,
                                size_t length)
 {
-    size_t i, j;
+    size_t i = 0, j;
 
     rtc_MsanCheckInitialized(B, sizeof(B[0]), B_length);
     rtc_MsanCheckInitialized(in_ptr - B_length + 1, sizeof(in_ptr[0]),
                              B_length + length - 1);
 
-    for (i = 0; i < length; i++)
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_UseSSE2())
+    {
+        // Filters blocks of eight samples, leaving the rest to the C code.
+        i = WebRtcSpl_FilterMAFastQ12SSE2(in_ptr, out_ptr, B, B_length,
+                                          length);
+        out_ptr += i;
+    }
+#endif
+
+    for (; i < length; i++)
     {
         int32_t o = 0;
 
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+
+// Rounds the Q12 sums in |o| to Q0 as (o + 2048) >> 12, computed as
+// ((o >> 11) + 1) >> 1 so that it cannot overflow. Saturating to 16 bits
+// afterwards gives the same result as saturating |o| to
+// [-134217728, 134215679] first, as done in the C code.
+static __inline __m128i RoundQ12(__m128i o) {
+  return _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(o, 11),
+                                      _mm_set1_epi32(1)), 1);
+}
+
+// Filters eight samples, using one _mm_madd_epi16() per pair of taps. The
+// sums wrap around like the 32-bit sum of the C code.
+static __inline __m128i FilterEight(const int16_t* in_ptr,
+                                    const __m128i* coef_pairs,
+                                    size_t B_length) {
+  __m128i sum_lo = _mm_setzero_si128();
+  __m128i sum_hi = _mm_setzero_si128();
+  size_t j = 0;
+
+  for (j = 0; j + 1 < B_length; j += 2) {
+    const __m128i x0 = _mm_loadu_si128((const __m128i*)&in_ptr[-(ptrdiff_t)j]);
+    const __m128i x1 =
+        _mm_loadu_si128((const __m128i*)&in_ptr[-(ptrdiff_t)j - 1]);
+    sum_lo = _mm_add_epi32(
+        sum_lo, _mm_madd_epi16(_mm_unpacklo_epi16(x0, x1), coef_pairs[j / 2]));
+    sum_hi = _mm_add_epi32(
+        sum_hi, _mm_madd_epi16(_mm_unpackhi_epi16(x0, x1), coef_pairs[j / 2]));
+  }
+  if (j < B_length) {
+    // The last tap of an odd length filter is paired with zeros, to not read
+    // in front of the filter state.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i x0 = _mm_loadu_si128((const __m128i*)&in_ptr[-(ptrdiff_t)j]);
+    sum_lo = _mm_add_epi32(
+        sum_lo,
+        _mm_madd_epi16(_mm_unpacklo_epi16(x0, zero), coef_pairs[j / 2]));
+    sum_hi = _mm_add_epi32(
+        sum_hi,
+        _mm_madd_epi16(_mm_unpackhi_epi16(x0, zero), coef_pairs[j / 2]));
+  }
+  return _mm_packs_epi32(RoundQ12(sum_lo), RoundQ12(sum_hi));
+}
+
+size_t WebRtcSpl_FilterMAFastQ12SSE2(const int16_t* in_ptr,
+                                     int16_t* out_ptr,
+                                     const int16_t* B,
+                                     size_t B_length,
+                                     size_t length) {
+  __m128i coef_pairs[(kFilterMAFastQ12SSE2MaxLength + 1) / 2];
+  size_t i = 0, j = 0;
+
+  if (B_length > kFilterMAFastQ12SSE2MaxLength) {
+    return 0;
+  }
+  // Leave it to the C code to filter in place where it reads back its own
+  // output.
+  if ((uintptr_t)out_ptr > (uintptr_t)(in_ptr - (B_length - 1)) &&
+      (uintptr_t)out_ptr < (uintptr_t)(in_ptr + length)) {
+    return 0;
+  }
+  for (j = 0; j < B_length; j += 2) {
+    const uint16_t second = j + 1 < B_length ? (uint16_t)B[j + 1] : 0;
+    coef_pairs[j / 2] =
+        _mm_set1_epi32((int32_t)(((uint32_t)second << 16) | (uint16_t)B[j]));
+  }
+
+  // The input of every eight outputs is loaded before they are stored, which
+  // also covers in-place filtering with |out_ptr| <= |in_ptr| - (B_length - 1).
+  for (i = 0; i + 8 <= length; i += 8) {
+    _mm_storeu_si128((__m128i*)&out_ptr[i],
+                     FilterEight(&in_ptr[i], coef_pairs, B_length));
+  }
+  return i;
+}
@@ -11,6 +11,7 @@
 #ifndef COMMON_AUDIO_SIGNAL_PROCESSING_INCLUDE_REAL_FFT_H_
 #define COMMON_AUDIO_SIGNAL_PROCESSING_INCLUDE_REAL_FFT_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 // For ComplexFFT(), the maximum fft order is 10;
@@ -23,6 +24,9 @@ struct RealFFT;
 extern "C" {
 #endif
 
+// Creates the FFT specification structure for transforms of length 2^order.
+// The bit reversal permutation and, where SIMD kernels are available, the
+// twiddle tables are computed once here and reused by every transform.
 struct RealFFT* WebRtcSpl_CreateRealFFT(int order);
 void WebRtcSpl_FreeRealFFT(struct RealFFT* self);
 
@@ -89,6 +93,35 @@ int WebRtcSpl_RealInverseFFT(struct RealFFT* self,
                              const int16_t* complex_data_in,
                              int16_t* real_data_out);
 
+// Batched versions of WebRtcSpl_RealForwardFFT() and
+// WebRtcSpl_RealInverseFFT(), transforming |num_frames| equal-size frames
+// stored back to back. Frame k of the real signal starts at k * 2^order and
+// frame k of the CCS vectors at k * (2^order + 2). The output of every frame
+// is identical to that of the corresponding single-frame call.
+//
+// Input Arguments:
+//   self - pointer to preallocated and initialized FFT specification structure.
+//   real_data_in / complex_data_in - |num_frames| input frames.
+//   num_frames - number of frames to transform.
+//
+// Output Arguments:
+//   complex_data_out / real_data_out - |num_frames| output frames.
+//   scales - (inverse only) the return value of WebRtcSpl_RealInverseFFT()
+//            for each frame.
+//
+// Return Value:
+//   0  - FFT calculation is successful.
+//   -1 - Error with bad arguments.
+int WebRtcSpl_RealForwardFFTBatch(struct RealFFT* self,
+                                  const int16_t* real_data_in,
+                                  size_t num_frames,
+                                  int16_t* complex_data_out);
+int WebRtcSpl_RealInverseFFTBatch(struct RealFFT* self,
+                                  const int16_t* complex_data_in,
+                                  size_t num_frames,
+                                  int16_t* real_data_out,
+                                  int* scales);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,7 @@
 
 #include <string.h>
 #include "common_audio/signal_processing/dot_product_with_scale.h"
+#include "rtc_base/system/arch.h"
 
 // Macros specific for the fixed point implementation
 #define WEBRTC_SPL_WORD16_MAX 32767
@@ -146,6 +147,9 @@ int16_t WebRtcSpl_MaxAbsValueW16C(const int16_t* vector, size_t length);
 #if defined(WEBRTC_HAS_NEON)
 int16_t WebRtcSpl_MaxAbsValueW16Neon(const int16_t* vector, size_t length);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length);
+#endif
 #if defined(MIPS32_LE)
 int16_t WebRtcSpl_MaxAbsValueW16_mips(const int16_t* vector, size_t length);
 #endif
@@ -163,6 +167,9 @@ int32_t WebRtcSpl_MaxAbsValueW32C(const int32_t* vector, size_t length);
 #if defined(WEBRTC_HAS_NEON)
 int32_t WebRtcSpl_MaxAbsValueW32Neon(const int32_t* vector, size_t length);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int32_t WebRtcSpl_MaxAbsValueW32SSE2(const int32_t* vector, size_t length);
+#endif
 #if defined(MIPS_DSP_R1_LE)
 int32_t WebRtcSpl_MaxAbsValueW32_mips(const int32_t* vector, size_t length);
 #endif
@@ -287,6 +294,32 @@ size_t WebRtcSpl_MinIndexW16(const int16_t* vector, size_t length);
 //                 indexes have the minimum, return the first).
 size_t WebRtcSpl_MinIndexW32(const int32_t* vector, size_t length);
 
+// Statistics of a 16-bit vector, as computed by WebRtcSpl_GetVectorStatsW16().
+typedef struct {
+  int16_t min_value;      // WebRtcSpl_MinValueW16().
+  int16_t max_value;      // WebRtcSpl_MaxValueW16().
+  int16_t max_abs_value;  // WebRtcSpl_MaxAbsValueW16().
+  size_t max_index;       // WebRtcSpl_MaxIndexW16().
+  size_t max_abs_index;   // WebRtcSpl_MaxAbsIndexW16().
+  int32_t energy;         // WebRtcSpl_Energy().
+  int energy_scale;       // |scale_factor| of WebRtcSpl_Energy().
+} WebRtcSpl_VectorStats;
+
+// Computes all the statistics in WebRtcSpl_VectorStats in a single pass over
+// the vector, with results identical to those of the individual functions.
+// A second pass is made for |energy| only if |energy_scale| is non-zero.
+// Implementation in vector_statistics.c.
+//
+// Input:
+//      - vector : 16-bit input vector.
+//      - length : Number of samples in vector, larger than 0.
+//
+// Output:
+//      - stats  : Statistics of |vector|.
+void WebRtcSpl_GetVectorStatsW16(const int16_t* vector,
+                                 size_t length,
+                                 WebRtcSpl_VectorStats* stats);
+
 // End: Minimum and maximum operations.
 
 // Vector scaling operations. Implementation in vector_scaling_operations.c.
@@ -321,6 +354,10 @@ void WebRtcSpl_ScaleAndAddVectors(const int16_t* in_vector1,
                                   int right_shifts2,
                                   int16_t* out_vector,
                                   size_t vector_length);
+void WebRtcSpl_WindowW32(int32_t* out_vector,
+                         const int32_t* in_vector,
+                         const int32_t* window,
+                         size_t vector_length);
 
 // The functions (with related pointer) perform the vector operation:
 //   out_vector[k] = ((scale1 * in_vector1[k]) + (scale2 * in_vector2[k])
@@ -439,6 +476,34 @@ int16_t WebRtcSpl_LevinsonDurbin(const int32_t* auto_corr,
                                  int16_t* refl_coef,
                                  size_t order);
 
+// WebRtcSpl_AutoCorrelation() followed by WebRtcSpl_LevinsonDurbin(), with
+// the auto-correlation kept internal. If |lag_window| is not NULL, the
+// auto-correlation is multiplied by it in between, as the LPC analysis of the
+// codecs does.
+//
+// Input:
+//      - in_vector        : Vector to calculate the LPC coefficients of
+//      - in_vector_length : Length (in samples) of |in_vector|
+//      - order            : The LPC filter order (support up to order 20)
+//      - lag_window       : NULL, or |order|+1 lag window values in Q31,
+//                           applied with WebRtcSpl_WindowW32()
+//
+// Output:
+//      - lpc_coef         : lpc_coef[0..order] LPC coefficients in Q12
+//      - refl_coef        : refl_coef[0...order-1]| Reflection coefficients in
+//                           Q15
+//      - scale            : The scale returned by WebRtcSpl_AutoCorrelation()
+//
+// Return value            : 1 for stable, 0 for unstable, -1 if |order| is
+//                           above 20
+int16_t WebRtcSpl_AutoCorrelationToLpc(const int16_t* in_vector,
+                                       size_t in_vector_length,
+                                       size_t order,
+                                       const int32_t* lag_window,
+                                       int16_t* lpc_coef,
+                                       int16_t* refl_coef,
+                                       int* scale);
+
 // Converts reflection coefficients |refl_coef| to LPC coefficients |lpc_coef|.
 // This version is a 16 bit operation.
 //
@@ -531,6 +596,15 @@ void WebRtcSpl_CrossCorrelationNeon(int32_t* cross_correlation,
                                     int right_shifts,
                                     int step_seq2);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcSpl_CrossCorrelationSSE2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2);
+#endif
 #if defined(MIPS32_LE)
 void WebRtcSpl_CrossCorrelation_mips(int32_t* cross_correlation,
                                      const int16_t* seq1,
@@ -682,6 +756,16 @@ int WebRtcSpl_DownsampleFastNeon(const int16_t* data_in,
                                  int factor,
                                  size_t delay);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int WebRtcSpl_DownsampleFastSSE2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay);
+#endif
 #if defined(MIPS32_LE)
 int WebRtcSpl_DownsampleFast_mips(const int16_t* data_in,
                                   size_t data_in_length,
@@ -904,6 +988,60 @@ void WebRtcSpl_SynthesisQMF(const int16_t* low_band,
                             int16_t* out_data,
                             int32_t* filter_state1,
                             int32_t* filter_state2);
+void WebRtcSpl_AnalysisQMFBatch(const int16_t* const* in_data,
+                                size_t in_data_length,
+                                int16_t* const* low_band,
+                                int16_t* const* high_band,
+                                int32_t* const* filter_state1,
+                                int32_t* const* filter_state2,
+                                size_t num_streams);
+void WebRtcSpl_SynthesisQMFBatch(const int16_t* const* low_band,
+                                 const int16_t* const* high_band,
+                                 size_t band_length,
+                                 int16_t* const* out_data,
+                                 int32_t* const* filter_state1,
+                                 int32_t* const* filter_state2,
+                                 size_t num_streams);
+void WebRtcSpl_AnalysisQMFC(const int16_t* in_data,
+                            size_t in_data_length,
+                            int16_t* low_band,
+                            int16_t* high_band,
+                            int32_t* filter_state1,
+                            int32_t* filter_state2);
+void WebRtcSpl_SynthesisQMFC(const int16_t* low_band,
+                             const int16_t* high_band,
+                             size_t band_length,
+                             int16_t* out_data,
+                             int32_t* filter_state1,
+                             int32_t* filter_state2);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcSpl_AnalysisQMFSSE2(const int16_t* in_data,
+                               size_t in_data_length,
+                               int16_t* low_band,
+                               int16_t* high_band,
+                               int32_t* filter_state1,
+                               int32_t* filter_state2);
+void WebRtcSpl_SynthesisQMFSSE2(const int16_t* low_band,
+                                const int16_t* high_band,
+                                size_t band_length,
+                                int16_t* out_data,
+                                int32_t* filter_state1,
+                                int32_t* filter_state2);
+void WebRtcSpl_AnalysisQMFBatchSSE2(const int16_t* const* in_data,
+                                    size_t in_data_length,
+                                    int16_t* const* low_band,
+                                    int16_t* const* high_band,
+                                    int32_t* const* filter_state1,
+                                    int32_t* const* filter_state2,
+                                    size_t num_streams);
+void WebRtcSpl_SynthesisQMFBatchSSE2(const int16_t* const* low_band,
+                                     const int16_t* const* high_band,
+                                     size_t band_length,
+                                     int16_t* const* out_data,
+                                     int32_t* const* filter_state1,
+                                     int32_t* const* filter_state2,
+                                     size_t num_streams);
+#endif
 
 #ifdef __cplusplus
 }
@@ -1165,6 +1303,24 @@ void WebRtcSpl_SynthesisQMF(const int16_t* low_band,
 //      - out_vector    : Output vector
 //
 
+//
+// WebRtcSpl_WindowW32(...)
+//
+// Performs the vector operation:
+//  out_vector[k] = in_vector[k] * window[k]
+// with |window| in Q31. |in_vector| is first normalized by the left shifts
+// of in_vector[0], and the 32 bit products are formed from 16 bit halves, as
+// the LPC analysis of iLBC windows its auto-correlation.
+//
+// Input:
+//      - in_vector     : Input vector
+//      - window        : Window vector in Q31
+//      - vector_length : Elements in the input vectors
+//
+// Output:
+//      - out_vector    : Output vector (can be the same as |in_vector|)
+//
+
 //
 // WebRtcSpl_ReverseOrderMultArrayElements(...)
 //
@@ -1587,6 +1743,25 @@ void WebRtcSpl_SynthesisQMF(const int16_t* low_band,
 //      - out_data      : Super-wideband speech signal, 0-16 kHz
 //
 
+//
+// WebRtcSpl_AnalysisQMFBatch(...)
+// WebRtcSpl_SynthesisQMFBatch(...)
+//
+// Same as WebRtcSpl_AnalysisQMF() and WebRtcSpl_SynthesisQMF(), for
+// |num_streams| independent streams with equal frame lengths. Element s of
+// every pointer array refers to the data and filter states of stream s. The
+// output of each stream is identical to that of the single-stream call.
+//
+
+//
+// WebRtcSpl_AnalysisQMFC(...)
+// WebRtcSpl_SynthesisQMFC(...)
+//
+// The C versions of WebRtcSpl_AnalysisQMF() and WebRtcSpl_SynthesisQMF(),
+// which select the SSE2 versions where the CPU has SSE2. The outputs and
+// filter states of both are identical.
+//
+
 // int16_t WebRtcSpl_SatW32ToW16(...)
 //
 // This function saturates a 32-bit word into a 16-bit word.
@@ -28,6 +28,8 @@
 
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 // TODO(bjorn/kma): Consolidate function pairs (e.g. combine
 //   WebRtcSpl_MaxAbsValueW16C and WebRtcSpl_MaxAbsIndexW16 into a single one.)
@@ -179,6 +181,12 @@ size_t WebRtcSpl_MaxIndexW32(const int32_t* vector, size_t length) {
 
   RTC_DCHECK_GT(length, 0);
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    return WebRtcSpl_MaxIndexW32SSE2(vector, length);
+  }
+#endif
+
   for (i = 0; i < length; i++) {
     if (vector[i] > maximum) {
       maximum = vector[i];
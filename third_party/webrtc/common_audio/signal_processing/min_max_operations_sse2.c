@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "rtc_base/checks.h"
+
+// SSE2 has no 32-bit minimum and maximum, so they are selected with masks.
+static __inline __m128i MaxW32(__m128i a, __m128i b) {
+  const __m128i greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(greater, a),
+                      _mm_andnot_si128(greater, b));
+}
+
+static __inline __m128i MinW32(__m128i a, __m128i b) {
+  const __m128i less = _mm_cmplt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, b));
+}
+
+static __inline int16_t HorizontalMaxW16(__m128i v) {
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, 0x4e));
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, 0xb1));
+  v = _mm_max_epi16(v, _mm_shufflelo_epi16(v, 0xb1));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static __inline int16_t HorizontalMinW16(__m128i v) {
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, 0x4e));
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, 0xb1));
+  v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, 0xb1));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static __inline int32_t HorizontalMaxW32(__m128i v) {
+  v = MaxW32(v, _mm_shuffle_epi32(v, 0x4e));
+  v = MaxW32(v, _mm_shuffle_epi32(v, 0xb1));
+  return _mm_cvtsi128_si32(v);
+}
+
+static __inline int32_t HorizontalMinW32(__m128i v) {
+  v = MinW32(v, _mm_shuffle_epi32(v, 0x4e));
+  v = MinW32(v, _mm_shuffle_epi32(v, 0xb1));
+  return _mm_cvtsi128_si32(v);
+}
+
+// The largest absolute value is the larger of the maximum and minus the
+// minimum, which is computed in a wider type so that -32768 gives 32768
+// before the final clamping.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length) {
+  __m128i maximum = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+  __m128i minimum = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+  int max_value = 0, min_value = 0, absolute = 0;
+  size_t i = 0;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (i = 0; i + 8 <= length; i += 8) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    maximum = _mm_max_epi16(maximum, v);
+    minimum = _mm_min_epi16(minimum, v);
+  }
+  max_value = HorizontalMaxW16(maximum);
+  min_value = HorizontalMinW16(minimum);
+  for (; i < length; i++) {
+    max_value = WEBRTC_SPL_MAX(max_value, vector[i]);
+    min_value = WEBRTC_SPL_MIN(min_value, vector[i]);
+  }
+
+  absolute = WEBRTC_SPL_MAX(max_value, -min_value);
+  return (int16_t)WEBRTC_SPL_MIN(absolute, WEBRTC_SPL_WORD16_MAX);
+}
+
+int32_t WebRtcSpl_MaxAbsValueW32SSE2(const int32_t* vector, size_t length) {
+  __m128i maximum = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+  __m128i minimum = _mm_set1_epi32(WEBRTC_SPL_WORD32_MAX);
+  int64_t max_value = 0, min_value = 0, absolute = 0;
+  size_t i = 0;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    maximum = MaxW32(maximum, v);
+    minimum = MinW32(minimum, v);
+  }
+  max_value = HorizontalMaxW32(maximum);
+  min_value = HorizontalMinW32(minimum);
+  for (; i < length; i++) {
+    max_value = WEBRTC_SPL_MAX(max_value, vector[i]);
+    min_value = WEBRTC_SPL_MIN(min_value, vector[i]);
+  }
+
+  absolute = WEBRTC_SPL_MAX(max_value, -min_value);
+  return (int32_t)WEBRTC_SPL_MIN(absolute, WEBRTC_SPL_WORD32_MAX);
+}
+
+// The maximum is found first, and then the first index at which it occurs.
+size_t WebRtcSpl_MaxIndexW32SSE2(const int32_t* vector, size_t length) {
+  __m128i maximum = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+  int32_t max_value = 0;
+  size_t i = 0;
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    maximum =
+        MaxW32(maximum, _mm_loadu_si128((const __m128i*)&vector[i]));
+  }
+  max_value = HorizontalMaxW32(maximum);
+  for (; i < length; i++) {
+    max_value = WEBRTC_SPL_MAX(max_value, vector[i]);
+  }
+
+  for (i = 0; i + 4 <= length; i += 4) {
+    const __m128i equal =
+        _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)&vector[i]),
+                        _mm_set1_epi32(max_value));
+    if (_mm_movemask_epi8(equal)) {
+      break;
+    }
+  }
+  while (vector[i] != max_value) {
+    i++;
+  }
+  return i;
+}
@@ -12,24 +12,91 @@
 
 #include <stdlib.h>
 
+#include "common_audio/signal_processing/complex_fft_tables.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "common_audio/signal_processing/complex_fft_sse2.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+#endif
 
 struct RealFFT {
   int order;
+  // Bit reversal permutation of the 2^order complex values, used to place the
+  // input directly in bit-reversed order instead of swapping afterwards.
+  uint16_t* bit_reverse;
+  // Twiddles for the forward and inverse SSE2 kernels, in the layout
+  // described in complex_fft_sse2.h. NULL if the C code is used.
+  int16_t* twiddles;
+  int16_t* inverse_twiddles;
 };
 
+// Fills |twiddles| for a transform of 2^|order| points. |sign| is -1 for the
+// forward and 1 for the inverse transform, see wi in complex_fft.c.
+static void InitTwiddles(int order, int sign, int16_t* twiddles) {
+  int l, m;
+  int k = 10 - 1;
+
+  for (l = 1; l < (1 << order); l <<= 1, --k) {
+    int16_t* w_re = &twiddles[4 * (l - 1)];
+    int16_t* w_im = w_re + 2 * l;
+    for (m = 0; m < l; ++m) {
+      const int j = m << k;
+      const int16_t wr = kSinTable1024[j + 256];
+      const int16_t wi = (int16_t)(sign * kSinTable1024[j]);
+      w_re[2 * m] = wr;
+      w_re[2 * m + 1] = -wi;
+      w_im[2 * m] = wi;
+      w_im[2 * m + 1] = wr;
+    }
+  }
+}
+
 struct RealFFT* WebRtcSpl_CreateRealFFT(int order) {
   struct RealFFT* self = NULL;
+  size_t n = 0;
+  size_t num_twiddles = 0;
+  size_t i = 0;
 
   if (order > kMaxFFTOrder || order < 0) {
     return NULL;
   }
+  n = (size_t)1 << order;
 
-  self = malloc(sizeof(struct RealFFT));
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (order >= kComplexFFTSSE2MinStages && WebRtc_UseSSE2()) {
+    num_twiddles = 4 * (n - 1);
+  }
+#endif
+
+  // One allocation for the structure and its tables.
+  self = malloc(sizeof(struct RealFFT) + n * sizeof(uint16_t) +
+                2 * num_twiddles * sizeof(int16_t));
   if (self == NULL) {
     return NULL;
   }
   self->order = order;
+  self->bit_reverse = (uint16_t*)(self + 1);
+  self->twiddles = NULL;
+  self->inverse_twiddles = NULL;
+
+  for (i = 0; i < n; ++i) {
+    size_t reversed = 0;
+    int bit = 0;
+    for (bit = 0; bit < order; ++bit) {
+      reversed |= ((i >> bit) & 1) << (order - 1 - bit);
+    }
+    self->bit_reverse[i] = (uint16_t)reversed;
+  }
+
+  if (num_twiddles > 0) {
+    self->twiddles = (int16_t*)(self->bit_reverse + n);
+    self->inverse_twiddles = self->twiddles + num_twiddles;
+    InitTwiddles(order, -1, self->twiddles);
+    InitTwiddles(order, 1, self->inverse_twiddles);
+  }
 
   return self;
 }
@@ -44,25 +111,33 @@ void WebRtcSpl_FreeRealFFT(struct RealFFT* self) {
 // WebRtcSpl_RealInverseFFT) are real-valued FFT wrappers for complex-valued
 // FFT implementation in SPL.
 
-int WebRtcSpl_RealForwardFFT(struct RealFFT* self,
-                             const int16_t* real_data_in,
-                             int16_t* complex_data_out) {
+// Forward transform of one frame. |complex_buffer| must hold 2^(order + 1)
+// values.
+static int ForwardFFT(const struct RealFFT* self,
+                      const int16_t* real_data_in,
+                      int16_t* complex_data_out,
+                      int16_t* complex_buffer) {
   int i = 0;
-  int j = 0;
   int result = 0;
   int n = 1 << self->order;
-  // The complex-value FFT implementation needs a buffer to hold 2^order
-  // 16-bit COMPLEX numbers, for both time and frequency data.
-  int16_t complex_buffer[2 << kMaxFFTOrder];
 
-  // Insert zeros to the imaginary parts for complex forward FFT input.
-  for (i = 0, j = 0; i < n; i += 1, j += 2) {
+  // Insert zeros to the imaginary parts for complex forward FFT input, and
+  // store in bit-reversed order (what WebRtcSpl_ComplexBitReverse() does).
+  for (i = 0; i < n; i++) {
+    const int j = 2 * self->bit_reverse[i];
     complex_buffer[j] = real_data_in[i];
     complex_buffer[j + 1] = 0;
-  };
+  }
 
-  WebRtcSpl_ComplexBitReverse(complex_buffer, self->order);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->twiddles != NULL) {
+    WebRtcSpl_ComplexFFTSSE2(complex_buffer, self->order, self->twiddles);
+  } else {
+    result = WebRtcSpl_ComplexFFT(complex_buffer, self->order, 1);
+  }
+#else
   result = WebRtcSpl_ComplexFFT(complex_buffer, self->order, 1);
+#endif
 
   // For real FFT output, use only the first N + 2 elements from
   // complex forward FFT.
@@ -71,27 +146,41 @@ int WebRtcSpl_RealForwardFFT(struct RealFFT* self,
   return result;
 }
 
-int WebRtcSpl_RealInverseFFT(struct RealFFT* self,
-                             const int16_t* complex_data_in,
-                             int16_t* real_data_out) {
+// Inverse transform of one frame. |complex_buffer| must hold 2^(order + 1)
+// values.
+static int InverseFFT(const struct RealFFT* self,
+                      const int16_t* complex_data_in,
+                      int16_t* real_data_out,
+                      int16_t* complex_buffer) {
   int i = 0;
   int j = 0;
   int result = 0;
   int n = 1 << self->order;
-  // Create the buffer specific to complex-valued FFT implementation.
-  int16_t complex_buffer[2 << kMaxFFTOrder];
 
   // For n-point FFT, first copy the first n + 2 elements into complex
   // FFT, then construct the remaining n - 2 elements by real FFT's
-  // conjugate-symmetric properties.
-  memcpy(complex_buffer, complex_data_in, sizeof(int16_t) * (n + 2));
-  for (i = n + 2; i < 2 * n; i += 2) {
-    complex_buffer[i] = complex_data_in[2 * n - i];
-    complex_buffer[i + 1] = -complex_data_in[2 * n - i + 1];
+  // conjugate-symmetric properties. Both are stored in bit-reversed order.
+  for (i = 0; i <= n / 2; i++) {
+    j = 2 * self->bit_reverse[i];
+    complex_buffer[j] = complex_data_in[2 * i];
+    complex_buffer[j + 1] = complex_data_in[2 * i + 1];
+  }
+  for (i = n / 2 + 1; i < n; i++) {
+    j = 2 * self->bit_reverse[i];
+    complex_buffer[j] = complex_data_in[2 * (n - i)];
+    complex_buffer[j + 1] = -complex_data_in[2 * (n - i) + 1];
   }
 
-  WebRtcSpl_ComplexBitReverse(complex_buffer, self->order);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (self->inverse_twiddles != NULL) {
+    result = WebRtcSpl_ComplexIFFTSSE2(complex_buffer, self->order,
+                                       self->inverse_twiddles);
+  } else {
+    result = WebRtcSpl_ComplexIFFT(complex_buffer, self->order, 1);
+  }
+#else
   result = WebRtcSpl_ComplexIFFT(complex_buffer, self->order, 1);
+#endif
 
   // Strip out the imaginary parts of the complex inverse FFT output.
   for (i = 0, j = 0; i < n; i += 1, j += 2) {
@@ -100,3 +189,58 @@ int WebRtcSpl_RealInverseFFT(struct RealFFT* self,
 
   return result;
 }
+
+int WebRtcSpl_RealForwardFFT(struct RealFFT* self,
+                             const int16_t* real_data_in,
+                             int16_t* complex_data_out) {
+  // The complex-value FFT implementation needs a buffer to hold 2^order
+  // 16-bit COMPLEX numbers, for both time and frequency data.
+  int16_t complex_buffer[2 << kMaxFFTOrder];
+
+  return ForwardFFT(self, real_data_in, complex_data_out, complex_buffer);
+}
+
+int WebRtcSpl_RealInverseFFT(struct RealFFT* self,
+                             const int16_t* complex_data_in,
+                             int16_t* real_data_out) {
+  // Create the buffer specific to complex-valued FFT implementation.
+  int16_t complex_buffer[2 << kMaxFFTOrder];
+
+  return InverseFFT(self, complex_data_in, real_data_out, complex_buffer);
+}
+
+int WebRtcSpl_RealForwardFFTBatch(struct RealFFT* self,
+                                  const int16_t* real_data_in,
+                                  size_t num_frames,
+                                  int16_t* complex_data_out) {
+  int16_t complex_buffer[2 << kMaxFFTOrder];
+  const size_t n = (size_t)1 << self->order;
+  size_t k = 0;
+
+  for (k = 0; k < num_frames; k++) {
+    if (ForwardFFT(self, &real_data_in[k * n],
+                   &complex_data_out[k * (n + 2)], complex_buffer) < 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int WebRtcSpl_RealInverseFFTBatch(struct RealFFT* self,
+                                  const int16_t* complex_data_in,
+                                  size_t num_frames,
+                                  int16_t* real_data_out,
+                                  int* scales) {
+  int16_t complex_buffer[2 << kMaxFFTOrder];
+  const size_t n = (size_t)1 << self->order;
+  size_t k = 0;
+
+  for (k = 0; k < num_frames; k++) {
+    scales[k] = InverseFFT(self, &complex_data_in[k * (n + 2)],
+                           &real_data_out[k * n], complex_buffer);
+    if (scales[k] < 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
@@ -9,12 +9,15 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers, currently for ARM, MIPS and x86 platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
 
+#include "common_audio/signal_processing/spl_init.h"
+
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
 /* Declare function pointers. */
@@ -44,6 +47,17 @@ static void InitPointersToC(void) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Replace the generic C versions with the SSE2 versions where there
+ * are any. */
+static void InitPointersToSSE2(void) {
+  WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16SSE2;
+  WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32SSE2;
+  WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationSSE2;
+  WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastSSE2;
+}
+#endif
+
 #if defined(WEBRTC_HAS_NEON)
 /* Initialize function pointers to the Neon version. */
 static void InitPointersToNeon(void) {
@@ -89,21 +103,32 @@ static void InitFunctionPointers(void) {
   InitPointersToMIPS();
 #else
   InitPointersToC();
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    InitPointersToSSE2();
+  }
+#endif
 #endif  /* WEBRTC_HAS_NEON */
 }
 
 #if defined(WEBRTC_POSIX)
 #include <pthread.h>
 
-static void once(void (*func)(void)) {
-  static pthread_once_t lock = PTHREAD_ONCE_INIT;
-  pthread_once(&lock, func);
+static pthread_mutex_t once_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void WebRtcSpl_CallOnce(int* done, void (*func)(void)) {
+  pthread_mutex_lock(&once_lock);
+  if (!*done) {
+    func();
+    *done = 1;
+  }
+  pthread_mutex_unlock(&once_lock);
 }
 
 #elif defined(_WIN32)
 #include <windows.h>
 
-static void once(void (*func)(void)) {
+void WebRtcSpl_CallOnce(int* done, void (*func)(void)) {
   /* Didn't use InitializeCriticalSection() since there's no race-free context
    * in which to execute it.
    *
@@ -112,12 +137,11 @@ static void once(void (*func)(void)) {
    * http://code.google.com/p/webm/issues/detail?id=467.
    */
   static CRITICAL_SECTION lock = {(void *)((size_t)-1), -1, 0, 0, 0, 0};
-  static int done = 0;
 
   EnterCriticalSection(&lock);
-  if (!done) {
+  if (!*done) {
     func();
-    done = 1;
+    *done = 1;
   }
   LeaveCriticalSection(&lock);
 }
@@ -129,5 +153,6 @@ static void once(void (*func)(void)) {
 #endif  /* WEBRTC_POSIX */
 
 void WebRtcSpl_Init(void) {
-  once(InitFunctionPointers);
+  static int done = 0;
+  WebRtcSpl_CallOnce(&done, InitFunctionPointers);
 }
@@ -0,0 +1,31 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// The one time initialization of WebRtcSpl_Init(), shared with the other
+// common_audio code that sets up tables or function pointers on first use.
+
+#ifndef COMMON_AUDIO_SIGNAL_PROCESSING_SPL_INIT_H_
+#define COMMON_AUDIO_SIGNAL_PROCESSING_SPL_INIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calls |func| if |*done| is 0 and sets |*done| to 1, under a lock, so that
+// |func| runs once per process for every |done| flag, which is a static
+// variable initialized to 0. Callers that return from this function see all
+// writes of |func|. |func| must not call WebRtcSpl_CallOnce() itself.
+void WebRtcSpl_CallOnce(int* done, void (*func)(void));
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // COMMON_AUDIO_SIGNAL_PROCESSING_SPL_INIT_H_
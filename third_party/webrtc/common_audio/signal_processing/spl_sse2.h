@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 kernels that are internal to SPL. The SPL functions using them, which
+// are not dispatched through the function pointers set up by WebRtcSpl_Init()
+// so that callers which never call WebRtcSpl_Init() keep working, select them
+// with WebRtc_UseSSE2() at every call.
+
+#ifndef COMMON_AUDIO_SIGNAL_PROCESSING_SPL_SSE2_H_
+#define COMMON_AUDIO_SIGNAL_PROCESSING_SPL_SSE2_H_
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The correlation loop of WebRtcSpl_AutoCorrelation(), with every product
+// shifted right by |scaling| before accumulation. Computes |order| + 1 lags.
+void WebRtcSpl_AutoCorrelationSSE2(const int16_t* in_vector,
+                                   size_t in_vector_length,
+                                   size_t order,
+                                   int scaling,
+                                   int32_t* result);
+
+// The pass over |vector| of WebRtcSpl_GetVectorStatsW16(). Fills in all of
+// |stats| except |energy| and |energy_scale|. Returns in |scaling_max| the
+// maximum absolute value as seen by WebRtcSpl_GetScalingSquare(), where
+// -32768 is ignored and an empty maximum is -1, and in |sum_of_squares| the
+// unscaled energy.
+void WebRtcSpl_VectorStatsSSE2(const int16_t* vector,
+                               size_t length,
+                               WebRtcSpl_VectorStats* stats,
+                               int16_t* scaling_max,
+                               uint64_t* sum_of_squares);
+
+// Sum of (vector[i] * vector[i]) >> scaling, wrapping around like the sum in
+// WebRtcSpl_Energy().
+int32_t WebRtcSpl_ScaledEnergySSE2(const int16_t* vector,
+                                   size_t length,
+                                   int scaling);
+
+// WebRtcSpl_MaxIndexW32() for a nonempty |vector|.
+size_t WebRtcSpl_MaxIndexW32SSE2(const int32_t* vector, size_t length);
+
+// Longest filter handled by WebRtcSpl_FilterMAFastQ12SSE2().
+enum { kFilterMAFastQ12SSE2MaxLength = 32 };
+
+// WebRtcSpl_FilterMAFastQ12() for the largest multiple of eight samples not
+// exceeding |length|. Returns the number of samples filtered, which is 0 if
+// |B_length| exceeds kFilterMAFastQ12SSE2MaxLength.
+size_t WebRtcSpl_FilterMAFastQ12SSE2(const int16_t* in_ptr,
+                                     int16_t* out_ptr,
+                                     const int16_t* B,
+                                     size_t B_length,
+                                     size_t length);
+
+// Range of filter lengths handled by WebRtcSpl_FilterARFastQ12SSE2(). Shorter
+// filters are faster in C, since the recursion within every block of eight
+// samples remains sequential.
+enum { kFilterARFastQ12SSE2MinLength = 9 };
+enum { kFilterARFastQ12SSE2MaxLength = 17 };
+
+// WebRtcSpl_FilterARFastQ12() for the largest multiple of eight samples not
+// exceeding |data_length|. Returns the number of samples filtered, which is 0
+// if |coefficients_length| is outside the range above, or if the absolute
+// values of the coefficients sum to more than 65535 so that 32-bit sums could
+// overflow.
+size_t WebRtcSpl_FilterARFastQ12SSE2(const int16_t* data_in,
+                                     int16_t* data_out,
+                                     const int16_t* coefficients,
+                                     size_t coefficients_length,
+                                     size_t data_length);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // WEBRTC_ARCH_X86_FAMILY
+
+#endif  // COMMON_AUDIO_SIGNAL_PROCESSING_SPL_SSE2_H_
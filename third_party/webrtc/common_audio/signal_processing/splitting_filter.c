@@ -15,6 +15,8 @@
 
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 // Maximum number of samples in a low/high-band frame.
 enum
@@ -22,9 +24,9 @@ enum
     kMaxBandFrameLength = 320  // 10 ms at 64 kHz.
 };
 
-// QMF filter coefficients in Q16.
-static const uint16_t WebRtcSpl_kAllPassFilter1[3] = {6418, 36982, 57261};
-static const uint16_t WebRtcSpl_kAllPassFilter2[3] = {21333, 49062, 63010};
+// QMF filter coefficients in Q16. Also used by splitting_filter_sse2.c.
+const uint16_t WebRtcSpl_kAllPassFilter1[3] = {6418, 36982, 57261};
+const uint16_t WebRtcSpl_kAllPassFilter2[3] = {21333, 49062, 63010};
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 // WebRtcSpl_AllPassQMF(...)
@@ -126,6 +128,22 @@ void WebRtcSpl_AllPassQMF(int32_t* in_data, size_t data_length,
 void WebRtcSpl_AnalysisQMF(const int16_t* in_data, size_t in_data_length,
                            int16_t* low_band, int16_t* high_band,
                            int32_t* filter_state1, int32_t* filter_state2)
+{
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_UseSSE2())
+    {
+        WebRtcSpl_AnalysisQMFSSE2(in_data, in_data_length, low_band, high_band,
+                                  filter_state1, filter_state2);
+        return;
+    }
+#endif
+    WebRtcSpl_AnalysisQMFC(in_data, in_data_length, low_band, high_band,
+                           filter_state1, filter_state2);
+}
+
+void WebRtcSpl_AnalysisQMFC(const int16_t* in_data, size_t in_data_length,
+                            int16_t* low_band, int16_t* high_band,
+                            int32_t* filter_state1, int32_t* filter_state2)
 {
     size_t i;
     int16_t k;
@@ -166,6 +184,22 @@ void WebRtcSpl_AnalysisQMF(const int16_t* in_data, size_t in_data_length,
 void WebRtcSpl_SynthesisQMF(const int16_t* low_band, const int16_t* high_band,
                             size_t band_length, int16_t* out_data,
                             int32_t* filter_state1, int32_t* filter_state2)
+{
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_UseSSE2())
+    {
+        WebRtcSpl_SynthesisQMFSSE2(low_band, high_band, band_length, out_data,
+                                   filter_state1, filter_state2);
+        return;
+    }
+#endif
+    WebRtcSpl_SynthesisQMFC(low_band, high_band, band_length, out_data,
+                            filter_state1, filter_state2);
+}
+
+void WebRtcSpl_SynthesisQMFC(const int16_t* low_band, const int16_t* high_band,
+                             size_t band_length, int16_t* out_data,
+                             int32_t* filter_state1, int32_t* filter_state2)
 {
     int32_t tmp;
     int32_t half_in1[kMaxBandFrameLength];
@@ -205,3 +239,57 @@ void WebRtcSpl_SynthesisQMF(const int16_t* low_band, const int16_t* high_band,
     }
 
 }
+
+void WebRtcSpl_AnalysisQMFBatch(const int16_t* const* in_data,
+                                size_t in_data_length,
+                                int16_t* const* low_band,
+                                int16_t* const* high_band,
+                                int32_t* const* filter_state1,
+                                int32_t* const* filter_state2,
+                                size_t num_streams)
+{
+    size_t s;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_UseSSE2())
+    {
+        WebRtcSpl_AnalysisQMFBatchSSE2(in_data, in_data_length, low_band,
+                                       high_band, filter_state1, filter_state2,
+                                       num_streams);
+        return;
+    }
+#endif
+
+    for (s = 0; s < num_streams; s++)
+    {
+        WebRtcSpl_AnalysisQMF(in_data[s], in_data_length, low_band[s],
+                              high_band[s], filter_state1[s], filter_state2[s]);
+    }
+}
+
+void WebRtcSpl_SynthesisQMFBatch(const int16_t* const* low_band,
+                                 const int16_t* const* high_band,
+                                 size_t band_length,
+                                 int16_t* const* out_data,
+                                 int32_t* const* filter_state1,
+                                 int32_t* const* filter_state2,
+                                 size_t num_streams)
+{
+    size_t s;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_UseSSE2())
+    {
+        WebRtcSpl_SynthesisQMFBatchSSE2(low_band, high_band, band_length,
+                                        out_data, filter_state1, filter_state2,
+                                        num_streams);
+        return;
+    }
+#endif
+
+    for (s = 0; s < num_streams; s++)
+    {
+        WebRtcSpl_SynthesisQMF(low_band[s], high_band[s], band_length,
+                               out_data[s], filter_state1[s], filter_state2[s]);
+    }
+}
@@ -0,0 +1,373 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file contains the SSE2 versions of the splitting filter functions.
+ *
+ * The three first order all-pass sections of WebRtcSpl_AllPassQMF() are
+ * recursive in time, but each only depends on the previous section one
+ * sample earlier. They are therefore run as a wavefront: lane c of a vector
+ * holds section c, and at step t it filters sample t - c, taking its input
+ * from the output of lane c - 1 at step t - 1. Independent all-pass chains
+ * (the two branches of a stream, and the branches of several streams) are
+ * interleaved to hide the latency of the recursion.
+ */
+
+#include <emmintrin.h>
+
+#include "rtc_base/checks.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Maximum number of samples in a low/high-band frame.
+enum {
+  kMaxBandFrameLength = 320,  // 10 ms at 64 kHz.
+  kMaxChains = 4              // Two streams with two branches each.
+};
+
+// QMF filter coefficients in Q16, defined in splitting_filter.c.
+extern const uint16_t WebRtcSpl_kAllPassFilter1[3];
+extern const uint16_t WebRtcSpl_kAllPassFilter2[3];
+
+typedef struct {
+  __m128i in_prev;    // Lane c: input of section c at the previous sample.
+  __m128i out_prev;   // Lane c: output of section c at the previous sample.
+  __m128i coef_low;   // Lane c: {a_c, 0}, for the low half of the product.
+  __m128i coef_half;  // Lane c: {a_c >> 1, a_c >> 1}.
+  __m128i coef_odd;   // Lane c: all ones if a_c is odd.
+  const int32_t* in;
+  int32_t* out;
+  int32_t* state;
+} AllPassChain;
+
+static void InitChain(AllPassChain* chain,
+                      const int32_t* in,
+                      int32_t* out,
+                      const uint16_t* coefficients,
+                      int32_t* filter_state) {
+  const uint16_t* a = coefficients;
+  chain->in_prev =
+      _mm_setr_epi32(filter_state[0], filter_state[2], filter_state[4], 0);
+  chain->out_prev =
+      _mm_setr_epi32(filter_state[1], filter_state[3], filter_state[5], 0);
+  chain->coef_low = _mm_setr_epi32(a[0], a[1], a[2], 0);
+  chain->coef_half = _mm_setr_epi32(
+      (a[0] >> 1) * 0x10001, (a[1] >> 1) * 0x10001, (a[2] >> 1) * 0x10001, 0);
+  chain->coef_odd = _mm_setr_epi32(-(a[0] & 1), -(a[1] & 1), -(a[2] & 1), 0);
+  chain->in = in;
+  chain->out = out;
+  chain->state = filter_state;
+}
+
+static void StoreChainState(const AllPassChain* chain) {
+  int32_t in_prev[4];
+  int32_t out_prev[4];
+  _mm_storeu_si128((__m128i*)in_prev, chain->in_prev);
+  _mm_storeu_si128((__m128i*)out_prev, chain->out_prev);
+  chain->state[0] = in_prev[0];
+  chain->state[1] = out_prev[0];
+  chain->state[2] = in_prev[1];
+  chain->state[3] = out_prev[1];
+  chain->state[4] = in_prev[2];
+  chain->state[5] = out_prev[2];
+}
+
+// WebRtcSpl_SubSatW32() on four lanes.
+static __inline __m128i SubSatW32(__m128i a, __m128i b) {
+  const __m128i diff = _mm_sub_epi32(a, b);
+  const __m128i overflow = _mm_srai_epi32(
+      _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, diff)), 31);
+  const __m128i saturated =
+      _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff));
+  return _mm_or_si128(_mm_andnot_si128(overflow, diff),
+                      _mm_and_si128(overflow, saturated));
+}
+
+// WEBRTC_SPL_SCALEDIFF32(a, b, c) on four lanes, with the unsigned 16-bit a
+// given by the coefficient vectors of |chain|.
+static __inline __m128i ScaleDiff32(const AllPassChain* chain,
+                                    __m128i b,
+                                    __m128i c) {
+  // (b >> 16) * a, computed as 2 * (b >> 16) * (a >> 1) + (b >> 16) * (a & 1).
+  const __m128i b_high = _mm_srai_epi32(b, 16);
+  const __m128i b_high2 =
+      _mm_or_si128(_mm_and_si128(b, _mm_set1_epi32((int32_t)0xffff0000)),
+                   _mm_srli_epi32(b, 16));
+  const __m128i high = _mm_add_epi32(_mm_madd_epi16(b_high2, chain->coef_half),
+                                     _mm_and_si128(b_high, chain->coef_odd));
+  // ((uint32_t)(b & 0x0000FFFF) * a) >> 16.
+  const __m128i low = _mm_mulhi_epu16(b, chain->coef_low);
+  return _mm_add_epi32(c, _mm_add_epi32(high, low));
+}
+
+// One wavefront step: lane c filters the previous output of lane c - 1, lane
+// 0 filters |x|. Lanes not set in |valid| keep their state.
+static __inline void Step(AllPassChain* chain, int32_t x, __m128i valid) {
+  const __m128i in = _mm_or_si128(_mm_slli_si128(chain->out_prev, 4),
+                                  _mm_cvtsi32_si128(x));
+  const __m128i diff = SubSatW32(in, chain->out_prev);
+  const __m128i out = ScaleDiff32(chain, diff, chain->in_prev);
+  chain->in_prev = _mm_or_si128(_mm_and_si128(valid, in),
+                                _mm_andnot_si128(valid, chain->in_prev));
+  chain->out_prev = _mm_or_si128(_mm_and_si128(valid, out),
+                                 _mm_andnot_si128(valid, chain->out_prev));
+}
+
+static __inline void StepAll(AllPassChain* chain, int32_t x) {
+  const __m128i in = _mm_or_si128(_mm_slli_si128(chain->out_prev, 4),
+                                  _mm_cvtsi32_si128(x));
+  const __m128i diff = SubSatW32(in, chain->out_prev);
+  chain->out_prev = ScaleDiff32(chain, diff, chain->in_prev);
+  chain->in_prev = in;
+}
+
+// Output of the last section, i.e., the filtered sample two steps back.
+static __inline int32_t LastSection(const AllPassChain* chain) {
+  return _mm_cvtsi128_si32(_mm_srli_si128(chain->out_prev, 8));
+}
+
+// Runs WebRtcSpl_AllPassQMF() for |num_chains| independent chains in
+// lockstep. Unlike the C version the input is not modified.
+static void AllPassChains(AllPassChain* chains,
+                          int num_chains,
+                          size_t data_length) {
+  const int n = (int)data_length;
+  int t, c;
+
+  for (t = 0; t < n + 2; t++) {
+    if (t >= 2 && t < n) {
+      for (c = 0; c < num_chains; c++) {
+        StepAll(&chains[c], chains[c].in[t]);
+        chains[c].out[t - 2] = LastSection(&chains[c]);
+      }
+    } else {
+      // Filling and draining the wavefront: section s is active for samples
+      // t - s in [0, n).
+      const __m128i valid =
+          _mm_setr_epi32(-(t < n), -(t >= 1 && t - 1 < n),
+                         -(t >= 2 && t - 2 < n), 0);
+      for (c = 0; c < num_chains; c++) {
+        Step(&chains[c], t < n ? chains[c].in[t] : 0, valid);
+        if (t >= 2) {
+          chains[c].out[t - 2] = LastSection(&chains[c]);
+        }
+      }
+    }
+  }
+  for (c = 0; c < num_chains; c++) {
+    StoreChainState(&chains[c]);
+  }
+}
+
+// Splits even and odd samples of |in_data| and shifts them to Q10.
+static void SplitToQ10(const int16_t* in_data,
+                       size_t band_length,
+                       int32_t* even,
+                       int32_t* odd) {
+  size_t i = 0;
+  for (; i + 4 <= band_length; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)&in_data[2 * i]);
+    _mm_storeu_si128((__m128i*)&even[i],
+                     _mm_srai_epi32(_mm_slli_epi32(v, 16), 16 - 10));
+    _mm_storeu_si128((__m128i*)&odd[i], _mm_slli_epi32(_mm_srai_epi32(v, 16),
+                                                        10));
+  }
+  for (; i < band_length; i++) {
+    even[i] = ((int32_t)in_data[2 * i]) * (1 << 10);
+    odd[i] = ((int32_t)in_data[2 * i + 1]) * (1 << 10);
+  }
+}
+
+// Sum and difference of the filtered branches, saturated to 16 bits.
+static void CombineBands(const int32_t* filter1,
+                         const int32_t* filter2,
+                         size_t band_length,
+                         int16_t* low_band,
+                         int16_t* high_band) {
+  const __m128i round = _mm_set1_epi32(1024);
+  size_t i = 0;
+  for (; i + 8 <= band_length; i += 8) {
+    const __m128i f1_0 = _mm_loadu_si128((const __m128i*)&filter1[i]);
+    const __m128i f1_1 = _mm_loadu_si128((const __m128i*)&filter1[i + 4]);
+    const __m128i f2_0 = _mm_loadu_si128((const __m128i*)&filter2[i]);
+    const __m128i f2_1 = _mm_loadu_si128((const __m128i*)&filter2[i + 4]);
+    const __m128i low_0 =
+        _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(f1_0, f2_0), round), 11);
+    const __m128i low_1 =
+        _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(f1_1, f2_1), round), 11);
+    const __m128i high_0 =
+        _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(f1_0, f2_0), round), 11);
+    const __m128i high_1 =
+        _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(f1_1, f2_1), round), 11);
+    _mm_storeu_si128((__m128i*)&low_band[i], _mm_packs_epi32(low_0, low_1));
+    _mm_storeu_si128((__m128i*)&high_band[i], _mm_packs_epi32(high_0, high_1));
+  }
+  for (; i < band_length; i++) {
+    low_band[i] =
+        WebRtcSpl_SatW32ToW16((filter1[i] + filter2[i] + 1024) >> 11);
+    high_band[i] =
+        WebRtcSpl_SatW32ToW16((filter1[i] - filter2[i] + 1024) >> 11);
+  }
+}
+
+// Sum and difference channels of the bands, in Q10.
+static void SumAndDifferenceToQ10(const int16_t* low_band,
+                                  const int16_t* high_band,
+                                  size_t band_length,
+                                  int32_t* sum,
+                                  int32_t* difference) {
+  size_t i = 0;
+  for (; i + 8 <= band_length; i += 8) {
+    const __m128i low = _mm_loadu_si128((const __m128i*)&low_band[i]);
+    const __m128i high = _mm_loadu_si128((const __m128i*)&high_band[i]);
+    // Sign extend to 32 bits.
+    const __m128i low_0 = _mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16);
+    const __m128i low_1 = _mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16);
+    const __m128i high_0 = _mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16);
+    const __m128i high_1 = _mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16);
+    _mm_storeu_si128((__m128i*)&sum[i],
+                     _mm_slli_epi32(_mm_add_epi32(low_0, high_0), 10));
+    _mm_storeu_si128((__m128i*)&sum[i + 4],
+                     _mm_slli_epi32(_mm_add_epi32(low_1, high_1), 10));
+    _mm_storeu_si128((__m128i*)&difference[i],
+                     _mm_slli_epi32(_mm_sub_epi32(low_0, high_0), 10));
+    _mm_storeu_si128((__m128i*)&difference[i + 4],
+                     _mm_slli_epi32(_mm_sub_epi32(low_1, high_1), 10));
+  }
+  for (; i < band_length; i++) {
+    sum[i] = ((int32_t)low_band[i] + (int32_t)high_band[i]) * (1 << 10);
+    difference[i] = ((int32_t)low_band[i] - (int32_t)high_band[i]) * (1 << 10);
+  }
+}
+
+// Interleaves the filtered channels to the output, back in Q0 and saturated.
+static void InterleaveToQ0(const int32_t* filter1,
+                           const int32_t* filter2,
+                           size_t band_length,
+                           int16_t* out_data) {
+  const __m128i round = _mm_set1_epi32(512);
+  size_t i = 0;
+  for (; i + 8 <= band_length; i += 8) {
+    const __m128i even = _mm_packs_epi32(
+        _mm_srai_epi32(
+            _mm_add_epi32(_mm_loadu_si128((const __m128i*)&filter2[i]), round),
+            10),
+        _mm_srai_epi32(_mm_add_epi32(
+                           _mm_loadu_si128((const __m128i*)&filter2[i + 4]),
+                           round),
+                       10));
+    const __m128i odd = _mm_packs_epi32(
+        _mm_srai_epi32(
+            _mm_add_epi32(_mm_loadu_si128((const __m128i*)&filter1[i]), round),
+            10),
+        _mm_srai_epi32(_mm_add_epi32(
+                           _mm_loadu_si128((const __m128i*)&filter1[i + 4]),
+                           round),
+                       10));
+    _mm_storeu_si128((__m128i*)&out_data[2 * i], _mm_unpacklo_epi16(even, odd));
+    _mm_storeu_si128((__m128i*)&out_data[2 * i + 8],
+                     _mm_unpackhi_epi16(even, odd));
+  }
+  for (; i < band_length; i++) {
+    out_data[2 * i] = WebRtcSpl_SatW32ToW16((filter2[i] + 512) >> 10);
+    out_data[2 * i + 1] = WebRtcSpl_SatW32ToW16((filter1[i] + 512) >> 10);
+  }
+}
+
+void WebRtcSpl_AnalysisQMFBatchSSE2(const int16_t* const* in_data,
+                                    size_t in_data_length,
+                                    int16_t* const* low_band,
+                                    int16_t* const* high_band,
+                                    int32_t* const* filter_state1,
+                                    int32_t* const* filter_state2,
+                                    size_t num_streams) {
+  int32_t half_in1[kMaxChains / 2][kMaxBandFrameLength];
+  int32_t half_in2[kMaxChains / 2][kMaxBandFrameLength];
+  int32_t filter1[kMaxChains / 2][kMaxBandFrameLength];
+  int32_t filter2[kMaxChains / 2][kMaxBandFrameLength];
+  AllPassChain chains[kMaxChains];
+  const size_t band_length = in_data_length / 2;
+  size_t s = 0;
+  RTC_DCHECK_EQ(0, in_data_length % 2);
+  RTC_DCHECK_LE(band_length, kMaxBandFrameLength);
+
+  while (s < num_streams) {
+    const size_t num = WEBRTC_SPL_MIN(num_streams - s, kMaxChains / 2);
+    size_t k;
+    for (k = 0; k < num; k++) {
+      SplitToQ10(in_data[s + k], band_length, half_in2[k], half_in1[k]);
+      InitChain(&chains[2 * k], half_in1[k], filter1[k],
+                WebRtcSpl_kAllPassFilter1, filter_state1[s + k]);
+      InitChain(&chains[2 * k + 1], half_in2[k], filter2[k],
+                WebRtcSpl_kAllPassFilter2, filter_state2[s + k]);
+    }
+    AllPassChains(chains, (int)(2 * num), band_length);
+    for (k = 0; k < num; k++) {
+      CombineBands(filter1[k], filter2[k], band_length, low_band[s + k],
+                   high_band[s + k]);
+    }
+    s += num;
+  }
+}
+
+void WebRtcSpl_SynthesisQMFBatchSSE2(const int16_t* const* low_band,
+                                     const int16_t* const* high_band,
+                                     size_t band_length,
+                                     int16_t* const* out_data,
+                                     int32_t* const* filter_state1,
+                                     int32_t* const* filter_state2,
+                                     size_t num_streams) {
+  int32_t half_in1[kMaxChains / 2][kMaxBandFrameLength];
+  int32_t half_in2[kMaxChains / 2][kMaxBandFrameLength];
+  int32_t filter1[kMaxChains / 2][kMaxBandFrameLength];
+  int32_t filter2[kMaxChains / 2][kMaxBandFrameLength];
+  AllPassChain chains[kMaxChains];
+  size_t s = 0;
+  RTC_DCHECK_LE(band_length, kMaxBandFrameLength);
+
+  while (s < num_streams) {
+    const size_t num = WEBRTC_SPL_MIN(num_streams - s, kMaxChains / 2);
+    size_t k;
+    for (k = 0; k < num; k++) {
+      SumAndDifferenceToQ10(low_band[s + k], high_band[s + k], band_length,
+                            half_in1[k], half_in2[k]);
+      InitChain(&chains[2 * k], half_in1[k], filter1[k],
+                WebRtcSpl_kAllPassFilter2, filter_state1[s + k]);
+      InitChain(&chains[2 * k + 1], half_in2[k], filter2[k],
+                WebRtcSpl_kAllPassFilter1, filter_state2[s + k]);
+    }
+    AllPassChains(chains, (int)(2 * num), band_length);
+    for (k = 0; k < num; k++) {
+      InterleaveToQ0(filter1[k], filter2[k], band_length, out_data[s + k]);
+    }
+    s += num;
+  }
+}
+
+void WebRtcSpl_AnalysisQMFSSE2(const int16_t* in_data,
+                               size_t in_data_length,
+                               int16_t* low_band,
+                               int16_t* high_band,
+                               int32_t* filter_state1,
+                               int32_t* filter_state2) {
+  WebRtcSpl_AnalysisQMFBatchSSE2(&in_data, in_data_length, &low_band,
+                                 &high_band, &filter_state1, &filter_state2,
+                                 1);
+}
+
+void WebRtcSpl_SynthesisQMFSSE2(const int16_t* low_band,
+                                const int16_t* high_band,
+                                size_t band_length,
+                                int16_t* out_data,
+                                int32_t* filter_state1,
+                                int32_t* filter_state2) {
+  WebRtcSpl_SynthesisQMFBatchSSE2(&low_band, &high_band, band_length,
+                                  &out_data, &filter_state1, &filter_state2,
+                                  1);
+}
@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of WebRtcSpl_FilterMAFastQ12() and WebRtcSpl_FilterARFastQ12(),
+// which filter blocks of eight samples with SSE2 where the CPU has it,
+// against the per-sample loops they ran before, reproduced below. Every
+// filter length up to kMaxFilterLength is run on every length up to
+// kMaxCheckedLength and some frame lengths, with random, full-scale and small
+// input and state, and random coefficients of small and of full range, the
+// latter of which the SSE2 AR filter leaves to C. The outputs must be
+// identical. The time per 10 ms frame at 16 kHz of both is printed too.
+// Returns 0 if all outputs are identical.
+//
+// Usage: filter_q12_check [iterations]
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kMaxFilterLength = 40;
+const size_t kMaxCheckedLength = 40;
+const size_t kFrameLengths[] = {80, 160, 240, 320};
+// 10 ms at 16 kHz, with the filter lengths of a 10th and a 16th order LPC.
+const size_t kTimedLength = 160;
+const size_t kTimedFilterLengths[] = {11, 17};
+
+typedef void (*Filter)(const int16_t* in,
+                       int16_t* out,
+                       const int16_t* coefficients,
+                       size_t coefficients_length,
+                       size_t length);
+
+// The loop of WebRtcSpl_FilterMAFastQ12() before the SSE2 version. The sum
+// wraps around in 32 bits, as it does there, but without overflowing an int.
+void FilterMAReference(const int16_t* in_ptr,
+                       int16_t* out_ptr,
+                       const int16_t* B,
+                       size_t B_length,
+                       size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    uint32_t sum = 0;
+    for (size_t j = 0; j < B_length; j++) {
+      sum += static_cast<uint32_t>(
+          B[j] * in_ptr[static_cast<ptrdiff_t>(i) - static_cast<ptrdiff_t>(j)]);
+    }
+    int32_t o = static_cast<int32_t>(sum);
+    o = WEBRTC_SPL_SAT(static_cast<int32_t>(134215679), o,
+                       static_cast<int32_t>(-134217728));
+    *out_ptr++ = static_cast<int16_t>((o + 2048) >> 12);
+  }
+}
+
+// The loop of WebRtcSpl_FilterARFastQ12() before the SSE2 version.
+void FilterARReference(const int16_t* data_in,
+                       int16_t* data_out,
+                       const int16_t* coefficients,
+                       size_t coefficients_length,
+                       size_t data_length) {
+  for (size_t i = 0; i < data_length; i++) {
+    int64_t sum = 0;
+    for (size_t j = coefficients_length - 1; j > 0; j--) {
+      sum += coefficients[j] *
+             data_out[static_cast<ptrdiff_t>(i) - static_cast<ptrdiff_t>(j)];
+    }
+    int64_t output = coefficients[0] * data_in[i];
+    output -= sum;
+    output = WEBRTC_SPL_SAT(134215679, output, -134217728);
+    data_out[i] = static_cast<int16_t>((output + 2048) >> 12);
+  }
+}
+
+// Fills |x| with one of the kinds of input.
+void Fill(int kind, std::vector<int16_t>* x) {
+  for (int16_t& sample : *x) {
+    switch (kind) {
+      case 0:
+        sample = static_cast<int16_t>(rand() % 65536 - 32768);
+        break;
+      case 1:
+        sample = rand() % 2 ? 32767 : -32768;
+        break;
+      default:
+        sample = static_cast<int16_t>(rand() % 7 - 3);
+        break;
+    }
+  }
+}
+
+// Fills |coefficients| in Q12, within +-1.0 if |full_range| is false.
+void FillCoefficients(bool full_range, std::vector<int16_t>* coefficients) {
+  for (int16_t& c : *coefficients) {
+    c = full_range ? static_cast<int16_t>(rand() % 65536 - 32768)
+                   : static_cast<int16_t>(rand() % 8193 - 4096);
+  }
+}
+
+// Adds to |mismatches| the number of runs in which |filter| differs from
+// |reference|, and prints the first. The filter reads |filter_length| - 1
+// samples of state before its input, for the MA filter, or before its output,
+// for the AR filter.
+void Check(const char* name,
+           Filter filter,
+           Filter reference,
+           size_t filter_length,
+           size_t length,
+           int iterations,
+           int* mismatches) {
+  const size_t history = filter_length - 1;
+  for (int i = 0; i < iterations; ++i) {
+    std::vector<int16_t> coefficients(filter_length);
+    FillCoefficients(i % 2 == 1, &coefficients);
+    std::vector<int16_t> in(history + length);
+    std::vector<int16_t> out(history + length);
+    Fill(i % 3, &in);
+    Fill((i + 1) % 3, &out);
+    std::vector<int16_t> expected = out;
+    filter(&in[history], &out[history], coefficients.data(), filter_length,
+           length);
+    reference(&in[history], &expected[history], coefficients.data(),
+              filter_length, length);
+    if (out == expected) {
+      continue;
+    }
+    if (*mismatches == 0) {
+      for (size_t k = history; k < out.size(); ++k) {
+        if (out[k] != expected[k]) {
+          printf("%s: filter length %d, length %d, output %d is %d, "
+                 "expected %d\n",
+                 name, static_cast<int>(filter_length),
+                 static_cast<int>(length), static_cast<int>(k - history),
+                 out[k], expected[k]);
+          break;
+        }
+      }
+    }
+    ++*mismatches;
+  }
+}
+
+// Returns the number of runs of all lengths in which |filter| differs.
+int CheckAll(const char* name, Filter filter, Filter reference, bool ar,
+             int iterations) {
+  int mismatches = 0;
+  // The AR filter needs at least two coefficients.
+  for (size_t filter_length = ar ? 2 : 1; filter_length <= kMaxFilterLength;
+       ++filter_length) {
+    for (size_t length = 1; length <= kMaxCheckedLength; ++length) {
+      Check(name, filter, reference, filter_length, length, iterations,
+            &mismatches);
+    }
+    for (size_t length : kFrameLengths) {
+      Check(name, filter, reference, filter_length, length, iterations,
+            &mismatches);
+    }
+  }
+  printf("%s: %d runs differ\n", name, mismatches);
+  return mismatches;
+}
+
+// Returns the time per frame of |filter| with a stable filter, carrying the
+// state over from frame to frame.
+double Time(Filter filter, size_t filter_length, int iterations) {
+  const size_t history = filter_length - 1;
+  std::vector<int16_t> coefficients(filter_length, 0);
+  // A lowpass that is stable as AR filter too.
+  coefficients[0] = 4096;
+  coefficients[1] = -2048;
+  std::vector<int16_t> in(history + kTimedLength);
+  std::vector<int16_t> out(history + kTimedLength, 0);
+  Fill(0, &in);
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    filter(&in[history], &out[history], coefficients.data(), filter_length,
+           kTimedLength);
+    std::copy(out.end() - history, out.end(), out.begin());
+  }
+  return static_cast<double>(rtc::TimeNanos() - start_ns) / iterations;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 6;
+  if (iterations < 1) {
+    fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  printf("Kernel: %s\n", WebRtc_UseSSE2() ? "SSE2" : "C");
+#endif
+
+  srand(1);
+  int mismatches = 0;
+  mismatches += webrtc::CheckAll("FilterMAFastQ12", WebRtcSpl_FilterMAFastQ12,
+                                 webrtc::FilterMAReference, false,
+                                 iterations);
+  mismatches += webrtc::CheckAll("FilterARFastQ12", WebRtcSpl_FilterARFastQ12,
+                                 webrtc::FilterARReference, true, iterations);
+
+  const int timed = 20000 * iterations;
+  for (size_t filter_length : webrtc::kTimedFilterLengths) {
+    printf("ns per %d samples, %d coefficients: MA %.0f (before %.0f), "
+           "AR %.0f (before %.0f)\n",
+           static_cast<int>(webrtc::kTimedLength),
+           static_cast<int>(filter_length),
+           webrtc::Time(WebRtcSpl_FilterMAFastQ12, filter_length, timed),
+           webrtc::Time(webrtc::FilterMAReference, filter_length, timed),
+           webrtc::Time(WebRtcSpl_FilterARFastQ12, filter_length, timed),
+           webrtc::Time(webrtc::FilterARReference, filter_length, timed));
+  }
+  return mismatches == 0 ? 0 : 1;
+}
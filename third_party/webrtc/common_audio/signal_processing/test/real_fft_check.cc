@@ -0,0 +1,214 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the planned real FFT of real_fft.h, which uses precomputed bit
+// reversal and, where the CPU has SSE2, precomputed twiddles and the SSE2
+// kernels, against the transforms that real_fft.c computed before:
+// WebRtcSpl_ComplexBitReverse() followed by WebRtcSpl_ComplexFFT() or
+// WebRtcSpl_ComplexIFFT(), reproduced below. Every order up to kMaxFFTOrder
+// is transformed, forward and inverse, single and batched, with random,
+// full-scale and small input, and the outputs and scales must be identical.
+// The time of a forward plus inverse transform of both is printed too.
+// Returns 0 if all outputs are identical.
+//
+// Usage: real_fft_check [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "common_audio/signal_processing/include/real_fft.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+namespace webrtc {
+namespace {
+
+const int kMinOrder = 1;
+const size_t kBatchFrames = 3;
+
+// The forward transform of real_fft.c before it was planned.
+int ForwardReference(int order, const int16_t* real_data_in,
+                     int16_t* complex_data_out) {
+  const size_t n = static_cast<size_t>(1) << order;
+  int16_t complex_buffer[2 << kMaxFFTOrder];
+  for (size_t i = 0; i < n; ++i) {
+    complex_buffer[2 * i] = real_data_in[i];
+    complex_buffer[2 * i + 1] = 0;
+  }
+  WebRtcSpl_ComplexBitReverse(complex_buffer, order);
+  const int result = WebRtcSpl_ComplexFFT(complex_buffer, order, 1);
+  memcpy(complex_data_out, complex_buffer, sizeof(int16_t) * (n + 2));
+  return result;
+}
+
+// The inverse transform of real_fft.c before it was planned.
+int InverseReference(int order, const int16_t* complex_data_in,
+                     int16_t* real_data_out) {
+  const size_t n = static_cast<size_t>(1) << order;
+  int16_t complex_buffer[2 << kMaxFFTOrder];
+  memcpy(complex_buffer, complex_data_in, sizeof(int16_t) * (n + 2));
+  for (size_t i = n + 2; i < 2 * n; i += 2) {
+    complex_buffer[i] = complex_data_in[2 * n - i];
+    complex_buffer[i + 1] = -complex_data_in[2 * n - i + 1];
+  }
+  WebRtcSpl_ComplexBitReverse(complex_buffer, order);
+  const int result = WebRtcSpl_ComplexIFFT(complex_buffer, order, 1);
+  for (size_t i = 0; i < n; ++i) {
+    real_data_out[i] = complex_buffer[2 * i];
+  }
+  return result;
+}
+
+// Fills |x| with one of the kinds of input.
+void Fill(int kind, std::vector<int16_t>* x) {
+  for (int16_t& sample : *x) {
+    switch (kind) {
+      case 0:
+        sample = static_cast<int16_t>(rand() % 65536 - 32768);
+        break;
+      case 1:
+        sample = rand() % 2 ? 32767 : -32768;
+        break;
+      default:
+        sample = static_cast<int16_t>(rand() % 7 - 3);
+        break;
+    }
+  }
+}
+
+// Counts a mismatch of |name|, printing the first one.
+void Mismatch(const char* name, int order, int* mismatches) {
+  if (*mismatches == 0) {
+    printf("%s: order %d differs\n", name, order);
+  }
+  ++*mismatches;
+}
+
+// Returns the number of transforms of |order| that differ from the
+// reference.
+int Check(int order, int iterations) {
+  const size_t n = static_cast<size_t>(1) << order;
+  RealFFT* fft = WebRtcSpl_CreateRealFFT(order);
+  if (!fft) {
+    printf("Cannot create the FFT of order %d\n", order);
+    return 1;
+  }
+  int mismatches = 0;
+  for (int i = 0; i < iterations; ++i) {
+    std::vector<int16_t> real(kBatchFrames * n);
+    Fill(i % 3, &real);
+    std::vector<int16_t> spectrum(kBatchFrames * (n + 2));
+    std::vector<int16_t> expected_spectrum(spectrum.size());
+    std::vector<int16_t> batch_spectrum(spectrum.size());
+    for (size_t k = 0; k < kBatchFrames; ++k) {
+      const int result = WebRtcSpl_RealForwardFFT(fft, &real[k * n],
+                                                  &spectrum[k * (n + 2)]);
+      const int expected_result = ForwardReference(
+          order, &real[k * n], &expected_spectrum[k * (n + 2)]);
+      if (result != expected_result) {
+        Mismatch("RealForwardFFT", order, &mismatches);
+      }
+    }
+    if (spectrum != expected_spectrum) {
+      Mismatch("RealForwardFFT", order, &mismatches);
+    }
+    if (WebRtcSpl_RealForwardFFTBatch(fft, real.data(), kBatchFrames,
+                                      batch_spectrum.data()) != 0 ||
+        batch_spectrum != expected_spectrum) {
+      Mismatch("RealForwardFFTBatch", order, &mismatches);
+    }
+
+    // Invert the spectra, and also arbitrary input of the same kind.
+    for (int pass = 0; pass < 2; ++pass) {
+      if (pass == 1) {
+        Fill(i % 3, &spectrum);
+      }
+      std::vector<int16_t> out(kBatchFrames * n);
+      std::vector<int16_t> expected_out(out.size());
+      std::vector<int16_t> batch_out(out.size());
+      std::vector<int> scales(kBatchFrames);
+      std::vector<int> expected_scales(kBatchFrames);
+      std::vector<int> batch_scales(kBatchFrames);
+      for (size_t k = 0; k < kBatchFrames; ++k) {
+        scales[k] = WebRtcSpl_RealInverseFFT(fft, &spectrum[k * (n + 2)],
+                                             &out[k * n]);
+        expected_scales[k] = InverseReference(order, &spectrum[k * (n + 2)],
+                                              &expected_out[k * n]);
+      }
+      if (out != expected_out || scales != expected_scales) {
+        Mismatch("RealInverseFFT", order, &mismatches);
+      }
+      if (WebRtcSpl_RealInverseFFTBatch(fft, spectrum.data(), kBatchFrames,
+                                        batch_out.data(),
+                                        batch_scales.data()) != 0 ||
+          batch_out != expected_out || batch_scales != expected_scales) {
+        Mismatch("RealInverseFFTBatch", order, &mismatches);
+      }
+    }
+  }
+  WebRtcSpl_FreeRealFFT(fft);
+  return mismatches;
+}
+
+// Returns the time of a forward plus inverse transform of |order|, planned or
+// with the reference.
+double Time(int order, bool planned, int iterations) {
+  const size_t n = static_cast<size_t>(1) << order;
+  RealFFT* fft = WebRtcSpl_CreateRealFFT(order);
+  std::vector<int16_t> real(n);
+  std::vector<int16_t> spectrum(n + 2);
+  Fill(0, &real);
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    if (planned) {
+      WebRtcSpl_RealForwardFFT(fft, real.data(), spectrum.data());
+      WebRtcSpl_RealInverseFFT(fft, spectrum.data(), real.data());
+    } else {
+      ForwardReference(order, real.data(), spectrum.data());
+      InverseReference(order, spectrum.data(), real.data());
+    }
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  WebRtcSpl_FreeRealFFT(fft);
+  return static_cast<double>(elapsed_ns) / iterations;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 100;
+  if (iterations < 1) {
+    fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  printf("Kernel: %s\n", WebRtc_UseSSE2() ? "SSE2" : "C");
+#endif
+  // WebRtcSpl_ComplexIFFT() uses the function pointers of SPL.
+  WebRtcSpl_Init();
+
+  srand(1);
+  int mismatches = 0;
+  printf("%6s %8s %12s %12s\n", "order", "differ", "planned ns",
+         "before ns");
+  for (int order = webrtc::kMinOrder; order <= kMaxFFTOrder; ++order) {
+    const int order_mismatches = webrtc::Check(order, iterations);
+    const int timed = 100 * iterations;
+    printf("%6d %8d %12.0f %12.0f\n", order, order_mismatches,
+           webrtc::Time(order, true, timed), webrtc::Time(order, false, timed));
+    mismatches += order_mismatches;
+  }
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the QMF splitting filters, WebRtcSpl_AnalysisQMF(),
+// WebRtcSpl_SynthesisQMF() and their batch versions, which use the SSE2
+// kernels where the CPU has them, against WebRtcSpl_AnalysisQMFC() and
+// WebRtcSpl_SynthesisQMFC(). Consecutive frames of several band lengths are
+// filtered with random, full-scale and small input, and the bands, the
+// output and the filter states must be identical. The time per 10 ms frame
+// at 32 kHz of both is printed too. Returns 0 if all outputs are identical.
+//
+// Usage: splitting_filter_check [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kBandLengths[] = {1, 2, 3, 7, 8, 9, 80, 160, 320};
+const size_t kFrames = 20;
+const size_t kStreams = 5;
+const size_t kStateLength = 6;
+// 10 ms at 32 kHz.
+const size_t kTimedBandLength = 160;
+
+// The filter states of one stream.
+struct State {
+  int32_t state1[kStateLength];
+  int32_t state2[kStateLength];
+
+  State() {
+    memset(state1, 0, sizeof(state1));
+    memset(state2, 0, sizeof(state2));
+  }
+  bool operator==(const State& other) const {
+    return memcmp(state1, other.state1, sizeof(state1)) == 0 &&
+           memcmp(state2, other.state2, sizeof(state2)) == 0;
+  }
+};
+
+// Fills |x| with one of the kinds of input.
+void Fill(int kind, std::vector<int16_t>* x) {
+  for (int16_t& sample : *x) {
+    switch (kind) {
+      case 0:
+        sample = static_cast<int16_t>(rand() % 65536 - 32768);
+        break;
+      case 1:
+        sample = rand() % 2 ? 32767 : -32768;
+        break;
+      default:
+        sample = static_cast<int16_t>(rand() % 7 - 3);
+        break;
+    }
+  }
+}
+
+// Counts a mismatch of |name|, printing the first one.
+void Mismatch(const char* name, size_t band_length, size_t frame,
+              int* mismatches) {
+  if (*mismatches == 0) {
+    printf("%s: band length %d, frame %d differs\n", name,
+           static_cast<int>(band_length), static_cast<int>(frame));
+  }
+  ++*mismatches;
+}
+
+// Returns the number of frames in which the analysis, single and batched,
+// differs from WebRtcSpl_AnalysisQMFC().
+int CheckAnalysis(int iterations) {
+  int mismatches = 0;
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t band_length : kBandLengths) {
+      std::vector<State> states(kStreams);
+      std::vector<State> batch_states(kStreams);
+      std::vector<State> expected_states(kStreams);
+      for (size_t frame = 0; frame < kFrames; ++frame) {
+        std::vector<std::vector<int16_t>> in(kStreams);
+        std::vector<std::vector<int16_t>> bands(kStreams);
+        std::vector<std::vector<int16_t>> batch_bands(kStreams);
+        std::vector<std::vector<int16_t>> expected(kStreams);
+        std::vector<const int16_t*> in_ptrs(kStreams);
+        std::vector<int16_t*> low_ptrs(kStreams);
+        std::vector<int16_t*> high_ptrs(kStreams);
+        std::vector<int32_t*> state1_ptrs(kStreams);
+        std::vector<int32_t*> state2_ptrs(kStreams);
+        for (size_t s = 0; s < kStreams; ++s) {
+          in[s].resize(2 * band_length);
+          Fill((i + frame + s) % 3, &in[s]);
+          bands[s].resize(2 * band_length);
+          batch_bands[s].resize(2 * band_length);
+          expected[s].resize(2 * band_length);
+          WebRtcSpl_AnalysisQMF(in[s].data(), 2 * band_length,
+                                bands[s].data(), &bands[s][band_length],
+                                states[s].state1, states[s].state2);
+          WebRtcSpl_AnalysisQMFC(in[s].data(), 2 * band_length,
+                                 expected[s].data(), &expected[s][band_length],
+                                 expected_states[s].state1,
+                                 expected_states[s].state2);
+          in_ptrs[s] = in[s].data();
+          low_ptrs[s] = batch_bands[s].data();
+          high_ptrs[s] = &batch_bands[s][band_length];
+          state1_ptrs[s] = batch_states[s].state1;
+          state2_ptrs[s] = batch_states[s].state2;
+        }
+        WebRtcSpl_AnalysisQMFBatch(in_ptrs.data(), 2 * band_length,
+                                   low_ptrs.data(), high_ptrs.data(),
+                                   state1_ptrs.data(), state2_ptrs.data(),
+                                   kStreams);
+        for (size_t s = 0; s < kStreams; ++s) {
+          if (bands[s] != expected[s] ||
+              !(states[s] == expected_states[s])) {
+            Mismatch("AnalysisQMF", band_length, frame, &mismatches);
+          }
+          if (batch_bands[s] != expected[s] ||
+              !(batch_states[s] == expected_states[s])) {
+            Mismatch("AnalysisQMFBatch", band_length, frame, &mismatches);
+          }
+        }
+      }
+    }
+  }
+  printf("Analysis: %d frames differ\n", mismatches);
+  return mismatches;
+}
+
+// Returns the number of frames in which the synthesis, single and batched,
+// differs from WebRtcSpl_SynthesisQMFC().
+int CheckSynthesis(int iterations) {
+  int mismatches = 0;
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t band_length : kBandLengths) {
+      std::vector<State> states(kStreams);
+      std::vector<State> batch_states(kStreams);
+      std::vector<State> expected_states(kStreams);
+      for (size_t frame = 0; frame < kFrames; ++frame) {
+        std::vector<std::vector<int16_t>> bands(kStreams);
+        std::vector<std::vector<int16_t>> out(kStreams);
+        std::vector<std::vector<int16_t>> batch_out(kStreams);
+        std::vector<std::vector<int16_t>> expected(kStreams);
+        std::vector<const int16_t*> low_ptrs(kStreams);
+        std::vector<const int16_t*> high_ptrs(kStreams);
+        std::vector<int16_t*> out_ptrs(kStreams);
+        std::vector<int32_t*> state1_ptrs(kStreams);
+        std::vector<int32_t*> state2_ptrs(kStreams);
+        for (size_t s = 0; s < kStreams; ++s) {
+          bands[s].resize(2 * band_length);
+          Fill((i + frame + s) % 3, &bands[s]);
+          out[s].resize(2 * band_length);
+          batch_out[s].resize(2 * band_length);
+          expected[s].resize(2 * band_length);
+          WebRtcSpl_SynthesisQMF(bands[s].data(), &bands[s][band_length],
+                                 band_length, out[s].data(), states[s].state1,
+                                 states[s].state2);
+          WebRtcSpl_SynthesisQMFC(bands[s].data(), &bands[s][band_length],
+                                  band_length, expected[s].data(),
+                                  expected_states[s].state1,
+                                  expected_states[s].state2);
+          low_ptrs[s] = bands[s].data();
+          high_ptrs[s] = &bands[s][band_length];
+          out_ptrs[s] = batch_out[s].data();
+          state1_ptrs[s] = batch_states[s].state1;
+          state2_ptrs[s] = batch_states[s].state2;
+        }
+        WebRtcSpl_SynthesisQMFBatch(low_ptrs.data(), high_ptrs.data(),
+                                    band_length, out_ptrs.data(),
+                                    state1_ptrs.data(), state2_ptrs.data(),
+                                    kStreams);
+        for (size_t s = 0; s < kStreams; ++s) {
+          if (out[s] != expected[s] || !(states[s] == expected_states[s])) {
+            Mismatch("SynthesisQMF", band_length, frame, &mismatches);
+          }
+          if (batch_out[s] != expected[s] ||
+              !(batch_states[s] == expected_states[s])) {
+            Mismatch("SynthesisQMFBatch", band_length, frame, &mismatches);
+          }
+        }
+      }
+    }
+  }
+  printf("Synthesis: %d frames differ\n", mismatches);
+  return mismatches;
+}
+
+typedef void (*Analysis)(const int16_t* in_data,
+                         size_t in_data_length,
+                         int16_t* low_band,
+                         int16_t* high_band,
+                         int32_t* filter_state1,
+                         int32_t* filter_state2);
+typedef void (*Synthesis)(const int16_t* low_band,
+                          const int16_t* high_band,
+                          size_t band_length,
+                          int16_t* out_data,
+                          int32_t* filter_state1,
+                          int32_t* filter_state2);
+
+// Returns the time per frame of splitting and combining the bands again.
+double Time(Analysis analysis, Synthesis synthesis, int iterations) {
+  std::vector<int16_t> signal(2 * kTimedBandLength);
+  std::vector<int16_t> bands(2 * kTimedBandLength);
+  Fill(0, &signal);
+  State analysis_state;
+  State synthesis_state;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    analysis(signal.data(), signal.size(), bands.data(),
+             &bands[kTimedBandLength], analysis_state.state1,
+             analysis_state.state2);
+    synthesis(bands.data(), &bands[kTimedBandLength], kTimedBandLength,
+              signal.data(), synthesis_state.state1, synthesis_state.state2);
+  }
+  return static_cast<double>(rtc::TimeNanos() - start_ns) / iterations;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 20;
+  if (iterations < 1) {
+    fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  printf("Kernel: %s\n", WebRtc_UseSSE2() ? "SSE2" : "C");
+#endif
+
+  srand(1);
+  int mismatches = 0;
+  mismatches += webrtc::CheckAnalysis(iterations);
+  mismatches += webrtc::CheckSynthesis(iterations);
+
+  const int timed = 5000 * iterations;
+  printf("ns per 10 ms at 32 kHz, analysis and synthesis: %.0f (C %.0f)\n",
+         webrtc::Time(WebRtcSpl_AnalysisQMF, WebRtcSpl_SynthesisQMF, timed),
+         webrtc::Time(WebRtcSpl_AnalysisQMFC, WebRtcSpl_SynthesisQMFC, timed));
+  return mismatches == 0 ? 0 : 1;
+}
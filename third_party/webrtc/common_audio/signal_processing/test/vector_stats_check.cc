@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of WebRtcSpl_GetVectorStatsW16(), which makes its pass over the
+// vector with SSE2 where the CPU has it, against the individual functions it
+// replaces: WebRtcSpl_MinValueW16(), WebRtcSpl_MaxValueW16(),
+// WebRtcSpl_MaxAbsValueW16(), WebRtcSpl_MaxIndexW16(),
+// WebRtcSpl_MaxAbsIndexW16() and WebRtcSpl_Energy(). Every length up to
+// kMaxCheckedLength and some frame lengths are checked, with random,
+// full-scale, small, constant -32768 and zero input, at every offset of a
+// 16-byte block. All statistics must be identical. The time of the single
+// pass and of the individual calls is printed too. Returns 0 if all
+// statistics are identical.
+//
+// Usage: vector_stats_check [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kMaxCheckedLength = 70;
+const size_t kFrameLengths[] = {80, 160, 240, 320, 480, 1024};
+const size_t kMaxOffset = 8;
+const int kNumKinds = 5;
+// 10 ms at 16 kHz.
+const size_t kTimedLength = 160;
+
+// Fills |x| with one of the kinds of input.
+void Fill(int kind, std::vector<int16_t>* x) {
+  for (int16_t& sample : *x) {
+    switch (kind) {
+      case 0:
+        sample = static_cast<int16_t>(rand() % 65536 - 32768);
+        break;
+      case 1:
+        sample = rand() % 2 ? 32767 : -32768;
+        break;
+      case 2:
+        sample = static_cast<int16_t>(rand() % 7 - 3);
+        break;
+      case 3:
+        sample = -32768;
+        break;
+      default:
+        sample = 0;
+        break;
+    }
+  }
+}
+
+// The statistics from the individual functions.
+WebRtcSpl_VectorStats Reference(int16_t* vector, size_t length) {
+  WebRtcSpl_VectorStats stats;
+  stats.min_value = WebRtcSpl_MinValueW16(vector, length);
+  stats.max_value = WebRtcSpl_MaxValueW16(vector, length);
+  stats.max_abs_value = WebRtcSpl_MaxAbsValueW16(vector, length);
+  stats.max_index = WebRtcSpl_MaxIndexW16(vector, length);
+  stats.max_abs_index = WebRtcSpl_MaxAbsIndexW16(vector, length);
+  stats.energy = WebRtcSpl_Energy(vector, length, &stats.energy_scale);
+  return stats;
+}
+
+bool Equal(const WebRtcSpl_VectorStats& a, const WebRtcSpl_VectorStats& b) {
+  return a.min_value == b.min_value && a.max_value == b.max_value &&
+         a.max_abs_value == b.max_abs_value && a.max_index == b.max_index &&
+         a.max_abs_index == b.max_abs_index && a.energy == b.energy &&
+         a.energy_scale == b.energy_scale;
+}
+
+void Print(const char* name, const WebRtcSpl_VectorStats& stats) {
+  printf("  %s: min %d max %d max abs %d at %d and %d, energy %d >> %d\n",
+         name, stats.min_value, stats.max_value, stats.max_abs_value,
+         static_cast<int>(stats.max_index),
+         static_cast<int>(stats.max_abs_index), stats.energy,
+         stats.energy_scale);
+}
+
+// Adds to |mismatches| the number of vectors of |length| whose statistics
+// differ, and prints the first.
+void Check(size_t length, int iterations, int* mismatches) {
+  std::vector<int16_t> buffer(kMaxOffset + length);
+  for (int i = 0; i < iterations; ++i) {
+    for (int kind = 0; kind < kNumKinds; ++kind) {
+      Fill(kind, &buffer);
+      for (size_t offset = 0; offset < kMaxOffset; ++offset) {
+        int16_t* vector = &buffer[offset];
+        WebRtcSpl_VectorStats stats;
+        WebRtcSpl_GetVectorStatsW16(vector, length, &stats);
+        const WebRtcSpl_VectorStats expected = Reference(vector, length);
+        if (Equal(stats, expected)) {
+          continue;
+        }
+        if (*mismatches == 0) {
+          printf("Length %d, offset %d, input kind %d differs:\n",
+                 static_cast<int>(length), static_cast<int>(offset), kind);
+          Print("single pass", stats);
+          Print("expected", expected);
+        }
+        ++*mismatches;
+      }
+    }
+  }
+}
+
+// Returns the time of the statistics of one vector, in a single pass or with
+// the individual functions.
+double Time(bool single_pass, int iterations) {
+  std::vector<int16_t> vector(kTimedLength);
+  Fill(0, &vector);
+  int64_t sum = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    WebRtcSpl_VectorStats stats;
+    if (single_pass) {
+      WebRtcSpl_GetVectorStatsW16(vector.data(), vector.size(), &stats);
+    } else {
+      stats = Reference(vector.data(), vector.size());
+    }
+    // Use the results, and make every call depend on the last one.
+    sum += stats.energy + stats.max_index;
+    vector[i % kTimedLength] ^= static_cast<int16_t>(sum & 1);
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  if (sum == 1) {
+    printf("\n");
+  }
+  return static_cast<double>(elapsed_ns) / iterations;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 20;
+  if (iterations < 1) {
+    fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  printf("Kernel: %s\n", WebRtc_UseSSE2() ? "SSE2" : "C");
+#endif
+  // The individual functions are function pointers of SPL.
+  WebRtcSpl_Init();
+
+  srand(1);
+  int mismatches = 0;
+  for (size_t length = 1; length <= webrtc::kMaxCheckedLength; ++length) {
+    webrtc::Check(length, iterations, &mismatches);
+  }
+  for (size_t length : webrtc::kFrameLengths) {
+    webrtc::Check(length, iterations, &mismatches);
+  }
+  printf("%d vectors differ\n", mismatches);
+
+  const int timed = 10000 * iterations;
+  printf("ns per %d samples: single pass %.0f, individual functions %.0f\n",
+         static_cast<int>(webrtc::kTimedLength), webrtc::Time(true, timed),
+         webrtc::Time(false, timed));
+  return mismatches == 0 ? 0 : 1;
+}
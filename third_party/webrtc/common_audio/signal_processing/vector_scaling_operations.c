@@ -17,6 +17,7 @@
  * WebRtcSpl_ScaleVector()
  * WebRtcSpl_ScaleVectorWithSat()
  * WebRtcSpl_ScaleAndAddVectors()
+ * WebRtcSpl_WindowW32()
  * WebRtcSpl_ScaleAndAddVectorsWithRoundC()
  */
 
@@ -139,6 +140,36 @@ void WebRtcSpl_ScaleAndAddVectors(const int16_t *in1, int16_t gain1, int shift1,
     }
 }
 
+void WebRtcSpl_WindowW32(int32_t* out_vector,
+                         const int32_t* in_vector,
+                         const int32_t* window,
+                         size_t vector_length) {
+  size_t i;
+  int16_t x_hi, x_low, y_hi, y_low;
+  int16_t left_shifts;
+
+  if (vector_length == 0) {
+    return;
+  }
+  left_shifts = (int16_t)WebRtcSpl_NormW32(in_vector[0]);
+  WebRtcSpl_VectorBitShiftW32(out_vector, vector_length, in_vector,
+                              -left_shifts);
+
+  // The 32 bit values are split into halves as hi * 65536 + lo * 2. The
+  // high product is doubled as unsigned, since it may be negative.
+  for (i = 0; i < vector_length; i++) {
+    x_hi = (int16_t)(out_vector[i] >> 16);
+    y_hi = (int16_t)(window[i] >> 16);
+    x_low = (int16_t)((out_vector[i] - x_hi * 65536) >> 1);
+    y_low = (int16_t)((window[i] - y_hi * 65536) >> 1);
+    out_vector[i] = (int32_t)((uint32_t)(x_hi * y_hi) << 1) +
+                    ((x_hi * y_low) >> 14) + ((x_low * y_hi) >> 14);
+  }
+
+  WebRtcSpl_VectorBitShiftW32(out_vector, vector_length, out_vector,
+                              left_shifts);
+}
+
 // C version of WebRtcSpl_ScaleAndAddVectorsWithRound() for generic platforms.
 int WebRtcSpl_ScaleAndAddVectorsWithRoundC(const int16_t* in_vector1,
                                            int16_t in_vector1_scale,
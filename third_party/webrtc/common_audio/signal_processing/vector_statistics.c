@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file contains the function WebRtcSpl_GetVectorStatsW16().
+ * The description header can be found in signal_processing_library.h
+ *
+ */
+
+#include <stdlib.h>
+
+#include "rtc_base/checks.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+static void VectorStatsC(const int16_t* vector,
+                         size_t length,
+                         WebRtcSpl_VectorStats* stats,
+                         int16_t* scaling_max,
+                         uint64_t* sum_of_squares) {
+  size_t i = 0;
+  int16_t minimum = WEBRTC_SPL_WORD16_MAX;
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  // Use type int to accommodate the value of abs(-32768).
+  int absolute = 0, max_abs = 0;
+  // WebRtcSpl_GetScalingSquare() takes the absolute value in 16 bits, which
+  // leaves -32768 negative, so that it never becomes the maximum.
+  int smax = -1;
+  uint64_t sum = 0;
+
+  stats->max_index = 0;
+  stats->max_abs_index = 0;
+  for (i = 0; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (vector[i] < minimum) {
+      minimum = vector[i];
+    }
+    if (vector[i] > maximum) {
+      maximum = vector[i];
+      stats->max_index = i;
+    }
+    if (absolute > max_abs) {
+      max_abs = absolute;
+      stats->max_abs_index = i;
+    }
+    if (absolute > smax && vector[i] != WEBRTC_SPL_WORD16_MIN) {
+      smax = absolute;
+    }
+    sum += (uint32_t)(vector[i] * vector[i]);
+  }
+
+  stats->min_value = minimum;
+  stats->max_value = maximum;
+  stats->max_abs_value = (int16_t)WEBRTC_SPL_MIN(max_abs,
+                                                 WEBRTC_SPL_WORD16_MAX);
+  *scaling_max = (int16_t)smax;
+  *sum_of_squares = sum;
+}
+
+static int32_t ScaledEnergyC(const int16_t* vector,
+                             size_t length,
+                             int scaling) {
+  size_t i = 0;
+  // Accumulate as unsigned to wrap around without undefined behavior.
+  uint32_t en = 0;
+
+  for (i = 0; i < length; i++) {
+    en += (uint32_t)((vector[i] * vector[i]) >> scaling);
+  }
+  return (int32_t)en;
+}
+
+void WebRtcSpl_GetVectorStatsW16(const int16_t* vector,
+                                 size_t length,
+                                 WebRtcSpl_VectorStats* stats) {
+  int16_t smax = -1;
+  int16_t nbits = 0;
+  int16_t t = 0;
+  uint64_t sum_of_squares = 0;
+  int use_sse2 = 0;
+
+  RTC_DCHECK_GT(length, 0);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  use_sse2 = WebRtc_UseSSE2();
+  if (use_sse2) {
+    WebRtcSpl_VectorStatsSSE2(vector, length, stats, &smax, &sum_of_squares);
+  }
+#endif
+  if (!use_sse2) {
+    VectorStatsC(vector, length, stats, &smax, &sum_of_squares);
+  }
+
+  // Same scaling as WebRtcSpl_GetScalingSquare(vector, length, length).
+  nbits = WebRtcSpl_GetSizeInBits((uint32_t)length);
+  t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+  stats->energy_scale = (smax == 0 || t > nbits) ? 0 : nbits - t;
+
+  if (stats->energy_scale == 0) {
+    // Without scaling the energy is the (wrapped around) sum of squares.
+    stats->energy = (int32_t)(uint32_t)sum_of_squares;
+    return;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2) {
+    stats->energy =
+        WebRtcSpl_ScaledEnergySSE2(vector, length, stats->energy_scale);
+    return;
+  }
+#endif
+  stats->energy = ScaledEnergyC(vector, length, stats->energy_scale);
+}
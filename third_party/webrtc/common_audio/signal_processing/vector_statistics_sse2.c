@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/signal_processing/spl_sse2.h"
+
+// The maxima are reduced to scalars once per block. The index of the first
+// maximum is then found by searching the block in which it first occurred.
+enum { kBlockLength = 64 };
+
+static __inline int16_t HorizontalMax(__m128i v) {
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, 0x4e));
+  v = _mm_max_epi16(v, _mm_shuffle_epi32(v, 0xb1));
+  v = _mm_max_epi16(v, _mm_shufflelo_epi16(v, 0xb1));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+static __inline int16_t HorizontalMin(__m128i v) {
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, 0x4e));
+  v = _mm_min_epi16(v, _mm_shuffle_epi32(v, 0xb1));
+  v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, 0xb1));
+  return (int16_t)_mm_cvtsi128_si32(v);
+}
+
+void WebRtcSpl_VectorStatsSSE2(const int16_t* vector,
+                               size_t length,
+                               WebRtcSpl_VectorStats* stats,
+                               int16_t* scaling_max,
+                               uint64_t* sum_of_squares) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i sign = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+  __m128i minimum = _mm_set1_epi16(WEBRTC_SPL_WORD16_MAX);
+  __m128i smax = _mm_set1_epi16(-1);
+  __m128i energy = zero;
+  int16_t maximum = WEBRTC_SPL_WORD16_MIN;
+  // The absolute values are compared as unsigned 16-bit values, which is done
+  // with signed comparisons on the values with the sign bit flipped. Then
+  // abs(-32768) is the largest and 0 is the smallest (WEBRTC_SPL_WORD16_MIN).
+  int16_t max_abs = WEBRTC_SPL_WORD16_MIN;
+  size_t max_block = 0, max_abs_block = 0;
+  size_t i = 0, j = 0;
+  int absolute = 0;
+  uint64_t partial_sums[2];
+  uint64_t sum = 0;
+  int16_t min_value = 0, scaling_maximum = 0;
+
+  for (i = 0; i + kBlockLength <= length; i += kBlockLength) {
+    __m128i block_max = sign;
+    __m128i block_abs = sign;
+    int16_t value = 0;
+
+    for (j = i; j < i + kBlockLength; j += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&vector[j]);
+      // The 16-bit absolute value, which is -32768 for -32768.
+      const __m128i abs_v = _mm_max_epi16(v, _mm_sub_epi16(zero, v));
+      // Sums of two squares, which fit an unsigned 32-bit value.
+      const __m128i squares = _mm_madd_epi16(v, v);
+      block_max = _mm_max_epi16(block_max, v);
+      block_abs = _mm_max_epi16(block_abs, _mm_xor_si128(abs_v, sign));
+      minimum = _mm_min_epi16(minimum, v);
+      smax = _mm_max_epi16(smax, abs_v);
+      energy = _mm_add_epi64(energy, _mm_unpacklo_epi32(squares, zero));
+      energy = _mm_add_epi64(energy, _mm_unpackhi_epi32(squares, zero));
+    }
+
+    value = HorizontalMax(block_max);
+    if (value > maximum) {
+      maximum = value;
+      max_block = i;
+    }
+    value = HorizontalMax(block_abs);
+    if (value > max_abs) {
+      max_abs = value;
+      max_abs_block = i;
+    }
+  }
+
+  min_value = HorizontalMin(minimum);
+  scaling_maximum = HorizontalMax(smax);
+  _mm_storeu_si128((__m128i*)partial_sums, energy);
+  sum = partial_sums[0] + partial_sums[1];
+  absolute = (uint16_t)(max_abs ^ WEBRTC_SPL_WORD16_MIN);
+
+  stats->max_index = 0;
+  stats->max_abs_index = 0;
+  if (i > 0) {
+    for (j = max_block; vector[j] != maximum; j++) {
+    }
+    stats->max_index = j;
+    for (j = max_abs_block; abs((int)vector[j]) != absolute; j++) {
+    }
+    stats->max_abs_index = j;
+  }
+
+  for (; i < length; i++) {
+    const int value = abs((int)vector[i]);
+    if (vector[i] < min_value) {
+      min_value = vector[i];
+    }
+    if (vector[i] > maximum) {
+      maximum = vector[i];
+      stats->max_index = i;
+    }
+    if (value > absolute) {
+      absolute = value;
+      stats->max_abs_index = i;
+    }
+    if (value > scaling_maximum && vector[i] != WEBRTC_SPL_WORD16_MIN) {
+      scaling_maximum = (int16_t)value;
+    }
+    sum += (uint32_t)(vector[i] * vector[i]);
+  }
+
+  stats->min_value = min_value;
+  stats->max_value = maximum;
+  stats->max_abs_value =
+      (int16_t)WEBRTC_SPL_MIN(absolute, WEBRTC_SPL_WORD16_MAX);
+  *scaling_max = scaling_maximum;
+  *sum_of_squares = sum;
+}
+
+int32_t WebRtcSpl_ScaledEnergySSE2(const int16_t* vector,
+                                   size_t length,
+                                   int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i energy = _mm_setzero_si128();
+  size_t i = 0;
+  // Accumulate as unsigned to wrap around without undefined behavior.
+  uint32_t en = 0;
+
+  for (i = 0; i + 8 <= length; i += 8) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    const __m128i low = _mm_mullo_epi16(v, v);
+    const __m128i high = _mm_mulhi_epi16(v, v);
+    energy = _mm_add_epi32(
+        energy, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+    energy = _mm_add_epi32(
+        energy, _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+  }
+  energy = _mm_add_epi32(energy, _mm_shuffle_epi32(energy, 0x4e));
+  energy = _mm_add_epi32(energy, _mm_shuffle_epi32(energy, 0xb1));
+  en = (uint32_t)_mm_cvtsi128_si32(energy);
+
+  for (; i < length; i++) {
+    en += (uint32_t)((vector[i] * vector[i]) >> scaling);
+  }
+  return (int32_t)en;
+}
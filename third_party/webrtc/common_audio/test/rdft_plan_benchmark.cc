@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Accuracy and speed of the planned real FFT of rdft_plan.h against
+// WebRtc_rdft() of fft4g, for every length from 2^kRdftMinOrder to
+// 2^kRdftMaxOrder. Both transform the same random signal, and are compared
+// with a DFT in double precision: the largest error of the forward transform
+// relative to the largest magnitude of the spectrum, and of forward plus
+// inverse relative to the largest sample. Then the time of a forward plus
+// inverse transform is measured. Returns 0 if the planned transform is within
+// kMaxError at every length.
+//
+// Usage: rdft_plan_benchmark [iterations]
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common_audio/rdft_plan.h"
+#include "common_audio/third_party/fft4g/fft4g.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+// Largest relative error of the planned transform. WebRtc_rdft() stays
+// within 4e-7 up to 1024 points.
+const double kMaxError = 1e-6;
+
+// Forward and inverse transforms of one length.
+class Transform {
+ public:
+  virtual ~Transform() {}
+  virtual void Forward(float* data) = 0;
+  virtual void Inverse(float* data) = 0;
+};
+
+class PlannedTransform : public Transform {
+ public:
+  explicit PlannedTransform(size_t length)
+      : plan_(WebRtc_GetRdftPlan(length)) {}
+  void Forward(float* data) override { WebRtc_RdftForward(plan_, data); }
+  void Inverse(float* data) override { WebRtc_RdftInverse(plan_, data); }
+
+ private:
+  const RdftPlan* plan_;
+};
+
+class Fft4gTransform : public Transform {
+ public:
+  // The work arrays are at least as large as fft4g.c asks for.
+  explicit Fft4gTransform(size_t length)
+      : length_(length),
+        ip_(2 + static_cast<size_t>(sqrt(static_cast<double>(length))) + 1),
+        w_(length / 2 + 1) {}
+  void Forward(float* data) override {
+    WebRtc_rdft(length_, 1, data, ip_.data(), w_.data());
+  }
+  void Inverse(float* data) override {
+    WebRtc_rdft(length_, -1, data, ip_.data(), w_.data());
+  }
+
+ private:
+  const size_t length_;
+  std::vector<size_t> ip_;
+  std::vector<float> w_;
+};
+
+// The spectrum of |x| in the layout of WebRtc_rdft(), in double precision.
+std::vector<double> Dft(const std::vector<float>& x) {
+  const size_t n = x.size();
+  std::vector<double> spectrum(n);
+  for (size_t k = 0; k <= n / 2; ++k) {
+    double re = 0;
+    double im = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const double angle = 2 * M_PI * ((i * k) % n) / n;
+      re += x[i] * cos(angle);
+      im += x[i] * sin(angle);
+    }
+    if (k == 0) {
+      spectrum[0] = re;
+    } else if (k == n / 2) {
+      spectrum[1] = re;
+    } else {
+      spectrum[2 * k] = re;
+      spectrum[2 * k + 1] = im;
+    }
+  }
+  return spectrum;
+}
+
+// Returns the largest difference between |a| and |b| relative to the largest
+// absolute value of |b|.
+double Error(const std::vector<float>& a, const std::vector<double>& b) {
+  double max_value = 0;
+  double max_difference = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    max_value = std::max(max_value, fabs(b[i]));
+    max_difference = std::max(max_difference, fabs(a[i] - b[i]));
+  }
+  return max_difference / max_value;
+}
+
+struct Result {
+  double forward_error;
+  double inverse_error;
+  double ns;
+};
+
+Result Measure(Transform* transform,
+               const std::vector<float>& x,
+               const std::vector<double>& spectrum,
+               int iterations) {
+  const size_t n = x.size();
+  Result result;
+  std::vector<float> data = x;
+  transform->Forward(data.data());
+  result.forward_error = Error(data, spectrum);
+  transform->Inverse(data.data());
+  const std::vector<double> expected(x.begin(), x.end());
+  for (float& d : data) {
+    d *= 2.f / n;
+  }
+  result.inverse_error = Error(data, expected);
+
+  data = x;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    transform->Forward(data.data());
+    transform->Inverse(data.data());
+    for (float& d : data) {
+      d *= 2.f / n;
+    }
+  }
+  result.ns = static_cast<double>(rtc::TimeNanos() - start_ns) / iterations;
+  return result;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 10000;
+  if (iterations < 1) {
+    fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  srand(1);
+  bool passed = true;
+  printf("%6s %24s %24s %16s\n", "length", "forward error",
+         "inverse error", "ns");
+  printf("%6s %12s %11s %12s %11s %8s %7s\n", "", "planned", "fft4g",
+         "planned", "fft4g", "planned", "fft4g");
+  for (int order = kRdftMinOrder; order <= kRdftMaxOrder; ++order) {
+    const size_t n = static_cast<size_t>(1) << order;
+    std::vector<float> x(n);
+    for (float& sample : x) {
+      sample = static_cast<float>(rand() % 65536 - 32768);
+    }
+    const std::vector<double> spectrum = webrtc::Dft(x);
+    webrtc::PlannedTransform planned(n);
+    webrtc::Fft4gTransform fft4g(n);
+    const webrtc::Result p =
+        webrtc::Measure(&planned, x, spectrum, iterations);
+    const webrtc::Result f = webrtc::Measure(&fft4g, x, spectrum, iterations);
+    printf("%6d %12.2g %11.2g %12.2g %11.2g %8.0f %7.0f\n",
+           static_cast<int>(n), p.forward_error, f.forward_error,
+           p.inverse_error, f.inverse_error, p.ns, f.ns);
+    passed = passed && p.forward_error <= webrtc::kMaxError &&
+             p.inverse_error <= webrtc::kMaxError;
+  }
+  printf("%s\n", passed ? "passed" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Benchmark of WebRtcVad_ProcessBatch() against WebRtcVad_Process() per
+// stream, for the active speaker detection of many audio streams. Every
+// stream reads the input file from a different offset, in 10 ms frames. The
+// decisions of both must be identical, and the number of streams one core
+// can run in real time is reported for both.
+//
+// Usage: vad_batch_benchmark <input.pcm> [streams] [rate] [mode] [loops]
+//
+// The input is 16-bit mono PCM at |rate|, which defaults to 16000 Hz.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "common_audio/vad/include/webrtc_vad.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const int kFrameMs = 10;
+
+class Streams {
+ public:
+  Streams(int num_streams, int mode) : handles_(num_streams) {
+    for (VadInst*& handle : handles_) {
+      handle = WebRtcVad_Create();
+      WebRtcVad_Init(handle);
+      WebRtcVad_set_mode(handle, mode);
+    }
+  }
+  ~Streams() {
+    for (VadInst* handle : handles_) {
+      WebRtcVad_Free(handle);
+    }
+  }
+
+  VadInst* const* handles() const { return handles_.data(); }
+
+ private:
+  std::vector<VadInst*> handles_;
+};
+
+struct Result {
+  int64_t single_ns = 0;
+  int64_t batch_ns = 0;
+  size_t active = 0;
+  size_t mismatches = 0;
+};
+
+// Runs |num_streams| streams over |num_frames| frames of |input|, which holds
+// the frames twice.
+Result Run(const std::vector<int16_t>& input,
+           size_t num_frames,
+           int num_streams,
+           int rate,
+           int mode,
+           int loops) {
+  const size_t frame_length = static_cast<size_t>(rate / 1000 * kFrameMs);
+  std::vector<const int16_t*> frames(num_streams);
+  std::vector<int> decisions(num_streams);
+  Result result;
+  for (int loop = 0; loop < loops; ++loop) {
+    Streams single(num_streams, mode);
+    Streams batch(num_streams, mode);
+    for (size_t frame = 0; frame < num_frames; ++frame) {
+      for (int i = 0; i < num_streams; ++i) {
+        const size_t offset = (frame + i * 7919 % num_frames) % num_frames;
+        frames[i] = &input[offset * frame_length];
+      }
+
+      int64_t start_ns = rtc::TimeNanos();
+      if (WebRtcVad_ProcessBatch(batch.handles(), num_streams, rate,
+                                 frames.data(), frame_length,
+                                 decisions.data()) != 0) {
+        fprintf(stderr, "WebRtcVad_ProcessBatch() failed\n");
+        result.mismatches = 1;
+        return result;
+      }
+      result.batch_ns += rtc::TimeNanos() - start_ns;
+
+      start_ns = rtc::TimeNanos();
+      for (int i = 0; i < num_streams; ++i) {
+        const int decision = WebRtcVad_Process(single.handles()[i], rate,
+                                               frames[i], frame_length);
+        if (loop == 0) {
+          result.active += decision == 1;
+          result.mismatches += decision != decisions[i];
+        }
+      }
+      result.single_ns += rtc::TimeNanos() - start_ns;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <input.pcm> [streams] [rate] [mode] [loops]\n",
+            argv[0]);
+    return 1;
+  }
+  const int num_streams = argc > 2 ? atoi(argv[2]) : 100;
+  const int rate = argc > 3 ? atoi(argv[3]) : 16000;
+  const int mode = argc > 4 ? atoi(argv[4]) : 0;
+  const int loops = argc > 5 ? atoi(argv[5]) : 3;
+  const size_t frame_length =
+      static_cast<size_t>(rate / 1000 * webrtc::kFrameMs);
+  if (num_streams < 1 || loops < 1 || mode < 0 || mode > 3 ||
+      WebRtcVad_ValidRateAndFrameLength(rate, frame_length) != 0) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  const size_t num_frames = input.size() / frame_length;
+  if (num_frames < 2) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+  // The input repeated, so that every stream can read |num_frames| frames
+  // from its own offset.
+  input.resize(num_frames * frame_length);
+  input.insert(input.end(), input.begin(), input.end());
+
+  const webrtc::Result result =
+      webrtc::Run(input, num_frames, num_streams, rate, mode, loops);
+
+  const double stream_frames =
+      static_cast<double>(num_frames) * num_streams * loops;
+  const double single_per_frame_ns = result.single_ns / stream_frames;
+  const double batch_per_frame_ns = result.batch_ns / stream_frames;
+  const double frame_ns = webrtc::kFrameMs * 1e6;
+  printf("%d streams at %d Hz, mode %d, %d frames of %d ms\n", num_streams,
+         rate, mode, static_cast<int>(num_frames), webrtc::kFrameMs);
+  printf("%10s %16s %16s %10s %10s\n", "", "ns/stream/frame",
+         "streams/core", "active", "mismatch");
+  printf("%10s %16.0f %16.0f %10d %10s\n", "single", single_per_frame_ns,
+         frame_ns / single_per_frame_ns, static_cast<int>(result.active), "");
+  printf("%10s %16.0f %16.0f %10s %10d\n", "batch", batch_per_frame_ns,
+         frame_ns / batch_per_frame_ns, "",
+         static_cast<int>(result.mismatches));
+  return result.mismatches == 0 ? 0 : 1;
+}
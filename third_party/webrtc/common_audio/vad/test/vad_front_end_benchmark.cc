@@ -0,0 +1,212 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Compares the decimating front end of the VAD, see
+// WebRtcVad_set_decimating_front_end(), with the default one, in 10 ms
+// frames. Reports the time per frame of both, and how often their decisions
+// agree. With a label file, which has one character per frame, '1' for speech
+// and '0' for non-speech, the share of correct, missed and false speech
+// decisions of both is reported as well. The decimating front end passes if
+// the decisions agree on at least |kMinAgreement| of the frames, and it is
+// correct on at most |kMaxAccuracyLoss| fewer of the labeled frames. Near the
+// noise floor the decisions follow small changes of the features, so that the
+// default front end agrees with itself on the same audio delayed by one 8 kHz
+// sample on only 93% to 99% of the frames of speech in noise.
+//
+// Usage: vad_front_end_benchmark <input.pcm> [mode] [labels] [loops]
+//
+// The input is 16-bit mono PCM at 48 kHz.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "common_audio/vad/include/webrtc_vad.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const int kRate = 48000;
+const int kFrameMs = 10;
+const double kMinAgreement = 0.9;
+const double kMaxAccuracyLoss = 0.02;
+
+class Vad {
+ public:
+  Vad(int mode, int decimating_front_end) : handle_(WebRtcVad_Create()) {
+    WebRtcVad_Init(handle_);
+    WebRtcVad_set_mode(handle_, mode);
+    WebRtcVad_set_decimating_front_end(handle_, decimating_front_end);
+  }
+  ~Vad() { WebRtcVad_Free(handle_); }
+
+  VadInst* handle() { return handle_; }
+
+ private:
+  VadInst* handle_;
+};
+
+struct FrontEndResult {
+  int64_t ns = 0;
+  size_t active = 0;
+  size_t correct = 0;
+  size_t missed = 0;
+  size_t false_alarms = 0;
+};
+
+struct Result {
+  FrontEndResult reference;
+  FrontEndResult decimating;
+  size_t agreements = 0;
+};
+
+void Count(int decision, const std::vector<char>& labels, size_t frame,
+           FrontEndResult* result) {
+  result->active += decision == 1;
+  if (frame < labels.size()) {
+    const int label = labels[frame] == '1';
+    result->correct += decision == label;
+    result->missed += label && !decision;
+    result->false_alarms += !label && decision;
+  }
+}
+
+void PrintFrontEnd(const char* name, const FrontEndResult& result,
+                   size_t num_frames, size_t num_labels, int loops) {
+  printf("%12s %12.0f %10d", name,
+         static_cast<double>(result.ns) / (num_frames * loops),
+         static_cast<int>(result.active));
+  if (num_labels > 0) {
+    printf(" %9.2f%% %9.2f%% %9.2f%%", 100.0 * result.correct / num_labels,
+           100.0 * result.missed / num_labels,
+           100.0 * result.false_alarms / num_labels);
+  }
+  printf("\n");
+}
+
+Result Run(const std::vector<int16_t>& input,
+           const std::vector<char>& labels,
+           int mode,
+           int loops) {
+  const size_t frame_length = static_cast<size_t>(kRate / 1000 * kFrameMs);
+  const size_t num_frames = input.size() / frame_length;
+  Result result;
+  for (int loop = 0; loop < loops; ++loop) {
+    Vad reference(mode, 0);
+    Vad decimating(mode, 1);
+    for (size_t frame = 0; frame < num_frames; ++frame) {
+      const int16_t* audio_frame = &input[frame * frame_length];
+
+      int64_t start_ns = rtc::TimeNanos();
+      const int reference_decision = WebRtcVad_Process(
+          reference.handle(), kRate, audio_frame, frame_length);
+      result.reference.ns += rtc::TimeNanos() - start_ns;
+
+      start_ns = rtc::TimeNanos();
+      const int decimating_decision = WebRtcVad_Process(
+          decimating.handle(), kRate, audio_frame, frame_length);
+      result.decimating.ns += rtc::TimeNanos() - start_ns;
+
+      if (loop == 0) {
+        Count(reference_decision, labels, frame, &result.reference);
+        Count(decimating_decision, labels, frame, &result.decimating);
+        result.agreements += reference_decision == decimating_decision;
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <input.pcm> [mode] [labels] [loops]\n", argv[0]);
+    return 1;
+  }
+  const int mode = argc > 2 ? atoi(argv[2]) : 0;
+  const int loops = argc > 4 ? atoi(argv[4]) : 3;
+  if (mode < 0 || mode > 3 || loops < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  const size_t frame_length =
+      static_cast<size_t>(webrtc::kRate / 1000 * webrtc::kFrameMs);
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  const size_t num_frames = input.size() / frame_length;
+  if (num_frames == 0) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+
+  std::vector<char> labels;
+  if (argc > 3) {
+    file = fopen(argv[3], "r");
+    if (!file) {
+      fprintf(stderr, "Cannot open %s\n", argv[3]);
+      return 1;
+    }
+    int c;
+    while ((c = fgetc(file)) != EOF && labels.size() < num_frames) {
+      if (c == '0' || c == '1') {
+        labels.push_back(static_cast<char>(c));
+      }
+    }
+    fclose(file);
+  }
+
+  const webrtc::Result result = webrtc::Run(input, labels, mode, loops);
+
+  const double agreement =
+      static_cast<double>(result.agreements) / num_frames;
+  const double accuracy_loss =
+      labels.empty() ? 0.0
+                     : (static_cast<double>(result.reference.correct) -
+                        static_cast<double>(result.decimating.correct)) /
+                           labels.size();
+  printf("Mode %d, %d frames of %d ms, %d labeled\n", mode,
+         static_cast<int>(num_frames), webrtc::kFrameMs,
+         static_cast<int>(labels.size()));
+  printf("%12s %12s %10s", "front end", "ns/frame", "active");
+  if (!labels.empty()) {
+    printf(" %10s %10s %10s", "correct", "missed", "false");
+  }
+  printf("\n");
+  webrtc::PrintFrontEnd("reference", result.reference, num_frames,
+                        labels.size(), loops);
+  webrtc::PrintFrontEnd("decimating", result.decimating, num_frames,
+                        labels.size(), loops);
+  printf("agreement %.2f%% (at least %.0f%% required)\n", 100.0 * agreement,
+         100.0 * webrtc::kMinAgreement);
+  if (!labels.empty()) {
+    printf("accuracy loss %.2f%% (at most %.0f%% allowed)\n",
+           100.0 * accuracy_loss, 100.0 * webrtc::kMaxAccuracyLoss);
+  }
+  return agreement >= webrtc::kMinAgreement &&
+                 accuracy_loss <= webrtc::kMaxAccuracyLoss
+             ? 0
+             : 1;
+}
@@ -15,6 +15,7 @@
 #include "common_audio/vad/vad_filterbank.h"
 #include "common_audio/vad/vad_gmm.h"
 #include "common_audio/vad/vad_sp.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 // Spectrum Weighting
 static const int16_t kSpectrumWeight[kNumChannels] = { 6, 8, 10, 12, 14, 16 };
@@ -508,6 +509,11 @@ int WebRtcVad_InitCore(VadInstT* self) {
   // Initialization of 48 to 8 kHz downsampling.
   WebRtcSpl_ResetResample48khzTo8khz(&self->state_48_to_8);
 
+  // The decimating front end is off by default.
+  self->decimating_front_end = 0;
+  memset(self->decimation_filter_state, 0,
+         sizeof(self->decimation_filter_state));
+
   // Read initial PDF parameters.
   for (i = 0; i < kTableSize; i++) {
     self->noise_means[i] = kNoiseDataMeans[i];
@@ -604,11 +610,12 @@ int WebRtcVad_set_mode_core(VadInstT* self, int mode) {
 // Calculate VAD decision by first extracting feature values and then calculate
 // probability for both speech and background noise.
 
-int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length) {
-  int vad;
+// Resamples |frame_length| samples of |speech_frame| at 48 kHz to 8 kHz, into
+// |speech_nb|, or decimates them in one step if |inst| has the decimating
+// front end.
+static void Resample48khzTo8khz(VadInstT* inst, const int16_t* speech_frame,
+                                size_t frame_length, int16_t* speech_nb) {
   size_t i;
-  int16_t speech_nb[240];  // 30 ms in 8 kHz.
   // |tmp_mem| is a temporary memory used by resample function, length is
   // frame length in 10 ms (480 samples) + 256 extra.
   int32_t tmp_mem[480 + 256] = { 0 };
@@ -616,12 +623,26 @@ int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
   const size_t kFrameLen10ms8khz = 80;
   size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
 
+  if (inst->decimating_front_end) {
+    WebRtcVad_Decimate48khzTo8khz(speech_frame, speech_nb,
+                                  inst->decimation_filter_state, frame_length);
+    return;
+  }
+
   for (i = 0; i < num_10ms_frames; i++) {
     WebRtcSpl_Resample48khzTo8khz(speech_frame,
                                   &speech_nb[i * kFrameLen10ms8khz],
                                   &inst->state_48_to_8,
                                   tmp_mem);
   }
+}
+
+int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
+                           size_t frame_length) {
+  int vad;
+  int16_t speech_nb[240];  // 30 ms in 8 kHz.
+
+  Resample48khzTo8khz(inst, speech_frame, frame_length, speech_nb);
 
   // Do VAD on an 8 kHz signal
   vad = WebRtcVad_CalcVad8khz(inst, speech_nb, frame_length / 6);
@@ -683,3 +704,67 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
 
     return inst->vad;
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Calculates the VAD decisions of |kNumBatchLanes| instances, with the
+// features of all of them calculated together.
+static void CalcVadBatchLanes(VadInstT* const* inst, int fs,
+                              const int16_t* const* speech_frame,
+                              size_t frame_length, int* vad) {
+  int16_t feature_vector[kNumBatchLanes * kNumChannels];
+  int16_t total_power[kNumBatchLanes];
+  int16_t speech_nb[kNumBatchLanes][240];  // 30 ms in 8 kHz.
+  const int16_t* speech_nb_ptr[kNumBatchLanes];
+  int i;
+
+  if (fs == 48000) {
+    for (i = 0; i < kNumBatchLanes; i++) {
+      Resample48khzTo8khz(inst[i], speech_frame[i], frame_length,
+                          speech_nb[i]);
+      speech_nb_ptr[i] = speech_nb[i];
+    }
+    speech_frame = speech_nb_ptr;
+    frame_length /= 6;
+    fs = 8000;
+  }
+
+  // Get power in the bands
+  WebRtcVad_CalculateFeaturesBatch(inst, speech_frame, fs, frame_length,
+                                   feature_vector, total_power);
+
+  // Make a VAD, with the frame length at 8 kHz.
+  frame_length /= (size_t)(fs / 8000);
+  for (i = 0; i < kNumBatchLanes; i++) {
+    inst[i]->vad = GmmProbability(inst[i], &feature_vector[i * kNumChannels],
+                                  total_power[i], frame_length);
+    vad[i] = inst[i]->vad;
+  }
+}
+#endif
+
+void WebRtcVad_CalcVadBatch(VadInstT* const* inst, size_t num_insts, int fs,
+                            const int16_t* const* speech_frame,
+                            size_t frame_length, int* vad) {
+  size_t i = 0;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    for (; i + kNumBatchLanes <= num_insts; i += kNumBatchLanes) {
+      CalcVadBatchLanes(&inst[i], fs, &speech_frame[i], frame_length, &vad[i]);
+    }
+  }
+#endif
+
+  // The remaining instances, one at a time.
+  for (; i < num_insts; i++) {
+    if (fs == 48000) {
+      vad[i] = WebRtcVad_CalcVad48khz(inst[i], speech_frame[i], frame_length);
+    } else if (fs == 32000) {
+      vad[i] = WebRtcVad_CalcVad32khz(inst[i], speech_frame[i], frame_length);
+    } else if (fs == 16000) {
+      vad[i] = WebRtcVad_CalcVad16khz(inst[i], speech_frame[i], frame_length);
+    } else {
+      vad[i] = WebRtcVad_CalcVad8khz(inst[i], speech_frame[i], frame_length);
+    }
+  }
+}
@@ -21,11 +21,17 @@ enum { kNumChannels = 6 };   // Number of frequency bands (named channels).
 enum { kNumGaussians = 2 };  // Number of Gaussians per channel in the GMM.
 enum { kTableSize = kNumChannels * kNumGaussians };
 enum { kMinEnergy = 10 };  // Minimum energy required to trigger audio signal.
+// Number of past 48 kHz samples kept by the decimating front end.
+enum { kDecimationFilterStateLength = 71 };
 
 typedef struct VadInstT_ {
   int vad;
   int32_t downsampling_filter_states[4];
   WebRtcSpl_State48khzTo8khz state_48_to_8;
+  // Nonzero if 48 kHz input is decimated to 8 kHz in one step, see
+  // WebRtcVad_Decimate48khzTo8khz().
+  int decimating_front_end;
+  int16_t decimation_filter_state[kDecimationFilterStateLength];
   int16_t noise_means[kTableSize];
   int16_t speech_means[kTableSize];
   int16_t noise_stds[kTableSize];
@@ -111,4 +117,31 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst,
                           const int16_t* speech_frame,
                           size_t frame_length);
 
+/****************************************************************************
+ * WebRtcVad_CalcVadBatch(...)
+ *
+ * Calculate probability for active speech and make VAD decisions for several
+ * instances, with one frame each. Equal to calling WebRtcVad_CalcVad48khz(),
+ * WebRtcVad_CalcVad32khz(), WebRtcVad_CalcVad16khz() or
+ * WebRtcVad_CalcVad8khz() for every instance, but the features of several
+ * instances are calculated together where SIMD is available.
+ *
+ * Input:
+ *      - inst          : Instances, |num_insts| of them
+ *      - fs            : Sampling frequency (Hz): 8000, 16000, 32000 or 48000
+ *      - speech_frame  : Input speech frames, one per instance
+ *      - frame_length  : Number of input samples per frame
+ *
+ * Output:
+ *      - inst          : Updated filter states etc.
+ *      - vad           : VAD decision per instance, as returned by
+ *                        WebRtcVad_CalcVad8khz()
+ */
+void WebRtcVad_CalcVadBatch(VadInstT* const* inst,
+                            size_t num_insts,
+                            int fs,
+                            const int16_t* const* speech_frame,
+                            size_t frame_length,
+                            int* vad);
+
 #endif  // COMMON_AUDIO_VAD_VAD_CORE_H_
@@ -138,32 +138,18 @@ static void SplitFilter(const int16_t* data_in, size_t data_length,
   }
 }
 
-// Calculates the energy of |data_in| in dB, and also updates an overall
-// |total_energy| if necessary.
+// The part of LogOfEnergy() after the energy calculation.
 //
-// - data_in      [i]   : Input audio data for energy calculation.
-// - data_length  [i]   : Length of input data.
+// - energy       [i]   : Energy of the input audio data, as returned by
+//                        WebRtcSpl_Energy().
+// - tot_rshifts  [i]   : Scaling of |energy|, as returned by
+//                        WebRtcSpl_Energy().
 // - offset       [i]   : Offset value added to |log_energy|.
-// - total_energy [i/o] : An external energy updated with the energy of
-//                        |data_in|.
-//                        NOTE: |total_energy| is only updated if
-//                        |total_energy| <= |kMinEnergy|.
+// - total_energy [i/o] : See LogOfEnergy().
 // - log_energy   [o]   : 10 * log10("energy of |data_in|") given in Q4.
-static void LogOfEnergy(const int16_t* data_in, size_t data_length,
-                        int16_t offset, int16_t* total_energy,
-                        int16_t* log_energy) {
-  // |tot_rshifts| accumulates the number of right shifts performed on |energy|.
-  int tot_rshifts = 0;
-  // The |energy| will be normalized to 15 bits. We use unsigned integer because
-  // we eventually will mask out the fractional part.
-  uint32_t energy = 0;
-
-  RTC_DCHECK(data_in);
-  RTC_DCHECK_GT(data_length, 0);
-
-  energy = (uint32_t) WebRtcSpl_Energy((int16_t*) data_in, data_length,
-                                       &tot_rshifts);
-
+static void EnergyToLogOfEnergy(uint32_t energy, int tot_rshifts,
+                                int16_t offset, int16_t* total_energy,
+                                int16_t* log_energy) {
   if (energy != 0) {
     // By construction, normalizing to 15 bits is equivalent with 17 leading
     // zeros of an unsigned 32 bit value.
@@ -240,6 +226,34 @@ static void LogOfEnergy(const int16_t* data_in, size_t data_length,
   }
 }
 
+// Calculates the energy of |data_in| in dB, and also updates an overall
+// |total_energy| if necessary.
+//
+// - data_in      [i]   : Input audio data for energy calculation.
+// - data_length  [i]   : Length of input data.
+// - offset       [i]   : Offset value added to |log_energy|.
+// - total_energy [i/o] : An external energy updated with the energy of
+//                        |data_in|.
+//                        NOTE: |total_energy| is only updated if
+//                        |total_energy| <= |kMinEnergy|.
+// - log_energy   [o]   : 10 * log10("energy of |data_in|") given in Q4.
+static void LogOfEnergy(const int16_t* data_in, size_t data_length,
+                        int16_t offset, int16_t* total_energy,
+                        int16_t* log_energy) {
+  // |tot_rshifts| accumulates the number of right shifts performed on |energy|.
+  int tot_rshifts = 0;
+  // The |energy| will be normalized to 15 bits. We use unsigned integer because
+  // we eventually will mask out the fractional part.
+  uint32_t energy = 0;
+
+  RTC_DCHECK(data_in);
+  RTC_DCHECK_GT(data_length, 0);
+
+  energy = (uint32_t) WebRtcSpl_Energy((int16_t*) data_in, data_length,
+                                       &tot_rshifts);
+  EnergyToLogOfEnergy(energy, tot_rshifts, offset, total_energy, log_energy);
+}
+
 int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
                                     size_t data_length, int16_t* features) {
   int16_t total_energy = 0;
@@ -327,3 +341,31 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
 
   return total_energy;
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* self,
+                                      const int16_t* const* data_in,
+                                      int fs,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energy) {
+  uint32_t energy[kNumChannels * kNumBatchLanes];
+  int energy_rshifts[kNumChannels * kNumBatchLanes];
+  int i, channel;
+
+  WebRtcVad_CalculateBandEnergiesSSE2(self, data_in, fs, data_length, energy,
+                                      energy_rshifts);
+
+  // The bands in the order of WebRtcVad_CalculateFeatures(), which updates
+  // |total_energy| until it exceeds |kMinEnergy|.
+  for (i = 0; i < kNumBatchLanes; i++) {
+    total_energy[i] = 0;
+    for (channel = kNumChannels - 1; channel >= 0; channel--) {
+      const int index = channel * kNumBatchLanes + i;
+      EnergyToLogOfEnergy(energy[index], energy_rshifts[index],
+                          kOffsetVector[channel], &total_energy[i],
+                          &features[i * kNumChannels + channel]);
+    }
+  }
+}
+#endif
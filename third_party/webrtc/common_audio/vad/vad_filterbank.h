@@ -16,6 +16,7 @@
 #define COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
 
 #include "common_audio/vad/vad_core.h"
+#include "rtc_base/system/arch.h"
 
 // Takes |data_length| samples of |data_in| and calculates the logarithm of the
 // energy of each of the |kNumChannels| = 6 frequency bands used by the VAD:
@@ -42,4 +43,42 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self,
                                     size_t data_length,
                                     int16_t* features);
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Number of VAD instances whose features are calculated together by
+// WebRtcVad_CalculateFeaturesBatch(), one per 16-bit SIMD lane.
+enum { kNumBatchLanes = 8 };
+
+// Calculates the features of |kNumBatchLanes| VAD instances together, bit
+// exact with WebRtcVad_CalculateFeatures() for each of them. Frames at 16 and
+// 32 kHz are downsampled to 8 kHz first, as in WebRtcVad_CalcVad16khz() and
+// WebRtcVad_CalcVad32khz(). Requires SSE2.
+//
+// - self         [i/o] : State information of the |kNumBatchLanes| VADs.
+// - data_in      [i]   : One audio frame per VAD.
+// - fs           [i]   : Sampling frequency of the frames (Hz): 8000, 16000
+//                        or 32000.
+// - data_length  [i]   : Frame size, in number of samples.
+// - features     [o]   : |kNumChannels| features per VAD, as in
+//                        WebRtcVad_CalculateFeatures().
+// - total_energy [o]   : Total energy of the signal per VAD, as returned by
+//                        WebRtcVad_CalculateFeatures().
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* self,
+                                      const int16_t* const* data_in,
+                                      int fs,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energy);
+
+// Runs the filter bank of the VADs in |self| and calculates the energy of
+// every band with WebRtcSpl_Energy(). The energy of |channel| of VAD |i| is
+// written to |energy|[|channel| * |kNumBatchLanes| + |i|], and its scaling to
+// |energy_rshifts| at the same index.
+void WebRtcVad_CalculateBandEnergiesSSE2(VadInstT* const* self,
+                                         const int16_t* const* data_in,
+                                         int fs,
+                                         size_t data_length,
+                                         uint32_t* energy,
+                                         int* energy_rshifts);
+#endif
+
 #endif  // COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
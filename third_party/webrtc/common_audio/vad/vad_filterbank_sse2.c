@@ -0,0 +1,427 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 version of the filter bank of WebRtcVad_CalculateFeatures(), for
+// |kNumBatchLanes| VAD instances at a time. The signals are stored with the
+// samples of all instances next to each other, so that the 16-bit lanes of a
+// register hold the same sample of each instance. The filters then run in
+// parallel over the instances, with the operations of the C code in
+// vad_filterbank.c and vad_sp.c, and the results are bit exact.
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/vad/vad_filterbank.h"
+#include "rtc_base/checks.h"
+
+// 30 ms at 32 kHz.
+enum { kMaxFrameLength = 960 };
+
+// Coefficients of HighPassFilter() in vad_filterbank.c, Q14.
+static const int16_t kHpZeroCoefs[3] = { 6631, -13262, 6631 };
+static const int16_t kHpPoleCoefs[3] = { 16384, -7756, 5620 };
+
+// Allpass filter coefficients of SplitFilter() in vad_filterbank.c, Q15.
+static const int16_t kAllPassCoefsQ15[2] = { 20972, 5571 };
+
+// Allpass filter coefficients of WebRtcVad_Downsampling() in vad_sp.c, Q13.
+static const int16_t kAllPassCoefsQ13[2] = { 5243, 1392 };
+
+// Multiplies the 16-bit lanes of |a| and |b| into 32-bit products, lanes 0 to
+// 3 in |low| and lanes 4 to 7 in |high|.
+static __inline void MulW16(__m128i a,
+                            __m128i b,
+                            __m128i* low,
+                            __m128i* high) {
+  const __m128i product_low = _mm_mullo_epi16(a, b);
+  const __m128i product_high = _mm_mulhi_epi16(a, b);
+  *low = _mm_unpacklo_epi16(product_low, product_high);
+  *high = _mm_unpackhi_epi16(product_low, product_high);
+}
+
+// Casts the 32-bit lanes of |low| and |high| to 16 bits, with the wrap around
+// of a cast to int16_t.
+static __inline __m128i CastW32ToW16(__m128i low, __m128i high) {
+  low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+  high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+  return _mm_packs_epi32(low, high);
+}
+
+// Sign extends the 16-bit lanes of |a| to 32 bits.
+static __inline void ExtendW16(__m128i a, __m128i* low, __m128i* high) {
+  *low = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+  *high = _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+}
+
+// Loads one 16-bit state of every instance into the lanes of a register.
+#define LOAD_STATES(self, state)                                           \
+  _mm_set_epi16((self)[7]->state, (self)[6]->state, (self)[5]->state,      \
+                (self)[4]->state, (self)[3]->state, (self)[2]->state,      \
+                (self)[1]->state, (self)[0]->state)
+
+// Stores the lanes of |a| to one 16-bit state of every instance.
+static __inline void StoreStates(__m128i a, int16_t* const* states) {
+  int16_t lanes[kNumBatchLanes];
+  int i;
+
+  _mm_storeu_si128((__m128i*)lanes, a);
+  for (i = 0; i < kNumBatchLanes; i++) {
+    *states[i] = lanes[i];
+  }
+}
+
+// Interleaves |data_length| samples of the frames in |data_in|, which has to
+// be a multiple of 8, to |data_out|.
+static void Interleave(const int16_t* const* data_in,
+                       size_t data_length,
+                       __m128i* data_out) {
+  size_t n;
+
+  RTC_DCHECK_EQ(0, data_length % 8);
+  for (n = 0; n < data_length; n += 8) {
+    const __m128i a0 = _mm_loadu_si128((const __m128i*)&data_in[0][n]);
+    const __m128i a1 = _mm_loadu_si128((const __m128i*)&data_in[1][n]);
+    const __m128i a2 = _mm_loadu_si128((const __m128i*)&data_in[2][n]);
+    const __m128i a3 = _mm_loadu_si128((const __m128i*)&data_in[3][n]);
+    const __m128i a4 = _mm_loadu_si128((const __m128i*)&data_in[4][n]);
+    const __m128i a5 = _mm_loadu_si128((const __m128i*)&data_in[5][n]);
+    const __m128i a6 = _mm_loadu_si128((const __m128i*)&data_in[6][n]);
+    const __m128i a7 = _mm_loadu_si128((const __m128i*)&data_in[7][n]);
+    const __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    const __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    const __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    const __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+    const __m128i b4 = _mm_unpacklo_epi16(a4, a5);
+    const __m128i b5 = _mm_unpackhi_epi16(a4, a5);
+    const __m128i b6 = _mm_unpacklo_epi16(a6, a7);
+    const __m128i b7 = _mm_unpackhi_epi16(a6, a7);
+    const __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    const __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    const __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    const __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    const __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    const __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    const __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    const __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+    data_out[n] = _mm_unpacklo_epi64(c0, c4);
+    data_out[n + 1] = _mm_unpackhi_epi64(c0, c4);
+    data_out[n + 2] = _mm_unpacklo_epi64(c1, c5);
+    data_out[n + 3] = _mm_unpackhi_epi64(c1, c5);
+    data_out[n + 4] = _mm_unpacklo_epi64(c2, c6);
+    data_out[n + 5] = _mm_unpackhi_epi64(c2, c6);
+    data_out[n + 6] = _mm_unpacklo_epi64(c3, c7);
+    data_out[n + 7] = _mm_unpackhi_epi64(c3, c7);
+  }
+}
+
+// One all-pass branch of WebRtcVad_Downsampling(). Returns the output for the
+// input |x|, and updates the 32-bit states in |state_low| and |state_high|.
+static __inline __m128i DownsamplingBranch(__m128i x,
+                                           __m128i coefficient,
+                                           __m128i* state_low,
+                                           __m128i* state_high) {
+  __m128i low, high, x_low, x_high, out;
+
+  MulW16(coefficient, x, &low, &high);
+  low = _mm_add_epi32(_mm_srai_epi32(*state_low, 1), _mm_srai_epi32(low, 14));
+  high = _mm_add_epi32(_mm_srai_epi32(*state_high, 1),
+                       _mm_srai_epi32(high, 14));
+  out = CastW32ToW16(low, high);
+  MulW16(coefficient, out, &low, &high);
+  ExtendW16(x, &x_low, &x_high);
+  *state_low = _mm_sub_epi32(x_low, _mm_srai_epi32(low, 12));
+  *state_high = _mm_sub_epi32(x_high, _mm_srai_epi32(high, 12));
+  return out;
+}
+
+// WebRtcVad_Downsampling() of the interleaved |signal|, in place, with the
+// filter states from |filter_state_index| on in the instances.
+static void Downsampling(VadInstT* const* self,
+                         int filter_state_index,
+                         __m128i* signal,
+                         size_t in_length) {
+  const __m128i coefficient_upper = _mm_set1_epi16(kAllPassCoefsQ13[0]);
+  const __m128i coefficient_lower = _mm_set1_epi16(kAllPassCoefsQ13[1]);
+  int32_t states[2][kNumBatchLanes];
+  __m128i upper_low, upper_high, lower_low, lower_high;
+  size_t n;
+  int i;
+
+  for (i = 0; i < kNumBatchLanes; i++) {
+    states[0][i] = self[i]->downsampling_filter_states[filter_state_index];
+    states[1][i] = self[i]->downsampling_filter_states[filter_state_index + 1];
+  }
+  upper_low = _mm_loadu_si128((const __m128i*)&states[0][0]);
+  upper_high = _mm_loadu_si128((const __m128i*)&states[0][4]);
+  lower_low = _mm_loadu_si128((const __m128i*)&states[1][0]);
+  lower_high = _mm_loadu_si128((const __m128i*)&states[1][4]);
+
+  for (n = 0; n < in_length / 2; n++) {
+    const __m128i upper = DownsamplingBranch(
+        signal[2 * n], coefficient_upper, &upper_low, &upper_high);
+    const __m128i lower = DownsamplingBranch(
+        signal[2 * n + 1], coefficient_lower, &lower_low, &lower_high);
+    signal[n] = _mm_add_epi16(upper, lower);
+  }
+
+  _mm_storeu_si128((__m128i*)&states[0][0], upper_low);
+  _mm_storeu_si128((__m128i*)&states[0][4], upper_high);
+  _mm_storeu_si128((__m128i*)&states[1][0], lower_low);
+  _mm_storeu_si128((__m128i*)&states[1][4], lower_high);
+  for (i = 0; i < kNumBatchLanes; i++) {
+    self[i]->downsampling_filter_states[filter_state_index] = states[0][i];
+    self[i]->downsampling_filter_states[filter_state_index + 1] =
+        states[1][i];
+  }
+}
+
+// One sample of AllPassFilter() in vad_filterbank.c. Returns the output for
+// the input |x|, and updates the Q15 states in |state_low| and |state_high|.
+static __inline __m128i AllPassStep(__m128i x,
+                                    __m128i coefficient,
+                                    __m128i* state_low,
+                                    __m128i* state_high) {
+  __m128i low, high, out;
+
+  MulW16(coefficient, x, &low, &high);
+  low = _mm_add_epi32(*state_low, low);
+  high = _mm_add_epi32(*state_high, high);
+  // The 32-bit values shifted by 16 fit in 16 bits.
+  out = _mm_packs_epi32(_mm_srai_epi32(low, 16), _mm_srai_epi32(high, 16));
+  MulW16(coefficient, out, &low, &high);
+  // |x| in Q14, from its high and low bits.
+  *state_low = _mm_unpacklo_epi16(_mm_slli_epi16(x, 14), _mm_srai_epi16(x, 2));
+  *state_high =
+      _mm_unpackhi_epi16(_mm_slli_epi16(x, 14), _mm_srai_epi16(x, 2));
+  *state_low = _mm_slli_epi32(_mm_sub_epi32(*state_low, low), 1);
+  *state_high = _mm_slli_epi32(_mm_sub_epi32(*state_high, high), 1);
+  return out;
+}
+
+// SplitFilter() in vad_filterbank.c, with the filter states of
+// |frequency_band| in the instances.
+static void SplitFilter(VadInstT* const* self,
+                        int frequency_band,
+                        const __m128i* data_in,
+                        size_t data_length,
+                        __m128i* hp_data_out,
+                        __m128i* lp_data_out) {
+  const __m128i coefficient_upper = _mm_set1_epi16(kAllPassCoefsQ15[0]);
+  const __m128i coefficient_lower = _mm_set1_epi16(kAllPassCoefsQ15[1]);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i upper_state = LOAD_STATES(self, upper_state[frequency_band]);
+  const __m128i lower_state = LOAD_STATES(self, lower_state[frequency_band]);
+  // The states in Q15.
+  __m128i upper_low = _mm_unpacklo_epi16(zero, upper_state);
+  __m128i upper_high = _mm_unpackhi_epi16(zero, upper_state);
+  __m128i lower_low = _mm_unpacklo_epi16(zero, lower_state);
+  __m128i lower_high = _mm_unpackhi_epi16(zero, lower_state);
+  int16_t* states[kNumBatchLanes];
+  size_t i;
+  int k;
+
+  for (i = 0; i < data_length / 2; i++) {
+    const __m128i hp = AllPassStep(data_in[2 * i], coefficient_upper,
+                                   &upper_low, &upper_high);
+    const __m128i lp = AllPassStep(data_in[2 * i + 1], coefficient_lower,
+                                   &lower_low, &lower_high);
+    hp_data_out[i] = _mm_sub_epi16(hp, lp);
+    lp_data_out[i] = _mm_add_epi16(lp, hp);
+  }
+
+  for (k = 0; k < kNumBatchLanes; k++) {
+    states[k] = &self[k]->upper_state[frequency_band];
+  }
+  StoreStates(_mm_packs_epi32(_mm_srai_epi32(upper_low, 16),
+                              _mm_srai_epi32(upper_high, 16)),
+              states);
+  for (k = 0; k < kNumBatchLanes; k++) {
+    states[k] = &self[k]->lower_state[frequency_band];
+  }
+  StoreStates(_mm_packs_epi32(_mm_srai_epi32(lower_low, 16),
+                              _mm_srai_epi32(lower_high, 16)),
+              states);
+}
+
+// HighPassFilter() in vad_filterbank.c.
+static void HighPassFilter(VadInstT* const* self,
+                           const __m128i* data_in,
+                           size_t data_length,
+                           __m128i* data_out) {
+  // The coefficients of the sample pairs (x, state[0]), (state[1], state[2])
+  // and (state[3], 0), for _mm_madd_epi16().
+  const __m128i coefficients0 = _mm_set_epi16(
+      kHpZeroCoefs[1], kHpZeroCoefs[0], kHpZeroCoefs[1], kHpZeroCoefs[0],
+      kHpZeroCoefs[1], kHpZeroCoefs[0], kHpZeroCoefs[1], kHpZeroCoefs[0]);
+  const __m128i coefficients1 = _mm_set_epi16(
+      -kHpPoleCoefs[1], kHpZeroCoefs[2], -kHpPoleCoefs[1], kHpZeroCoefs[2],
+      -kHpPoleCoefs[1], kHpZeroCoefs[2], -kHpPoleCoefs[1], kHpZeroCoefs[2]);
+  const __m128i coefficients2 = _mm_set_epi16(
+      0, -kHpPoleCoefs[2], 0, -kHpPoleCoefs[2],
+      0, -kHpPoleCoefs[2], 0, -kHpPoleCoefs[2]);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i state0 = LOAD_STATES(self, hp_filter_state[0]);
+  __m128i state1 = LOAD_STATES(self, hp_filter_state[1]);
+  __m128i state2 = LOAD_STATES(self, hp_filter_state[2]);
+  __m128i state3 = LOAD_STATES(self, hp_filter_state[3]);
+  int16_t* states[kNumBatchLanes];
+  size_t i;
+  int k;
+
+  for (i = 0; i < data_length; i++) {
+    const __m128i x = data_in[i];
+    __m128i low = _mm_add_epi32(
+        _mm_add_epi32(
+            _mm_madd_epi16(_mm_unpacklo_epi16(x, state0), coefficients0),
+            _mm_madd_epi16(_mm_unpacklo_epi16(state1, state2),
+                           coefficients1)),
+        _mm_madd_epi16(_mm_unpacklo_epi16(state3, zero), coefficients2));
+    __m128i high = _mm_add_epi32(
+        _mm_add_epi32(
+            _mm_madd_epi16(_mm_unpackhi_epi16(x, state0), coefficients0),
+            _mm_madd_epi16(_mm_unpackhi_epi16(state1, state2),
+                           coefficients1)),
+        _mm_madd_epi16(_mm_unpackhi_epi16(state3, zero), coefficients2));
+    state1 = state0;
+    state0 = x;
+    state3 = state2;
+    state2 = CastW32ToW16(_mm_srai_epi32(low, 14), _mm_srai_epi32(high, 14));
+    data_out[i] = state2;
+  }
+
+  for (k = 0; k < kNumBatchLanes; k++) {
+    states[k] = &self[k]->hp_filter_state[0];
+  }
+  StoreStates(state0, states);
+  for (k = 0; k < kNumBatchLanes; k++) {
+    states[k] = &self[k]->hp_filter_state[1];
+  }
+  StoreStates(state1, states);
+  for (k = 0; k < kNumBatchLanes; k++) {
+    states[k] = &self[k]->hp_filter_state[2];
+  }
+  StoreStates(state2, states);
+  for (k = 0; k < kNumBatchLanes; k++) {
+    states[k] = &self[k]->hp_filter_state[3];
+  }
+  StoreStates(state3, states);
+}
+
+// WebRtcSpl_Energy() of every lane of |data_in|. The energies of |channel| are
+// written to |energy| and |energy_rshifts|, from index
+// |channel| * |kNumBatchLanes| on.
+static void Energy(const __m128i* data_in,
+                   size_t data_length,
+                   int channel,
+                   uint32_t* energy,
+                   int* energy_rshifts) {
+  const int nbits = WebRtcSpl_GetSizeInBits((uint32_t)data_length);
+  __m128i max_abs = _mm_set1_epi16(-1);
+  int16_t max_abs_lanes[kNumBatchLanes];
+  int scaling = 0;
+  size_t n;
+  int i;
+
+  energy += channel * kNumBatchLanes;
+  energy_rshifts += channel * kNumBatchLanes;
+
+  // The scaling of WebRtcSpl_GetScalingSquare(), where the absolute value of
+  // -32768 wraps around as well.
+  for (n = 0; n < data_length; n++) {
+    const __m128i x = data_in[n];
+    max_abs = _mm_max_epi16(
+        max_abs, _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x)));
+  }
+  _mm_storeu_si128((__m128i*)max_abs_lanes, max_abs);
+  for (i = 0; i < kNumBatchLanes; i++) {
+    const int16_t smax = max_abs_lanes[i];
+    const int t = WebRtcSpl_NormW32(WEBRTC_SPL_MUL(smax, smax));
+    energy_rshifts[i] = (smax == 0 || t > nbits) ? 0 : nbits - t;
+    scaling |= energy_rshifts[i];
+  }
+
+  if (scaling == 0) {
+    __m128i sum_low = _mm_setzero_si128();
+    __m128i sum_high = _mm_setzero_si128();
+    for (n = 0; n < data_length; n++) {
+      __m128i low, high;
+      MulW16(data_in[n], data_in[n], &low, &high);
+      sum_low = _mm_add_epi32(sum_low, low);
+      sum_high = _mm_add_epi32(sum_high, high);
+    }
+    _mm_storeu_si128((__m128i*)&energy[0], sum_low);
+    _mm_storeu_si128((__m128i*)&energy[4], sum_high);
+  } else {
+    // Loud signals, with a different scaling for every lane.
+    for (i = 0; i < kNumBatchLanes; i++) {
+      const int16_t* x = (const int16_t*)data_in + i;
+      int32_t en = 0;
+      for (n = 0; n < data_length; n++) {
+        en += (x[n * kNumBatchLanes] * x[n * kNumBatchLanes]) >>
+            energy_rshifts[i];
+      }
+      energy[i] = (uint32_t)en;
+    }
+  }
+}
+
+void WebRtcVad_CalculateBandEnergiesSSE2(VadInstT* const* self,
+                                         const int16_t* const* data_in,
+                                         int fs,
+                                         size_t data_length,
+                                         uint32_t* energy,
+                                         int* energy_rshifts) {
+  // The input frames, downsampled to 8 kHz in place.
+  __m128i data[kMaxFrameLength];
+  __m128i hp_120[120], lp_120[120];
+  __m128i hp_60[60], lp_60[60];
+  size_t half_data_length;
+  size_t length;
+
+  RTC_DCHECK(fs == 8000 || fs == 16000 || fs == 32000);
+  RTC_DCHECK_LE(data_length, kMaxFrameLength);
+
+  Interleave(data_in, data_length, data);
+  if (fs == 32000) {
+    Downsampling(self, 2, data, data_length);
+    data_length /= 2;
+  }
+  if (fs >= 16000) {
+    Downsampling(self, 0, data, data_length);
+    data_length /= 2;
+  }
+  RTC_DCHECK_LE(data_length, 240);
+  half_data_length = data_length >> 1;
+  length = half_data_length;
+
+  // The bands of WebRtcVad_CalculateFeatures(), with the same buffers.
+  SplitFilter(self, 0, data, data_length, hp_120, lp_120);
+
+  SplitFilter(self, 1, hp_120, length, hp_60, lp_60);
+  length >>= 1;
+  Energy(hp_60, length, 5, energy, energy_rshifts);
+  Energy(lp_60, length, 4, energy, energy_rshifts);
+
+  length = half_data_length;
+  SplitFilter(self, 2, lp_120, length, hp_60, lp_60);
+  length >>= 1;
+  Energy(hp_60, length, 3, energy, energy_rshifts);
+
+  SplitFilter(self, 3, lp_60, length, hp_120, lp_120);
+  length >>= 1;
+  Energy(hp_120, length, 2, energy, energy_rshifts);
+
+  SplitFilter(self, 4, lp_120, length, hp_60, lp_60);
+  length >>= 1;
+  Energy(hp_60, length, 1, energy, energy_rshifts);
+
+  HighPassFilter(self, lp_60, length, hp_120);
+  Energy(hp_120, length, 0, energy, energy_rshifts);
+}
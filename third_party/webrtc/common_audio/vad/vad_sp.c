@@ -10,6 +10,8 @@
 
 #include "common_audio/vad/vad_sp.h"
 
+#include <string.h>
+
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "common_audio/vad/vad_core.h"
@@ -20,6 +22,17 @@ static const int16_t kAllPassCoefsQ13[2] = { 5243, 1392 };  // Q13.
 static const int16_t kSmoothingDown = 6553;  // 0.2 in Q15.
 static const int16_t kSmoothingUp = 32439;  // 0.99 in Q15.
 
+// Low-pass filter of WebRtcVad_Decimate48khzTo8khz(), Kaiser windowed sinc
+// with the cutoff at 4 kHz, in Q12. The stop band, from 5 kHz, is 45 dB down.
+static const int16_t kDecimationCoefsQ12[72] = {
+    -1,   -2,   -3,   -4,   -4,   -2,    2,    7,   11,   13,   11,    5,
+    -5,  -17,  -26,  -30,  -25,  -10,   12,   36,   55,   62,   51,   21,
+   -24,  -74, -115, -132, -112,  -49,   59,  199,  353,  499,  613,  674,
+   674,  613,  499,  353,  199,   59,  -49, -112, -132, -115,  -74,  -24,
+    21,   51,   62,   55,   36,   12,  -10,  -25,  -30,  -26,  -17,   -5,
+     5,   11,   13,   11,    7,    2,   -2,   -4,   -4,   -3,   -2,   -1 };
+static const int kDecimationFactor = 6;
+
 // TODO(bjornv): Move this function to vad_filterbank.c.
 // Downsampling filter based on splitting filter and allpass functions.
 void WebRtcVad_Downsampling(const int16_t* signal_in,
@@ -52,6 +65,35 @@ void WebRtcVad_Downsampling(const int16_t* signal_in,
   filter_state[1] = tmp32_2;
 }
 
+void WebRtcVad_Decimate48khzTo8khz(const int16_t* signal_in,
+                                   int16_t* signal_out,
+                                   int16_t* filter_state,
+                                   size_t in_length) {
+  // The filter state followed by up to 30 ms of input.
+  int16_t signal[kDecimationFilterStateLength + 1440];
+
+  RTC_DCHECK_GE(in_length, kDecimationFilterStateLength);
+  RTC_DCHECK_LE(in_length, 1440);
+
+  memcpy(signal, filter_state,
+         sizeof(signal[0]) * kDecimationFilterStateLength);
+  memcpy(&signal[kDecimationFilterStateLength], signal_in,
+         sizeof(signal[0]) * in_length);
+
+  // Each output sample is filtered from the input samples up to the last one
+  // of its |kDecimationFactor| input samples.
+  WebRtcSpl_DownsampleFast(
+      &signal[kDecimationFilterStateLength + kDecimationFactor - 1],
+      in_length - kDecimationFactor + 1, signal_out,
+      in_length / kDecimationFactor, kDecimationCoefsQ12,
+      sizeof(kDecimationCoefsQ12) / sizeof(kDecimationCoefsQ12[0]),
+      kDecimationFactor, 0);
+
+  // Store the filter state.
+  memcpy(filter_state, &signal[in_length],
+         sizeof(signal[0]) * kDecimationFilterStateLength);
+}
+
 // Inserts |feature_value| into |low_value_vector|, if it is one of the 16
 // smallest values the last 100 frames. Then calculates and returns the median
 // of the five smallest values.
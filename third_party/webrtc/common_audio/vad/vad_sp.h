@@ -33,6 +33,27 @@ void WebRtcVad_Downsampling(const int16_t* signal_in,
                             int32_t* filter_state,
                             size_t in_length);
 
+// Decimates the signal from 48 kHz to 8 kHz in one step, with a low-pass FIR
+// filter that is only evaluated at the output samples. The filter passes up to
+// 3 kHz and is 6 dB down at 4 kHz. Used instead of
+// WebRtcSpl_Resample48khzTo8khz() when |decimating_front_end| is set.
+//
+// Inputs:
+//      - signal_in     : Input signal.
+//      - in_length     : Length of input signal in samples, 480, 960 or 1440.
+//
+// Input & Output:
+//      - filter_state  : The last |kDecimationFilterStateLength| input
+//                        samples, updated after all samples have been
+//                        processed.
+//
+// Output:
+//      - signal_out    : Decimated signal (of length |in_length| / 6).
+void WebRtcVad_Decimate48khzTo8khz(const int16_t* signal_in,
+                                   int16_t* signal_out,
+                                   int16_t* filter_state,
+                                   size_t in_length);
+
 // Updates and returns the smoothed feature minimum. As minimum we use the
 // median of the five smallest feature values in a 100 frames long window.
 // As long as |handle->frame_counter| is zero, that is, we haven't received any
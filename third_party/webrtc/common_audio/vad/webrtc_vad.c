@@ -54,6 +54,28 @@ int WebRtcVad_set_mode(VadInst* handle, int mode) {
   return WebRtcVad_set_mode_core(self, mode);
 }
 
+int WebRtcVad_set_decimating_front_end(VadInst* handle, int enable) {
+  VadInstT* self = (VadInstT*) handle;
+
+  if (handle == NULL) {
+    return -1;
+  }
+  if (self->init_flag != kInitCheck) {
+    return -1;
+  }
+  if (enable != 0 && enable != 1) {
+    return -1;
+  }
+
+  if (self->decimating_front_end != enable) {
+    // Start from silence, as after WebRtcVad_Init().
+    memset(self->decimation_filter_state, 0,
+           sizeof(self->decimation_filter_state));
+    self->decimating_front_end = enable;
+  }
+  return 0;
+}
+
 int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
                       size_t frame_length) {
   int vad = -1;
@@ -89,6 +111,38 @@ int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
   return vad;
 }
 
+int WebRtcVad_ProcessBatch(VadInst* const* handles, size_t num_handles,
+                           int fs, const int16_t* const* audio_frames,
+                           size_t frame_length, int* decisions) {
+  size_t i;
+
+  if (handles == NULL || audio_frames == NULL || decisions == NULL) {
+    return -1;
+  }
+  if (WebRtcVad_ValidRateAndFrameLength(fs, frame_length) != 0) {
+    return -1;
+  }
+  for (i = 0; i < num_handles; i++) {
+    const VadInstT* self = (const VadInstT*) handles[i];
+    if (self == NULL || self->init_flag != kInitCheck) {
+      return -1;
+    }
+    if (audio_frames[i] == NULL) {
+      return -1;
+    }
+  }
+
+  WebRtcVad_CalcVadBatch((VadInstT* const*) handles, num_handles, fs,
+                         audio_frames, frame_length, decisions);
+
+  for (i = 0; i < num_handles; i++) {
+    if (decisions[i] > 0) {
+      decisions[i] = 1;
+    }
+  }
+  return 0;
+}
+
 int WebRtcVad_ValidRateAndFrameLength(int rate, size_t frame_length) {
   int return_value = -1;
   size_t i;
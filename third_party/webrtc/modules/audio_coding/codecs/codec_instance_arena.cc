@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/codec_instance_arena.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+size_t StateBytes(CodecInstanceArena::Codec codec) {
+  int bytes = 0;
+  int16_t words = 0;
+  int16_t address = 0;
+  switch (codec) {
+    case CodecInstanceArena::kIlbcEncoder: {
+      // The iLBC functions only return the size when given an address.
+      IlbcEncoderInstance* inst;
+      WebRtcIlbcfix_EncoderAssign(&inst, &address, &words);
+      return words * sizeof(int16_t);
+    }
+    case CodecInstanceArena::kIlbcDecoder: {
+      IlbcDecoderInstance* inst;
+      WebRtcIlbcfix_DecoderAssign(&inst, &address, &words);
+      return words * sizeof(int16_t);
+    }
+    case CodecInstanceArena::kIsac:
+      WebRtcIsac_AssignSize(&bytes);
+      return bytes;
+    case CodecInstanceArena::kIsacFix:
+      WebRtcIsacfix_AssignSize(&bytes);
+      return bytes;
+    case CodecInstanceArena::kG722Encoder:
+      WebRtcG722_EncoderAssignSize(&bytes);
+      return bytes;
+    case CodecInstanceArena::kG722Decoder:
+      WebRtcG722_DecoderAssignSize(&bytes);
+      return bytes;
+    case CodecInstanceArena::kNumCodecs:
+      break;
+  }
+  RTC_NOTREACHED();
+  return 0;
+}
+
+}  // namespace
+
+const size_t CodecInstanceArena::kCacheLineBytes;
+const size_t CodecInstanceArena::kDefaultSlabBytes;
+
+CodecInstanceArena::CodecInstanceArena(size_t slab_bytes) {
+  for (int i = 0; i < kNumCodecs; ++i) {
+    Pool& pool = pools_[i];
+    pool.state_bytes = StateBytes(static_cast<Codec>(i));
+    pool.slot_bytes = (pool.state_bytes + kCacheLineBytes - 1) &
+                      ~(kCacheLineBytes - 1);
+    pool.slots_per_slab = std::max<size_t>(slab_bytes / pool.slot_bytes, 1);
+  }
+  // Done by the Create functions of the codecs, but not by their Assign
+  // functions.
+  WebRtcSpl_Init();
+}
+
+CodecInstanceArena::~CodecInstanceArena() {
+  // The slabs go with the arena, but live iSAC-fix instances may also hold the
+  // memory of WebRtcIsacfix_CreateInternal(). The slots that were never used
+  // or are free are skipped, since a freed slot still has its old pointer.
+  Pool& pool = pools_[kIsacFix];
+  if (pool.instances == 0) {
+    return;
+  }
+  std::sort(pool.free_slots.begin(), pool.free_slots.end(),
+            std::less<void*>());
+  for (size_t i = 0; i < pool.slabs.size(); ++i) {
+    const size_t used_slots = i + 1 < pool.slabs.size()
+                                  ? pool.slots_per_slab
+                                  : pool.slots_per_slab - pool.unused_slots;
+    for (size_t j = 0; j < used_slots; ++j) {
+      void* slot = pool.slabs[i].get() + j * pool.slot_bytes;
+      if (!std::binary_search(pool.free_slots.begin(), pool.free_slots.end(),
+                              slot, std::less<void*>())) {
+        WebRtcIsacfix_FreeInternal(static_cast<ISACFIX_MainStruct*>(slot));
+      }
+    }
+  }
+}
+
+IlbcEncoderInstance* CodecInstanceArena::CreateIlbcEncoder() {
+  int16_t* slot = static_cast<int16_t*>(AllocateSlot(kIlbcEncoder));
+  IlbcEncoderInstance* inst = nullptr;
+  int16_t size = 0;
+  if (!slot || WebRtcIlbcfix_EncoderAssign(&inst, slot, &size) != 0) {
+    return nullptr;
+  }
+  return inst;
+}
+
+IlbcDecoderInstance* CodecInstanceArena::CreateIlbcDecoder() {
+  int16_t* slot = static_cast<int16_t*>(AllocateSlot(kIlbcDecoder));
+  IlbcDecoderInstance* inst = nullptr;
+  int16_t size = 0;
+  if (!slot || WebRtcIlbcfix_DecoderAssign(&inst, slot, &size) != 0) {
+    return nullptr;
+  }
+  return inst;
+}
+
+ISACStruct* CodecInstanceArena::CreateIsac() {
+  void* slot = AllocateSlot(kIsac);
+  ISACStruct* inst = nullptr;
+  if (!slot || WebRtcIsac_Assign(&inst, slot) != 0) {
+    return nullptr;
+  }
+  return inst;
+}
+
+ISACFIX_MainStruct* CodecInstanceArena::CreateIsacFix() {
+  void* slot = AllocateSlot(kIsacFix);
+  ISACFIX_MainStruct* inst = nullptr;
+  if (!slot || WebRtcIsacfix_Assign(&inst, slot) != 0) {
+    return nullptr;
+  }
+  return inst;
+}
+
+G722EncInst* CodecInstanceArena::CreateG722Encoder() {
+  void* slot = AllocateSlot(kG722Encoder);
+  G722EncInst* inst = nullptr;
+  if (!slot || WebRtcG722_AssignEncoder(&inst, slot) != 0) {
+    return nullptr;
+  }
+  return inst;
+}
+
+G722DecInst* CodecInstanceArena::CreateG722Decoder() {
+  void* slot = AllocateSlot(kG722Decoder);
+  G722DecInst* inst = nullptr;
+  if (!slot || WebRtcG722_AssignDecoder(&inst, slot) != 0) {
+    return nullptr;
+  }
+  return inst;
+}
+
+void CodecInstanceArena::Free(ISACFIX_MainStruct* inst) {
+  if (inst) {
+    WebRtcIsacfix_FreeInternal(inst);
+  }
+  FreeSlot(kIsacFix, inst);
+}
+
+CodecInstanceArena::Footprint CodecInstanceArena::GetFootprint(
+    Codec codec) const {
+  RTC_DCHECK_LT(codec, kNumCodecs);
+  const Pool& pool = pools_[codec];
+  Footprint footprint;
+  footprint.state_bytes = pool.state_bytes;
+  footprint.slot_bytes = pool.slot_bytes;
+  footprint.slots_per_slab = pool.slots_per_slab;
+  footprint.instances = pool.instances;
+  footprint.slabs = pool.slabs.size();
+  footprint.reserved_bytes =
+      pool.slabs.size() * pool.slots_per_slab * pool.slot_bytes;
+  return footprint;
+}
+
+void* CodecInstanceArena::AllocateSlot(Codec codec) {
+  Pool& pool = pools_[codec];
+  void* slot = nullptr;
+  if (!pool.free_slots.empty()) {
+    slot = pool.free_slots.back();
+    pool.free_slots.pop_back();
+  } else {
+    if (pool.unused_slots == 0) {
+      char* slab = static_cast<char*>(
+          AlignedMalloc(pool.slots_per_slab * pool.slot_bytes,
+                        kCacheLineBytes));
+      if (!slab) {
+        return nullptr;
+      }
+      pool.slabs.emplace_back(slab);
+      pool.unused_slots = pool.slots_per_slab;
+    }
+    slot = pool.slabs.back().get() +
+           (pool.slots_per_slab - pool.unused_slots) * pool.slot_bytes;
+    --pool.unused_slots;
+  }
+  ++pool.instances;
+  return slot;
+}
+
+void CodecInstanceArena::FreeSlot(Codec codec, void* slot) {
+  if (!slot) {
+    return;
+  }
+  Pool& pool = pools_[codec];
+  RTC_DCHECK_GT(pool.instances, 0);
+  --pool.instances;
+  pool.free_slots.push_back(slot);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_CODEC_INSTANCE_ARENA_H_
+#define MODULES_AUDIO_CODING_CODECS_CODEC_INSTANCE_ARENA_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "modules/audio_coding/codecs/g722/g722_interface.h"
+#include "modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "modules/audio_coding/codecs/isac/fix/include/isacfix.h"
+#include "modules/audio_coding/codecs/isac/main/include/isac.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/memory/aligned_malloc.h"
+
+namespace webrtc {
+
+// Places the states of codec instances in slabs of memory, instead of
+// allocating every state separately. The states of each codec are packed
+// contiguously in slabs of about the same size, every state starting on a
+// cache line, and the slots of freed instances are reused first. The states
+// are placed with the *Assign() functions of the codecs.
+//
+// Instances created by the arena must be freed by it, and not with the Free
+// functions of the codecs. Instances still alive when the arena is destroyed
+// are freed with it. The arena itself is not thread safe, but the
+// instances it creates may be used on any thread.
+class CodecInstanceArena {
+ public:
+  enum Codec {
+    kIlbcEncoder,
+    kIlbcDecoder,
+    kIsac,
+    kIsacFix,
+    kG722Encoder,
+    kG722Decoder,
+    kNumCodecs
+  };
+
+  struct Footprint {
+    // Size of the state of one instance, and of the slot that holds it.
+    size_t state_bytes = 0;
+    size_t slot_bytes = 0;
+    size_t slots_per_slab = 0;
+    size_t instances = 0;
+    size_t slabs = 0;
+    // Memory held in slabs, used or not.
+    size_t reserved_bytes = 0;
+  };
+
+  static const size_t kCacheLineBytes = 64;
+  static const size_t kDefaultSlabBytes = 256 * 1024;
+
+  // A slab holds as many states as fit in |slab_bytes|, and at least one.
+  explicit CodecInstanceArena(size_t slab_bytes = kDefaultSlabBytes);
+  ~CodecInstanceArena();
+
+  // The created instances are not initialized, like those of the Create
+  // functions of the codecs. Return null on error.
+  IlbcEncoderInstance* CreateIlbcEncoder();
+  IlbcDecoderInstance* CreateIlbcDecoder();
+  ISACStruct* CreateIsac();
+  ISACFIX_MainStruct* CreateIsacFix();
+  G722EncInst* CreateG722Encoder();
+  G722DecInst* CreateG722Decoder();
+
+  void Free(IlbcEncoderInstance* inst) { FreeSlot(kIlbcEncoder, inst); }
+  void Free(IlbcDecoderInstance* inst) { FreeSlot(kIlbcDecoder, inst); }
+  void Free(ISACStruct* inst) { FreeSlot(kIsac, inst); }
+  // Also frees the memory of WebRtcIsacfix_CreateInternal(), if any.
+  void Free(ISACFIX_MainStruct* inst);
+  void Free(G722EncInst* inst) { FreeSlot(kG722Encoder, inst); }
+  void Free(G722DecInst* inst) { FreeSlot(kG722Decoder, inst); }
+
+  Footprint GetFootprint(Codec codec) const;
+
+ private:
+  struct Pool {
+    size_t state_bytes = 0;
+    size_t slot_bytes = 0;
+    size_t slots_per_slab = 0;
+    size_t instances = 0;
+    // Slots in the last slab that were never used.
+    size_t unused_slots = 0;
+    std::vector<std::unique_ptr<char, AlignedFreeDeleter>> slabs;
+    // Freed slots, of which the last is reused first.
+    std::vector<void*> free_slots;
+  };
+
+  void* AllocateSlot(Codec codec);
+  void FreeSlot(Codec codec, void* slot);
+
+  Pool pools_[kNumCodecs];
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(CodecInstanceArena);
+};
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_CODECS_CODEC_INSTANCE_ARENA_H_
@@ -12,12 +12,92 @@
 
 #include "modules/third_party/g711/g711.h"
 #include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "rtc_base/system/arch.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/audio_coding/codecs/g711/g711_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+#endif
+
+// alaw_to_linear() and ulaw_to_linear() for all 256 code words.
+static const int16_t kALawToLinear[256] = {
+    -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736,
+    -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784,
+    -2752, -2624, -3008, -2880, -2240, -2112, -2496, -2368,
+    -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392,
+    -22016, -20992, -24064, -23040, -17920, -16896, -19968, -18944,
+    -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136,
+    -11008, -10496, -12032, -11520, -8960, -8448, -9984, -9472,
+    -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568,
+    -344, -328, -376, -360, -280, -264, -312, -296,
+    -472, -456, -504, -488, -408, -392, -440, -424,
+    -88, -72, -120, -104, -24, -8, -56, -40,
+    -216, -200, -248, -232, -152, -136, -184, -168,
+    -1376, -1312, -1504, -1440, -1120, -1056, -1248, -1184,
+    -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696,
+    -688, -656, -752, -720, -560, -528, -624, -592,
+    -944, -912, -1008, -976, -816, -784, -880, -848,
+    5504, 5248, 6016, 5760, 4480, 4224, 4992, 4736,
+    7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784,
+    2752, 2624, 3008, 2880, 2240, 2112, 2496, 2368,
+    3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392,
+    22016, 20992, 24064, 23040, 17920, 16896, 19968, 18944,
+    30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136,
+    11008, 10496, 12032, 11520, 8960, 8448, 9984, 9472,
+    15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568,
+    344, 328, 376, 360, 280, 264, 312, 296,
+    472, 456, 504, 488, 408, 392, 440, 424,
+    88, 72, 120, 104, 24, 8, 56, 40,
+    216, 200, 248, 232, 152, 136, 184, 168,
+    1376, 1312, 1504, 1440, 1120, 1056, 1248, 1184,
+    1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696,
+    688, 656, 752, 720, 560, 528, 624, 592,
+    944, 912, 1008, 976, 816, 784, 880, 848,
+};
+
+static const int16_t kULawToLinear[256] = {
+    -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956,
+    -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764,
+    -15996, -15484, -14972, -14460, -13948, -13436, -12924, -12412,
+    -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316,
+    -7932, -7676, -7420, -7164, -6908, -6652, -6396, -6140,
+    -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092,
+    -3900, -3772, -3644, -3516, -3388, -3260, -3132, -3004,
+    -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980,
+    -1884, -1820, -1756, -1692, -1628, -1564, -1500, -1436,
+    -1372, -1308, -1244, -1180, -1116, -1052, -988, -924,
+    -876, -844, -812, -780, -748, -716, -684, -652,
+    -620, -588, -556, -524, -492, -460, -428, -396,
+    -372, -356, -340, -324, -308, -292, -276, -260,
+    -244, -228, -212, -196, -180, -164, -148, -132,
+    -120, -112, -104, -96, -88, -80, -72, -64,
+    -56, -48, -40, -32, -24, -16, -8, 0,
+    32124, 31100, 30076, 29052, 28028, 27004, 25980, 24956,
+    23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764,
+    15996, 15484, 14972, 14460, 13948, 13436, 12924, 12412,
+    11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316,
+    7932, 7676, 7420, 7164, 6908, 6652, 6396, 6140,
+    5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092,
+    3900, 3772, 3644, 3516, 3388, 3260, 3132, 3004,
+    2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980,
+    1884, 1820, 1756, 1692, 1628, 1564, 1500, 1436,
+    1372, 1308, 1244, 1180, 1116, 1052, 988, 924,
+    876, 844, 812, 780, 748, 716, 684, 652,
+    620, 588, 556, 524, 492, 460, 428, 396,
+    372, 356, 340, 324, 308, 292, 276, 260,
+    244, 228, 212, 196, 180, 164, 148, 132,
+    120, 112, 104, 96, 88, 80, 72, 64,
+    56, 48, 40, 32, 24, 16, 8, 0,
+};
 
 size_t WebRtcG711_EncodeA(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded) {
-  size_t n;
-  for (n = 0; n < len; n++)
+  size_t n = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2())
+    n = WebRtcG711_EncodeASSE2(speechIn, len, encoded);
+#endif
+  for (; n < len; n++)
     encoded[n] = linear_to_alaw(speechIn[n]);
   return len;
 }
@@ -25,8 +105,12 @@ size_t WebRtcG711_EncodeA(const int16_t* speechIn,
 size_t WebRtcG711_EncodeU(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded) {
-  size_t n;
-  for (n = 0; n < len; n++)
+  size_t n = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2())
+    n = WebRtcG711_EncodeUSSE2(speechIn, len, encoded);
+#endif
+  for (; n < len; n++)
     encoded[n] = linear_to_ulaw(speechIn[n]);
   return len;
 }
@@ -37,7 +121,7 @@ size_t WebRtcG711_DecodeA(const uint8_t* encoded,
                           int16_t* speechType) {
   size_t n;
   for (n = 0; n < len; n++)
-    decoded[n] = alaw_to_linear(encoded[n]);
+    decoded[n] = kALawToLinear[encoded[n]];
   *speechType = 1;
   return len;
 }
@@ -48,11 +132,25 @@ size_t WebRtcG711_DecodeU(const uint8_t* encoded,
                           int16_t* speechType) {
   size_t n;
   for (n = 0; n < len; n++)
-    decoded[n] = ulaw_to_linear(encoded[n]);
+    decoded[n] = kULawToLinear[encoded[n]];
   *speechType = 1;
   return len;
 }
 
+size_t WebRtcG711_TranscodeAtoU(const uint8_t* alaw,
+                                size_t len,
+                                uint8_t* ulaw) {
+  alaw_to_ulaw_block(alaw, len, ulaw);
+  return len;
+}
+
+size_t WebRtcG711_TranscodeUtoA(const uint8_t* ulaw,
+                                size_t len,
+                                uint8_t* alaw) {
+  ulaw_to_alaw_block(ulaw, len, alaw);
+  return len;
+}
+
 int16_t WebRtcG711_Version(char* version, int16_t lenBytes) {
   strncpy(version, "2.0.0", lenBytes);
   return 0;
@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_CODING_CODECS_G711_G711_INTERFACE_H_
 #define MODULES_AUDIO_CODING_CODECS_G711_G711_INTERFACE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 // Comfort noise constants
@@ -111,6 +112,50 @@ size_t WebRtcG711_DecodeU(const uint8_t* encoded,
                           int16_t* decoded,
                           int16_t* speechType);
 
+/****************************************************************************
+ * WebRtcG711_TranscodeAtoU(...)
+ *
+ * This function transcodes a G711 A-law frame to U-law, using the procedure
+ * defined in G.711, without decoding to linear PCM. The output may be
+ * written in place of the input.
+ *
+ * Input:
+ *      - alaw               : A-law encoded data
+ *      - len                : Bytes in alaw
+ *
+ * Output:
+ *      - ulaw               : U-law encoded data
+ *
+ * Return value              : Length (in bytes) of U-law data.
+ *                             Always equal to len input parameter.
+ */
+
+size_t WebRtcG711_TranscodeAtoU(const uint8_t* alaw,
+                                size_t len,
+                                uint8_t* ulaw);
+
+/****************************************************************************
+ * WebRtcG711_TranscodeUtoA(...)
+ *
+ * This function transcodes a G711 U-law frame to A-law, using the procedure
+ * defined in G.711, without decoding to linear PCM. The output may be
+ * written in place of the input.
+ *
+ * Input:
+ *      - ulaw               : U-law encoded data
+ *      - len                : Bytes in ulaw
+ *
+ * Output:
+ *      - alaw               : A-law encoded data
+ *
+ * Return value              : Length (in bytes) of A-law data.
+ *                             Always equal to len input parameter.
+ */
+
+size_t WebRtcG711_TranscodeUtoA(const uint8_t* ulaw,
+                                size_t len,
+                                uint8_t* alaw);
+
 /**********************************************************************
  * WebRtcG711_Version(...)
  *
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g711/g711_sse2.h"
+
+#include <emmintrin.h>
+
+// Both laws code a magnitude as (seg << 4) | mant, where seg + 7 is the
+// position of the highest set bit and mant the four bits below it. Both are
+// read directly from the exponent and the mantissa of the magnitude converted
+// to float, which is exact since magnitudes have less than 24 bits. With the
+// float exponent bias of 127, (bits >> 19) - ((127 + 7) << 4) is the code.
+static __inline __m128i SegmentAndMantissa(__m128i magnitude) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i offset = _mm_set1_epi32((127 + 7) << 4);
+  const __m128i lo = _mm_castps_si128(
+      _mm_cvtepi32_ps(_mm_unpacklo_epi16(magnitude, zero)));
+  const __m128i hi = _mm_castps_si128(
+      _mm_cvtepi32_ps(_mm_unpackhi_epi16(magnitude, zero)));
+  return _mm_packs_epi32(_mm_sub_epi32(_mm_srli_epi32(lo, 19), offset),
+                         _mm_sub_epi32(_mm_srli_epi32(hi, 19), offset));
+}
+
+// linear_to_alaw() for eight samples, as 16-bit values.
+static __inline __m128i LinearToAlaw(__m128i linear) {
+  const __m128i sign = _mm_srai_epi16(linear, 15);
+  // The magnitude, -linear - 1 for negative samples, is at most 32767.
+  const __m128i magnitude = _mm_xor_si128(linear, sign);
+  // Segments 0 and 1 share a step size of 16, so that the code is
+  // magnitude >> 4 below 512. Magnitudes below 256 are moved to segment 1 by
+  // adding 256, and the code is corrected by -16.
+  const __m128i segment0 =
+      _mm_cmplt_epi16(magnitude, _mm_set1_epi16(0x100));
+  const __m128i code = _mm_sub_epi16(
+      SegmentAndMantissa(_mm_add_epi16(
+          magnitude, _mm_and_si128(segment0, _mm_set1_epi16(0x100)))),
+      _mm_and_si128(segment0, _mm_set1_epi16(0x10)));
+  // The mask is ALAW_AMI_MASK | 0x80 for positive and ALAW_AMI_MASK for
+  // negative samples.
+  const __m128i mask = _mm_xor_si128(
+      _mm_set1_epi16(0xD5), _mm_and_si128(sign, _mm_set1_epi16(0x80)));
+  return _mm_xor_si128(code, mask);
+}
+
+// linear_to_ulaw() for eight samples, as 16-bit values.
+static __inline __m128i LinearToUlaw(__m128i linear) {
+  const __m128i sign = _mm_srai_epi16(linear, 15);
+  // The biased magnitude, ULAW_BIAS - linear - 1 for negative samples, is at
+  // most 32899 and is treated as unsigned. Due to the bias it is at least
+  // 128, so that the highest set bit is that of segment 0 or above.
+  const __m128i magnitude =
+      _mm_add_epi16(_mm_xor_si128(linear, sign), _mm_set1_epi16(0x84));
+  // Segment 8 is out of range and clips to code 0x7F.
+  const __m128i code =
+      _mm_min_epi16(SegmentAndMantissa(magnitude), _mm_set1_epi16(0x7F));
+  // The mask is 0xFF for positive and 0x7F for negative samples.
+  const __m128i mask = _mm_xor_si128(
+      _mm_set1_epi16(0xFF), _mm_and_si128(sign, _mm_set1_epi16(0x80)));
+  return _mm_xor_si128(code, mask);
+}
+
+size_t WebRtcG711_EncodeASSE2(const int16_t* speechIn,
+                              size_t len,
+                              uint8_t* encoded) {
+  size_t n;
+  for (n = 0; n + 16 <= len; n += 16) {
+    const __m128i lo = _mm_loadu_si128((const __m128i*)&speechIn[n]);
+    const __m128i hi = _mm_loadu_si128((const __m128i*)&speechIn[n + 8]);
+    _mm_storeu_si128((__m128i*)&encoded[n],
+                     _mm_packus_epi16(LinearToAlaw(lo), LinearToAlaw(hi)));
+  }
+  return n;
+}
+
+size_t WebRtcG711_EncodeUSSE2(const int16_t* speechIn,
+                              size_t len,
+                              uint8_t* encoded) {
+  size_t n;
+  for (n = 0; n + 16 <= len; n += 16) {
+    const __m128i lo = _mm_loadu_si128((const __m128i*)&speechIn[n]);
+    const __m128i hi = _mm_loadu_si128((const __m128i*)&speechIn[n + 8]);
+    _mm_storeu_si128((__m128i*)&encoded[n],
+                     _mm_packus_epi16(LinearToUlaw(lo), LinearToUlaw(hi)));
+  }
+  return n;
+}
@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 versions of the G.711 encoders, bit-exact with linear_to_alaw() and
+// linear_to_ulaw(). Only for use by g711_interface.c.
+
+#ifndef MODULES_AUDIO_CODING_CODECS_G711_G711_SSE2_H_
+#define MODULES_AUDIO_CODING_CODECS_G711_G711_SSE2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Encode the largest multiple of 16 samples not exceeding |len|, and return
+// the number of samples encoded.
+size_t WebRtcG711_EncodeASSE2(const int16_t* speechIn,
+                              size_t len,
+                              uint8_t* encoded);
+size_t WebRtcG711_EncodeUSSE2(const int16_t* speechIn,
+                              size_t len,
+                              uint8_t* encoded);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MODULES_AUDIO_CODING_CODECS_G711_G711_SSE2_H_
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Exhaustive check of the G.711 interface against the reference functions
+// of modules/third_party/g711. All 65536 sample values are encoded with
+// WebRtcG711_EncodeA() and WebRtcG711_EncodeU() from every offset of a
+// 16-sample block, so that the SSE2 loop and the C tail both see every
+// value, and must match linear_to_alaw() and linear_to_ulaw(). All 256 code
+// words are decoded and must match alaw_to_linear() and ulaw_to_linear(),
+// and are transcoded, also in place, and must match alaw_to_ulaw() and
+// ulaw_to_alaw(). Returns 0 if everything matches.
+//
+// Usage: g711_exhaustive_check
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "modules/third_party/g711/g711.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kNumValues = 65536;
+const size_t kNumCodes = 256;
+// The SSE2 encoders take 16 samples at a time.
+const size_t kBlockSize = 16;
+
+typedef size_t (*Encoder)(const int16_t* speech, size_t len, uint8_t* encoded);
+typedef uint8_t (*ReferenceEncoder)(int linear);
+typedef size_t (*Decoder)(const uint8_t* encoded,
+                          size_t len,
+                          int16_t* decoded,
+                          int16_t* speech_type);
+typedef int16_t (*ReferenceDecoder)(uint8_t code);
+typedef size_t (*Transcoder)(const uint8_t* in, size_t len, uint8_t* out);
+typedef uint8_t (*ReferenceTranscoder)(uint8_t code);
+
+// Returns the number of sample values, at all offsets, that |encoder|
+// encodes differently from |reference|.
+int CheckEncoder(const char* name,
+                 Encoder encoder,
+                 ReferenceEncoder reference) {
+  std::vector<int16_t> speech(kBlockSize + kNumValues);
+  std::vector<uint8_t> encoded(speech.size());
+  int mismatches = 0;
+  for (size_t offset = 0; offset < kBlockSize; ++offset) {
+    for (size_t i = 0; i < kNumValues; ++i) {
+      speech[offset + i] = static_cast<int16_t>(i - 32768);
+    }
+    if (encoder(&speech[offset], kNumValues, &encoded[offset]) !=
+        kNumValues) {
+      printf("%s: wrong length\n", name);
+      return 1;
+    }
+    for (size_t i = 0; i < kNumValues; ++i) {
+      const int16_t value = speech[offset + i];
+      if (encoded[offset + i] == reference(value)) {
+        continue;
+      }
+      if (mismatches == 0) {
+        printf("%s: offset %d, %d encoded as 0x%02x, expected 0x%02x\n", name,
+               static_cast<int>(offset), value, encoded[offset + i],
+               reference(value));
+      }
+      ++mismatches;
+    }
+  }
+  printf("%s: %d of %d differ\n", name, mismatches,
+         static_cast<int>(kBlockSize * kNumValues));
+  return mismatches;
+}
+
+int CheckDecoder(const char* name,
+                 Decoder decoder,
+                 ReferenceDecoder reference) {
+  std::vector<uint8_t> codes(kNumCodes);
+  for (size_t i = 0; i < kNumCodes; ++i) {
+    codes[i] = static_cast<uint8_t>(i);
+  }
+  std::vector<int16_t> decoded(kNumCodes);
+  int16_t speech_type = 0;
+  if (decoder(codes.data(), kNumCodes, decoded.data(), &speech_type) !=
+          kNumCodes ||
+      speech_type != 1) {
+    printf("%s: wrong length or speech type\n", name);
+    return 1;
+  }
+  int mismatches = 0;
+  for (size_t i = 0; i < kNumCodes; ++i) {
+    if (decoded[i] != reference(codes[i])) {
+      if (mismatches == 0) {
+        printf("%s: 0x%02x decoded as %d, expected %d\n", name, codes[i],
+               decoded[i], reference(codes[i]));
+      }
+      ++mismatches;
+    }
+  }
+  printf("%s: %d of %d differ\n", name, mismatches,
+         static_cast<int>(kNumCodes));
+  return mismatches;
+}
+
+// Transcodes all code words into a second buffer and in place.
+int CheckTranscoder(const char* name,
+                    Transcoder transcoder,
+                    ReferenceTranscoder reference) {
+  std::vector<uint8_t> codes(kNumCodes);
+  for (size_t i = 0; i < kNumCodes; ++i) {
+    codes[i] = static_cast<uint8_t>(i);
+  }
+  std::vector<uint8_t> out(kNumCodes);
+  std::vector<uint8_t> in_place = codes;
+  if (transcoder(codes.data(), kNumCodes, out.data()) != kNumCodes ||
+      transcoder(in_place.data(), kNumCodes, in_place.data()) != kNumCodes) {
+    printf("%s: wrong length\n", name);
+    return 1;
+  }
+  int mismatches = 0;
+  for (size_t i = 0; i < kNumCodes; ++i) {
+    const uint8_t expected = reference(codes[i]);
+    if (out[i] != expected || in_place[i] != expected) {
+      if (mismatches == 0) {
+        printf("%s: 0x%02x transcoded as 0x%02x (0x%02x in place), expected "
+               "0x%02x\n",
+               name, codes[i], out[i], in_place[i], expected);
+      }
+      ++mismatches;
+    }
+  }
+  printf("%s: %d of %d differ\n", name, mismatches,
+         static_cast<int>(kNumCodes));
+  return mismatches;
+}
+
+uint8_t LinearToAlaw(int linear) {
+  return linear_to_alaw(linear);
+}
+uint8_t LinearToUlaw(int linear) {
+  return linear_to_ulaw(linear);
+}
+int16_t AlawToLinear(uint8_t code) {
+  return alaw_to_linear(code);
+}
+int16_t UlawToLinear(uint8_t code) {
+  return ulaw_to_linear(code);
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main() {
+  int mismatches = 0;
+  mismatches += webrtc::CheckEncoder("EncodeA", WebRtcG711_EncodeA,
+                                     webrtc::LinearToAlaw);
+  mismatches += webrtc::CheckEncoder("EncodeU", WebRtcG711_EncodeU,
+                                     webrtc::LinearToUlaw);
+  mismatches += webrtc::CheckDecoder("DecodeA", WebRtcG711_DecodeA,
+                                     webrtc::AlawToLinear);
+  mismatches += webrtc::CheckDecoder("DecodeU", WebRtcG711_DecodeU,
+                                     webrtc::UlawToLinear);
+  mismatches += webrtc::CheckTranscoder("TranscodeAtoU",
+                                        WebRtcG711_TranscodeAtoU,
+                                        alaw_to_ulaw);
+  mismatches += webrtc::CheckTranscoder("TranscodeUtoA",
+                                        WebRtcG711_TranscodeUtoA,
+                                        ulaw_to_alaw);
+  return mismatches == 0 ? 0 : 1;
+}
@@ -14,6 +14,23 @@
 #include "modules/audio_coding/codecs/g722/g722_interface.h"
 #include "modules/third_party/g722/g722_enc_dec.h"
 
+int16_t WebRtcG722_EncoderAssignSize(int *sizeinbytes)
+{
+    *sizeinbytes = (int)sizeof(G722EncoderState);
+    return 0;
+}
+
+int16_t WebRtcG722_AssignEncoder(G722EncInst **G722enc_inst,
+                                 void *G722enc_inst_Addr)
+{
+    *G722enc_inst = (G722EncInst*)G722enc_inst_Addr;
+    if (*G722enc_inst != NULL) {
+      return(0);
+    } else {
+      return(-1);
+    }
+}
+
 int16_t WebRtcG722_CreateEncoder(G722EncInst **G722enc_inst)
 {
     *G722enc_inst=(G722EncInst*)malloc(sizeof(G722EncoderState));
@@ -54,6 +71,34 @@ size_t WebRtcG722_Encode(G722EncInst *G722enc_inst,
                               speechIn, len);
 }
 
+void WebRtcG722_EncodeBatch(G722EncInst* const* G722enc_insts,
+                            const int16_t* const* speechIn,
+                            size_t len,
+                            size_t num_insts,
+                            uint8_t* const* encoded,
+                            size_t* encoded_len)
+{
+    WebRtc_g722_encode_batch((G722EncoderState* const*) G722enc_insts,
+                             encoded, speechIn, len, num_insts, encoded_len);
+}
+
+int16_t WebRtcG722_DecoderAssignSize(int *sizeinbytes)
+{
+    *sizeinbytes = (int)sizeof(G722DecoderState);
+    return 0;
+}
+
+int16_t WebRtcG722_AssignDecoder(G722DecInst **G722dec_inst,
+                                 void *G722dec_inst_Addr)
+{
+    *G722dec_inst = (G722DecInst*)G722dec_inst_Addr;
+    if (*G722dec_inst != NULL) {
+      return(0);
+    } else {
+      return(-1);
+    }
+}
+
 int16_t WebRtcG722_CreateDecoder(G722DecInst **G722dec_inst)
 {
     *G722dec_inst=(G722DecInst*)malloc(sizeof(G722DecoderState));
@@ -31,6 +31,41 @@ typedef struct WebRtcG722DecInst G722DecInst;
 extern "C" {
 #endif
 
+/****************************************************************************
+ * WebRtcG722_EncoderAssignSize(...)
+ *
+ * Returns the number of bytes needed for a G722 encoder instance, so that the
+ * instance can be created outside G722.
+ *
+ * Output:
+ *     - sizeinbytes          : number of bytes needed to allocate for the
+ *                              instance.
+ *
+ * Return value               :  0 - Ok
+ *                              -1 - Error
+ */
+int16_t WebRtcG722_EncoderAssignSize(int* sizeinbytes);
+
+/****************************************************************************
+ * WebRtcG722_AssignEncoder(...)
+ *
+ * Places a G722 encoder instance in already allocated memory of at least
+ * the size given by WebRtcG722_EncoderAssignSize(). The memory is owned by
+ * the caller, so the instance must not be released with
+ * WebRtcG722_FreeEncoder().
+ *
+ * Input:
+ *     - G722enc_inst_Addr    : the already allocated memory.
+ *
+ * Output:
+ *     - G722enc_inst         : G722 instance for encoder
+ *
+ * Return value               :  0 - Ok
+ *                              -1 - Error
+ */
+int16_t WebRtcG722_AssignEncoder(G722EncInst** G722enc_inst,
+                                 void* G722enc_inst_Addr);
+
 /****************************************************************************
  * WebRtcG722_CreateEncoder(...)
  *
@@ -94,6 +129,66 @@ size_t WebRtcG722_Encode(G722EncInst* G722enc_inst,
                          size_t len,
                          uint8_t* encoded);
 
+/****************************************************************************
+ * WebRtcG722_EncodeBatch(...)
+ *
+ * This function encodes the same number of samples for several independent
+ * G722 instances, e.g. for all the participants of a conference.
+ *
+ * Input:
+ *     - G722enc_insts        : G722 instances, one per input vector
+ *     - speechIn             : Input speech vectors
+ *     - len                  : Samples in every vector of speechIn
+ *     - num_insts            : Number of instances
+ *
+ * Output:
+ *        - encoded           : The encoded data vectors
+ *        - encoded_len       : Length (in bytes) of the coded data of every
+ *                              instance
+ */
+
+void WebRtcG722_EncodeBatch(G722EncInst* const* G722enc_insts,
+                            const int16_t* const* speechIn,
+                            size_t len,
+                            size_t num_insts,
+                            uint8_t* const* encoded,
+                            size_t* encoded_len);
+
+/****************************************************************************
+ * WebRtcG722_DecoderAssignSize(...)
+ *
+ * Returns the number of bytes needed for a G722 decoder instance, so that the
+ * instance can be created outside G722.
+ *
+ * Output:
+ *     - sizeinbytes          : number of bytes needed to allocate for the
+ *                              instance.
+ *
+ * Return value               :  0 - Ok
+ *                              -1 - Error
+ */
+int16_t WebRtcG722_DecoderAssignSize(int* sizeinbytes);
+
+/****************************************************************************
+ * WebRtcG722_AssignDecoder(...)
+ *
+ * Places a G722 decoder instance in already allocated memory of at least
+ * the size given by WebRtcG722_DecoderAssignSize(). The memory is owned by
+ * the caller, so the instance must not be released with
+ * WebRtcG722_FreeDecoder().
+ *
+ * Input:
+ *     - G722dec_inst_Addr    : the already allocated memory.
+ *
+ * Output:
+ *     - G722dec_inst         : G722 instance for decoder
+ *
+ * Return value               :  0 - Ok
+ *                              -1 - Error
+ */
+int16_t WebRtcG722_AssignDecoder(G722DecInst** G722dec_inst,
+                                 void* G722dec_inst_Addr);
+
 /****************************************************************************
  * WebRtcG722_CreateDecoder(...)
  *
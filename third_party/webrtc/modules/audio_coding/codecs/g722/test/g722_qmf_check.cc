@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the block QMFs of G.722, WebRtc_g722_tx_qmf() and
+// WebRtc_g722_rx_qmf(), which use the SSE2 kernel where the CPU has it,
+// against the per-pair QMFs that WebRtc_g722_encode() and
+// WebRtc_g722_decode() ran before, reproduced below. Blocks of every length
+// up to G722_QMF_BLOCK_PAIRS pairs are filtered, with random, full-scale and
+// small input, and the outputs must be identical. The time per pair of both
+// is printed too. Returns 0 if all outputs are identical.
+//
+// Usage: g722_qmf_check [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "modules/third_party/g722/g722_qmf.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+namespace webrtc {
+namespace {
+
+const int kQmfCoeffs[12] = {3,   -11, 12,  32, -210, 951,
+                            3876, -805, 362, -156, 53, -11};
+const size_t kMaxPairs = G722_QMF_BLOCK_PAIRS;
+const size_t kMaxLength = G722_QMF_HISTORY + 2 * kMaxPairs;
+
+int16_t Saturate(int32_t amp) {
+  int16_t amp16 = static_cast<int16_t>(amp);
+  if (amp == amp16)
+    return amp16;
+  return amp > 32767 ? 32767 : -32768;
+}
+
+// The transmit QMF of WebRtc_g722_encode(), over the window of 24 samples of
+// every pair.
+void TxQmfReference(const int16_t x[], size_t num_pairs, int16_t out[]) {
+  for (size_t n = 0; n < num_pairs; ++n) {
+    const int16_t* window = &x[2 * n];
+    int sumodd = 0;
+    int sumeven = 0;
+    for (int i = 0; i < 12; ++i) {
+      sumodd += window[2 * i] * kQmfCoeffs[i];
+      sumeven += window[2 * i + 1] * kQmfCoeffs[11 - i];
+    }
+    out[2 * n] = static_cast<int16_t>((sumeven + sumodd) >> 14);
+    out[2 * n + 1] = static_cast<int16_t>((sumeven - sumodd) >> 14);
+  }
+}
+
+// The receive QMF of WebRtc_g722_decode().
+void RxQmfReference(const int16_t x[], size_t num_pairs, int16_t amp[]) {
+  for (size_t n = 0; n < num_pairs; ++n) {
+    const int16_t* window = &x[2 * n];
+    int xout1 = 0;
+    int xout2 = 0;
+    for (int i = 0; i < 12; ++i) {
+      xout2 += window[2 * i] * kQmfCoeffs[i];
+      xout1 += window[2 * i + 1] * kQmfCoeffs[11 - i];
+    }
+    amp[2 * n] = Saturate(xout1 >> 11);
+    amp[2 * n + 1] = Saturate(xout2 >> 11);
+  }
+}
+
+typedef void (*Qmf)(const int16_t x[], size_t num_pairs, int16_t out[]);
+
+// Fills |x| with one of the kinds of input.
+void Fill(int kind, std::vector<int16_t>* x) {
+  for (int16_t& sample : *x) {
+    switch (kind) {
+      case 0:
+        sample = static_cast<int16_t>(rand() % 65536 - 32768);
+        break;
+      case 1:
+        sample = rand() % 2 ? 32767 : -32768;
+        break;
+      default:
+        sample = static_cast<int16_t>(rand() % 7 - 3);
+        break;
+    }
+  }
+}
+
+// Returns the number of outputs of |qmf| that differ from |reference|.
+int Check(const char* name, Qmf qmf, Qmf reference, int iterations) {
+  std::vector<int16_t> x(kMaxLength);
+  std::vector<int16_t> out(2 * kMaxPairs);
+  std::vector<int16_t> expected(2 * kMaxPairs);
+  int mismatches = 0;
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t num_pairs = 1; num_pairs <= kMaxPairs; ++num_pairs) {
+      Fill(i % 3, &x);
+      qmf(x.data(), num_pairs, out.data());
+      reference(x.data(), num_pairs, expected.data());
+      for (size_t k = 0; k < 2 * num_pairs; ++k) {
+        if (out[k] == expected[k]) {
+          continue;
+        }
+        if (mismatches == 0) {
+          printf("%s: %d pairs, output %d is %d, expected %d\n", name,
+                 static_cast<int>(num_pairs), static_cast<int>(k), out[k],
+                 expected[k]);
+        }
+        ++mismatches;
+      }
+    }
+  }
+  printf("%s: %d outputs differ\n", name, mismatches);
+  return mismatches;
+}
+
+// Returns the time per pair of |qmf| on full blocks.
+double Time(Qmf qmf, int iterations) {
+  std::vector<int16_t> x(kMaxLength);
+  std::vector<int16_t> out(2 * kMaxPairs);
+  Fill(0, &x);
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    qmf(x.data(), kMaxPairs, out.data());
+    // Feed the output back, so that the calls are not independent.
+    x[i % kMaxLength] ^= out[i % (2 * kMaxPairs)];
+  }
+  return static_cast<double>(rtc::TimeNanos() - start_ns) /
+         (static_cast<double>(iterations) * kMaxPairs);
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 300;
+  if (iterations < 1) {
+    fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  printf("Kernel: %s\n", WebRtc_UseSSE2() ? "SSE2" : "C");
+#endif
+
+  srand(1);
+  int mismatches = 0;
+  mismatches += webrtc::Check("tx", WebRtc_g722_tx_qmf,
+                              webrtc::TxQmfReference, iterations);
+  mismatches += webrtc::Check("rx", WebRtc_g722_rx_qmf,
+                              webrtc::RxQmfReference, iterations);
+
+  const int timed = 1000 * iterations;
+  printf("ns/pair: tx %.2f (per pair reference %.2f), rx %.2f (%.2f)\n",
+         webrtc::Time(WebRtc_g722_tx_qmf, timed),
+         webrtc::Time(webrtc::TxQmfReference, timed),
+         webrtc::Time(WebRtc_g722_rx_qmf, timed),
+         webrtc::Time(webrtc::RxQmfReference, timed));
+  return mismatches == 0 ? 0 : 1;
+}
@@ -222,7 +222,7 @@ void WebRtcIlbcfix_CbSearch(
     WebRtcIlbcfix_CbSearchCore(
         cDot, range, stage, inverseEnergy,
         inverseEnergyShifts, Crit,
-        &indexNew, &CritNew, &CritNewSh);
+        &indexNew, &CritNew, &CritNewSh, iLBCenc_inst->use_sse2);
 
     /* Update the global best index and the corresponding gain */
     WebRtcIlbcfix_CbUpdateBestIndex(
@@ -275,7 +275,7 @@ void WebRtcIlbcfix_CbSearch(
     WebRtcIlbcfix_CbSearchCore(
         cDot, eInd-sInd+1, stage, inverseEnergy+indexOffset,
         inverseEnergyShifts+indexOffset, Crit,
-        &indexNew, &CritNew, &CritNewSh);
+        &indexNew, &CritNew, &CritNewSh, iLBCenc_inst->use_sse2);
 
     /* Update the global best index and the corresponding gain */
     WebRtcIlbcfix_CbUpdateBestIndex(
@@ -18,6 +18,7 @@
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
+#include "modules/audio_coding/codecs/ilbc/cb_search_core.h"
 
 void WebRtcIlbcfix_CbSearchCore(
     int32_t *cDot,    /* (i) Cross Correlation */
@@ -32,8 +33,10 @@ void WebRtcIlbcfix_CbSearchCore(
                                                    vector) */
     int32_t *bestCrit,   /* (o) Value of critera for the
                                                    chosen index */
-    int16_t *bestCritSh)   /* (o) The domain of the chosen
+    int16_t *bestCritSh,   /* (o) The domain of the chosen
                                                    criteria */
+    int useSSE2)           /* (i) Nonzero to compute the criteria
+                                                   with SSE2 */
 {
   int32_t maxW32, tmp32;
   int16_t max, sh, tmp16;
@@ -57,13 +60,22 @@ void WebRtcIlbcfix_CbSearchCore(
   maxW32 = WebRtcSpl_MaxAbsValueW32(cDot, range);
 
   sh = (int16_t)WebRtcSpl_NormW32(maxW32);
-  cDotPtr = cDot;
-  inverseEnergyPtr = inverseEnergy;
-  critPtr = Crit;
-  inverseEnergyShiftPtr=inverseEnergyShift;
   max=WEBRTC_SPL_WORD16_MIN;
-
-  for (i=0;i<range;i++) {
+  i=0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (useSSE2) {
+    i = WebRtcIlbcfix_CbSearchCritSSE2(cDot, range, sh, inverseEnergy,
+                                       inverseEnergyShift, Crit, &max);
+  }
+#else
+  (void)useSSE2;
+#endif
+  cDotPtr = cDot+i;
+  inverseEnergyPtr = inverseEnergy+i;
+  critPtr = Crit+i;
+  inverseEnergyShiftPtr=inverseEnergyShift+i;
+
+  for (;i<range;i++) {
     /* Calculate cDot*cDot and put the result in a int16_t */
     tmp32 = *cDotPtr << sh;
     tmp16 = (int16_t)(tmp32 >> 16);
@@ -89,23 +101,26 @@ void WebRtcIlbcfix_CbSearchCore(
     max = 0;
   }
 
-  /* Modify the criterias, so that all of them use the same Q domain */
+  /* Modify the criterias, so that all of them use the same Q domain,
+     and find the index of the (first) best value */
   critPtr=Crit;
   inverseEnergyShiftPtr=inverseEnergyShift;
+  *bestIndex=0;
+  *bestCrit=WEBRTC_SPL_WORD32_MIN;
   for (i=0;i<range;i++) {
     /* Guarantee that the shift value is less than 16
        in order to simplify for DSP's (and guard against >31) */
     tmp16 = WEBRTC_SPL_MIN(16, max-(*inverseEnergyShiftPtr));
 
     (*critPtr)=WEBRTC_SPL_SHIFT_W32((*critPtr),-tmp16);
+    if (*critPtr > *bestCrit) {
+      *bestCrit = *critPtr;
+      *bestIndex = i;
+    }
     critPtr++;
     inverseEnergyShiftPtr++;
   }
 
-  /* Find the index of the best value */
-  *bestIndex = WebRtcSpl_MaxIndexW32(Crit, range);
-  *bestCrit = Crit[*bestIndex];
-
   /* Calculate total shifts of this criteria */
   *bestCritSh = 32 - 2*sh + max;
 
@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_CB_SEARCH_CORE_H_
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "rtc_base/system/arch.h"
 
 void WebRtcIlbcfix_CbSearchCore(
     int32_t* cDot,               /* (i) Cross Correlation */
@@ -34,7 +35,24 @@ void WebRtcIlbcfix_CbSearchCore(
                                            vector) */
     int32_t* bestCrit, /* (o) Value of critera for the
                                 chosen index */
-    int16_t* bestCritSh); /* (o) The domain of the chosen
+    int16_t* bestCritSh, /* (o) The domain of the chosen
                                    criteria */
+    int useSSE2);        /* (i) Nonzero to compute the criteria
+                                   with SSE2 */
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Computes the criteria of WebRtcIlbcfix_CbSearchCore() for the largest
+   multiple of eight indices not exceeding range, and returns the number of
+   indices. maxShift is set to the maximum of inverseEnergyShift over the
+   nonzero criterias, or WEBRTC_SPL_WORD16_MIN if there are none. */
+size_t WebRtcIlbcfix_CbSearchCritSSE2(
+    const int32_t* cDot,               /* (i) Cross Correlation */
+    size_t range,                      /* (i) Search range */
+    int16_t sh,                        /* (i) Normalization shift of cDot */
+    const int16_t* inverseEnergy,      /* (i) Inversed energy */
+    const int16_t* inverseEnergyShift, /* (i) Shifts of inversed energy */
+    int32_t* Crit,                     /* (o) The criteria */
+    int16_t* maxShift); /* (o) Maximum shift of a nonzero criteria */
+#endif
 
 #endif
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+ iLBC Speech Coder ANSI-C Source Code
+
+ WebRtcIlbcfix_CbSearchCritSSE2.c
+
+******************************************************************/
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "modules/audio_coding/codecs/ilbc/cb_search_core.h"
+
+size_t WebRtcIlbcfix_CbSearchCritSSE2(
+    const int32_t *cDot,    /* (i) Cross Correlation */
+    size_t range,    /* (i) Search range */
+    int16_t sh,    /* (i) Normalization shift of cDot */
+    const int16_t *inverseEnergy,  /* (i) Inversed energy */
+    const int16_t *inverseEnergyShift, /* (i) Shifts of inversed energy */
+    int32_t *Crit,    /* (o) The criteria */
+    int16_t *maxShift)   /* (o) Maximum shift of a nonzero criteria */
+{
+  const __m128i shift = _mm_cvtsi32_si128(sh);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i max = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+  size_t i;
+
+  for (i = 0; i + 8 <= range; i += 8) {
+    /* cDot << sh fits 32 bits, so that its upper 16 bits fit a int16_t */
+    const __m128i cDot0 = _mm_srai_epi32(
+        _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&cDot[i]), shift), 16);
+    const __m128i cDot1 = _mm_srai_epi32(
+        _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&cDot[i + 4]), shift),
+        16);
+    const __m128i tmp16 = _mm_packs_epi32(cDot0, cDot1);
+    const __m128i cDotSqW16 = _mm_mulhi_epi16(tmp16, tmp16);
+    const __m128i invEn =
+        _mm_loadu_si128((const __m128i*)&inverseEnergy[i]);
+    const __m128i low = _mm_mullo_epi16(cDotSqW16, invEn);
+    const __m128i high = _mm_mulhi_epi16(cDotSqW16, invEn);
+    const __m128i crit0 = _mm_unpacklo_epi16(low, high);
+    const __m128i crit1 = _mm_unpackhi_epi16(low, high);
+    /* All ones in the 16-bit lanes of zero criterias */
+    const __m128i isZero = _mm_packs_epi32(_mm_cmpeq_epi32(crit0, zero),
+                                           _mm_cmpeq_epi32(crit1, zero));
+    const __m128i shifts =
+        _mm_loadu_si128((const __m128i*)&inverseEnergyShift[i]);
+    _mm_storeu_si128((__m128i*)&Crit[i], crit0);
+    _mm_storeu_si128((__m128i*)&Crit[i + 4], crit1);
+    max = _mm_max_epi16(max, _mm_or_si128(_mm_andnot_si128(isZero, shifts),
+        _mm_and_si128(isZero, _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN))));
+  }
+
+  max = _mm_max_epi16(max, _mm_shuffle_epi32(max, 0x4e));
+  max = _mm_max_epi16(max, _mm_shuffle_epi32(max, 0xb1));
+  max = _mm_max_epi16(max, _mm_shufflelo_epi16(max, 0xb1));
+  *maxShift = (int16_t)_mm_cvtsi128_si32(max);
+  return i;
+}
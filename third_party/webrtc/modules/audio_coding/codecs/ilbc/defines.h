@@ -172,6 +172,10 @@ typedef struct IlbcEncoder_ {
   size_t diff;
 #endif
 
+  /* Whether the codebook search uses the SSE2 criteria. Set by
+     WebRtcIlbcfix_InitEncode() if the CPU has SSE2. */
+  int use_sse2;
+
 } IlbcEncoder;
 
 /* type definition decoder instance */
@@ -20,6 +20,8 @@
 #include "modules/audio_coding/codecs/ilbc/constants.h"
 #include "modules/audio_coding/codecs/ilbc/comp_corr.h"
 #include "modules/audio_coding/codecs/ilbc/bw_expand.h"
+#include "modules/audio_coding/codecs/ilbc/do_plc.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 /*----------------------------------------------------------------*
  *  Packet loss concealment routine. Conceals a residual signal
@@ -234,6 +236,25 @@ void WebRtcIlbcfix_DoThePlc(
     /* compute concealed residual */
     noise_energy_threshold_30dB = (int32_t)iLBCdec_inst->blockl * 900;
     energy = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_UseSSE2() && use_lag >= 8) {
+      /* The noise component is drawn first, since the seed is sequential */
+      for (i=0; i<iLBCdec_inst->blockl; i++) {
+        iLBCdec_inst->seed = (int16_t)(iLBCdec_inst->seed * 31821 + 13849);
+        randlag = 53 + (iLBCdec_inst->seed & 63);
+        if (randlag > i) {
+          randvec[i] =
+              iLBCdec_inst->prevResidual[iLBCdec_inst->blockl + i - randlag];
+        } else {
+          randvec[i] = iLBCdec_inst->prevResidual[i - randlag];
+        }
+      }
+      energy = WebRtcIlbcfix_DoThePlcMixSSE2(
+          PLCresidual, randvec, iLBCdec_inst->prevResidual,
+          iLBCdec_inst->blockl, use_lag, pitchfact, use_gain,
+          noise_energy_threshold_30dB);
+    } else
+#endif
     for (i=0; i<iLBCdec_inst->blockl; i++) {
 
       /* noise component -  52 < randlagFIX < 117 */
@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_DO_PLC_H_
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "rtc_base/system/arch.h"
 
 /*----------------------------------------------------------------*
  *  Packet loss concealment routine. Conceals a residual signal
@@ -38,4 +39,19 @@ void WebRtcIlbcfix_DoThePlc(
     /* (i/o) decoder instance */
     );
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Mixes the pitch repetition and noise components of a concealed residual
+   like WebRtcIlbcfix_DoThePlc(), eight samples at a time, and returns the
+   energy that it compares with energyThreshold. */
+int32_t WebRtcIlbcfix_DoThePlcMixSSE2(
+    int16_t* PLCresidual,        /* (o) concealed residual */
+    const int16_t* randvec,      /* (i) noise component */
+    const int16_t* prevResidual, /* (i) residual of the previous frame */
+    size_t blockl,               /* (i) frame length, a multiple of 8 */
+    size_t use_lag,              /* (i) pitch lag, at least 8 */
+    int16_t pitchfact,           /* (i) pitch repetition factor in Q15 */
+    int16_t use_gain,            /* (i) gain in Q15 */
+    int32_t energyThreshold);    /* (i) threshold of the energy sum */
+#endif
+
 #endif
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+ iLBC Speech Coder ANSI-C Source Code
+
+ WebRtcIlbcfix_DoThePlcMixSSE2.c
+
+******************************************************************/
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "modules/audio_coding/codecs/ilbc/do_plc.h"
+
+/* (a*b)>>15 of the int16_t in a and b, truncated to int16_t */
+static __inline __m128i MulQ15(__m128i a, __m128i b) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  const __m128i high = _mm_mulhi_epi16(a, b);
+  return _mm_packs_epi32(
+      _mm_srai_epi32(_mm_slli_epi32(
+          _mm_srai_epi32(_mm_unpacklo_epi16(low, high), 15), 16), 16),
+      _mm_srai_epi32(_mm_slli_epi32(
+          _mm_srai_epi32(_mm_unpackhi_epi16(low, high), 15), 16), 16));
+}
+
+int32_t WebRtcIlbcfix_DoThePlcMixSSE2(
+    int16_t *PLCresidual,   /* (o) concealed residual */
+    const int16_t *randvec,  /* (i) noise component */
+    const int16_t *prevResidual, /* (i) residual of the previous frame */
+    size_t blockl,    /* (i) frame length, a multiple of 8 */
+    size_t use_lag,   /* (i) pitch lag, at least 8 */
+    int16_t pitchfact,  /* (i) pitch repetition factor in Q15 */
+    int16_t use_gain,  /* (i) gain in Q15 */
+    int32_t energyThreshold)  /* (i) threshold of the energy sum */
+{
+  /* Pairs of the pitch and noise components are mixed by _mm_madd_epi16().
+     Neither factor is -32768, so the pairs cannot overflow. */
+  const __m128i factors = _mm_set1_epi32(
+      (int32_t)((uint16_t)pitchfact |
+                ((uint32_t)(uint16_t)(32767 - pitchfact) << 16)));
+  const __m128i round = _mm_set1_epi32(16384);
+  int16_t pitch[8];
+  int32_t energy = 0;
+  size_t i, k;
+
+  for (i = 0; i < blockl; i += 8) {
+    __m128i p, r, mix0, mix1, out;
+    int16_t tot_gain;
+    int32_t squares[4];
+    int64_t sum;
+
+    /* pitch repeatition component, which repeats the concealed residual
+       once it has used up prevResidual */
+    if (i + 8 <= use_lag) {
+      p = _mm_loadu_si128(
+          (const __m128i*)&prevResidual[blockl + i - use_lag]);
+    } else if (i >= use_lag) {
+      p = _mm_loadu_si128((const __m128i*)&PLCresidual[i - use_lag]);
+    } else {
+      for (k = 0; k < 8; k++) {
+        pitch[k] = (i + k < use_lag) ?
+            prevResidual[blockl + i + k - use_lag] :
+            PLCresidual[i + k - use_lag];
+      }
+      p = _mm_loadu_si128((const __m128i*)pitch);
+    }
+    r = _mm_loadu_si128((const __m128i*)&randvec[i]);
+
+    /* Attinuate total gain for each 10 ms */
+    if (i < 80) {
+      tot_gain = use_gain;
+    } else if (i < 160) {
+      tot_gain = (int16_t)((31130 * use_gain) >> 15);  /* 0.95*use_gain */
+    } else {
+      tot_gain = (int16_t)((29491 * use_gain) >> 15);  /* 0.9*use_gain */
+    }
+
+    /* mix noise and pitch repeatition */
+    mix0 = _mm_srai_epi32(_mm_add_epi32(
+        _mm_madd_epi16(_mm_unpacklo_epi16(p, r), factors), round), 15);
+    mix1 = _mm_srai_epi32(_mm_add_epi32(
+        _mm_madd_epi16(_mm_unpackhi_epi16(p, r), factors), round), 15);
+    out = MulQ15(_mm_set1_epi16(tot_gain), _mm_packs_epi32(mix0, mix1));
+    _mm_storeu_si128((__m128i*)&PLCresidual[i], out);
+
+    /* Compute energy until threshold for noise energy is reached. A block
+       that could reach it is summed sample by sample. */
+    if (energy < energyThreshold) {
+      /* Sums of two squares are below 2^31, but not those of eight */
+      _mm_storeu_si128((__m128i*)squares, _mm_madd_epi16(out, out));
+      sum = (int64_t)squares[0] + squares[1] + squares[2] + squares[3];
+      if (sum < energyThreshold - energy) {
+        energy += (int32_t)sum;
+      } else {
+        for (k = i; k < i + 8 && energy < energyThreshold; k++) {
+          energy += PLCresidual[k] * PLCresidual[k];
+        }
+      }
+    }
+  }
+
+  return energy;
+}
@@ -18,6 +18,8 @@
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
+#include "modules/audio_coding/codecs/ilbc/enh_upsample.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 /*----------------------------------------------------------------*
  * upsample finite array assuming zeros outside bounds
@@ -32,6 +34,13 @@ void WebRtcIlbcfix_EnhUpsample(
   int16_t *ps, *w16tmp;
   const int16_t *pp;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtcIlbcfix_EnhUpsampleSSE2(useq1, seq1);
+    return;
+  }
+#endif
+
   /* filtering: filter overhangs left side of sequence */
   pu1=useq1;
   for (j=0;j<ENH_UPS0; j++) {
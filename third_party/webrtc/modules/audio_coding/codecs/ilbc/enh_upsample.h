@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_ENH_UPSAMPLE_H_
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "rtc_base/system/arch.h"
 
 /*----------------------------------------------------------------*
  * upsample finite array assuming zeros outside bounds
@@ -30,4 +31,13 @@ void WebRtcIlbcfix_EnhUpsample(
     int16_t* seq1   /* (i) unupsampled sequence */
     );
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* WebRtcIlbcfix_EnhUpsample() for the ENH_CORRDIM samples of seq1, with the
+   four phases of every output computed at once. */
+void WebRtcIlbcfix_EnhUpsampleSSE2(
+    int32_t* useq1, /* (o) upsampled output sequence */
+    int16_t* seq1   /* (i) unupsampled sequence */
+    );
+#endif
+
 #endif
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+ iLBC Speech Coder ANSI-C Source Code
+
+ WebRtcIlbcfix_EnhUpsampleSSE2.c
+
+******************************************************************/
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/ilbc/constants.h"
+#include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "modules/audio_coding/codecs/ilbc/enh_upsample.h"
+
+/* Two adjacent int16_t as the 32-bit value of a _mm_madd_epi16() pair */
+static __inline __m128i Pair(int16_t first, int16_t second) {
+  return _mm_set1_epi32((int32_t)((uint16_t)first |
+                                  ((uint32_t)(uint16_t)second << 16)));
+}
+
+/* Taps k and k+1 of the four polyphase filters, as madd pairs */
+static __inline __m128i PolyPhaserTaps(int k) {
+  const int16_t (*poly)[ENH_FLO_MULT2_PLUS1] = WebRtcIlbcfix_kEnhPolyPhaser;
+  return _mm_setr_epi16(poly[0][k], poly[0][k + 1], poly[1][k],
+                        poly[1][k + 1], poly[2][k], poly[2][k + 1],
+                        poly[3][k], poly[3][k + 1]);
+}
+
+/* Tap k of the four polyphase filters, paired with zeros */
+static __inline __m128i PolyPhaserTap(int k) {
+  const int16_t (*poly)[ENH_FLO_MULT2_PLUS1] = WebRtcIlbcfix_kEnhPolyPhaser;
+  return _mm_setr_epi16(poly[0][k], 0, poly[1][k], 0, poly[2][k], 0,
+                        poly[3][k], 0);
+}
+
+void WebRtcIlbcfix_EnhUpsampleSSE2(
+    int32_t *useq1, /* (o) upsampled output sequence */
+    int16_t *seq1 /* (i) unupsampled sequence */
+                                    ){
+  /* Output 4*m+j is the sum over the taps k = 1..5 of
+     kEnhPolyPhaser[j][k]*seq1[m+3-k], with zeros outside seq1. The four
+     phases j of an output m are computed at once, from a zero padded copy
+     of seq1. */
+  const __m128i taps12 = PolyPhaserTaps(1);
+  const __m128i taps34 = PolyPhaserTaps(3);
+  const __m128i taps5 = PolyPhaserTap(5);
+  int16_t padded[ENH_CORRDIM + 4];
+  int m;
+
+  padded[0] = padded[1] = 0;
+  WEBRTC_SPL_MEMCPY_W16(&padded[2], seq1, ENH_CORRDIM);
+  padded[ENH_CORRDIM + 2] = padded[ENH_CORRDIM + 3] = 0;
+
+  for (m = 0; m < ENH_CORRDIM; m++) {
+    __m128i sum = _mm_madd_epi16(Pair(padded[m + 4], padded[m + 3]), taps12);
+    sum = _mm_add_epi32(
+        sum, _mm_madd_epi16(Pair(padded[m + 2], padded[m + 1]), taps34));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(Pair(padded[m], 0), taps5));
+    _mm_storeu_si128((__m128i*)&useq1[ENH_UPS0 * m], sum);
+  }
+}
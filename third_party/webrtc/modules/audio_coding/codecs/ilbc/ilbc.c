@@ -262,9 +262,10 @@ size_t WebRtcIlbcfix_DecodePlc(IlbcDecoderInstance* iLBCdec_inst,
   for (i=0;i<noOfLostFrames;i++) {
     // PLC decoding shouldn't fail, because there is no external input data
     // that can be bad.
-    RTC_CHECK(WebRtcIlbcfix_DecodeImpl(
+    int result = WebRtcIlbcfix_DecodeImpl(
         &decoded[i * ((IlbcDecoder*)iLBCdec_inst)->blockl], &dummy,
-        (IlbcDecoder*)iLBCdec_inst, 0));
+        (IlbcDecoder*)iLBCdec_inst, 0);
+    RTC_CHECK_EQ(result, 0);
   }
   return (noOfLostFrames*((IlbcDecoder*)iLBCdec_inst)->blockl);
 }
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/ilbc/ilbc_batch_engine.h"
+
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+
+namespace {
+
+size_t FrameLengthForMode(int16_t mode) {
+  return mode == 20 ? 160 : 240;
+}
+
+}  // namespace
+
+IlbcBatchEngine::Worker::Worker(IlbcBatchEngine* engine, size_t index)
+    : engine(engine),
+      index(index),
+      thread(&IlbcBatchEngine::WorkerThread, this, "IlbcBatchWorker"),
+      wake(false, false) {}
+
+IlbcBatchEngine::IlbcBatchEngine(size_t num_workers)
+    : done_(false, false) {
+  RTC_DCHECK_GT(num_workers, 0);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(new Worker(this, i));
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Start();
+  }
+}
+
+IlbcBatchEngine::~IlbcBatchEngine() {
+  rtc::AtomicOps::ReleaseStore(&stop_, 1);
+  for (auto& worker : workers_) {
+    worker->wake.Set();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Stop();
+  }
+}
+
+int IlbcBatchEngine::AddEncoder(int16_t mode) {
+  Stream stream = {true, nullptr, nullptr, FrameLengthForMode(mode), 0};
+  stream.enc_inst = arena_.CreateIlbcEncoder();
+  if (!stream.enc_inst) {
+    return -1;
+  }
+  if (WebRtcIlbcfix_EncoderInit(stream.enc_inst, mode) != 0) {
+    arena_.Free(stream.enc_inst);
+    return -1;
+  }
+  return AddStream(stream);
+}
+
+int IlbcBatchEngine::AddDecoder(int16_t mode) {
+  Stream stream = {false, nullptr, nullptr, FrameLengthForMode(mode), 0};
+  stream.dec_inst = arena_.CreateIlbcDecoder();
+  if (!stream.dec_inst) {
+    return -1;
+  }
+  if (WebRtcIlbcfix_DecoderInit(stream.dec_inst, mode) != 0) {
+    arena_.Free(stream.dec_inst);
+    return -1;
+  }
+  return AddStream(stream);
+}
+
+int IlbcBatchEngine::AddStream(const Stream& stream) {
+  // Pin the stream to the worker with the fewest streams.
+  Worker* home = workers_[0].get();
+  for (auto& worker : workers_) {
+    if (worker->num_streams < home->num_streams) {
+      home = worker.get();
+    }
+  }
+  ++home->num_streams;
+  streams_.push_back(stream);
+  streams_.back().home_worker = home->index;
+  return static_cast<int>(streams_.size() - 1);
+}
+
+size_t IlbcBatchEngine::FrameLength(int stream) const {
+  RTC_DCHECK_GE(stream, 0);
+  RTC_DCHECK_LT(stream, streams_.size());
+  return streams_[stream].frame_length;
+}
+
+void IlbcBatchEngine::Process(rtc::ArrayView<Frame> frames) {
+  // Group the frames by stream, keeping their order within each stream.
+  stream_starts_.assign(streams_.size() + 1, 0);
+  for (const Frame& frame : frames) {
+    RTC_DCHECK_GE(frame.stream, 0);
+    RTC_DCHECK_LT(frame.stream, streams_.size());
+    ++stream_starts_[frame.stream + 1];
+  }
+  int num_jobs = 0;
+  for (size_t i = 1; i < stream_starts_.size(); ++i) {
+    num_jobs += stream_starts_[i] > 0 ? 1 : 0;
+    stream_starts_[i] += stream_starts_[i - 1];
+  }
+  if (num_jobs == 0) {
+    return;
+  }
+  order_.resize(frames.size());
+  for (Frame& frame : frames) {
+    order_[stream_starts_[frame.stream]++] = &frame;
+  }
+
+  // |stream_starts_| now holds the end of the frames of every stream, which
+  // is the start of those of the next one.
+  rtc::AtomicOps::ReleaseStore(&pending_jobs_, num_jobs);
+  size_t first = 0;
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    const size_t end = stream_starts_[i];
+    if (end > first) {
+      Worker* home = workers_[streams_[i].home_worker].get();
+      rtc::CritScope cs(&home->lock);
+      home->jobs.push_back({static_cast<int>(i), first, end - first});
+    }
+    first = end;
+  }
+  // Wake all workers, also those without jobs of their own, which steal.
+  for (auto& worker : workers_) {
+    worker->wake.Set();
+  }
+  done_.Wait(rtc::Event::kForever);
+
+  // Move the stolen streams to their new workers, now that these are idle.
+  for (auto& worker : workers_) {
+    for (int stream : worker->stolen_streams) {
+      --workers_[streams_[stream].home_worker]->num_streams;
+      streams_[stream].home_worker = worker->index;
+      ++worker->num_streams;
+    }
+    worker->stolen_streams.clear();
+  }
+}
+
+IlbcBatchEngine::Stats IlbcBatchEngine::GetStats() const {
+  Stats stats;
+  for (const auto& worker : workers_) {
+    stats.frames += worker->stats.frames;
+    stats.deadline_misses += worker->stats.deadline_misses;
+    stats.steals += worker->stats.steals;
+  }
+  return stats;
+}
+
+void IlbcBatchEngine::WorkerThread(void* obj) {
+  Worker* worker = static_cast<Worker*>(obj);
+  worker->engine->RunWorker(worker);
+}
+
+void IlbcBatchEngine::RunWorker(Worker* worker) {
+  while (!rtc::AtomicOps::AcquireLoad(&stop_)) {
+    Job job;
+    if (!TakeJob(worker, &job)) {
+      worker->wake.Wait(rtc::Event::kForever);
+      continue;
+    }
+    RunJob(job, &worker->stats);
+    if (rtc::AtomicOps::Decrement(&pending_jobs_) == 0) {
+      done_.Set();
+    }
+  }
+}
+
+bool IlbcBatchEngine::TakeJob(Worker* worker, Job* job) {
+  {
+    rtc::CritScope cs(&worker->lock);
+    if (!worker->jobs.empty()) {
+      *job = worker->jobs.front();
+      worker->jobs.pop_front();
+      return true;
+    }
+  }
+  // Steal from the back of the queues of the other workers, i.e. the jobs
+  // that their owners would get to last. The stream moves to this worker
+  // after the call to Process(), so that it stays on one worker.
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    rtc::CritScope cs(&victim->lock);
+    if (!victim->jobs.empty()) {
+      *job = victim->jobs.back();
+      victim->jobs.pop_back();
+      ++worker->stats.steals;
+      worker->stolen_streams.push_back(job->stream);
+      return true;
+    }
+  }
+  return false;
+}
+
+void IlbcBatchEngine::RunJob(const Job& job, Stats* stats) {
+  const Stream& stream = streams_[job.stream];
+  for (size_t i = job.first; i < job.first + job.count; ++i) {
+    Frame* frame = order_[i];
+    if (stream.encoder) {
+      frame->result = WebRtcIlbcfix_Encode(stream.enc_inst, frame->audio,
+                                           stream.frame_length, frame->payload);
+      frame->payload_bytes = frame->result > 0 ? frame->result : 0;
+    } else if (frame->payload) {
+      int16_t speech_type;
+      frame->result =
+          WebRtcIlbcfix_Decode(stream.dec_inst, frame->payload,
+                               frame->payload_bytes, frame->audio,
+                               &speech_type);
+    } else {
+      frame->result = static_cast<int>(
+          WebRtcIlbcfix_DecodePlc(stream.dec_inst, frame->audio, 1));
+    }
+    frame->deadline_missed =
+        frame->deadline_us > 0 && rtc::TimeMicros() > frame->deadline_us;
+    if (frame->deadline_missed) {
+      ++stats->deadline_misses;
+    }
+  }
+  stats->frames += job.count;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_ILBC_ILBC_BATCH_ENGINE_H_
+#define MODULES_AUDIO_CODING_CODECS_ILBC_ILBC_BATCH_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_coding/codecs/codec_instance_arena.h"
+#include "modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Encodes and decodes the frames of many iLBC streams on a pool of worker
+// threads. Every stream is assigned a home worker, which processes all of its
+// frames, so that the codec state stays in the caches of one core. A worker
+// that runs out of work steals the pending frames of a whole stream from
+// another worker; the frames of one stream are therefore always processed in
+// order, and never by two workers at the same time.
+//
+// Stealing does not pin a stream to two workers: the stolen stream moves to
+// the worker that stole it, which becomes its home worker from the next call
+// to Process() on. The state of a stream thus only changes cores when the
+// load is rebalanced, and not back and forth between calls.
+//
+// AddEncoder(), AddDecoder(), Process() and the destructor must be called on
+// the same thread.
+class IlbcBatchEngine {
+ public:
+  // One frame of work for a stream.
+  struct Frame {
+    // Stream id, as returned by AddEncoder() or AddDecoder().
+    int stream = -1;
+    // Encoder streams: |audio| holds one frame of speech (160 or 240 samples,
+    // depending on the mode) and the payload is written to |payload|, which
+    // must hold at least 50 bytes.
+    // Decoder streams: |payload_bytes| bytes of |payload| are decoded to
+    // |audio|, which must hold the speech of all frames of the payload. A
+    // null |payload| conceals one lost frame.
+    int16_t* audio = nullptr;
+    uint8_t* payload = nullptr;
+    size_t payload_bytes = 0;
+    // Time, as given by rtc::TimeMicros(), by which the frame should be
+    // done, or 0 for no deadline.
+    int64_t deadline_us = 0;
+
+    // Set by Process(). |result| is the number of bytes encoded or samples
+    // decoded, or -1 on error.
+    int result = 0;
+    bool deadline_missed = false;
+  };
+
+  struct Stats {
+    size_t frames = 0;
+    size_t deadline_misses = 0;
+    // Number of times the pending frames of a stream were processed by
+    // another worker than its home worker, which the stream then moved to.
+    size_t steals = 0;
+  };
+
+  // Starts |num_workers| threads, typically one per core.
+  explicit IlbcBatchEngine(size_t num_workers);
+  ~IlbcBatchEngine();
+
+  // Add a stream with a new instance in 20 or 30 ms |mode|. Returns the
+  // stream id, or -1 on error.
+  int AddEncoder(int16_t mode);
+  int AddDecoder(int16_t mode);
+
+  size_t num_workers() const { return workers_.size(); }
+  // Number of samples in a frame of |stream|.
+  size_t FrameLength(int stream) const;
+
+  // Processes all of |frames| and returns when they are done. The frames of
+  // each stream are processed in the order in which they appear.
+  void Process(rtc::ArrayView<Frame> frames);
+
+  // Totals over all calls to Process() so far.
+  Stats GetStats() const;
+
+ private:
+  struct Stream {
+    bool encoder;
+    IlbcEncoderInstance* enc_inst;
+    IlbcDecoderInstance* dec_inst;
+    size_t frame_length;
+    size_t home_worker;
+  };
+
+  // The frames of one stream in a call to Process(), in |order_|.
+  struct Job {
+    int stream;
+    size_t first;
+    size_t count;
+  };
+
+  struct Worker {
+    Worker(IlbcBatchEngine* engine, size_t index);
+
+    IlbcBatchEngine* const engine;
+    const size_t index;
+    rtc::PlatformThread thread;
+    rtc::Event wake;
+    rtc::CriticalSection lock;
+    std::deque<Job> jobs RTC_GUARDED_BY(lock);
+    // Only used on the thread that calls Process().
+    size_t num_streams = 0;
+    // Only written by the worker thread, and read while it is idle.
+    Stats stats;
+    // Streams stolen in the current call to Process(), which move to this
+    // worker when it returns. Written like |stats|.
+    std::vector<int> stolen_streams;
+  };
+
+  static void WorkerThread(void* obj);
+  void RunWorker(Worker* worker);
+  bool TakeJob(Worker* worker, Job* job);
+  void RunJob(const Job& job, Stats* stats);
+  int AddStream(const Stream& stream);
+
+  // Holds the states of all streams, packed together.
+  CodecInstanceArena arena_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<Stream> streams_;
+  // The frames of the current call to Process(), grouped by stream.
+  std::vector<Frame*> order_;
+  std::vector<size_t> stream_starts_;
+  volatile int pending_jobs_ = 0;
+  volatile int stop_ = 0;
+  rtc::Event done_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(IlbcBatchEngine);
+};
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_CODECS_ILBC_ILBC_BATCH_ENGINE_H_
@@ -18,6 +18,7 @@
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 /*----------------------------------------------------------------*
  *  Initiation of encoder instance.
@@ -67,5 +68,11 @@ int WebRtcIlbcfix_InitEncode(  /* (o) Number of bytes encoded */
   iLBCenc_inst->section = 0;
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  iLBCenc_inst->use_sse2 = WebRtc_UseSSE2();
+#else
+  iLBCenc_inst->use_sse2 = 0;
+#endif
+
   return (int)(iLBCenc_inst->no_of_bytes);
 }
@@ -17,7 +17,6 @@
 ******************************************************************/
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
-#include "modules/audio_coding/codecs/ilbc/window32_w32.h"
 #include "modules/audio_coding/codecs/ilbc/bw_expand.h"
 #include "modules/audio_coding/codecs/ilbc/poly_to_lsf.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
@@ -38,7 +37,6 @@ void WebRtcIlbcfix_SimpleLpcAnalysis(
   int16_t stability;
   /* Stack based */
   int16_t A[LPC_FILTERORDER + 1];
-  int32_t R[LPC_FILTERORDER + 1];
   int16_t windowedData[BLOCKL_MAX];
   int16_t rc[LPC_FILTERORDER];
 
@@ -61,14 +59,12 @@ void WebRtcIlbcfix_SimpleLpcAnalysis(
       WebRtcSpl_ElementwiseVectorMult(windowedData, iLBCenc_inst->lpc_buffer+is, WebRtcIlbcfix_kLpcAsymWin, BLOCKL_MAX, 15);
     }
 
-    /* Compute autocorrelation */
-    WebRtcSpl_AutoCorrelation(windowedData, BLOCKL_MAX, LPC_FILTERORDER, R, &scale);
-
-    /* Window autocorrelation vector */
-    WebRtcIlbcfix_Window32W32(R, R, WebRtcIlbcfix_kLpcLagWin, LPC_FILTERORDER + 1 );
-
-    /* Calculate the A coefficients from the Autocorrelation using Levinson Durbin algorithm */
-    stability=WebRtcSpl_LevinsonDurbin(R, A, rc, LPC_FILTERORDER);
+    /* Compute the autocorrelation, window it and calculate the A coefficients
+       from it using Levinson Durbin algorithm */
+    stability=WebRtcSpl_AutoCorrelationToLpc(windowedData, BLOCKL_MAX,
+                                             LPC_FILTERORDER,
+                                             WebRtcIlbcfix_kLpcLagWin, A, rc,
+                                             &scale);
 
     /*
        Set the filter to {1.0, 0.0, 0.0,...} if filter from Levinson Durbin algorithm is unstable
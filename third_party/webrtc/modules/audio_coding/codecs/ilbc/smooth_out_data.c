@@ -18,7 +18,9 @@
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
+#include "modules/audio_coding/codecs/ilbc/smooth_out_data.h"
 #include "rtc_base/sanitizer.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 // An s32 + s32 -> s32 addition that's allowed to overflow. (It's still
 // undefined behavior, so not a good idea; this just makes UBSan ignore the
@@ -40,6 +42,12 @@ int32_t WebRtcIlbcfix_Smooth_odata(
   int16_t err;
   int32_t errs;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    return WebRtcIlbcfix_Smooth_odataSSE2(odata, psseq, surround, C);
+  }
+#endif
+
   for(i=0;i<80;i++) {
     odata[i]= (int16_t)((C * surround[i] + 1024) >> 11);
   }
@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_SMOOTH_OUT_DATA_H_
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "rtc_base/system/arch.h"
 
 /*----------------------------------------------------------------*
  * help function to WebRtcIlbcfix_Smooth()
@@ -30,4 +31,12 @@ int32_t WebRtcIlbcfix_Smooth_odata(int16_t* odata,
                                    int16_t* surround,
                                    int16_t C);
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* WebRtcIlbcfix_Smooth_odata() computed eight samples at a time. */
+int32_t WebRtcIlbcfix_Smooth_odataSSE2(int16_t* odata,
+                                       const int16_t* psseq,
+                                       const int16_t* surround,
+                                       int16_t C);
+#endif
+
 #endif
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+ iLBC Speech Coder ANSI-C Source Code
+
+ WebRtcIlbcfix_Smooth_odataSSE2.c
+
+******************************************************************/
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "modules/audio_coding/codecs/ilbc/smooth_out_data.h"
+
+/* Sign extends the low and high four int16_t of v to int32_t */
+static __inline __m128i ExtendLow(__m128i v) {
+  return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+static __inline __m128i ExtendHigh(__m128i v) {
+  return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+/* Keeps the low 16 bits of the int32_t in v, like a cast to int16_t */
+static __inline __m128i TruncateW32(__m128i v) {
+  return _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+}
+
+int32_t WebRtcIlbcfix_Smooth_odataSSE2(
+    int16_t *odata,
+    const int16_t *psseq,
+    const int16_t *surround,
+    int16_t C)
+{
+  const __m128i gain = _mm_set1_epi16(C);
+  const __m128i round = _mm_set1_epi32(1024);
+  __m128i errs = _mm_setzero_si128();
+  int i;
+
+  for (i = 0; i < ENH_BLOCKL; i += 8) {
+    const __m128i s = _mm_loadu_si128((const __m128i*)&surround[i]);
+    const __m128i low = _mm_mullo_epi16(gain, s);
+    const __m128i high = _mm_mulhi_epi16(gain, s);
+    const __m128i o0 = TruncateW32(_mm_srai_epi32(
+        _mm_add_epi32(_mm_unpacklo_epi16(low, high), round), 11));
+    const __m128i o1 = TruncateW32(_mm_srai_epi32(
+        _mm_add_epi32(_mm_unpackhi_epi16(low, high), round), 11));
+    const __m128i p = _mm_loadu_si128((const __m128i*)&psseq[i]);
+    /* The differences need 17 bits, but fit 16 after the shift */
+    const __m128i err = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_sub_epi32(ExtendLow(p), o0), 3),
+        _mm_srai_epi32(_mm_sub_epi32(ExtendHigh(p), o1), 3));
+    _mm_storeu_si128((__m128i*)&odata[i], _mm_packs_epi32(o0, o1));
+    /* Wraps around like the sum of the C code */
+    errs = _mm_add_epi32(errs, _mm_madd_epi16(err, err));
+  }
+
+  errs = _mm_add_epi32(errs, _mm_shuffle_epi32(errs, 0x4e));
+  errs = _mm_add_epi32(errs, _mm_shuffle_epi32(errs, 0xb1));
+  return _mm_cvtsi128_si32(errs);
+}
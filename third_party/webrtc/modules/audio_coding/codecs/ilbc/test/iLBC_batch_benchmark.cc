@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Load benchmark for IlbcBatchEngine. Every stream is a transcoding leg with
+// one encoder and one decoder instance; the decoder decodes what the encoder
+// produced for the previous frame. Frames are submitted in real time, one
+// batch per frame interval, with a deadline at the end of the interval. The
+// number of streams is increased until more than 1% of the frames miss their
+// deadline, and the largest number of streams that kept up is reported per
+// worker.
+//
+// Usage: iLBC_batch_benchmark <20|30> <input.pcm> [workers] [seconds]
+// The input is 16-bit mono PCM at 8 kHz, which every stream plays from a
+// different offset.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "modules/audio_coding/codecs/ilbc/ilbc_batch_engine.h"
+#include "rtc_base/event.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kMaxPayloadBytes = 50;
+const double kMaxMissRatio = 0.01;
+
+struct Leg {
+  int encoder;
+  int decoder;
+  size_t position;
+  uint8_t payload[2][kMaxPayloadBytes];
+  size_t payload_bytes;
+  std::vector<int16_t> decoded;
+};
+
+// Runs |num_streams| legs in real time for |num_frames| frame intervals.
+// Returns the ratio of frames that missed their deadline.
+double RunLoad(int16_t mode,
+               const std::vector<int16_t>& input,
+               size_t num_workers,
+               size_t num_streams,
+               size_t num_frames) {
+  IlbcBatchEngine engine(num_workers);
+  std::vector<Leg> legs(num_streams);
+  for (size_t i = 0; i < num_streams; ++i) {
+    legs[i].encoder = engine.AddEncoder(mode);
+    legs[i].decoder = engine.AddDecoder(mode);
+    if (legs[i].encoder < 0 || legs[i].decoder < 0) {
+      fprintf(stderr, "Error creating instances\n");
+      exit(1);
+    }
+    legs[i].position = (i * 797) % input.size();
+    legs[i].payload_bytes = 0;
+  }
+  const size_t frame_length = engine.FrameLength(legs[0].encoder);
+  const int64_t interval_us = mode * rtc::kNumMicrosecsPerMillisec;
+  for (Leg& leg : legs) {
+    leg.decoded.resize(frame_length);
+  }
+
+  std::vector<IlbcBatchEngine::Frame> frames(2 * num_streams);
+  std::vector<int16_t> speech(num_streams * frame_length);
+  rtc::Event timer(false, false);
+  int64_t start_us = rtc::TimeMicros();
+  for (size_t n = 0; n < num_frames; ++n) {
+    const int64_t deadline_us = start_us + interval_us;
+    for (size_t i = 0; i < num_streams; ++i) {
+      Leg& leg = legs[i];
+      int16_t* audio = &speech[i * frame_length];
+      for (size_t k = 0; k < frame_length; ++k) {
+        audio[k] = input[leg.position];
+        leg.position = (leg.position + 1) % input.size();
+      }
+      IlbcBatchEngine::Frame& encode = frames[2 * i];
+      encode = IlbcBatchEngine::Frame();
+      encode.stream = leg.encoder;
+      encode.audio = audio;
+      encode.payload = leg.payload[n % 2];
+      encode.deadline_us = deadline_us;
+
+      // The first decoder frame conceals the missing payload.
+      IlbcBatchEngine::Frame& decode = frames[2 * i + 1];
+      decode = IlbcBatchEngine::Frame();
+      decode.stream = leg.decoder;
+      decode.audio = leg.decoded.data();
+      decode.payload = leg.payload_bytes > 0 ? leg.payload[(n + 1) % 2]
+                                             : nullptr;
+      decode.payload_bytes = leg.payload_bytes;
+      decode.deadline_us = deadline_us;
+    }
+    engine.Process(frames);
+    for (size_t i = 0; i < num_streams; ++i) {
+      legs[i].payload_bytes = frames[2 * i].payload_bytes;
+    }
+
+    // Sleep until the next frame interval, or start it right away when
+    // behind.
+    const int64_t now_us = rtc::TimeMicros();
+    if (now_us < deadline_us) {
+      timer.Wait(static_cast<int>((deadline_us - now_us) /
+                                  rtc::kNumMicrosecsPerMillisec));
+      while (rtc::TimeMicros() < deadline_us) {
+      }
+      start_us = deadline_us;
+    } else {
+      start_us = now_us;
+    }
+  }
+
+  const IlbcBatchEngine::Stats stats = engine.GetStats();
+  return stats.frames > 0
+             ? static_cast<double>(stats.deadline_misses) / stats.frames
+             : 0.0;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    fprintf(stderr,
+            "Usage: %s <20|30> <input.pcm> [workers] [seconds]\n", argv[0]);
+    return 1;
+  }
+  const int16_t mode = static_cast<int16_t>(atoi(argv[1]));
+  if (mode != 20 && mode != 30) {
+    fprintf(stderr, "Mode must be 20 or 30\n");
+    return 1;
+  }
+  const size_t num_workers = argc > 3 ? atoi(argv[3]) : 1;
+  const int seconds = argc > 4 ? atoi(argv[4]) : 5;
+  if (num_workers < 1 || seconds < 1) {
+    fprintf(stderr, "Invalid number of workers or seconds\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[2], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[2]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read = 0;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  if (input.empty()) {
+    fprintf(stderr, "Empty input\n");
+    return 1;
+  }
+
+  const size_t num_frames = seconds * 1000 / mode;
+  printf("iLBC %d ms, %d workers, %d s per load\n", mode,
+         static_cast<int>(num_workers), seconds);
+  // Double the load until it is too high, then bisect.
+  size_t good = 0;
+  size_t bad = 0;
+  for (size_t streams = 8 * num_workers; bad == 0 || bad - good > 1;) {
+    const double misses =
+        webrtc::RunLoad(mode, input, num_workers, streams, num_frames);
+    printf("%6d streams: %6.2f%% deadline misses\n",
+           static_cast<int>(streams), 100.0 * misses);
+    if (misses <= webrtc::kMaxMissRatio) {
+      good = streams;
+    } else {
+      bad = streams;
+    }
+    streams = bad == 0 ? 2 * streams : (good + bad) / 2;
+    if (streams <= good) {
+      break;
+    }
+  }
+  printf("Max load: %d streams, %.1f streams/core\n", static_cast<int>(good),
+         static_cast<double>(good) / num_workers);
+  return 0;
+}
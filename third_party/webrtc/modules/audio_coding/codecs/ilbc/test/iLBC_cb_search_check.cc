@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the SSE2 codebook search of the iLBC encoder against the C code.
+// Every input is encoded once with the SSE2 criteria of
+// WebRtcIlbcfix_CbSearchCore() and the SSE2 WebRtcSpl_CrossCorrelation(),
+// as WebRtcIlbcfix_EncoderInit() and WebRtcSpl_Init() select them, and once
+// with the |use_sse2| flag of the encoder cleared after initialization and
+// the cross-correlation pointed at WebRtcSpl_CrossCorrelationC(). The
+// payloads of every frame must be identical. The encoder speed of both runs
+// is printed too, as a multiple of real time. Returns 0 if all payloads are
+// identical.
+//
+// Usage: iLBC_cb_search_check <20|30> <input1.pcm> [input2.pcm ...]
+//
+// The inputs are 16-bit mono PCM at 8 kHz, e.g. the iLBC test vectors
+// F00.INP to F06.INP of resources/audio_coding.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 8000;
+
+// Reads the 16-bit PCM of |file_name| into |samples|.
+bool ReadInput(const char* file_name, std::vector<int16_t>* samples) {
+  FILE* file = fopen(file_name, "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", file_name);
+    return false;
+  }
+  int16_t buffer[1024];
+  size_t read = 0;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    samples->insert(samples->end(), buffer, buffer + read);
+  }
+  fclose(file);
+  return true;
+}
+
+// Encodes the whole frames of |input| into |payloads|, with the SSE2 or the
+// C codebook search, and adds the time taken to |elapsed_ns|. Returns false
+// if the encoder fails.
+bool Encode(int16_t mode,
+            const std::vector<int16_t>& input,
+            bool use_sse2,
+            std::vector<uint8_t>* payloads,
+            int64_t* elapsed_ns) {
+  IlbcEncoderInstance* encoder = nullptr;
+  if (WebRtcIlbcfix_EncoderCreate(&encoder) != 0) {
+    fprintf(stderr, "Cannot create the encoder\n");
+    return false;
+  }
+  WebRtcIlbcfix_EncoderInit(encoder, mode);
+  IlbcEncoder* state = reinterpret_cast<IlbcEncoder*>(encoder);
+  state->use_sse2 = use_sse2 ? 1 : 0;
+  const CrossCorrelation cross_correlation = WebRtcSpl_CrossCorrelation;
+  if (!use_sse2) {
+    WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationC;
+  }
+
+  const size_t frame_samples = state->blockl;
+  const size_t payload_bytes = state->no_of_bytes;
+  const size_t num_frames = input.size() / frame_samples;
+  payloads->resize(num_frames * payload_bytes);
+  bool ok = true;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (size_t n = 0; n < num_frames && ok; ++n) {
+    ok = WebRtcIlbcfix_Encode(encoder, &input[n * frame_samples],
+                              frame_samples,
+                              &(*payloads)[n * payload_bytes]) ==
+         static_cast<int>(payload_bytes);
+  }
+  *elapsed_ns += rtc::TimeNanos() - start_ns;
+
+  WebRtcSpl_CrossCorrelation = cross_correlation;
+  WebRtcIlbcfix_EncoderFree(encoder);
+  if (!ok) {
+    fprintf(stderr, "Encoding failed\n");
+  }
+  return ok;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int16_t mode = argc > 1 ? static_cast<int16_t>(atoi(argv[1])) : 0;
+  if (argc < 3 || (mode != 20 && mode != 30)) {
+    fprintf(stderr, "Usage: %s <20|30> <input1.pcm> [input2.pcm ...]\n",
+            argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (!WebRtc_UseSSE2()) {
+    fprintf(stderr, "SSE2 is not available\n");
+    return 1;
+  }
+#endif
+  WebRtcSpl_Init();
+
+  const size_t payload_bytes = mode == 20 ? NO_OF_BYTES_20MS : NO_OF_BYTES_30MS;
+  size_t total_frames = 0;
+  size_t total_samples = 0;
+  size_t mismatches = 0;
+  int64_t sse2_ns = 0;
+  int64_t c_ns = 0;
+  for (int i = 2; i < argc; ++i) {
+    std::vector<int16_t> input;
+    if (!webrtc::ReadInput(argv[i], &input)) {
+      return 1;
+    }
+    std::vector<uint8_t> sse2;
+    std::vector<uint8_t> c;
+    if (!webrtc::Encode(mode, input, true, &sse2, &sse2_ns) ||
+        !webrtc::Encode(mode, input, false, &c, &c_ns)) {
+      return 1;
+    }
+    const size_t num_frames = sse2.size() / payload_bytes;
+    size_t file_mismatches = 0;
+    for (size_t n = 0; n < num_frames; ++n) {
+      if (memcmp(&sse2[n * payload_bytes], &c[n * payload_bytes],
+                 payload_bytes) == 0) {
+        continue;
+      }
+      if (mismatches == 0) {
+        printf("%s: frame %d differs\n", argv[i], static_cast<int>(n));
+      }
+      ++mismatches;
+      ++file_mismatches;
+    }
+    printf("%s: %d frames, %d differ\n", argv[i],
+           static_cast<int>(num_frames), static_cast<int>(file_mismatches));
+    total_frames += num_frames;
+    total_samples += num_frames * (mode == 20 ? BLOCKL_20MS : BLOCKL_30MS);
+  }
+
+  const double audio_ns = 1e9 * total_samples / webrtc::kSampleRateHz;
+  printf("%d frames, %d differ\n", static_cast<int>(total_frames),
+         static_cast<int>(mismatches));
+  printf("Encoder xRT: SSE2 %.1f, C %.1f\n",
+         sse2_ns > 0 ? audio_ns / sse2_ns : 0.0,
+         c_ns > 0 ? audio_ns / c_ns : 0.0);
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Decoder benchmark for iLBC under packet loss. The input is encoded once,
+// and then decoded with 0%, 5% and 20% of the frames lost at random (the same
+// frames in every run), which makes the enhancer run its backward PLC mixing
+// and the decoder conceal frames. The cost per frame is reported for the
+// received and the concealed frames, together with a checksum of the decoded
+// audio, which must not change with optimizations.
+//
+// Usage: iLBC_loss_benchmark <20|30> <input.pcm> [loops]
+// The input is 16-bit mono PCM at 8 kHz.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kMaxPayloadBytes = 50;
+const size_t kMaxFrameSamples = 240;
+const int kLossPercentages[] = {0, 5, 20};
+
+struct Result {
+  double received_ns = 0;
+  double concealed_ns = 0;
+  size_t received = 0;
+  size_t concealed = 0;
+  uint32_t checksum = 0;
+};
+
+// Decodes |payloads| |loops| times, losing the frames for which |lost| is set.
+Result RunDecoder(int16_t mode,
+                  const std::vector<uint8_t>& payloads,
+                  size_t payload_bytes,
+                  const std::vector<bool>& lost,
+                  int loops) {
+  IlbcDecoderInstance* decoder = nullptr;
+  WebRtcIlbcfix_DecoderCreate(&decoder);
+  int16_t decoded[kMaxFrameSamples];
+  int16_t speech_type;
+  int64_t received_ns = 0;
+  int64_t concealed_ns = 0;
+  Result result;
+  for (int loop = 0; loop < loops; ++loop) {
+    WebRtcIlbcfix_DecoderInit(decoder, mode);
+    for (size_t i = 0; i < lost.size(); ++i) {
+      const int64_t start_ns = rtc::TimeNanos();
+      int samples;
+      if (lost[i]) {
+        samples =
+            static_cast<int>(WebRtcIlbcfix_DecodePlc(decoder, decoded, 1));
+        concealed_ns += rtc::TimeNanos() - start_ns;
+        ++result.concealed;
+      } else {
+        samples = WebRtcIlbcfix_Decode(decoder, &payloads[i * payload_bytes],
+                                       payload_bytes, decoded, &speech_type);
+        received_ns += rtc::TimeNanos() - start_ns;
+        ++result.received;
+      }
+      if (loop == 0) {
+        for (int j = 0; j < samples; ++j) {
+          result.checksum =
+              result.checksum * 31 + static_cast<uint16_t>(decoded[j]);
+        }
+      }
+    }
+  }
+  WebRtcIlbcfix_DecoderFree(decoder);
+  if (result.received > 0) {
+    result.received_ns = static_cast<double>(received_ns) / result.received;
+  }
+  if (result.concealed > 0) {
+    result.concealed_ns = static_cast<double>(concealed_ns) / result.concealed;
+  }
+  return result;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s <20|30> <input.pcm> [loops]\n", argv[0]);
+    return 1;
+  }
+  const int16_t mode = static_cast<int16_t>(atoi(argv[1]));
+  if (mode != 20 && mode != 30) {
+    fprintf(stderr, "Mode must be 20 or 30\n");
+    return 1;
+  }
+  const int loops = argc > 3 ? atoi(argv[3]) : 10;
+  if (loops < 1) {
+    fprintf(stderr, "Invalid number of loops\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[2], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[2]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read = 0;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+
+  WebRtcSpl_Init();
+  const size_t frame_samples = 8 * mode;
+  const size_t num_frames = input.size() / frame_samples;
+  if (num_frames == 0) {
+    fprintf(stderr, "The input is shorter than one frame\n");
+    return 1;
+  }
+  IlbcEncoderInstance* encoder = nullptr;
+  WebRtcIlbcfix_EncoderCreate(&encoder);
+  WebRtcIlbcfix_EncoderInit(encoder, mode);
+  std::vector<uint8_t> payloads(num_frames * webrtc::kMaxPayloadBytes);
+  size_t payload_bytes = 0;
+  for (size_t i = 0; i < num_frames; ++i) {
+    const int bytes = WebRtcIlbcfix_Encode(
+        encoder, &input[i * frame_samples], frame_samples,
+        &payloads[i * webrtc::kMaxPayloadBytes]);
+    if (bytes <= 0) {
+      fprintf(stderr, "Encoding failed\n");
+      return 1;
+    }
+    payload_bytes = bytes;
+  }
+  WebRtcIlbcfix_EncoderFree(encoder);
+  // Pack the payloads back to back.
+  for (size_t i = 1; i < num_frames; ++i) {
+    std::copy(&payloads[i * webrtc::kMaxPayloadBytes],
+              &payloads[i * webrtc::kMaxPayloadBytes + payload_bytes],
+              &payloads[i * payload_bytes]);
+  }
+
+  printf("iLBC %d ms, %d frames, %d loops\n", mode,
+         static_cast<int>(num_frames), loops);
+  printf("%6s %14s %14s %14s %10s\n", "loss", "received_us", "concealed_us",
+         "average_us", "checksum");
+  for (int loss : webrtc::kLossPercentages) {
+    std::vector<bool> lost(num_frames);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < num_frames; ++i) {
+      seed = seed * 1103515245 + 12345;
+      lost[i] = static_cast<int>((seed >> 16) % 100) < loss;
+    }
+    const webrtc::Result result =
+        webrtc::RunDecoder(mode, payloads, payload_bytes, lost, loops);
+    const double average_ns =
+        (result.received_ns * result.received +
+         result.concealed_ns * result.concealed) /
+        (result.received + result.concealed);
+    printf("%5d%% %14.2f %14.2f %14.2f %10x\n", loss,
+           result.received_ns / 1000, result.concealed_ns / 1000,
+           average_ns / 1000, result.checksum);
+  }
+  return 0;
+}
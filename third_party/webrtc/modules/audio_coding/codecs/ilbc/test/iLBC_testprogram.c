@@ -22,12 +22,13 @@
 #include <string.h>
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
-#include "modules/audio_coding/codecs/ilbc/nit_encode.h"
+#include "modules/audio_coding/codecs/ilbc/init_encode.h"
 #include "modules/audio_coding/codecs/ilbc/encode.h"
 #include "modules/audio_coding/codecs/ilbc/init_decode.h"
 #include "modules/audio_coding/codecs/ilbc/decode.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
 #include "modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
 
 #define ILBCNOOFWORDS_MAX (NO_OF_BYTES_30MS)/2
 
@@ -46,7 +47,7 @@ short encode(                         /* (o) Number of bytes encoded */
                                                         ){
 
   /* do the actual encoding */
-  WebRtcIlbcfix_Encode((uint16_t *)encoded_data, data, iLBCenc_inst);
+  WebRtcIlbcfix_EncodeImpl((uint16_t *)encoded_data, data, iLBCenc_inst);
 
   return (iLBCenc_inst->no_of_bytes);
 }
@@ -69,8 +70,9 @@ short decode( /* (o) Number of decoded samples */
 
   /* do actual decoding of block */
 
-  WebRtcIlbcfix_Decode(decoded_data, (uint16_t *)encoded_data,
-                       iLBCdec_inst, mode);
+  if (WebRtcIlbcfix_DecodeImpl(decoded_data, (const uint16_t *)encoded_data,
+                                iLBCdec_inst, mode) == -1) {
+    printf("\nERROR - Decoding failed\n"); exit(3);}
 
   return (iLBCdec_inst->blockl);
 }
@@ -192,8 +194,11 @@ int main(int argc, char* argv[])
 
   /* Initialization */
 
-  WebRtcIlbcfix_EncoderInit(&Enc_Inst, mode);
-  WebRtcIlbcfix_DecoderInit(&Dec_Inst, mode, 1);
+  /* Select the fastest versions of the SPL functions for this CPU */
+  WebRtcSpl_Init();
+
+  WebRtcIlbcfix_InitEncode(&Enc_Inst, mode);
+  WebRtcIlbcfix_InitDecode(&Dec_Inst, mode, 1);
 
   /* extract the input file and channel file */
 
@@ -321,6 +326,12 @@ int main(int argc, char* argv[])
     printf("Time in iLBC_decode                :");
     printf(" %.1f s (%.1f%% of total runtime)\n\n",
            runtime2, 100.0*runtime2/(runtime1+runtime2));
+
+    /* Speed relative to real time (xRT), to compare optimizations */
+    printf("iLBC_encode speed                  :");
+    printf(" %.1f x realtime\n", outtime/runtime1);
+    printf("iLBC_decode speed                  :");
+    printf(" %.1f x realtime\n\n", outtime/runtime2);
 #endif
 
     /* Write data to files */
@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_CODEC_H_
 
 #include "modules/audio_coding/codecs/isac/fix/source/structs.h"
+#include "rtc_base/system/arch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -100,6 +101,17 @@ void WebRtcIsacfix_Spec2TimeNeon(int16_t* inreQ7,
                                  int32_t* outre2Q16);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsacfix_Time2SpecSSE2(int16_t* inre1Q9,
+                                 int16_t* inre2Q9,
+                                 int16_t* outre,
+                                 int16_t* outim);
+void WebRtcIsacfix_Spec2TimeSSE2(int16_t* inreQ7,
+                                 int16_t* inimQ7,
+                                 int32_t* outre1Q16,
+                                 int32_t* outre2Q16);
+#endif
+
 #if defined(MIPS32_LE)
 void WebRtcIsacfix_Time2SpecMIPS(int16_t* inre1Q9,
                                  int16_t* inre2Q9,
@@ -188,6 +200,21 @@ void WebRtcIsacfix_FilterMaLoopNeon(int16_t input0,
                                     int32_t* ptr2);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int WebRtcIsacfix_AutocorrSSE2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t N,
+                               int16_t order,
+                               int16_t* __restrict scale);
+
+void WebRtcIsacfix_FilterMaLoopSSE2(int16_t input0,
+                                    int16_t input1,
+                                    int32_t input2,
+                                    int32_t* ptr0,
+                                    int32_t* ptr1,
+                                    int32_t* ptr2);
+#endif
+
 #if defined(MIPS32_LE)
 int WebRtcIsacfix_AutocorrMIPS(int32_t* __restrict r,
                                const int16_t* __restrict x,
@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_ENTROPY_CODING_H_
 
 #include "modules/audio_coding/codecs/isac/fix/source/structs.h"
+#include "rtc_base/system/arch.h"
 
 /* decode complex spectrum (return number of bytes in stream) */
 int WebRtcIsacfix_DecodeSpec(Bitstr_dec* streamdata,
@@ -154,6 +155,25 @@ void WebRtcIsacfix_MatrixProduct2Neon(const int16_t matrix0[],
                                       const int matrix0_index_step);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsacfix_MatrixProduct1SSE2(const int16_t matrix0[],
+                                      const int32_t matrix1[],
+                                      int32_t matrix_product[],
+                                      const int matrix1_index_factor1,
+                                      const int matrix0_index_factor1,
+                                      const int matrix1_index_init_case,
+                                      const int matrix1_index_step,
+                                      const int matrix0_index_step,
+                                      const int inner_loop_count,
+                                      const int mid_loop_count,
+                                      const int shift);
+void WebRtcIsacfix_MatrixProduct2SSE2(const int16_t matrix0[],
+                                      const int32_t matrix1[],
+                                      int32_t matrix_product[],
+                                      const int matrix0_index_factor,
+                                      const int matrix0_index_step);
+#endif
+
 #if defined(MIPS32_LE)
 void WebRtcIsacfix_MatrixProduct1MIPS(const int16_t matrix0[],
                                       const int32_t matrix1[],
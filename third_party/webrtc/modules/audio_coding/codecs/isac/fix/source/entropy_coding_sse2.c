@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* This file contains WebRtcIsacfix_MatrixProduct1SSE2() and
+ * WebRtcIsacfix_MatrixProduct2SSE2() for x86 platforms with SSE2. API's are
+ * in entropy_coding.c. Results are bit exact with the c code for
+ * generic platforms. The index patterns vectorized are the same as in the
+ * ARM Neon version; the others use the C code.
+ */
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/entropy_coding.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+void WebRtcIsacfix_MatrixProduct1SSE2(const int16_t matrix0[],
+                                      const int32_t matrix1[],
+                                      int32_t matrix_product[],
+                                      const int matrix1_index_factor1,
+                                      const int matrix0_index_factor1,
+                                      const int matrix1_index_init_case,
+                                      const int matrix1_index_step,
+                                      const int matrix0_index_step,
+                                      const int inner_loop_count,
+                                      const int mid_loop_count,
+                                      const int shift) {
+  int j = 0, k = 0, n = 0;
+  int matrix1_index = 0, matrix0_index = 0, matrix_prod_index = 0;
+  int* matrix1_index_factor2 = &j;
+  int* matrix0_index_factor2 = &k;
+  const __m128i shift_v = _mm_cvtsi32_si128(shift);
+  if (matrix1_index_init_case != 0) {
+    matrix1_index_factor2 = &k;
+    matrix0_index_factor2 = &j;
+  }
+
+  for (j = 0; j < SUBFRAMES; j++) {
+    matrix_prod_index = mid_loop_count * j;
+    k = 0;
+    if (matrix1_index_init_case != 0 && matrix1_index_factor1 == 1) {
+      // Four consecutive k read consecutive elements of matrix1, and the same
+      // element of matrix0.
+      for (; k + 4 <= mid_loop_count; k += 4) {
+        __m128i sum = _mm_setzero_si128();
+        matrix1_index = k;
+        matrix0_index = matrix0_index_factor1 * j;
+        for (n = 0; n < inner_loop_count; n++) {
+          const __m128i matrix0_v = _mm_set1_epi32(matrix0[matrix0_index]);
+          const __m128i matrix1_v = _mm_sll_epi32(
+              _mm_loadu_si128((const __m128i*)&matrix1[matrix1_index]),
+              shift_v);
+          sum = _mm_add_epi32(
+              sum, WebRtcIsacfix_Mul16x32Rsft16SSE2(matrix0_v, matrix1_v));
+          matrix1_index += matrix1_index_step;
+          matrix0_index += matrix0_index_step;
+        }
+        _mm_storeu_si128((__m128i*)&matrix_product[matrix_prod_index], sum);
+        matrix_prod_index += 4;
+      }
+    } else if (matrix1_index_init_case == 0 && matrix0_index_factor1 == 1) {
+      // Four consecutive k read consecutive elements of matrix0, and the same
+      // element of matrix1.
+      for (; k + 4 <= mid_loop_count; k += 4) {
+        __m128i sum = _mm_setzero_si128();
+        matrix1_index = matrix1_index_factor1 * j;
+        matrix0_index = k;
+        for (n = 0; n < inner_loop_count; n++) {
+          const __m128i matrix0_v =
+              WebRtcIsacfix_LoadW16SSE2(&matrix0[matrix0_index]);
+          const __m128i matrix1_v =
+              _mm_set1_epi32(matrix1[matrix1_index] * (1 << shift));
+          sum = _mm_add_epi32(
+              sum, WebRtcIsacfix_Mul16x32Rsft16SSE2(matrix0_v, matrix1_v));
+          matrix1_index += matrix1_index_step;
+          matrix0_index += matrix0_index_step;
+        }
+        _mm_storeu_si128((__m128i*)&matrix_product[matrix_prod_index], sum);
+        matrix_prod_index += 4;
+      }
+    } else if (matrix1_index_init_case == 0 && matrix1_index_step == 1 &&
+               matrix0_index_step == 1) {
+      // The inner loop is a dot product of consecutive elements.
+      for (; k < mid_loop_count; k++) {
+        __m128i sum = _mm_setzero_si128();
+        int32_t sum32 = 0;
+        matrix1_index = matrix1_index_factor1 * j;
+        matrix0_index = matrix0_index_factor1 * k;
+        for (n = 0; n + 4 <= inner_loop_count; n += 4) {
+          const __m128i matrix0_v =
+              WebRtcIsacfix_LoadW16SSE2(&matrix0[matrix0_index]);
+          const __m128i matrix1_v = _mm_sll_epi32(
+              _mm_loadu_si128((const __m128i*)&matrix1[matrix1_index]),
+              shift_v);
+          sum = _mm_add_epi32(
+              sum, WebRtcIsacfix_Mul16x32Rsft16SSE2(matrix0_v, matrix1_v));
+          matrix1_index += 4;
+          matrix0_index += 4;
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+        sum32 = _mm_cvtsi128_si32(sum);
+        for (; n < inner_loop_count; n++) {
+          sum32 += WEBRTC_SPL_MUL_16_32_RSFT16(
+              matrix0[matrix0_index], matrix1[matrix1_index] * (1 << shift));
+          matrix1_index++;
+          matrix0_index++;
+        }
+        matrix_product[matrix_prod_index] = sum32;
+        matrix_prod_index++;
+      }
+    }
+
+    // The remaining k, and the index patterns that are not vectorized.
+    for (; k < mid_loop_count; k++) {
+      int32_t sum32 = 0;
+      matrix1_index = matrix1_index_factor1 * (*matrix1_index_factor2);
+      matrix0_index = matrix0_index_factor1 * (*matrix0_index_factor2);
+      for (n = 0; n < inner_loop_count; n++) {
+        sum32 += WEBRTC_SPL_MUL_16_32_RSFT16(
+            matrix0[matrix0_index], matrix1[matrix1_index] * (1 << shift));
+        matrix1_index += matrix1_index_step;
+        matrix0_index += matrix0_index_step;
+      }
+      matrix_product[matrix_prod_index] = sum32;
+      matrix_prod_index++;
+    }
+  }
+}
+
+// Computes two rows j and j + 1 of the product at a time, with the lanes
+// holding both columns of both rows.
+void WebRtcIsacfix_MatrixProduct2SSE2(const int16_t matrix0[],
+                                      const int32_t matrix1[],
+                                      int32_t matrix_product[],
+                                      const int matrix0_index_factor,
+                                      const int matrix0_index_step) {
+  int j = 0, n = 0;
+  int matrix1_index = 0, matrix0_index = 0, matrix_prod_index = 0;
+  for (j = 0; j < SUBFRAMES; j += 2) {
+    __m128i sum = _mm_setzero_si128();
+    matrix1_index = 0;
+    matrix0_index = matrix0_index_factor * j;
+    for (n = SUBFRAMES; n > 0; n--) {
+      const __m128i matrix0_v = _mm_set_epi32(
+          matrix0[matrix0_index + matrix0_index_factor],
+          matrix0[matrix0_index + matrix0_index_factor],
+          matrix0[matrix0_index], matrix0[matrix0_index]);
+      const __m128i columns =
+          _mm_loadl_epi64((const __m128i*)&matrix1[matrix1_index]);
+      const __m128i matrix1_v = _mm_unpacklo_epi64(columns, columns);
+      sum = _mm_add_epi32(
+          sum, WebRtcIsacfix_Mul16x32Rsft16SSE2(matrix0_v, matrix1_v));
+      matrix1_index += 2;
+      matrix0_index += matrix0_index_step;
+    }
+    _mm_storeu_si128((__m128i*)&matrix_product[matrix_prod_index],
+                     _mm_srai_epi32(sum, 3));
+    matrix_prod_index += 4;
+  }
+}
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Contains a function for WebRtcIsacfix_AllpassFilter2FixDec16SSE2()
+// in iSAC codec, optimized for SSE2. Bit exact with function
+// WebRtcIsacfix_AllpassFilter2FixDec16C() in filterbanks.c.
+//
+// As in the Neon version, the two all-pass sections of both channels run in
+// the four 32-bit lanes: channel 1 section 0, channel 1 section 1, channel 2
+// section 0 and channel 2 section 1. The second sections lag one sample
+// behind the first ones, whose outputs they take as inputs.
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/filterbank_internal.h"
+#include "rtc_base/checks.h"
+
+// WebRtcSpl_AddSatW32() in all lanes.
+static __inline __m128i AddSatW32(__m128i a, __m128i b) {
+  const __m128i sum = _mm_add_epi32(a, b);
+  // The addition overflows if a and b have the same sign, and the sum has
+  // the other one. The saturated value then has the sign of a.
+  const __m128i overflow = _mm_srai_epi32(
+      _mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+  const __m128i saturated =
+      _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff));
+  return _mm_or_si128(_mm_and_si128(overflow, saturated),
+                      _mm_andnot_si128(overflow, sum));
+}
+
+// Runs one sample through the four sections. Only the low 16 bits of the
+// lanes of |in_out| are used, and on return they hold the outputs. The high
+// 16 bits of the lanes of |factors| are zero, so that _mm_madd_epi16()
+// multiplies the low 16 bits only. Lanes where |keep| is set are not updated.
+static __inline __m128i AllpassStep(__m128i in_out,
+                                    __m128i factors,
+                                    __m128i keep,
+                                    __m128i* state) {
+  // a = factor * in_out in Q16, b = a + state.
+  const __m128i a = _mm_slli_epi32(_mm_madd_epi16(in_out, factors), 1);
+  const __m128i b = AddSatW32(a, *state);
+  const __m128i out = _mm_srai_epi32(b, 16);
+  // The new state is -factor * out in Q16, plus in_out in Q16.
+  const __m128i c = _mm_slli_epi32(
+      _mm_sub_epi32(_mm_setzero_si128(), _mm_madd_epi16(out, factors)), 1);
+  const __m128i new_state = AddSatW32(c, _mm_slli_epi32(in_out, 16));
+  *state = _mm_or_si128(_mm_and_si128(keep, *state),
+                        _mm_andnot_si128(keep, new_state));
+  return _mm_or_si128(_mm_and_si128(keep, in_out),
+                      _mm_andnot_si128(keep, out));
+}
+
+// Moves the outputs of the first sections to the inputs of the second ones,
+// and loads the next input samples into the first ones.
+static __inline __m128i NextInput(__m128i out,
+                                  const int16_t* data_ch1,
+                                  const int16_t* data_ch2) {
+  __m128i in = _mm_slli_si128(out, 4);
+  in = _mm_insert_epi16(in, *data_ch1, 0);
+  return _mm_insert_epi16(in, *data_ch2, 4);
+}
+
+void WebRtcIsacfix_AllpassFilter2FixDec16SSE2(
+    int16_t* data_ch1,  // Input and output in channel 1, in Q0
+    int16_t* data_ch2,  // Input and output in channel 2, in Q0
+    const int16_t* factor_ch1,  // Scaling factor for channel 1, in Q15
+    const int16_t* factor_ch2,  // Scaling factor for channel 2, in Q15
+    const int length,  // Length of the data buffers
+    int32_t* filter_state_ch1,  // Filter state for channel 1, in Q16
+    int32_t* filter_state_ch2) {  // Filter state for channel 2, in Q16
+  const __m128i factors = _mm_set_epi32(
+      (uint16_t)factor_ch2[1], (uint16_t)factor_ch2[0],
+      (uint16_t)factor_ch1[1], (uint16_t)factor_ch1[0]);
+  // Masks of the lanes of the first and the second sections.
+  const __m128i first = _mm_set_epi32(0, -1, 0, -1);
+  const __m128i second = _mm_set_epi32(-1, 0, -1, 0);
+  __m128i state = _mm_set_epi32(filter_state_ch2[1], filter_state_ch2[0],
+                                filter_state_ch1[1], filter_state_ch1[0]);
+  __m128i in_out = _mm_setzero_si128();
+  int n = 0;
+
+  // Assembly file assumption.
+  RTC_DCHECK_EQ(0, length % 2);
+
+  // The first sample only goes through the first sections.
+  in_out = NextInput(in_out, &data_ch1[0], &data_ch2[0]);
+  in_out = AllpassStep(in_out, factors, second, &state);
+
+  for (n = 1; n < length; n++) {
+    in_out = NextInput(in_out, &data_ch1[n], &data_ch2[n]);
+    in_out = AllpassStep(in_out, factors, _mm_setzero_si128(), &state);
+    data_ch1[n - 1] = (int16_t)_mm_extract_epi16(in_out, 2);
+    data_ch2[n - 1] = (int16_t)_mm_extract_epi16(in_out, 6);
+  }
+
+  // The last sample only goes through the second sections.
+  in_out = _mm_slli_si128(in_out, 4);
+  in_out = AllpassStep(in_out, factors, first, &state);
+  data_ch1[length - 1] = (int16_t)_mm_extract_epi16(in_out, 2);
+  data_ch2[length - 1] = (int16_t)_mm_extract_epi16(in_out, 6);
+
+  filter_state_ch1[0] = _mm_cvtsi128_si32(state);
+  filter_state_ch1[1] = _mm_cvtsi128_si32(_mm_shuffle_epi32(state, 0x55));
+  filter_state_ch2[0] = _mm_cvtsi128_si32(_mm_shuffle_epi32(state, 0xaa));
+  filter_state_ch2[1] = _mm_cvtsi128_si32(_mm_shuffle_epi32(state, 0xff));
+}
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "rtc_base/checks.h"
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+
+// Sum of x[j] * y[j] for 0 <= j < length, in 64 bits.
+static int64_t DotProduct(const int16_t* x, const int16_t* y, int length) {
+  // _mm_madd_epi16() sums two products in 32 bits, which only overflows for
+  // 2 * (-32768 * -32768) = 2^31. The sums minus one always fit, and are sign
+  // extended and accumulated in 64 bits. The ones are added back at the end.
+  const __m128i one = _mm_set1_epi32(1);
+  __m128i sum = _mm_setzero_si128();
+  int64_t prod = 0;
+  int j = 0;
+
+  for (j = 0; j + 8 <= length; j += 8) {
+    const __m128i p = _mm_sub_epi32(
+        _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&x[j]),
+                       _mm_loadu_si128((const __m128i*)&y[j])),
+        one);
+    const __m128i sign = _mm_srai_epi32(p, 31);
+    sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(p, sign));
+    sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(p, sign));
+  }
+  sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+  _mm_storel_epi64((__m128i*)&prod, sum);
+  prod += j / 2;
+
+  for (; j < length; j++) {
+    prod += x[j] * y[j];
+  }
+  return prod;
+}
+
+// Autocorrelation function in fixed point.
+// NOTE! Different from SPLIB-version in how it scales the signal.
+int WebRtcIsacfix_AutocorrSSE2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t N,
+                               int16_t order,
+                               int16_t* __restrict scale) {
+  int i = 0;
+  int16_t scaling = 0;
+  uint32_t temp = 0;
+  int64_t prod = 0;
+
+  RTC_DCHECK_EQ(0, N % 4);
+  RTC_DCHECK_GE(N, 8);
+
+  // Calculate r[0].
+  prod = DotProduct(x, x, N);
+
+  // Calculate scaling (the value of shifting).
+  temp = (uint32_t)(prod >> 31);
+  scaling = temp ? 32 - WebRtcSpl_NormU32(temp) : 0;
+  r[0] = (int32_t)(prod >> scaling);
+
+  // Perform the actual correlation calculation.
+  for (i = 1; i < order + 1; i++) {
+    r[i] = (int32_t)(DotProduct(x, &x[i], N - i) >> scaling);
+  }
+
+  *scale = scaling;
+
+  return order + 1;
+}
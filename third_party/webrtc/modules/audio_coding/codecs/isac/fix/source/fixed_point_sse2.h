@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * fixed_point_sse2.h
+ *
+ * SSE2 versions of the 16 x 32 bit multiplication macros of SPL, for four
+ * 32-bit lanes at a time. In all of them, |a| holds 16-bit values sign
+ * extended to 32 bits. The results are bit exact with the macros.
+ *
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
+#define MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
+
+#include <emmintrin.h>
+#include <stdint.h>
+
+/* a * (b >> 16). */
+static __inline __m128i WebRtcIsacfix_MulHighSSE2(__m128i a, __m128i b) {
+  return _mm_madd_epi16(b, _mm_slli_epi32(a, 16));
+}
+
+/* a * (uint16_t)b. The low 16 bits of b are unsigned, so the signed high half
+   of the product is corrected by a wherever their top bit is set. */
+static __inline __m128i WebRtcIsacfix_MulLowSSE2(__m128i a, __m128i b) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  const __m128i high = _mm_add_epi16(
+      _mm_mulhi_epi16(a, b), _mm_and_si128(a, _mm_srai_epi16(b, 15)));
+  return _mm_or_si128(_mm_srli_epi32(_mm_slli_epi32(low, 16), 16),
+                      _mm_slli_epi32(high, 16));
+}
+
+/* (int32_t)(a * b), i.e. WEBRTC_SPL_MUL() of a 16-bit and a 32-bit value. */
+static __inline __m128i WebRtcIsacfix_MulSSE2(__m128i a, __m128i b) {
+  return _mm_add_epi32(_mm_slli_epi32(WebRtcIsacfix_MulHighSSE2(a, b), 16),
+                       WebRtcIsacfix_MulLowSSE2(a, b));
+}
+
+/* WEBRTC_SPL_MUL_16_32_RSFT16(a, b). */
+static __inline __m128i WebRtcIsacfix_Mul16x32Rsft16SSE2(__m128i a,
+                                                         __m128i b) {
+  /* The low 16 bits of b shifted right by one are positive 16-bit values. */
+  const __m128i low = _mm_madd_epi16(
+      _mm_srli_epi32(_mm_slli_epi32(b, 16), 17), a);
+  return _mm_add_epi32(
+      WebRtcIsacfix_MulHighSSE2(a, b),
+      _mm_srai_epi32(_mm_add_epi32(low, _mm_set1_epi32(0x4000)), 15));
+}
+
+/* WEBRTC_SPL_MUL_16_32_RSFT11(a, b). */
+static __inline __m128i WebRtcIsacfix_Mul16x32Rsft11SSE2(__m128i a,
+                                                         __m128i b) {
+  const __m128i low = _mm_srai_epi32(WebRtcIsacfix_MulLowSSE2(a, b), 1);
+  return _mm_add_epi32(
+      _mm_slli_epi32(WebRtcIsacfix_MulHighSSE2(a, b), 5),
+      _mm_srai_epi32(_mm_add_epi32(low, _mm_set1_epi32(0x0200)), 10));
+}
+
+/* WEBRTC_SPL_MUL_16_32_RSFT14(a, b). */
+static __inline __m128i WebRtcIsacfix_Mul16x32Rsft14SSE2(__m128i a,
+                                                         __m128i b) {
+  const __m128i low = _mm_srai_epi32(WebRtcIsacfix_MulLowSSE2(a, b), 1);
+  return _mm_add_epi32(
+      _mm_slli_epi32(WebRtcIsacfix_MulHighSSE2(a, b), 2),
+      _mm_srai_epi32(_mm_add_epi32(low, _mm_set1_epi32(0x1000)), 13));
+}
+
+/* WEBRTC_SPL_MUL_16_32_RSFT15(a, b). */
+static __inline __m128i WebRtcIsacfix_Mul16x32Rsft15SSE2(__m128i a,
+                                                         __m128i b) {
+  const __m128i low = _mm_srai_epi32(WebRtcIsacfix_MulLowSSE2(a, b), 1);
+  return _mm_add_epi32(
+      _mm_slli_epi32(WebRtcIsacfix_MulHighSSE2(a, b), 1),
+      _mm_srai_epi32(_mm_add_epi32(low, _mm_set1_epi32(0x2000)), 14));
+}
+
+/* Loads four 16-bit values, sign extended to 32 bits. */
+static __inline __m128i WebRtcIsacfix_LoadW16SSE2(const int16_t* p) {
+  const __m128i v = _mm_loadl_epi64((const __m128i*)p);
+  return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+/* Truncates the 32-bit lanes of |a| and |b| to 16 bits, like a cast to
+   int16_t, and packs them into one vector. */
+static __inline __m128i WebRtcIsacfix_PackW32ToW16SSE2(__m128i a, __m128i b) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+
+#endif /* MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_ */
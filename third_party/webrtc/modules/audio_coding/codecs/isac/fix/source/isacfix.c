@@ -26,6 +26,7 @@
 #include "modules/audio_coding/codecs/isac/fix/source/filterbank_internal.h"
 #include "modules/audio_coding/codecs/isac/fix/source/lpc_masking_model.h"
 #include "modules/audio_coding/codecs/isac/fix/source/structs.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
 // Declare function pointers.
@@ -214,6 +215,26 @@ static void WebRtcIsacfix_InitNeon(void) {
 }
 #endif
 
+/****************************************************************************
+ * WebRtcIsacfix_InitSSE2(...)
+ *
+ * This function initializes function pointers for x86 platforms with SSE2.
+ */
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+static void WebRtcIsacfix_InitSSE2(void) {
+  WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrSSE2;
+  WebRtcIsacfix_FilterMaLoopFix = WebRtcIsacfix_FilterMaLoopSSE2;
+  WebRtcIsacfix_Spec2Time = WebRtcIsacfix_Spec2TimeSSE2;
+  WebRtcIsacfix_Time2Spec = WebRtcIsacfix_Time2SpecSSE2;
+  WebRtcIsacfix_AllpassFilter2FixDec16 =
+      WebRtcIsacfix_AllpassFilter2FixDec16SSE2;
+  WebRtcIsacfix_MatrixProduct1 = WebRtcIsacfix_MatrixProduct1SSE2;
+  WebRtcIsacfix_MatrixProduct2 = WebRtcIsacfix_MatrixProduct2SSE2;
+  WebRtcIsacfix_WindowAutocorrInput = WebRtcIsacfix_WindowAutocorrInputSSE2;
+}
+#endif
+
 /****************************************************************************
  * WebRtcIsacfix_InitMIPS(...)
  *
@@ -246,6 +267,7 @@ static void InitFunctionPointers(void) {
   WebRtcIsacfix_FilterMaLoopFix = WebRtcIsacfix_FilterMaLoopC;
   WebRtcIsacfix_CalculateResidualEnergy =
       WebRtcIsacfix_CalculateResidualEnergyC;
+  WebRtcIsacfix_WindowAutocorrInput = WebRtcIsacfix_WindowAutocorrInputC;
   WebRtcIsacfix_AllpassFilter2FixDec16 = WebRtcIsacfix_AllpassFilter2FixDec16C;
   WebRtcIsacfix_HighpassFilterFixDec32 = WebRtcIsacfix_HighpassFilterFixDec32C;
   WebRtcIsacfix_Time2Spec = WebRtcIsacfix_Time2SpecC;
@@ -257,6 +279,12 @@ static void InitFunctionPointers(void) {
   WebRtcIsacfix_InitNeon();
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtcIsacfix_InitSSE2();
+  }
+#endif
+
 #if defined(MIPS32_LE)
   WebRtcIsacfix_InitMIPS();
 #endif
@@ -456,6 +456,18 @@ static __inline int16_t  exp2_Q10_T(int16_t x) { // Both in and out in Q10
 // Declare function pointers.
 AutocorrFix WebRtcIsacfix_AutocorrFix;
 CalculateResidualEnergy WebRtcIsacfix_CalculateResidualEnergy;
+WindowAutocorrInput WebRtcIsacfix_WindowAutocorrInput;
+
+void WebRtcIsacfix_WindowAutocorrInputC(const int16_t* input,
+                                        const int16_t* window,
+                                        int length,
+                                        int16_t* output) {
+  int n;
+
+  for (n = 0; n < length; n++) {
+    output[n] = (int16_t)(input[n] * window[n] >> 15);  // Q0*Q21>>15 = Q6
+  }
+}
 
 /* This routine calculates the residual energy for LPC.
  * Formula as shown in comments inside.
@@ -610,25 +622,23 @@ void WebRtcIsacfix_GetLpcCoef(int16_t *inLoQ0,
 
   for (k = 0; k < SUBFRAMES; k++) {
 
-    /* Update input buffer and multiply signal with window */
+    /* Update input buffer */
     for (pos1 = 0; pos1 < WINLEN - UPDATE/2; pos1++) {
       maskdata->DataBufferLoQ0[pos1] = maskdata->DataBufferLoQ0[pos1 + UPDATE/2];
       maskdata->DataBufferHiQ0[pos1] = maskdata->DataBufferHiQ0[pos1 + UPDATE/2];
-      DataLoQ6[pos1] = (int16_t)(maskdata->DataBufferLoQ0[pos1] *
-          kWindowAutocorr[pos1] >> 15);  // Q0*Q21>>15 = Q6
-      DataHiQ6[pos1] = (int16_t)(maskdata->DataBufferHiQ0[pos1] *
-          kWindowAutocorr[pos1] >> 15);  // Q0*Q21>>15 = Q6
     }
     pos2 = (int16_t)(k * UPDATE / 2);
     for (n = 0; n < UPDATE/2; n++, pos1++) {
       maskdata->DataBufferLoQ0[pos1] = inLoQ0[QLOOKAHEAD + pos2];
       maskdata->DataBufferHiQ0[pos1] = inHiQ0[pos2++];
-      DataLoQ6[pos1] = (int16_t)(maskdata->DataBufferLoQ0[pos1] *
-          kWindowAutocorr[pos1] >> 15);  // Q0*Q21>>15 = Q6
-      DataHiQ6[pos1] = (int16_t)(maskdata->DataBufferHiQ0[pos1] *
-          kWindowAutocorr[pos1] >> 15);  // Q0*Q21>>15 = Q6
     }
 
+    /* Multiply signal with window */
+    WebRtcIsacfix_WindowAutocorrInput(maskdata->DataBufferLoQ0,
+                                      kWindowAutocorr, WINLEN, DataLoQ6);
+    WebRtcIsacfix_WindowAutocorrInput(maskdata->DataBufferHiQ0,
+                                      kWindowAutocorr, WINLEN, DataHiQ6);
+
     /* Get correlation coefficients */
     /* The highest absolute value measured inside DataLo in the test set
        For DataHi, corresponding value was 160.
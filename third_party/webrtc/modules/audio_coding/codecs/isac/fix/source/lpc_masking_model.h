@@ -23,6 +23,7 @@ extern "C" {
 #endif
 
 #include "modules/audio_coding/codecs/isac/fix/source/structs.h"
+#include "rtc_base/system/arch.h"
 
 void WebRtcIsacfix_GetVars(const int16_t* input,
                            const int16_t* pitchGains_Q12,
@@ -53,6 +54,25 @@ int32_t WebRtcIsacfix_CalculateResidualEnergyC(int lpc_order,
                                                int32_t* corr_coeffs,
                                                int* q_val_residual_energy);
 
+/* Multiplies |input| in Q0 with |window| in Q21, into |output| in Q6. */
+typedef void (*WindowAutocorrInput)(const int16_t* input,
+                                    const int16_t* window,
+                                    int length,
+                                    int16_t* output);
+extern WindowAutocorrInput WebRtcIsacfix_WindowAutocorrInput;
+
+void WebRtcIsacfix_WindowAutocorrInputC(const int16_t* input,
+                                        const int16_t* window,
+                                        int length,
+                                        int16_t* output);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsacfix_WindowAutocorrInputSSE2(const int16_t* input,
+                                           const int16_t* window,
+                                           int length,
+                                           int16_t* output);
+#endif
+
 #if defined(MIPS_DSP_R2_LE)
 int32_t WebRtcIsacfix_CalculateResidualEnergyMIPS(int lpc_order,
                                                   int32_t q_val_corr,
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* This file contains WebRtcIsacfix_WindowAutocorrInputSSE2() for x86
+ * platforms with SSE2. API's are in lpc_masking_model.c. Results are bit
+ * exact with the c code for generic platforms.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/lpc_masking_model.h"
+
+void WebRtcIsacfix_WindowAutocorrInputSSE2(const int16_t* input,
+                                           const int16_t* window,
+                                           int length,
+                                           int16_t* output) {
+  int n = 0;
+
+  // The C code keeps the low 16 bits of the 32-bit product shifted right by
+  // 15, which are the bits 0 to 14 of the high half of the product, shifted
+  // left by one, and the bit 15 of the low half.
+  for (; n + 8 <= length; n += 8) {
+    const __m128i input_v = _mm_loadu_si128((const __m128i*)&input[n]);
+    const __m128i window_v = _mm_loadu_si128((const __m128i*)&window[n]);
+    const __m128i low = _mm_mullo_epi16(input_v, window_v);
+    const __m128i high = _mm_mulhi_epi16(input_v, window_v);
+    _mm_storeu_si128((__m128i*)&output[n],
+                     _mm_or_si128(_mm_slli_epi16(high, 1),
+                                  _mm_srli_epi16(low, 15)));
+  }
+
+  for (; n < length; n++) {
+    output[n] = (int16_t)(input[n] * window[n] >> 15);  // Q0*Q21>>15 = Q6
+  }
+}
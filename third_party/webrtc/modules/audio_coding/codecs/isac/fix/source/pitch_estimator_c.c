@@ -25,16 +25,15 @@ void WebRtcIsacfix_PCorr2Q32(const int16_t* in, int32_t* logcorQ8) {
   const int32_t oneQ8 = 1 << 8;  // 1.00 in Q8
   const int16_t* x;
   const int16_t* inptr;
+  WebRtcSpl_VectorStats in_stats;
 
-  x = in + PITCH_MAX_LAG / 2 + 2;
-  scaling = WebRtcSpl_GetScalingSquare((int16_t*)in,
-                                       PITCH_CORR_LEN2,
-                                       PITCH_CORR_LEN2);
-  ysum32 = 1;
+  // The scaling and the energy of |in| are those of WebRtcSpl_Energy().
+  WebRtcSpl_GetVectorStatsW16(in, PITCH_CORR_LEN2, &in_stats);
+  scaling = in_stats.energy_scale;
+  ysum32 = 1 + in_stats.energy;  // Q0
   csum32 = 0;
   x = in + PITCH_MAX_LAG / 2 + 2;
   for (n = 0; n < PITCH_CORR_LEN2; n++) {
-    ysum32 += in[n] * in[n] >> scaling;  // Q0
     csum32 += x[n] * in[n] >> scaling;  // Q0
   }
   logcorQ8 += PITCH_LAG_SPAN2 - 1;
@@ -0,0 +1,282 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * transform_sse2.c
+ *
+ * SSE2 versions of WebRtcIsacfix_Time2SpecC() and WebRtcIsacfix_Spec2TimeC()
+ * in transform.c. Bit exact with the C code; the FFT itself is shared.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fft.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "modules/audio_coding/codecs/isac/fix/source/settings.h"
+
+/* Tables are defined in transform_tables.c file. */
+/* Cosine table 1 in Q14 */
+extern const int16_t WebRtcIsacfix_kCosTab1[FRAMESAMPLES/2];
+/* Sine table 1 in Q14 */
+extern const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2];
+/* Sine table 2 in Q14 */
+extern const int16_t WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4];
+
+/* Loads p[0], p[-1], p[-2], p[-3], sign extended to 32 bits. */
+static __inline __m128i LoadW16Reversed(const int16_t* p) {
+  return _mm_shuffle_epi32(WebRtcIsacfix_LoadW16SSE2(p - 3), 0x1b);
+}
+
+/* Stores the four 32-bit lanes of |v| truncated to 16 bits. */
+static __inline void StoreW16(int16_t* p, __m128i v) {
+  _mm_storel_epi64((__m128i*)p, WebRtcIsacfix_PackW32ToW16SSE2(v, v));
+}
+
+/* Stores v[3], v[2], v[1], v[0] truncated to 16 bits at p[-3], ..., p[0]. */
+static __inline void StoreW16Reversed(int16_t* p, __m128i v) {
+  StoreW16(p - 3, _mm_shuffle_epi32(v, 0x1b));
+}
+
+/* The sine factors of the separation into two complex vectors, which are
+   -kSinTab2[FRAMESAMPLES/4 - 1 - k] and kSinTab2[k], for four k. */
+static __inline void LoadSinTab2(int k, __m128i* tmp1r, __m128i* tmp1i) {
+  *tmp1r = _mm_sub_epi32(_mm_setzero_si128(),
+      LoadW16Reversed(&WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4 - 1 - k]));
+  *tmp1i = WebRtcIsacfix_LoadW16SSE2(&WebRtcIsacfix_kSinTab2[k]);
+}
+
+/* Scales |inre| and |inim| by 2^sh and truncates them to 16 bits, rounding
+   when shifting to the right, for the FFT. */
+static void PreShift(const int32_t* inre,
+                     const int32_t* inim,
+                     int16_t* outre,
+                     int16_t* outim,
+                     int16_t sh) {
+  int k;
+  if (sh >= 0) {
+    const __m128i shift = _mm_cvtsi32_si128(sh);
+    for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+      _mm_storeu_si128((__m128i*)&outre[k], WebRtcIsacfix_PackW32ToW16SSE2(
+          _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&inre[k]), shift),
+          _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&inre[k + 4]),
+                        shift)));
+      _mm_storeu_si128((__m128i*)&outim[k], WebRtcIsacfix_PackW32ToW16SSE2(
+          _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&inim[k]), shift),
+          _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&inim[k + 4]),
+                        shift)));
+    }
+  } else {
+    const __m128i shift = _mm_cvtsi32_si128(-sh);
+    const __m128i round = _mm_set1_epi32(1 << (-sh - 1));
+    for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+      __m128i re0 = _mm_loadu_si128((const __m128i*)&inre[k]);
+      __m128i re1 = _mm_loadu_si128((const __m128i*)&inre[k + 4]);
+      __m128i im0 = _mm_loadu_si128((const __m128i*)&inim[k]);
+      __m128i im1 = _mm_loadu_si128((const __m128i*)&inim[k + 4]);
+      re0 = _mm_sra_epi32(_mm_add_epi32(re0, round), shift);
+      re1 = _mm_sra_epi32(_mm_add_epi32(re1, round), shift);
+      im0 = _mm_sra_epi32(_mm_add_epi32(im0, round), shift);
+      im1 = _mm_sra_epi32(_mm_add_epi32(im1, round), shift);
+      _mm_storeu_si128((__m128i*)&outre[k],
+                       WebRtcIsacfix_PackW32ToW16SSE2(re0, re1));
+      _mm_storeu_si128((__m128i*)&outim[k],
+                       WebRtcIsacfix_PackW32ToW16SSE2(im0, im1));
+    }
+  }
+}
+
+/* Loads four outputs of the FFT from |in| and scales them by 2^-sh. */
+static __inline __m128i PostShift(const int16_t* in, int16_t sh) {
+  const __m128i v = WebRtcIsacfix_LoadW16SSE2(in);
+  if (sh >= 0) {
+    return _mm_sra_epi32(v, _mm_cvtsi32_si128(sh));
+  }
+  return _mm_sll_epi32(v, _mm_cvtsi32_si128(-sh));
+}
+
+/* The normalization shift of the FFT input, for which the largest absolute
+   value of |re| and |im| becomes Q(16+sh) with 7 significant bits. */
+static int16_t NormShift(const int32_t* re, const int32_t* im) {
+  int32_t max_re = WebRtcSpl_MaxAbsValueW32(re, FRAMESAMPLES/2);
+  const int32_t max_im = WebRtcSpl_MaxAbsValueW32(im, FRAMESAMPLES/2);
+  if (max_im > max_re) {
+    max_re = max_im;
+  }
+  return WebRtcSpl_NormW32(max_re) - 24;
+}
+
+void WebRtcIsacfix_Time2SpecSSE2(int16_t* inre1Q9,
+                                 int16_t* inre2Q9,
+                                 int16_t* outreQ7,
+                                 int16_t* outimQ7) {
+  int k;
+  int32_t tmpreQ16[FRAMESAMPLES/2], tmpimQ16[FRAMESAMPLES/2];
+  int16_t sh;
+  /* 0.5/sqrt(240) in Q19 is round(.5/sqrt(240)*(2^19)) = 16921 */
+  const __m128i factQ19 = _mm_set1_epi32(16921);
+  const __m128i four = _mm_set1_epi32(4);
+
+  /* Multiply with complex exponentials and combine into one complex vector.
+     The products of both inputs are summed pairwise by _mm_madd_epi16(). */
+  for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+    const __m128i re = _mm_loadu_si128((const __m128i*)&inre1Q9[k]);
+    const __m128i im = _mm_loadu_si128((const __m128i*)&inre2Q9[k]);
+    const __m128i tmp1rQ14 = _mm_loadu_si128(
+        (const __m128i*)&WebRtcIsacfix_kCosTab1[k]);
+    const __m128i tmp1iQ14 = _mm_loadu_si128(
+        (const __m128i*)&WebRtcIsacfix_kSinTab1[k]);
+    const __m128i minus_tmp1iQ14 =
+        _mm_sub_epi16(_mm_setzero_si128(), tmp1iQ14);
+    const __m128i cos_sin_lo = _mm_unpacklo_epi16(tmp1rQ14, tmp1iQ14);
+    const __m128i cos_sin_hi = _mm_unpackhi_epi16(tmp1rQ14, tmp1iQ14);
+    const __m128i cos_minus_sin_lo =
+        _mm_unpacklo_epi16(tmp1rQ14, minus_tmp1iQ14);
+    const __m128i cos_minus_sin_hi =
+        _mm_unpackhi_epi16(tmp1rQ14, minus_tmp1iQ14);
+    __m128i xr0 = _mm_srai_epi32(
+        _mm_madd_epi16(_mm_unpacklo_epi16(re, im), cos_sin_lo), 7);
+    __m128i xr1 = _mm_srai_epi32(
+        _mm_madd_epi16(_mm_unpackhi_epi16(re, im), cos_sin_hi), 7);
+    __m128i xi0 = _mm_srai_epi32(
+        _mm_madd_epi16(_mm_unpacklo_epi16(im, re), cos_minus_sin_lo), 7);
+    __m128i xi1 = _mm_srai_epi32(
+        _mm_madd_epi16(_mm_unpackhi_epi16(im, re), cos_minus_sin_hi), 7);
+    /* Q-domains below: (Q16*Q19>>16)>>3 = Q16 */
+    xr0 = WebRtcIsacfix_Mul16x32Rsft16SSE2(factQ19, xr0);
+    xr1 = WebRtcIsacfix_Mul16x32Rsft16SSE2(factQ19, xr1);
+    xi0 = WebRtcIsacfix_Mul16x32Rsft16SSE2(factQ19, xi0);
+    xi1 = WebRtcIsacfix_Mul16x32Rsft16SSE2(factQ19, xi1);
+    _mm_storeu_si128((__m128i*)&tmpreQ16[k],
+                     _mm_srai_epi32(_mm_add_epi32(xr0, four), 3));
+    _mm_storeu_si128((__m128i*)&tmpreQ16[k + 4],
+                     _mm_srai_epi32(_mm_add_epi32(xr1, four), 3));
+    _mm_storeu_si128((__m128i*)&tmpimQ16[k],
+                     _mm_srai_epi32(_mm_add_epi32(xi0, four), 3));
+    _mm_storeu_si128((__m128i*)&tmpimQ16[k + 4],
+                     _mm_srai_epi32(_mm_add_epi32(xi1, four), 3));
+  }
+
+  sh = NormShift(tmpreQ16, tmpimQ16);
+  PreShift(tmpreQ16, tmpimQ16, inre1Q9, inre2Q9, sh);
+
+  /* Get DFT */
+  WebRtcIsacfix_FftRadix16Fastest(inre1Q9, inre2Q9, -1); // real call
+
+  /* Use symmetry to separate into two complex vectors and center frames in
+     time around zero. Lanes k, ..., k + 3 of the first half are processed
+     together with FRAMESAMPLES/2 - 1 - k, ..., FRAMESAMPLES/2 - 4 - k of the
+     second half. */
+  for (k = 0; k < FRAMESAMPLES/4; k += 4) {
+    const int m = FRAMESAMPLES/2 - 1 - k;
+    const __m128i re = PostShift(&inre1Q9[k], sh);
+    const __m128i im = PostShift(&inre2Q9[k], sh);
+    const __m128i re_mirror = _mm_shuffle_epi32(PostShift(&inre1Q9[m - 3], sh),
+                                                0x1b);
+    const __m128i im_mirror = _mm_shuffle_epi32(PostShift(&inre2Q9[m - 3], sh),
+                                                0x1b);
+    const __m128i xrQ16 = _mm_add_epi32(re, re_mirror);
+    const __m128i yiQ16 = _mm_sub_epi32(re_mirror, re);
+    const __m128i xiQ16 = _mm_sub_epi32(im, im_mirror);
+    const __m128i yrQ16 = _mm_add_epi32(im, im_mirror);
+    __m128i tmp1rQ14, tmp1iQ14, v1Q16, v2Q16;
+    LoadSinTab2(k, &tmp1rQ14, &tmp1iQ14);
+
+    v1Q16 = _mm_sub_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, xrQ16),
+                          WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, xiQ16));
+    v2Q16 = _mm_add_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, xrQ16),
+                          WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, xiQ16));
+    StoreW16(&outreQ7[k], _mm_srai_epi32(v1Q16, 9));
+    StoreW16(&outimQ7[k], _mm_srai_epi32(v2Q16, 9));
+
+    v1Q16 = _mm_sub_epi32(
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, yrQ16)),
+        WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, yiQ16));
+    v2Q16 = _mm_sub_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, yiQ16),
+                          WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, yrQ16));
+    StoreW16Reversed(&outreQ7[m], _mm_srai_epi32(v1Q16, 9));
+    StoreW16Reversed(&outimQ7[m], _mm_srai_epi32(v2Q16, 9));
+  }
+}
+
+void WebRtcIsacfix_Spec2TimeSSE2(int16_t* inreQ7,
+                                 int16_t* inimQ7,
+                                 int32_t* outre1Q16,
+                                 int32_t* outre2Q16) {
+  int k;
+  int16_t sh;
+  /* 1/240 is 273 in Q16, and sqrt(240) in Q11 is round(15.49193338482967 *
+     2048) = 31727. */
+  const __m128i kScale = _mm_set1_epi32(273);
+  const __m128i factQ11 = _mm_set1_epi32(31727);
+
+  for (k = 0; k < FRAMESAMPLES/4; k += 4) {
+    /* Move zero in time to beginning of frames */
+    const int m = FRAMESAMPLES/2 - 1 - k;
+    const __m128i tmpInRe =
+        _mm_slli_epi32(WebRtcIsacfix_LoadW16SSE2(&inreQ7[k]), 9);
+    const __m128i tmpInIm =
+        _mm_slli_epi32(WebRtcIsacfix_LoadW16SSE2(&inimQ7[k]), 9);
+    const __m128i tmpInRe2 = _mm_slli_epi32(LoadW16Reversed(&inreQ7[m]), 9);
+    const __m128i tmpInIm2 = _mm_slli_epi32(LoadW16Reversed(&inimQ7[m]), 9);
+    __m128i tmp1rQ14, tmp1iQ14, xrQ16, xiQ16, yrQ16, yiQ16;
+    LoadSinTab2(k, &tmp1rQ14, &tmp1iQ14);
+
+    xrQ16 = _mm_add_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, tmpInRe),
+                          WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, tmpInIm));
+    xiQ16 = _mm_sub_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, tmpInIm),
+                          WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, tmpInRe));
+    yrQ16 = _mm_sub_epi32(
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, tmpInIm2)),
+        WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, tmpInRe2));
+    yiQ16 = _mm_sub_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, tmpInIm2),
+                          WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, tmpInRe2));
+
+    /* Combine into one vector,  z = x + j * y */
+    _mm_storeu_si128((__m128i*)&outre1Q16[k], _mm_sub_epi32(xrQ16, yiQ16));
+    _mm_storeu_si128((__m128i*)&outre1Q16[m - 3],
+                     _mm_shuffle_epi32(_mm_add_epi32(xrQ16, yiQ16), 0x1b));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k], _mm_add_epi32(xiQ16, yrQ16));
+    _mm_storeu_si128((__m128i*)&outre2Q16[m - 3],
+                     _mm_shuffle_epi32(_mm_sub_epi32(yrQ16, xiQ16), 0x1b));
+  }
+
+  /* Get IDFT */
+  sh = NormShift(outre1Q16, outre2Q16);
+  PreShift(outre1Q16, outre2Q16, inreQ7, inimQ7, sh);
+
+  WebRtcIsacfix_FftRadix16Fastest(inreQ7, inimQ7, 1); // real call
+
+  /* Scale back, divide through by the normalizing constant 240, and
+     demodulate and separate. */
+  for (k = 0; k < FRAMESAMPLES/2; k += 4) {
+    const __m128i tmp1rQ14 =
+        WebRtcIsacfix_LoadW16SSE2(&WebRtcIsacfix_kCosTab1[k]);
+    const __m128i tmp1iQ14 =
+        WebRtcIsacfix_LoadW16SSE2(&WebRtcIsacfix_kSinTab1[k]);
+    const __m128i re = WebRtcIsacfix_Mul16x32Rsft16SSE2(
+        kScale, PostShift(&inreQ7[k], sh));
+    const __m128i im = WebRtcIsacfix_Mul16x32Rsft16SSE2(
+        kScale, PostShift(&inimQ7[k], sh));
+    const __m128i xrQ16 =
+        _mm_sub_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, re),
+                      WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, im));
+    const __m128i xiQ16 =
+        _mm_add_epi32(WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1rQ14, im),
+                      WebRtcIsacfix_Mul16x32Rsft14SSE2(tmp1iQ14, re));
+    _mm_storeu_si128((__m128i*)&outre1Q16[k],
+                     WebRtcIsacfix_Mul16x32Rsft11SSE2(factQ11, xrQ16));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k],
+                     WebRtcIsacfix_Mul16x32Rsft11SSE2(factQ11, xiQ16));
+  }
+}
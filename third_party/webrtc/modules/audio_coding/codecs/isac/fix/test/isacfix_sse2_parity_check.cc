@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the SSE2 code of iSAC-fix against the C code. The input is
+// encoded and decoded once with the function pointers that
+// WebRtcIsacfix_EncoderInit() and WebRtcIsacfix_DecoderInit() set, once for
+// every SSE2 kernel with that kernel pointed back at its C version after
+// initialization, and once with all of them pointed at the C versions. The
+// payloads and decoded output of every run must be identical to the first
+// one. The encode and decode time per frame of the SSE2 and C runs is
+// printed too. Returns 0 if all runs are identical.
+//
+// Usage: isacfix_sse2_parity_check <input.pcm> [30|60]
+//
+// The input is 16-bit mono PCM at 16 kHz.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "modules/audio_coding/codecs/isac/fix/include/isacfix.h"
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "modules/audio_coding/codecs/isac/fix/source/filterbank_internal.h"
+#include "modules/audio_coding/codecs/isac/fix/source/lpc_masking_model.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+extern "C" {
+#include "modules/audio_coding/codecs/isac/fix/source/entropy_coding.h"
+}
+
+namespace webrtc {
+namespace {
+
+const size_t kBlockSamples = 160;
+const int kBitRate = 32000;
+const size_t kMaxPayloadBytes = 400;
+const size_t kMaxDecodedSamples = 960;
+
+void UseAutocorrC() {
+  WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrC;
+}
+void UseFilterMaLoopC() {
+  WebRtcIsacfix_FilterMaLoopFix = WebRtcIsacfix_FilterMaLoopC;
+}
+void UseTime2SpecC() {
+  WebRtcIsacfix_Time2Spec = WebRtcIsacfix_Time2SpecC;
+}
+void UseSpec2TimeC() {
+  WebRtcIsacfix_Spec2Time = WebRtcIsacfix_Spec2TimeC;
+}
+void UseAllpassFilterC() {
+  WebRtcIsacfix_AllpassFilter2FixDec16 = WebRtcIsacfix_AllpassFilter2FixDec16C;
+}
+void UseMatrixProductC() {
+  WebRtcIsacfix_MatrixProduct1 = WebRtcIsacfix_MatrixProduct1C;
+  WebRtcIsacfix_MatrixProduct2 = WebRtcIsacfix_MatrixProduct2C;
+}
+void UseWindowAutocorrInputC() {
+  WebRtcIsacfix_WindowAutocorrInput = WebRtcIsacfix_WindowAutocorrInputC;
+}
+void UseAllC() {
+  UseAutocorrC();
+  UseFilterMaLoopC();
+  UseTime2SpecC();
+  UseSpec2TimeC();
+  UseAllpassFilterC();
+  UseMatrixProductC();
+  UseWindowAutocorrInputC();
+}
+
+// The SSE2 kernels that WebRtcIsacfix_InitSSE2() installs.
+const struct {
+  const char* name;
+  void (*use_c)();
+} kKernels[] = {{"Autocorr", UseAutocorrC},
+                {"FilterMaLoop", UseFilterMaLoopC},
+                {"Time2Spec", UseTime2SpecC},
+                {"Spec2Time", UseSpec2TimeC},
+                {"AllpassFilter2FixDec16", UseAllpassFilterC},
+                {"MatrixProduct1/2", UseMatrixProductC},
+                {"WindowAutocorrInput", UseWindowAutocorrInputC}};
+
+struct Result {
+  std::vector<std::vector<uint8_t>> payloads;
+  std::vector<int16_t> decoded;
+  int64_t encode_ns = 0;
+  int64_t decode_ns = 0;
+};
+
+// Encodes and decodes |input| with a new instance. If |use_c| is given, it
+// is called after initialization to point kernels at their C versions. The
+// function pointers are global, so this is single threaded.
+Result Run(const std::vector<int16_t>& input, int frame_ms, void (*use_c)()) {
+  Result result;
+  ISACFIX_MainStruct* isac = nullptr;
+  WebRtcIsacfix_Create(&isac);
+  WebRtcIsacfix_EncoderInit(isac, 1);
+  WebRtcIsacfix_DecoderInit(isac);
+  WebRtcIsacfix_Control(isac, kBitRate, frame_ms);
+  if (use_c) {
+    use_c();
+  }
+  uint8_t encoded[kMaxPayloadBytes];
+  int16_t decoded[kMaxDecodedSamples];
+  int16_t speech_type;
+  for (size_t i = 0; i + kBlockSamples <= input.size(); i += kBlockSamples) {
+    int64_t start_ns = rtc::TimeNanos();
+    const int bytes = WebRtcIsacfix_Encode(isac, &input[i], encoded);
+    result.encode_ns += rtc::TimeNanos() - start_ns;
+    if (bytes <= 0) {
+      continue;
+    }
+    result.payloads.push_back(
+        std::vector<uint8_t>(encoded, encoded + bytes));
+    start_ns = rtc::TimeNanos();
+    const int samples = WebRtcIsacfix_Decode(
+        isac, encoded, static_cast<size_t>(bytes), decoded, &speech_type);
+    result.decode_ns += rtc::TimeNanos() - start_ns;
+    if (samples > 0) {
+      result.decoded.insert(result.decoded.end(), decoded, decoded + samples);
+    }
+  }
+  WebRtcIsacfix_Free(isac);
+  return result;
+}
+
+bool Identical(const Result& a, const Result& b) {
+  return a.payloads == b.payloads && a.decoded == b.decoded;
+}
+
+void PrintTime(const char* name, const Result& result) {
+  const double frames = static_cast<double>(result.payloads.size());
+  printf("%s: encode %.1f us, decode %.1f us per frame\n", name,
+         result.encode_ns / frames / 1000.0,
+         result.decode_ns / frames / 1000.0);
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <input.pcm> [30|60]\n", argv[0]);
+    return 1;
+  }
+  const int frame_ms = argc > 2 ? atoi(argv[2]) : 30;
+  if (frame_ms != 30 && frame_ms != 60) {
+    fprintf(stderr, "The frame size must be 30 or 60 ms\n");
+    return 1;
+  }
+  if (!WebRtc_UseSSE2()) {
+    fprintf(stderr, "SSE2 is not available\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+
+  const webrtc::Result sse2 = webrtc::Run(input, frame_ms, nullptr);
+  if (sse2.payloads.empty()) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+  bool passed = true;
+  for (const auto& kernel : webrtc::kKernels) {
+    const bool identical =
+        webrtc::Identical(sse2, webrtc::Run(input, frame_ms, kernel.use_c));
+    printf("%s: %s\n", kernel.name, identical ? "identical" : "DIFFERENT");
+    passed = passed && identical;
+  }
+  const webrtc::Result c = webrtc::Run(input, frame_ms, webrtc::UseAllC);
+  const bool identical = webrtc::Identical(sse2, c);
+  printf("All kernels: %d payloads, %s\n",
+         static_cast<int>(sse2.payloads.size()),
+         identical ? "identical" : "DIFFERENT");
+  passed = passed && identical;
+  webrtc::PrintTime("SSE2", sse2);
+  webrtc::PrintTime("C", c);
+  return passed ? 0 : 1;
+}
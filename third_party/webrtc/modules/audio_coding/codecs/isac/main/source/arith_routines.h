@@ -20,6 +20,14 @@
 
 #include "modules/audio_coding/codecs/isac/main/source/structs.h"
 
+/* Returns the width of the interval W_upper times cdf in Q16. This is the same
+ * as (W_upper >> 16) * cdf + (((W_upper & 0xFFFF) * cdf) >> 16), since the
+ * cdf values are at most 65535, but is a single multiplication. */
+static __inline uint32_t WebRtcIsac_ScaleInterval(uint32_t W_upper,
+                                                  uint32_t cdf) {
+  return (uint32_t)(((uint64_t)W_upper * cdf) >> 16);
+}
+
 int WebRtcIsac_EncLogisticMulti2(
     Bitstr* streamdata, /* in-/output struct containing bitstream */
     int16_t* dataQ7,    /* input: data vector */
@@ -21,7 +21,6 @@ void WebRtcIsac_EncHistMulti(Bitstr *streamdata, /* in-/output struct containing
                              const int N)   /* input: data vector length */
 {
   uint32_t W_lower, W_upper;
-  uint32_t W_upper_LSB, W_upper_MSB;
   uint8_t *stream_ptr;
   uint8_t *stream_ptr_carry;
   uint32_t cdf_lo, cdf_hi;
@@ -39,12 +38,8 @@ void WebRtcIsac_EncHistMulti(Bitstr *streamdata, /* in-/output struct containing
     cdf_hi = (uint32_t) *(*cdf++ + *data++ + 1);
 
     /* update interval */
-    W_upper_LSB = W_upper & 0x0000FFFF;
-    W_upper_MSB = W_upper >> 16;
-    W_lower = W_upper_MSB * cdf_lo;
-    W_lower += (W_upper_LSB * cdf_lo) >> 16;
-    W_upper = W_upper_MSB * cdf_hi;
-    W_upper += (W_upper_LSB * cdf_hi) >> 16;
+    W_lower = WebRtcIsac_ScaleInterval(W_upper, cdf_lo);
+    W_upper = WebRtcIsac_ScaleInterval(W_upper, cdf_hi);
 
     /* shift interval such that it begins at zero */
     W_upper -= ++W_lower;
@@ -90,7 +85,7 @@ int WebRtcIsac_DecHistBisectMulti(int *data,     /* output: data vector */
 {
   uint32_t    W_lower, W_upper;
   uint32_t    W_tmp;
-  uint32_t    W_upper_LSB, W_upper_MSB;
+  uint32_t    W_width;
   uint32_t    streamval;
   const   uint8_t *stream_ptr;
   const   uint16_t *cdf_ptr;
@@ -118,8 +113,7 @@ int WebRtcIsac_DecHistBisectMulti(int *data,     /* output: data vector */
   for (k=N; k>0; k--)
   {
     /* find the integer *data for which streamval lies in [W_lower+1, W_upper] */
-    W_upper_LSB = W_upper & 0x0000FFFF;
-    W_upper_MSB = W_upper >> 16;
+    W_width = W_upper;
 
     /* start halfway the cdf range */
     size_tmp = *cdf_size++ >> 1;
@@ -128,8 +122,7 @@ int WebRtcIsac_DecHistBisectMulti(int *data,     /* output: data vector */
     /* method of bisection */
     for ( ;; )
     {
-      W_tmp = W_upper_MSB * *cdf_ptr;
-      W_tmp += (W_upper_LSB * *cdf_ptr) >> 16;
+      W_tmp = WebRtcIsac_ScaleInterval(W_width, *cdf_ptr);
       size_tmp >>= 1;
       if (size_tmp == 0) break;
       if (streamval > W_tmp)
@@ -198,7 +191,7 @@ int WebRtcIsac_DecHistOneStepMulti(int *data,        /* output: data vector */
 {
   uint32_t    W_lower, W_upper;
   uint32_t    W_tmp;
-  uint32_t    W_upper_LSB, W_upper_MSB;
+  uint32_t    W_width;
   uint32_t    streamval;
   const   uint8_t *stream_ptr;
   const   uint16_t *cdf_ptr;
@@ -226,13 +219,11 @@ int WebRtcIsac_DecHistOneStepMulti(int *data,        /* output: data vector */
   for (k=N; k>0; k--)
   {
     /* find the integer *data for which streamval lies in [W_lower+1, W_upper] */
-    W_upper_LSB = W_upper & 0x0000FFFF;
-    W_upper_MSB = W_upper >> 16;
+    W_width = W_upper;
 
     /* start at the specified table entry */
     cdf_ptr = *cdf + (*init_index++);
-    W_tmp = W_upper_MSB * *cdf_ptr;
-    W_tmp += (W_upper_LSB * *cdf_ptr) >> 16;
+    W_tmp = WebRtcIsac_ScaleInterval(W_width, *cdf_ptr);
     if (streamval > W_tmp)
     {
       for ( ;; )
@@ -241,8 +232,7 @@ int WebRtcIsac_DecHistOneStepMulti(int *data,        /* output: data vector */
         if (cdf_ptr[0]==65535)
           /* range check */
           return -3;
-        W_tmp = W_upper_MSB * *++cdf_ptr;
-        W_tmp += (W_upper_LSB * *cdf_ptr) >> 16;
+        W_tmp = WebRtcIsac_ScaleInterval(W_width, *++cdf_ptr);
         if (streamval <= W_tmp) break;
       }
       W_upper = W_tmp;
@@ -256,8 +246,7 @@ int WebRtcIsac_DecHistOneStepMulti(int *data,        /* output: data vector */
           /* range check */
           return -3;
         }
-        W_tmp = W_upper_MSB * *cdf_ptr;
-        W_tmp += (W_upper_LSB * *cdf_ptr) >> 16;
+        W_tmp = WebRtcIsac_ScaleInterval(W_width, *cdf_ptr);
         if (streamval > W_tmp) break;
       }
       W_lower = W_tmp;
@@ -17,6 +17,7 @@
  */
 
 
+#include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "modules/audio_coding/codecs/isac/main/source/arith_routines.h"
 
 
@@ -85,16 +86,17 @@ int WebRtcIsac_EncLogisticMulti2(
     const int16_t isSWB12kHz)
 {
   uint32_t W_lower, W_upper;
-  uint32_t W_upper_LSB, W_upper_MSB;
+  uint32_t streamval;
   uint8_t *stream_ptr;
   uint8_t *maxStreamPtr;
   uint8_t *stream_ptr_carry;
   uint32_t cdf_lo, cdf_hi;
-  int k;
+  int k, bytes;
 
   /* point to beginning of stream buffer */
   stream_ptr = streamdata->stream + streamdata->stream_index;
   W_upper = streamdata->W_upper;
+  streamval = streamdata->streamval;
 
   maxStreamPtr = streamdata->stream + STREAM_SIZE_MAX_60 - 1;
   for (k = 0; k < N; k++)
@@ -124,44 +126,59 @@ int WebRtcIsac_EncLogisticMulti2(
 
 
     /* update interval */
-    W_upper_LSB = W_upper & 0x0000FFFF;
-    W_upper_MSB = W_upper >> 16;
-    W_lower = W_upper_MSB * cdf_lo;
-    W_lower += (W_upper_LSB * cdf_lo) >> 16;
-    W_upper = W_upper_MSB * cdf_hi;
-    W_upper += (W_upper_LSB * cdf_hi) >> 16;
+    W_lower = WebRtcIsac_ScaleInterval(W_upper, cdf_lo);
+    W_upper = WebRtcIsac_ScaleInterval(W_upper, cdf_hi);
 
     /* shift interval such that it begins at zero */
     W_upper -= ++W_lower;
 
     /* add integer to bitstream */
-    streamdata->streamval += W_lower;
+    streamval += W_lower;
 
     /* handle carry */
-    if (streamdata->streamval < W_lower)
+    if (streamval < W_lower)
     {
       /* propagate carry */
       stream_ptr_carry = stream_ptr;
       while (!(++(*--stream_ptr_carry)));
     }
 
-    /* renormalize interval, store most significant byte of streamval and update streamval */
-    while ( !(W_upper & 0xFF000000) )      /* W_upper < 2^24 */
+    /* renormalize interval, store most significant bytes of streamval and
+     * update streamval; all bytes (at most 3) are stored at once */
+    if (stream_ptr + 2 > maxStreamPtr)
     {
-      W_upper <<= 8;
-      *stream_ptr++ = (uint8_t) (streamdata->streamval >> 24);
-
-      if(stream_ptr > maxStreamPtr)
+      /* store one byte at a time as the stream ends */
+      while ( !(W_upper & 0xFF000000) )      /* W_upper < 2^24 */
       {
-        return -ISAC_DISALLOWED_BITSTREAM_LENGTH;
+        W_upper <<= 8;
+        *stream_ptr++ = (uint8_t) (streamval >> 24);
+
+        if(stream_ptr > maxStreamPtr)
+        {
+          streamdata->streamval = streamval;
+          return -ISAC_DISALLOWED_BITSTREAM_LENGTH;
+        }
+        streamval <<= 8;
       }
-      streamdata->streamval <<= 8;
+    }
+    else
+    {
+      /* store the 3 next bytes and keep the first |bytes| of them, which
+       * avoids a branch on their number, often 0 */
+      bytes = WebRtcSpl_NormU32(W_upper) >> 3;
+      stream_ptr[0] = (uint8_t) (streamval >> 24);
+      stream_ptr[1] = (uint8_t) (streamval >> 16);
+      stream_ptr[2] = (uint8_t) (streamval >> 8);
+      stream_ptr += bytes;
+      W_upper <<= 8 * bytes;
+      streamval <<= 8 * bytes;
     }
   }
 
   /* calculate new stream_index */
   streamdata->stream_index = (int)(stream_ptr - streamdata->stream);
   streamdata->W_upper = W_upper;
+  streamdata->streamval = streamval;
 
   return 0;
 }
@@ -178,12 +195,11 @@ int WebRtcIsac_DecLogisticMulti2(
 {
   uint32_t    W_lower, W_upper;
   uint32_t    W_tmp;
-  uint32_t    W_upper_LSB, W_upper_MSB;
   uint32_t    streamval;
   const uint8_t *stream_ptr;
   uint32_t    cdf_tmp;
   int16_t     candQ7;
-  int             k;
+  int             k, bytes;
 
   // Position just past the end of the stream. STREAM_SIZE_MAX_60 instead of
   // STREAM_SIZE_MAX (which is the size of the allocated buffer) because that's
@@ -209,31 +225,26 @@ int WebRtcIsac_DecLogisticMulti2(
   for (k = 0; k < N; k++)
   {
     /* find the integer *data for which streamval lies in [W_lower+1, W_upper] */
-    W_upper_LSB = W_upper & 0x0000FFFF;
-    W_upper_MSB = W_upper >> 16;
 
     /* find first candidate by inverting the logistic cdf */
     candQ7 = - *ditherQ7 + 64;
     cdf_tmp = piecewise(candQ7 * *envQ8);
 
-    W_tmp = W_upper_MSB * cdf_tmp;
-    W_tmp += (W_upper_LSB * cdf_tmp) >> 16;
+    W_tmp = WebRtcIsac_ScaleInterval(W_upper, cdf_tmp);
     if (streamval > W_tmp)
     {
       W_lower = W_tmp;
       candQ7 += 128;
       cdf_tmp = piecewise(candQ7 * *envQ8);
 
-      W_tmp = W_upper_MSB * cdf_tmp;
-      W_tmp += (W_upper_LSB * cdf_tmp) >> 16;
+      W_tmp = WebRtcIsac_ScaleInterval(W_upper, cdf_tmp);
       while (streamval > W_tmp)
       {
         W_lower = W_tmp;
         candQ7 += 128;
         cdf_tmp = piecewise(candQ7 * *envQ8);
 
-        W_tmp = W_upper_MSB * cdf_tmp;
-        W_tmp += (W_upper_LSB * cdf_tmp) >> 16;
+        W_tmp = WebRtcIsac_ScaleInterval(W_upper, cdf_tmp);
 
         /* error check */
         if (W_lower == W_tmp) return -1;
@@ -245,20 +256,20 @@ int WebRtcIsac_DecLogisticMulti2(
     }
     else
     {
+      /* the candidates are scaled from the width before the search */
+      const uint32_t W_width = W_upper;
       W_upper = W_tmp;
       candQ7 -= 128;
       cdf_tmp = piecewise(candQ7 * *envQ8);
 
-      W_tmp = W_upper_MSB * cdf_tmp;
-      W_tmp += (W_upper_LSB * cdf_tmp) >> 16;
+      W_tmp = WebRtcIsac_ScaleInterval(W_width, cdf_tmp);
       while ( !(streamval > W_tmp) )
       {
         W_upper = W_tmp;
         candQ7 -= 128;
         cdf_tmp = piecewise(candQ7 * *envQ8);
 
-        W_tmp = W_upper_MSB * cdf_tmp;
-        W_tmp += (W_upper_LSB * cdf_tmp) >> 16;
+        W_tmp = WebRtcIsac_ScaleInterval(W_width, cdf_tmp);
 
         /* error check */
         if (W_upper == W_tmp) return -1;
@@ -280,14 +291,32 @@ int WebRtcIsac_DecLogisticMulti2(
     /* add integer to bitstream */
     streamval -= W_lower;
 
-    /* renormalize interval and update streamval */
-    while ( !(W_upper & 0xFF000000) )    /* W_upper < 2^24 */
+    /* renormalize interval and update streamval; all bytes (at most 3) are
+     * read at once */
+    if (W_upper == 0)
+      return -1;  // Would read until out of bounds. Malformed input?
+    if (stream_ptr + 3 >= stream_end)
+    {
+      /* read one byte at a time as the stream ends */
+      while ( !(W_upper & 0xFF000000) )    /* W_upper < 2^24 */
+      {
+        /* read next byte from stream */
+        if (stream_ptr + 1 >= stream_end)
+          return -1;  // Would read out of bounds. Malformed input?
+        streamval = (streamval << 8) | *++stream_ptr;
+        W_upper <<= 8;
+      }
+    }
+    else
     {
-      /* read next byte from stream */
-      if (stream_ptr + 1 >= stream_end)
-        return -1;  // Would read out of bounds. Malformed input?
-      streamval = (streamval << 8) | *++stream_ptr;
-      W_upper <<= 8;
+      /* read the 3 next bytes and keep the first |bytes| of them, which
+       * avoids a branch on their number, often 0 */
+      bytes = WebRtcSpl_NormU32(W_upper) >> 3;
+      streamval = (streamval << (8 * bytes)) |
+          (((uint32_t)stream_ptr[1] << 16 | (uint32_t)stream_ptr[2] << 8 |
+            stream_ptr[3]) >> (24 - 8 * bytes));
+      stream_ptr += bytes;
+      W_upper <<= 8 * bytes;
     }
   }
 
@@ -23,6 +23,7 @@
 
 #include "modules/audio_coding/codecs/isac/main/source/structs.h"
 #include "modules/third_party/fft/fft.h"
+#include "rtc_base/system/arch.h"
 
 void WebRtcIsac_ResetBitstream(Bitstr* bit_stream);
 
@@ -195,6 +196,17 @@ void WebRtcIsac_Spec2time(const TransformTables* tables,
                           double* outre2,
                           FFTstr* fftstr_obj);
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsac_FftPassSSE2(const TransformTables* tables,
+                            int radix,
+                            int m,
+                            int s,
+                            const double* in_re,
+                            const double* in_im,
+                            double* out_re,
+                            double* out_im);
+#endif
+
 /***************************** filterbank functions **************************/
 
 void WebRtcIsac_FilterAndCombineFloat(float* InLP,
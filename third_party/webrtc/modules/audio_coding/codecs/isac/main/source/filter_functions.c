@@ -14,8 +14,10 @@
 #include <stdlib.h>
 #endif
 
+#include "modules/audio_coding/codecs/isac/main/source/filter_functions.h"
 #include "modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
 #include "modules/audio_coding/codecs/isac/main/source/isac_vad.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 static void WebRtcIsac_AllPoleFilter(double* InOut,
                                      double* Coef,
@@ -92,6 +94,16 @@ static void WebRtcIsac_ZeroPoleFilter(double* In,
 
 
 void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtcIsac_AutoCorrSSE2(r, x, N, order);
+    return;
+  }
+#endif
+  WebRtcIsac_AutoCorrC(r, x, N, order);
+}
+
+void WebRtcIsac_AutoCorrC(double* r, const double* x, size_t N, size_t order) {
   size_t  lag, n;
   double sum, prod;
   const double *x_lag;
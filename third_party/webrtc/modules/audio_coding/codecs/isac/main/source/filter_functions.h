@@ -12,8 +12,19 @@
 #define MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_FILTER_FUNCTIONS_H_
 
 #include "modules/audio_coding/codecs/isac/main/source/structs.h"
+#include "rtc_base/system/arch.h"
 
+// Computes the autocorrelation |r| of lags 0 to |order| of the |N| samples
+// of |x|, with the SSE2 code if the CPU has it.
 void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order);
+void WebRtcIsac_AutoCorrC(double* r, const double* x, size_t N, size_t order);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsac_AutoCorrSSE2(double* r,
+                             const double* x,
+                             size_t N,
+                             size_t order);
+#endif
 
 void WebRtcIsac_WeightingFilter(const double* in,
                                 double* weiout,
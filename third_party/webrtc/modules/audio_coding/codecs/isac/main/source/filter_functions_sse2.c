@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* SSE2 version of WebRtcIsac_AutoCorr(). The two lanes of a register hold
+ * the sums of two neighbouring lags, and each lane adds its products in the
+ * order of the C code in filter_functions.c, so the results are bit exact. */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/main/source/filter_functions.h"
+
+/* Adds the products from |n| on to the sums of the lags |lag| and |lag| + 1
+ * in |sum|, and stores them in |r|. The lag |lag| has one product more than
+ * the lag |lag| + 1. */
+static __inline void FinishLagPair(__m128d sum,
+                                   const double* x,
+                                   size_t n,
+                                   size_t N,
+                                   size_t lag,
+                                   double* r) {
+  for (; n < N - lag - 1; n++) {
+    sum = _mm_add_pd(sum,
+                     _mm_mul_pd(_mm_set1_pd(x[n]), _mm_loadu_pd(&x[n + lag])));
+  }
+  sum = _mm_add_sd(sum, _mm_set_sd(x[n] * x[N - 1]));
+  _mm_storeu_pd(&r[lag], sum);
+}
+
+void WebRtcIsac_AutoCorrSSE2(double* r,
+                             const double* x,
+                             size_t N,
+                             size_t order) {
+  size_t lag = 0, n;
+
+  /* Eight lags at a time keep four independent chains of additions in
+   * flight, for as many products as all of them have. */
+  for (; lag + 8 <= order + 1; lag += 8) {
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    __m128d sum2 = _mm_setzero_pd();
+    __m128d sum3 = _mm_setzero_pd();
+    const double* x_lag = &x[lag];
+    for (n = 0; n < N - lag - 7; n++) {
+      const __m128d x_v = _mm_set1_pd(x[n]);
+      sum0 = _mm_add_pd(sum0, _mm_mul_pd(x_v, _mm_loadu_pd(&x_lag[n])));
+      sum1 = _mm_add_pd(sum1, _mm_mul_pd(x_v, _mm_loadu_pd(&x_lag[n + 2])));
+      sum2 = _mm_add_pd(sum2, _mm_mul_pd(x_v, _mm_loadu_pd(&x_lag[n + 4])));
+      sum3 = _mm_add_pd(sum3, _mm_mul_pd(x_v, _mm_loadu_pd(&x_lag[n + 6])));
+    }
+    FinishLagPair(sum3, x, n, N, lag + 6, r);
+    FinishLagPair(sum2, x, n, N, lag + 4, r);
+    FinishLagPair(sum1, x, n, N, lag + 2, r);
+    FinishLagPair(sum0, x, n, N, lag, r);
+  }
+
+  for (; lag + 2 <= order + 1; lag += 2) {
+    FinishLagPair(_mm_setzero_pd(), x, 0, N, lag, r);
+  }
+
+  if (lag <= order) {
+    double sum = 0.0;
+    for (n = 0; n < N - lag; n++) {
+      sum += x[n] * x[n + lag];
+    }
+    r[lag] = sum;
+  }
+}
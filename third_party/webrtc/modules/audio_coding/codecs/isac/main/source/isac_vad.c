@@ -12,6 +12,8 @@
 
 #include <math.h>
 
+#include "system_wrappers/include/cpu_features_sse2.h"
+
 void WebRtcIsac_InitPitchFilter(PitchFiltstr* pitchfiltdata) {
   int k;
 
@@ -73,6 +75,12 @@ void WebRtcIsac_InitPitchAnalysis(PitchAnalysisStruct* State) {
   WebRtcIsac_InitPitchFilter(&(State->PFstr));
 
   WebRtcIsac_InitWeightingFilter(&(State->Wghtstr));
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  State->use_sse2 = WebRtc_UseSSE2();
+#else
+  State->use_sse2 = 0;
+#endif
 }
 
 void WebRtcIsac_InitPreFilterbank(PreFiltBankstr* prefiltdata) {
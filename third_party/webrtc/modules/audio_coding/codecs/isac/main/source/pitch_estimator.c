@@ -197,6 +197,9 @@ static void WebRtcIsac_InitializePitch(const double* in,
   double lags2[PITCH_MAX_NUM_PEAKS];
   double T[3][3];
   int row;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const int use_sse2 = State->use_sse2;
+#endif
 
   for(k = 0; k < 2*PITCH_BW+3; k++)
   {
@@ -213,8 +216,16 @@ static void WebRtcIsac_InitializePitch(const double* in,
   memcpy(buf_dec, State->dec_buffer, sizeof(double) * (PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2-PITCH_FRAME_LEN/2+2));
 
   /* decimation; put result after the old values */
-  WebRtcIsac_DecimateAllpass(in, State->decimator_state, PITCH_FRAME_LEN,
-                             &buf_dec[PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2-PITCH_FRAME_LEN/2+2]);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2) {
+    WebRtcIsac_DecimateAllpassSSE2(in, State->decimator_state, PITCH_FRAME_LEN,
+                                   &buf_dec[PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2-PITCH_FRAME_LEN/2+2]);
+  } else
+#endif
+  {
+    WebRtcIsac_DecimateAllpass(in, State->decimator_state, PITCH_FRAME_LEN,
+                               &buf_dec[PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2-PITCH_FRAME_LEN/2+2]);
+  }
 
   /* low-pass filtering */
   for (k = PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2-PITCH_FRAME_LEN/2+2; k < PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2+2; k++)
@@ -224,8 +235,16 @@ static void WebRtcIsac_InitializePitch(const double* in,
   memcpy(State->dec_buffer, buf_dec+PITCH_FRAME_LEN/2, sizeof(double) * (PITCH_CORR_LEN2+PITCH_CORR_STEP2+PITCH_MAX_LAG/2-PITCH_FRAME_LEN/2+2));
 
   /* compute correlation for first and second half of the frame */
-  PCorr(buf_dec, corrvec1);
-  PCorr(buf_dec + PITCH_CORR_STEP2, corrvec2);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2) {
+    WebRtcIsac_PCorrSSE2(buf_dec, corrvec1);
+    WebRtcIsac_PCorrSSE2(buf_dec + PITCH_CORR_STEP2, corrvec2);
+  } else
+#endif
+  {
+    PCorr(buf_dec, corrvec1);
+    PCorr(buf_dec + PITCH_CORR_STEP2, corrvec2);
+  }
 
   /* bias towards pitch lag of previous frame */
   log_lag = log(0.5 * old_lag);
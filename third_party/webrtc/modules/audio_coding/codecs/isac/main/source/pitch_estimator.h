@@ -21,6 +21,7 @@
 #include <stddef.h>
 
 #include "modules/audio_coding/codecs/isac/main/source/structs.h"
+#include "rtc_base/system/arch.h"
 
 void WebRtcIsac_PitchAnalysis(
     const double* in, /* PITCH_FRAME_LEN samples */
@@ -29,4 +30,13 @@ void WebRtcIsac_PitchAnalysis(
     double* lags,
     double* gains);
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsac_PCorrSSE2(const double* in, double* outcorr);
+
+void WebRtcIsac_DecimateAllpassSSE2(const double* in,
+                                    double* state_in,
+                                    size_t N,
+                                    double* out);
+#endif
+
 #endif /* MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_PITCH_ESTIMATOR_H_ */
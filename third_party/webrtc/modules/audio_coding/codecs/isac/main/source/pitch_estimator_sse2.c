@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* SSE2 versions of the correlation and decimation helpers of
+ * WebRtcIsac_PitchAnalysis(). Each lane performs the same operations in the
+ * same order as the C code in pitch_estimator.c, so the results are bit
+ * exact. */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include "modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
+
+#if (PITCH_LAG_SPAN2 - 1) % 8 != 0
+#error "WebRtcIsac_PCorrSSE2() correlates eight lags at a time"
+#endif
+
+/* Stores the correlations of the lags k and k + 1 from the two lanes of
+ * |sum|, normalized by the energies in |ysum|. */
+static __inline void StoreCorr(__m128d sum,
+                               const double* ysum,
+                               int k,
+                               double* outcorr) {
+  sum = _mm_div_pd(sum, _mm_sqrt_pd(_mm_loadu_pd(&ysum[k])));
+  _mm_storel_pd(&outcorr[PITCH_LAG_SPAN2 - 1 - k], sum);
+  _mm_storeh_pd(&outcorr[PITCH_LAG_SPAN2 - 2 - k], sum);
+}
+
+void WebRtcIsac_PCorrSSE2(const double* in, double* outcorr) {
+  double ysum[PITCH_LAG_SPAN2];
+  const double* x = in + PITCH_MAX_LAG/2 + 2;
+  double sum = 0.0;
+  int k, n;
+
+  ysum[0] = 1e-13;
+  for (n = 0; n < PITCH_CORR_LEN2; n++) {
+    ysum[0] += in[n] * in[n];
+    sum += x[n] * in[n];
+  }
+  outcorr[PITCH_LAG_SPAN2 - 1] = sum / sqrt(ysum[0]);
+
+  for (k = 1; k < PITCH_LAG_SPAN2; k++) {
+    ysum[k] = ysum[k - 1] - in[k-1] * in[k-1];
+    ysum[k] += in[PITCH_CORR_LEN2 + k - 1] * in[PITCH_CORR_LEN2 + k - 1];
+  }
+
+  /* Each lane accumulates the products of one lag in the order of the C
+   * code. Eight lags at a time keep four independent chains of additions in
+   * flight. */
+  for (k = 1; k < PITCH_LAG_SPAN2; k += 8) {
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    __m128d sum2 = _mm_setzero_pd();
+    __m128d sum3 = _mm_setzero_pd();
+    const double* inptr = &in[k];
+    for (n = 0; n < PITCH_CORR_LEN2; n++) {
+      const __m128d x_v = _mm_set1_pd(x[n]);
+      sum0 = _mm_add_pd(sum0, _mm_mul_pd(x_v, _mm_loadu_pd(&inptr[n])));
+      sum1 = _mm_add_pd(sum1, _mm_mul_pd(x_v, _mm_loadu_pd(&inptr[n + 2])));
+      sum2 = _mm_add_pd(sum2, _mm_mul_pd(x_v, _mm_loadu_pd(&inptr[n + 4])));
+      sum3 = _mm_add_pd(sum3, _mm_mul_pd(x_v, _mm_loadu_pd(&inptr[n + 6])));
+    }
+    StoreCorr(sum0, ysum, k, outcorr);
+    StoreCorr(sum1, ysum, k + 2, outcorr);
+    StoreCorr(sum2, ysum, k + 4, outcorr);
+    StoreCorr(sum3, ysum, k + 6, outcorr);
+  }
+}
+
+void WebRtcIsac_DecimateAllpassSSE2(const double* in,
+                                    double* state_in,
+                                    size_t N,
+                                    double* out) {
+  /* The lower all-pass branch filters the odd input samples, delayed by one,
+   * in the low lane, and the upper branch the even ones in the high lane. The
+   * two sections of a branch run one after the other on each sample. */
+  const __m128d ap0 = _mm_set_pd(0.0347, 0.1544);
+  const __m128d ap1 = _mm_set_pd(0.3826, 0.744);
+  const __m128d neg_ap0 = _mm_set_pd(-0.0347, -0.1544);
+  const __m128d neg_ap1 = _mm_set_pd(-0.3826, -0.744);
+  __m128d state0 = _mm_set_pd(state_in[0], state_in[ALLPASSSECTIONS]);
+  __m128d state1 = _mm_set_pd(state_in[1], state_in[ALLPASSSECTIONS + 1]);
+  __m128d x, y;
+  size_t n;
+
+  for (n = 0; n < N / 2; n++) {
+    if (n == 0) {
+      x = _mm_set_pd(in[0], state_in[2 * ALLPASSSECTIONS]);
+    } else {
+      x = _mm_loadu_pd(&in[2 * n - 1]);
+    }
+    y = _mm_add_pd(state0, _mm_mul_pd(ap0, x));
+    state0 = _mm_add_pd(_mm_mul_pd(neg_ap0, y), x);
+    x = y;
+    y = _mm_add_pd(state1, _mm_mul_pd(ap1, x));
+    state1 = _mm_add_pd(_mm_mul_pd(neg_ap1, y), x);
+    out[n] = _mm_cvtsd_f64(_mm_add_sd(y, _mm_unpackhi_pd(y, y)));
+  }
+
+  state_in[2 * ALLPASSSECTIONS] = in[N - 1];
+  _mm_storeh_pd(&state_in[0], state0);
+  _mm_storel_pd(&state_in[ALLPASSSECTIONS], state0);
+  _mm_storeh_pd(&state_in[1], state1);
+  _mm_storel_pd(&state_in[ALLPASSSECTIONS + 1], state1);
+}
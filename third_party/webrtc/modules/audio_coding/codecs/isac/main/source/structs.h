@@ -131,6 +131,10 @@ typedef struct {
   PitchFiltstr PFstr;
   WeightFiltstr Wghtstr;
 
+  // Whether the SSE2 decimation and correlation are used. Set by
+  // WebRtcIsac_InitPitchAnalysis() if the CPU has SSE2.
+  int use_sse2;
+
 } PitchAnalysisStruct;
 
 /* Have instance of struct together with other iSAC structs */
@@ -393,6 +397,10 @@ typedef struct {
   double sintab1[FRAMESAMPLES_HALF];
   double costab2[FRAMESAMPLES_QUARTER];
   double sintab2[FRAMESAMPLES_QUARTER];
+  // Twiddle factors of the planned FRAMESAMPLES_HALF-point FFT,
+  // exp(-2 * pi * i * k / FRAMESAMPLES_HALF).
+  double fftcostab[FRAMESAMPLES_HALF];
+  double fftsintab[FRAMESAMPLES_HALF];
 } TransformTables;
 
 typedef struct {
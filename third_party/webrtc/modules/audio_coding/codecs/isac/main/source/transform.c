@@ -14,6 +14,21 @@
 #include "modules/audio_coding/codecs/isac/main/source/codec.h"
 #include "modules/audio_coding/codecs/isac/main/source/os_specific_inline.h"
 #include "modules/third_party/fft/fft.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+/* Radices of the passes of the planned FFT. Their product is
+ * FRAMESAMPLES_HALF, and the first pass has an even number of butterflies. */
+#define FFT_PASSES 4
+static const int kFftRadix[FFT_PASSES] = {4, 4, 3, 5};
+
+/* sin(2 * pi / 3), cos(2 * pi / 5), cos(4 * pi / 5), sin(2 * pi / 5) and
+ * sin(4 * pi / 5). */
+#define FFT_SIN3 0.86602540378443864676
+#define FFT_COS5_1 0.30901699437494742410
+#define FFT_COS5_2 -0.80901699437494742410
+#define FFT_SIN5_1 0.95105651629515357212
+#define FFT_SIN5_2 0.58778525229247312917
 
 void WebRtcIsac_InitTransform(TransformTables* tables) {
   int k;
@@ -34,6 +49,157 @@ void WebRtcIsac_InitTransform(TransformTables* tables) {
     tables->sintab2[k] = sin(phase);
     phase += fact;
   }
+
+  fact = 2.0 * PI / FRAMESAMPLES_HALF;
+  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
+    tables->fftcostab[k] = cos(fact * k);
+    tables->fftsintab[k] = -sin(fact * k);
+  }
+}
+
+/* Length |radix| DFT of re + i * im, in place, with the exponent sign of the
+ * forward transform. |radix| is 3, 4 or 5. */
+static void Butterfly(int radix, double* re, double* im) {
+  double t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+  switch (radix) {
+    case 3:
+      t0r = re[1] + re[2];
+      t0i = im[1] + im[2];
+      t1r = FFT_SIN3 * (im[1] - im[2]);
+      t1i = FFT_SIN3 * (re[2] - re[1]);
+      t2r = re[0] - 0.5 * t0r;
+      t2i = im[0] - 0.5 * t0i;
+      re[0] += t0r;
+      im[0] += t0i;
+      re[1] = t2r + t1r;
+      im[1] = t2i + t1i;
+      re[2] = t2r - t1r;
+      im[2] = t2i - t1i;
+      break;
+    case 4:
+      t0r = re[0] + re[2];
+      t0i = im[0] + im[2];
+      t1r = re[0] - re[2];
+      t1i = im[0] - im[2];
+      t2r = re[1] + re[3];
+      t2i = im[1] + im[3];
+      t3r = im[1] - im[3];
+      t3i = re[3] - re[1];
+      re[0] = t0r + t2r;
+      im[0] = t0i + t2i;
+      re[1] = t1r + t3r;
+      im[1] = t1i + t3i;
+      re[2] = t0r - t2r;
+      im[2] = t0i - t2i;
+      re[3] = t1r - t3r;
+      im[3] = t1i - t3i;
+      break;
+    case 5: {
+      const double s1r = re[1] + re[4], s1i = im[1] + im[4];
+      const double d1r = re[1] - re[4], d1i = im[1] - im[4];
+      const double s2r = re[2] + re[3], s2i = im[2] + im[3];
+      const double d2r = re[2] - re[3], d2i = im[2] - im[3];
+      t0r = re[0] + FFT_COS5_1 * s1r + FFT_COS5_2 * s2r;
+      t0i = im[0] + FFT_COS5_1 * s1i + FFT_COS5_2 * s2i;
+      t1r = re[0] + FFT_COS5_2 * s1r + FFT_COS5_1 * s2r;
+      t1i = im[0] + FFT_COS5_2 * s1i + FFT_COS5_1 * s2i;
+      /* -i * (sin(2 * pi / 5) * d1 + sin(4 * pi / 5) * d2), and
+       * -i * (sin(4 * pi / 5) * d1 - sin(2 * pi / 5) * d2). */
+      t2r = FFT_SIN5_1 * d1i + FFT_SIN5_2 * d2i;
+      t2i = -FFT_SIN5_1 * d1r - FFT_SIN5_2 * d2r;
+      t3r = FFT_SIN5_2 * d1i - FFT_SIN5_1 * d2i;
+      t3i = -FFT_SIN5_2 * d1r + FFT_SIN5_1 * d2r;
+      re[0] += s1r + s2r;
+      im[0] += s1i + s2i;
+      re[1] = t0r + t2r;
+      im[1] = t0i + t2i;
+      re[4] = t0r - t2r;
+      im[4] = t0i - t2i;
+      re[2] = t1r + t3r;
+      im[2] = t1i + t3i;
+      re[3] = t1r - t3r;
+      im[3] = t1i - t3i;
+      break;
+    }
+  }
+}
+
+/* One pass of the FFT: |m| * |s| butterflies of length |radix| over a
+ * sequence of length n = |radix| * |m|, interleaved with stride |s|. */
+static void FftPass(const TransformTables* tables,
+                    int radix,
+                    int m,
+                    int s,
+                    const double* in_re,
+                    const double* in_im,
+                    double* out_re,
+                    double* out_im) {
+  int q, t, k;
+  double re[5], im[5];
+
+  for (q = 0; q < m; q++) {
+    for (t = 0; t < s; t++) {
+      for (k = 0; k < radix; k++) {
+        re[k] = in_re[t + s * (q + k * m)];
+        im[k] = in_im[t + s * (q + k * m)];
+      }
+      Butterfly(radix, re, im);
+      out_re[t + s * radix * q] = re[0];
+      out_im[t + s * radix * q] = im[0];
+      for (k = 1; k < radix; k++) {
+        /* Twiddle factor exp(-2 * pi * i * k * q / n). */
+        const double wr = tables->fftcostab[k * q * s];
+        const double wi = tables->fftsintab[k * q * s];
+        out_re[t + s * (radix * q + k)] = re[k] * wr - im[k] * wi;
+        out_im[t + s * (radix * q + k)] = re[k] * wi + im[k] * wr;
+      }
+    }
+  }
+}
+
+/* Unscaled FRAMESAMPLES_HALF-point DFT of re + i * im, in place, with the
+ * exponent sign of WebRtcIsac_Fftns(..., -1, ...). Swapping |re| and |im|
+ * gives the transform with the opposite sign. The passes form a
+ * self-sorting (Stockham) mixed-radix FFT, and alternate between the input
+ * and the scratch buffers of |fftstr_obj|. */
+static void Fft(const TransformTables* tables,
+                double* re,
+                double* im,
+                FFTstr* fftstr_obj) {
+  int k, n = FRAMESAMPLES_HALF, s = 1;
+  double* in_re = re;
+  double* in_im = im;
+  double* out_re = fftstr_obj->Tmp0;
+  double* out_im = fftstr_obj->Tmp1;
+  double* tmp;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const int use_sse2 = WebRtc_UseSSE2();
+#endif
+
+  for (k = 0; k < FFT_PASSES; k++) {
+    const int m = n / kFftRadix[k];
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (use_sse2) {
+      WebRtcIsac_FftPassSSE2(tables, kFftRadix[k], m, s, in_re, in_im, out_re,
+                             out_im);
+    } else {
+      FftPass(tables, kFftRadix[k], m, s, in_re, in_im, out_re, out_im);
+    }
+#else
+    FftPass(tables, kFftRadix[k], m, s, in_re, in_im, out_re, out_im);
+#endif
+    tmp = in_re;
+    in_re = out_re;
+    out_re = tmp;
+    tmp = in_im;
+    in_im = out_im;
+    out_im = tmp;
+    n = m;
+    s *= kFftRadix[k];
+  }
+
+  /* An even number of passes leaves the result in place. */
+  RTC_DCHECK(in_re == re);
 }
 
 void WebRtcIsac_Time2Spec(const TransformTables* tables,
@@ -43,14 +209,10 @@ void WebRtcIsac_Time2Spec(const TransformTables* tables,
                           int16_t* outimQ7,
                           FFTstr* fftstr_obj) {
   int k;
-  int dims[1];
   double tmp1r, tmp1i, xr, xi, yr, yi, fact;
   double tmpre[FRAMESAMPLES_HALF], tmpim[FRAMESAMPLES_HALF];
 
 
-  dims[0] = FRAMESAMPLES_HALF;
-
-
   /* Multiply with complex exponentials and combine into one complex vector */
   fact = 0.5 / sqrt(FRAMESAMPLES_HALF);
   for (k = 0; k < FRAMESAMPLES_HALF; k++) {
@@ -62,7 +224,7 @@ void WebRtcIsac_Time2Spec(const TransformTables* tables,
 
 
   /* Get DFT */
-  WebRtcIsac_Fftns(1, dims, tmpre, tmpim, -1, 1.0, fftstr_obj);
+  Fft(tables, tmpre, tmpim, fftstr_obj);
 
   /* Use symmetry to separate into two complex vectors and center frames in time around zero */
   for (k = 0; k < FRAMESAMPLES_QUARTER; k++) {
@@ -89,10 +251,6 @@ void WebRtcIsac_Spec2time(const TransformTables* tables,
   int k;
   double tmp1r, tmp1i, xr, xi, yr, yi, fact;
 
-  int dims;
-
-  dims = FRAMESAMPLES_HALF;
-
   for (k = 0; k < FRAMESAMPLES_QUARTER; k++) {
     /* Move zero in time to beginning of frames */
     tmp1r = tables->costab2[k];
@@ -110,12 +268,12 @@ void WebRtcIsac_Spec2time(const TransformTables* tables,
   }
 
 
-  /* Get IDFT */
-  WebRtcIsac_Fftns(1, &dims, outre1, outre2, 1, FRAMESAMPLES_HALF, fftstr_obj);
+  /* Get IDFT, scaled by 1 / FRAMESAMPLES_HALF in |fact| below */
+  Fft(tables, outre2, outre1, fftstr_obj);
 
 
   /* Demodulate and separate */
-  fact = sqrt(FRAMESAMPLES_HALF);
+  fact = 1.0 / sqrt(FRAMESAMPLES_HALF);
   for (k = 0; k < FRAMESAMPLES_HALF; k++) {
     tmp1r = tables->costab1[k];
     tmp1i = tables->sintab1[k];
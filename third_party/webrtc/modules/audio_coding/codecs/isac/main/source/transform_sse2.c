@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* One pass of the planned FFT of WebRtcIsac_Time2Spec() and
+ * WebRtcIsac_Spec2time(), optimized for SSE2. Two butterflies are computed at
+ * a time, in the two lanes of the registers. The butterflies are the same as
+ * those of FftPass() in transform.c. */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/main/source/codec.h"
+#include "rtc_base/checks.h"
+
+#define FFT_SIN3 0.86602540378443864676
+#define FFT_COS5_1 0.30901699437494742410
+#define FFT_COS5_2 -0.80901699437494742410
+#define FFT_SIN5_1 0.95105651629515357212
+#define FFT_SIN5_2 0.58778525229247312917
+
+static __inline __m128d Mul(__m128d a, double b) {
+  return _mm_mul_pd(a, _mm_set1_pd(b));
+}
+
+static void Butterfly(int radix, __m128d* re, __m128d* im) {
+  __m128d t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+  switch (radix) {
+    case 3:
+      t0r = _mm_add_pd(re[1], re[2]);
+      t0i = _mm_add_pd(im[1], im[2]);
+      t1r = Mul(_mm_sub_pd(im[1], im[2]), FFT_SIN3);
+      t1i = Mul(_mm_sub_pd(re[2], re[1]), FFT_SIN3);
+      t2r = _mm_sub_pd(re[0], Mul(t0r, 0.5));
+      t2i = _mm_sub_pd(im[0], Mul(t0i, 0.5));
+      re[0] = _mm_add_pd(re[0], t0r);
+      im[0] = _mm_add_pd(im[0], t0i);
+      re[1] = _mm_add_pd(t2r, t1r);
+      im[1] = _mm_add_pd(t2i, t1i);
+      re[2] = _mm_sub_pd(t2r, t1r);
+      im[2] = _mm_sub_pd(t2i, t1i);
+      break;
+    case 4:
+      t0r = _mm_add_pd(re[0], re[2]);
+      t0i = _mm_add_pd(im[0], im[2]);
+      t1r = _mm_sub_pd(re[0], re[2]);
+      t1i = _mm_sub_pd(im[0], im[2]);
+      t2r = _mm_add_pd(re[1], re[3]);
+      t2i = _mm_add_pd(im[1], im[3]);
+      t3r = _mm_sub_pd(im[1], im[3]);
+      t3i = _mm_sub_pd(re[3], re[1]);
+      re[0] = _mm_add_pd(t0r, t2r);
+      im[0] = _mm_add_pd(t0i, t2i);
+      re[1] = _mm_add_pd(t1r, t3r);
+      im[1] = _mm_add_pd(t1i, t3i);
+      re[2] = _mm_sub_pd(t0r, t2r);
+      im[2] = _mm_sub_pd(t0i, t2i);
+      re[3] = _mm_sub_pd(t1r, t3r);
+      im[3] = _mm_sub_pd(t1i, t3i);
+      break;
+    case 5: {
+      const __m128d s1r = _mm_add_pd(re[1], re[4]);
+      const __m128d s1i = _mm_add_pd(im[1], im[4]);
+      const __m128d d1r = _mm_sub_pd(re[1], re[4]);
+      const __m128d d1i = _mm_sub_pd(im[1], im[4]);
+      const __m128d s2r = _mm_add_pd(re[2], re[3]);
+      const __m128d s2i = _mm_add_pd(im[2], im[3]);
+      const __m128d d2r = _mm_sub_pd(re[2], re[3]);
+      const __m128d d2i = _mm_sub_pd(im[2], im[3]);
+      t0r = _mm_add_pd(re[0], _mm_add_pd(Mul(s1r, FFT_COS5_1),
+                                         Mul(s2r, FFT_COS5_2)));
+      t0i = _mm_add_pd(im[0], _mm_add_pd(Mul(s1i, FFT_COS5_1),
+                                         Mul(s2i, FFT_COS5_2)));
+      t1r = _mm_add_pd(re[0], _mm_add_pd(Mul(s1r, FFT_COS5_2),
+                                         Mul(s2r, FFT_COS5_1)));
+      t1i = _mm_add_pd(im[0], _mm_add_pd(Mul(s1i, FFT_COS5_2),
+                                         Mul(s2i, FFT_COS5_1)));
+      t2r = _mm_add_pd(Mul(d1i, FFT_SIN5_1), Mul(d2i, FFT_SIN5_2));
+      t2i = _mm_sub_pd(Mul(d1r, -FFT_SIN5_1), Mul(d2r, FFT_SIN5_2));
+      t3r = _mm_sub_pd(Mul(d1i, FFT_SIN5_2), Mul(d2i, FFT_SIN5_1));
+      t3i = _mm_add_pd(Mul(d1r, -FFT_SIN5_2), Mul(d2r, FFT_SIN5_1));
+      re[0] = _mm_add_pd(re[0], _mm_add_pd(s1r, s2r));
+      im[0] = _mm_add_pd(im[0], _mm_add_pd(s1i, s2i));
+      re[1] = _mm_add_pd(t0r, t2r);
+      im[1] = _mm_add_pd(t0i, t2i);
+      re[4] = _mm_sub_pd(t0r, t2r);
+      im[4] = _mm_sub_pd(t0i, t2i);
+      re[2] = _mm_add_pd(t1r, t3r);
+      im[2] = _mm_add_pd(t1i, t3i);
+      re[3] = _mm_sub_pd(t1r, t3r);
+      im[3] = _mm_sub_pd(t1i, t3i);
+      break;
+    }
+  }
+}
+
+void WebRtcIsac_FftPassSSE2(const TransformTables* tables,
+                            int radix,
+                            int m,
+                            int s,
+                            const double* in_re,
+                            const double* in_im,
+                            double* out_re,
+                            double* out_im) {
+  int q, t, k;
+  __m128d re[5], im[5];
+
+  if (s == 1) {
+    /* The butterflies q and q + 1 read adjacent samples, and use different
+     * twiddle factors. */
+    RTC_DCHECK_EQ(0, m % 2);
+    for (q = 0; q < m; q += 2) {
+      for (k = 0; k < radix; k++) {
+        re[k] = _mm_loadu_pd(&in_re[q + k * m]);
+        im[k] = _mm_loadu_pd(&in_im[q + k * m]);
+      }
+      Butterfly(radix, re, im);
+      _mm_storel_pd(&out_re[radix * q], re[0]);
+      _mm_storel_pd(&out_im[radix * q], im[0]);
+      _mm_storeh_pd(&out_re[radix * (q + 1)], re[0]);
+      _mm_storeh_pd(&out_im[radix * (q + 1)], im[0]);
+      for (k = 1; k < radix; k++) {
+        const __m128d wr = _mm_loadh_pd(
+            _mm_load_sd(&tables->fftcostab[k * q]),
+            &tables->fftcostab[k * (q + 1)]);
+        const __m128d wi = _mm_loadh_pd(
+            _mm_load_sd(&tables->fftsintab[k * q]),
+            &tables->fftsintab[k * (q + 1)]);
+        const __m128d yr =
+            _mm_sub_pd(_mm_mul_pd(re[k], wr), _mm_mul_pd(im[k], wi));
+        const __m128d yi =
+            _mm_add_pd(_mm_mul_pd(re[k], wi), _mm_mul_pd(im[k], wr));
+        _mm_storel_pd(&out_re[radix * q + k], yr);
+        _mm_storel_pd(&out_im[radix * q + k], yi);
+        _mm_storeh_pd(&out_re[radix * (q + 1) + k], yr);
+        _mm_storeh_pd(&out_im[radix * (q + 1) + k], yi);
+      }
+    }
+  } else {
+    /* The butterflies t and t + 1 read and write adjacent samples, and share
+     * the twiddle factors. */
+    RTC_DCHECK_EQ(0, s % 2);
+    for (q = 0; q < m; q++) {
+      for (t = 0; t < s; t += 2) {
+        for (k = 0; k < radix; k++) {
+          re[k] = _mm_loadu_pd(&in_re[t + s * (q + k * m)]);
+          im[k] = _mm_loadu_pd(&in_im[t + s * (q + k * m)]);
+        }
+        Butterfly(radix, re, im);
+        _mm_storeu_pd(&out_re[t + s * radix * q], re[0]);
+        _mm_storeu_pd(&out_im[t + s * radix * q], im[0]);
+        for (k = 1; k < radix; k++) {
+          const __m128d wr = _mm_set1_pd(tables->fftcostab[k * q * s]);
+          const __m128d wi = _mm_set1_pd(tables->fftsintab[k * q * s]);
+          _mm_storeu_pd(
+              &out_re[t + s * (radix * q + k)],
+              _mm_sub_pd(_mm_mul_pd(re[k], wr), _mm_mul_pd(im[k], wi)));
+          _mm_storeu_pd(
+              &out_im[t + s * (radix * q + k)],
+              _mm_add_pd(_mm_mul_pd(re[k], wi), _mm_mul_pd(im[k], wr)));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,294 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Micro-benchmark of the entropy coding of iSAC payloads. The lower band of
+// every payload is entropy decoded the way WebRtcIsac_DecodeLb() does it,
+// without the signal processing, and the decoded spectra are then encoded
+// again with WebRtcIsac_EncodeSpec(). The cost per frame is reported for both
+// directions, together with checksums of the decoded spectra and of the
+// re-encoded bitstreams, which must not change with optimizations.
+//
+// The payloads are either recorded in a file, as a 16-bit little endian
+// length followed by the payload bytes for every payload, or made by encoding
+// 16-bit mono PCM at 16 kHz. In that case they can be recorded to a file.
+//
+// Usage: isac_entropy_benchmark <input.pcm|input.isac> [loops] [30|60]
+//                               [record.isac]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_coding/codecs/isac/main/include/isac.h"
+extern "C" {
+#include "modules/audio_coding/codecs/isac/main/source/arith_routines.h"
+#include "modules/audio_coding/codecs/isac/main/source/codec.h"
+#include "modules/audio_coding/codecs/isac/main/source/entropy_coding.h"
+#include "modules/audio_coding/codecs/isac/main/source/settings.h"
+#include "modules/audio_coding/codecs/isac/main/source/structs.h"
+}
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const size_t kBlockSamples = 160;
+
+// The spectrum of one decoded frame, in Q7 as WebRtcIsac_EncodeSpec() takes
+// it.
+struct Frame {
+  int16_t real[FRAMESAMPLES_HALF];
+  int16_t imag[FRAMESAMPLES_HALF];
+  int16_t avg_pitch_gain_q12;
+};
+
+struct Result {
+  double decode_ns = 0;
+  double encode_ns = 0;
+  size_t payload_bytes = 0;
+  uint32_t decode_checksum = 0;
+  uint32_t encode_checksum = 0;
+};
+
+uint32_t Checksum(uint32_t checksum, const int16_t* data, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    checksum = checksum * 31 + static_cast<uint16_t>(data[i]);
+  }
+  return checksum;
+}
+
+bool ReadPayloads(const std::string& file_name,
+                  std::vector<std::vector<uint8_t>>* payloads) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", file_name.c_str());
+    return false;
+  }
+  uint8_t length[2];
+  while (fread(length, 1, 2, file) == 2) {
+    std::vector<uint8_t> payload(length[0] | (length[1] << 8));
+    if (payload.empty() ||
+        fread(payload.data(), 1, payload.size(), file) != payload.size()) {
+      fprintf(stderr, "%s is truncated\n", file_name.c_str());
+      fclose(file);
+      return false;
+    }
+    payloads->push_back(payload);
+  }
+  fclose(file);
+  return true;
+}
+
+bool WritePayloads(const std::string& file_name,
+                   const std::vector<std::vector<uint8_t>>& payloads) {
+  FILE* file = fopen(file_name.c_str(), "wb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", file_name.c_str());
+    return false;
+  }
+  for (const std::vector<uint8_t>& payload : payloads) {
+    const uint8_t length[2] = {static_cast<uint8_t>(payload.size() & 0xff),
+                               static_cast<uint8_t>(payload.size() >> 8)};
+    fwrite(length, 1, 2, file);
+    fwrite(payload.data(), 1, payload.size(), file);
+  }
+  fclose(file);
+  return true;
+}
+
+// Encodes 16 kHz PCM from |file_name| with |frame_ms| frames at 32 kbps.
+bool EncodePayloads(const std::string& file_name,
+                    int16_t frame_ms,
+                    std::vector<std::vector<uint8_t>>* payloads) {
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", file_name.c_str());
+    return false;
+  }
+  ISACStruct* encoder = nullptr;
+  WebRtcIsac_Create(&encoder);
+  WebRtcIsac_EncoderInit(encoder, 1);
+  WebRtcIsac_Control(encoder, 32000, frame_ms);
+  int16_t block[kBlockSamples];
+  uint8_t encoded[STREAM_SIZE_MAX];
+  while (fread(block, sizeof(block[0]), kBlockSamples, file) ==
+         kBlockSamples) {
+    const int bytes = WebRtcIsac_Encode(encoder, block, encoded);
+    if (bytes < 0) {
+      fprintf(stderr, "Encoding failed\n");
+      break;
+    }
+    if (bytes > 0) {
+      payloads->push_back(std::vector<uint8_t>(encoded, encoded + bytes));
+    }
+  }
+  WebRtcIsac_Free(encoder);
+  fclose(file);
+  return true;
+}
+
+// Entropy decodes the lower band of |payload| into |frames|. Returns false if
+// the payload is malformed.
+bool DecodePayload(const std::vector<uint8_t>& payload,
+                   Bitstr* bitstream,
+                   std::vector<Frame>* frames) {
+  double lo_filt_coef[(ORDERLO + 1) * SUBFRAMES];
+  double hi_filt_coef[(ORDERHI + 1) * SUBFRAMES];
+  double real[FRAMESAMPLES_HALF];
+  double imag[FRAMESAMPLES_HALF];
+  double pitch_lags[4];
+  int16_t pitch_gains_q12[4];
+  int16_t frame_samples;
+  int16_t bandwidth_index;
+
+  WebRtcIsac_ResetBitstream(bitstream);
+  memcpy(bitstream->stream, payload.data(),
+         std::min<size_t>(payload.size(), STREAM_SIZE_MAX));
+  if (WebRtcIsac_DecodeFrameLen(bitstream, &frame_samples) < 0 ||
+      WebRtcIsac_DecodeSendBW(bitstream, &bandwidth_index) < 0) {
+    return false;
+  }
+  const int num_frames = frame_samples / MAX_FRAMESAMPLES + 1;
+  for (int i = 0; i < num_frames; ++i) {
+    if (WebRtcIsac_DecodePitchGain(bitstream, pitch_gains_q12) < 0 ||
+        WebRtcIsac_DecodePitchLag(bitstream, pitch_gains_q12, pitch_lags) <
+            0 ||
+        WebRtcIsac_DecodeLpc(bitstream, lo_filt_coef, hi_filt_coef) < 0) {
+      return false;
+    }
+    Frame frame;
+    frame.avg_pitch_gain_q12 =
+        (pitch_gains_q12[0] + pitch_gains_q12[1] + pitch_gains_q12[2] +
+         pitch_gains_q12[3]) >> 2;
+    if (WebRtcIsac_DecodeSpec(bitstream, frame.avg_pitch_gain_q12,
+                              kIsacLowerBand, real, imag) < 0) {
+      return false;
+    }
+    // The lower band spectrum is decoded in Q7.
+    for (int k = 0; k < FRAMESAMPLES_HALF; ++k) {
+      frame.real[k] = static_cast<int16_t>(lrint(real[k] * 128));
+      frame.imag[k] = static_cast<int16_t>(lrint(imag[k] * 128));
+    }
+    frames->push_back(frame);
+  }
+  return true;
+}
+
+Result Run(const std::vector<std::vector<uint8_t>>& payloads, int loops) {
+  Result result;
+  Bitstr bitstream;
+  std::vector<Frame> frames;
+  memset(&bitstream, 0, sizeof(bitstream));
+
+  int64_t decode_ns = 0;
+  for (int loop = 0; loop < loops; ++loop) {
+    frames.clear();
+    const int64_t start_ns = rtc::TimeNanos();
+    for (const std::vector<uint8_t>& payload : payloads) {
+      if (!DecodePayload(payload, &bitstream, &frames)) {
+        fprintf(stderr, "Malformed payload\n");
+        return Result();
+      }
+    }
+    decode_ns += rtc::TimeNanos() - start_ns;
+  }
+  for (const Frame& frame : frames) {
+    result.decode_checksum =
+        Checksum(result.decode_checksum, frame.real, FRAMESAMPLES_HALF);
+    result.decode_checksum =
+        Checksum(result.decode_checksum, frame.imag, FRAMESAMPLES_HALF);
+  }
+
+  int64_t encode_ns = 0;
+  for (int loop = 0; loop < loops; ++loop) {
+    for (const Frame& frame : frames) {
+      const int64_t start_ns = rtc::TimeNanos();
+      WebRtcIsac_ResetBitstream(&bitstream);
+      const int err =
+          WebRtcIsac_EncodeSpec(frame.real, frame.imag,
+                                frame.avg_pitch_gain_q12, kIsacLowerBand,
+                                &bitstream);
+      const int bytes = err < 0 ? err : WebRtcIsac_EncTerminate(&bitstream);
+      encode_ns += rtc::TimeNanos() - start_ns;
+      if (loop == 0) {
+        // An error code is part of the checksum.
+        result.encode_checksum = result.encode_checksum * 31 + bytes;
+        for (int i = 0; i < bytes; ++i) {
+          result.encode_checksum =
+              result.encode_checksum * 31 + bitstream.stream[i];
+        }
+        result.payload_bytes += bytes > 0 ? bytes : 0;
+      }
+    }
+  }
+
+  const double count = static_cast<double>(frames.size()) * loops;
+  result.decode_ns = decode_ns / count;
+  result.encode_ns = encode_ns / count;
+  return result;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <input.pcm|input.isac> [loops] [30|60] "
+            "[record.isac]\n",
+            argv[0]);
+    return 1;
+  }
+  const std::string input = argv[1];
+  const int loops = argc > 2 ? atoi(argv[2]) : 10;
+  const int16_t frame_ms = static_cast<int16_t>(argc > 3 ? atoi(argv[3]) : 30);
+  if (loops < 1) {
+    fprintf(stderr, "Invalid number of loops\n");
+    return 1;
+  }
+  if (frame_ms != 30 && frame_ms != 60) {
+    fprintf(stderr, "The frame size must be 30 or 60 ms\n");
+    return 1;
+  }
+
+  WebRtcSpl_Init();
+  std::vector<std::vector<uint8_t>> payloads;
+  const size_t dot = input.rfind('.');
+  if (dot != std::string::npos && input.substr(dot) == ".isac") {
+    if (!webrtc::ReadPayloads(input, &payloads)) {
+      return 1;
+    }
+  } else if (!webrtc::EncodePayloads(input, frame_ms, &payloads) ||
+             (argc > 4 && !webrtc::WritePayloads(argv[4], payloads))) {
+    return 1;
+  }
+  if (payloads.empty()) {
+    fprintf(stderr, "No payloads\n");
+    return 1;
+  }
+
+  const webrtc::Result result = webrtc::Run(payloads, loops);
+  if (result.decode_ns == 0) {
+    return 1;
+  }
+  printf("%d payloads, %d loops\n", static_cast<int>(payloads.size()), loops);
+  printf("%14s %14s %10s %10s %10s\n", "decode_us", "encode_us", "bytes",
+         "dec_sum", "enc_sum");
+  printf("%14.2f %14.2f %10d %10x %10x\n", result.decode_ns / 1000,
+         result.encode_ns / 1000, static_cast<int>(result.payload_bytes),
+         result.decode_checksum, result.encode_checksum);
+  return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the planned 240-point FFT of WebRtcIsac_Time2Spec() and
+// WebRtcIsac_Spec2time(), which runs its passes with SSE2 where the CPU has
+// it, against the transforms that used WebRtcIsac_Fftns() before, reproduced
+// below. Frames of random, sinusoidal, small and zero input are transformed
+// both ways. The Q7 spectra of Time2Spec may differ by kSpectrumTolerance
+// where a value rounds the other way, and the output of Spec2time must agree
+// within kTimeTolerance, relative to its largest value. The time per call of
+// both is printed too. Returns 0 if all outputs are within tolerance.
+//
+// Usage: isac_fft_check [frames]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+extern "C" {
+#include "modules/audio_coding/codecs/isac/main/source/codec.h"
+#include "modules/audio_coding/codecs/isac/main/source/os_specific_inline.h"
+#include "modules/audio_coding/codecs/isac/main/source/settings.h"
+#include "modules/audio_coding/codecs/isac/main/source/structs.h"
+#include "modules/third_party/fft/fft.h"
+}
+
+namespace webrtc {
+namespace {
+
+// One Q7 step, for values that lie on a rounding boundary.
+const int kSpectrumTolerance = 1;
+// Largest difference of Spec2time, relative to the largest output of a
+// frame. The planned FFT adds in a different order than WebRtcIsac_Fftns().
+const double kTimeTolerance = 1e-12;
+const int kNumKinds = 4;
+// Keeps the Q7 spectra of the random input within int16_t.
+const double kTimeAmplitude = 8.0;
+const double kSpectrumAmplitude = 1000.0;
+
+// WebRtcIsac_Time2Spec() before the planned FFT.
+void Time2SpecReference(const TransformTables* tables,
+                        double* inre1,
+                        double* inre2,
+                        int16_t* outreQ7,
+                        int16_t* outimQ7,
+                        FFTstr* fftstr_obj) {
+  int k;
+  int dims[1];
+  double tmp1r, tmp1i, xr, xi, yr, yi, fact;
+  double tmpre[FRAMESAMPLES_HALF], tmpim[FRAMESAMPLES_HALF];
+
+  dims[0] = FRAMESAMPLES_HALF;
+
+  fact = 0.5 / sqrt(FRAMESAMPLES_HALF);
+  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
+    tmp1r = tables->costab1[k];
+    tmp1i = tables->sintab1[k];
+    tmpre[k] = (inre1[k] * tmp1r + inre2[k] * tmp1i) * fact;
+    tmpim[k] = (inre2[k] * tmp1r - inre1[k] * tmp1i) * fact;
+  }
+
+  WebRtcIsac_Fftns(1, dims, tmpre, tmpim, -1, 1.0, fftstr_obj);
+
+  for (k = 0; k < FRAMESAMPLES_QUARTER; k++) {
+    xr = tmpre[k] + tmpre[FRAMESAMPLES_HALF - 1 - k];
+    yi = -tmpre[k] + tmpre[FRAMESAMPLES_HALF - 1 - k];
+    xi = tmpim[k] - tmpim[FRAMESAMPLES_HALF - 1 - k];
+    yr = tmpim[k] + tmpim[FRAMESAMPLES_HALF - 1 - k];
+
+    tmp1r = tables->costab2[k];
+    tmp1i = tables->sintab2[k];
+    outreQ7[k] = static_cast<int16_t>(
+        WebRtcIsac_lrint((xr * tmp1r - xi * tmp1i) * 128.0));
+    outimQ7[k] = static_cast<int16_t>(
+        WebRtcIsac_lrint((xr * tmp1i + xi * tmp1r) * 128.0));
+    outreQ7[FRAMESAMPLES_HALF - 1 - k] = static_cast<int16_t>(
+        WebRtcIsac_lrint((-yr * tmp1i - yi * tmp1r) * 128.0));
+    outimQ7[FRAMESAMPLES_HALF - 1 - k] = static_cast<int16_t>(
+        WebRtcIsac_lrint((-yr * tmp1r + yi * tmp1i) * 128.0));
+  }
+}
+
+// WebRtcIsac_Spec2time() before the planned FFT.
+void Spec2timeReference(const TransformTables* tables,
+                        double* inre,
+                        double* inim,
+                        double* outre1,
+                        double* outre2,
+                        FFTstr* fftstr_obj) {
+  int k;
+  int dims = FRAMESAMPLES_HALF;
+  double tmp1r, tmp1i, xr, xi, yr, yi, fact;
+
+  for (k = 0; k < FRAMESAMPLES_QUARTER; k++) {
+    tmp1r = tables->costab2[k];
+    tmp1i = tables->sintab2[k];
+    xr = inre[k] * tmp1r + inim[k] * tmp1i;
+    xi = inim[k] * tmp1r - inre[k] * tmp1i;
+    yr = -inim[FRAMESAMPLES_HALF - 1 - k] * tmp1r -
+         inre[FRAMESAMPLES_HALF - 1 - k] * tmp1i;
+    yi = -inre[FRAMESAMPLES_HALF - 1 - k] * tmp1r +
+         inim[FRAMESAMPLES_HALF - 1 - k] * tmp1i;
+
+    outre1[k] = xr - yi;
+    outre1[FRAMESAMPLES_HALF - 1 - k] = xr + yi;
+    outre2[k] = xi + yr;
+    outre2[FRAMESAMPLES_HALF - 1 - k] = -xi + yr;
+  }
+
+  WebRtcIsac_Fftns(1, &dims, outre1, outre2, 1, FRAMESAMPLES_HALF, fftstr_obj);
+
+  fact = sqrt(FRAMESAMPLES_HALF);
+  for (k = 0; k < FRAMESAMPLES_HALF; k++) {
+    tmp1r = tables->costab1[k];
+    tmp1i = tables->sintab1[k];
+    xr = (outre1[k] * tmp1r - outre2[k] * tmp1i) * fact;
+    outre2[k] = (outre2[k] * tmp1r + outre1[k] * tmp1i) * fact;
+    outre1[k] = xr;
+  }
+}
+
+// Fills |x| with |length| values of one of the kinds of input, of up to
+// |amplitude|.
+void Fill(int kind, double amplitude, double* x, size_t length) {
+  const double frequency = 2.0 * M_PI * (1 + rand() % 100) / length;
+  for (size_t i = 0; i < length; ++i) {
+    switch (kind) {
+      case 0:
+        x[i] = amplitude * (2.0 * rand() / RAND_MAX - 1.0);
+        break;
+      case 1:
+        x[i] = amplitude * sin(frequency * i);
+        break;
+      case 2:
+        x[i] = 1e-3 * amplitude * (2.0 * rand() / RAND_MAX - 1.0);
+        break;
+      default:
+        x[i] = 0.0;
+        break;
+    }
+  }
+}
+
+// Returns the largest difference between |a| and |b| relative to the largest
+// absolute value of |a|, or 0 if both are zero.
+double RelativeDifference(const double* a, const double* b, size_t length) {
+  double max_value = 0;
+  double max_difference = 0;
+  for (size_t i = 0; i < length; ++i) {
+    max_value = std::max(max_value, fabs(a[i]));
+    max_difference = std::max(max_difference, fabs(a[i] - b[i]));
+  }
+  if (max_difference == 0) {
+    return 0;
+  }
+  return max_value > 0 ? max_difference / max_value : HUGE_VAL;
+}
+
+// Sets |time2spec_ns| and |spec2time_ns| to the time per call of the planned
+// transforms, or of the references, on random input.
+void Time(const TransformTables* tables,
+          bool planned,
+          int iterations,
+          double* time2spec_ns,
+          double* spec2time_ns) {
+  FFTstr fftstr_obj;
+  double in1[FRAMESAMPLES_HALF];
+  double in2[FRAMESAMPLES_HALF];
+  int16_t re_q7[FRAMESAMPLES_HALF];
+  int16_t im_q7[FRAMESAMPLES_HALF];
+  double out1[FRAMESAMPLES_HALF];
+  double out2[FRAMESAMPLES_HALF];
+  Fill(0, kTimeAmplitude, in1, FRAMESAMPLES_HALF);
+  Fill(0, kTimeAmplitude, in2, FRAMESAMPLES_HALF);
+
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    if (planned) {
+      WebRtcIsac_Time2Spec(tables, in1, in2, re_q7, im_q7, &fftstr_obj);
+    } else {
+      Time2SpecReference(tables, in1, in2, re_q7, im_q7, &fftstr_obj);
+    }
+    in1[i % FRAMESAMPLES_HALF] += 1e-3 * re_q7[0];
+  }
+  *time2spec_ns =
+      static_cast<double>(rtc::TimeNanos() - start_ns) / iterations;
+
+  start_ns = rtc::TimeNanos();
+  for (int i = 0; i < iterations; ++i) {
+    if (planned) {
+      WebRtcIsac_Spec2time(tables, in1, in2, out1, out2, &fftstr_obj);
+    } else {
+      Spec2timeReference(tables, in1, in2, out1, out2, &fftstr_obj);
+    }
+    in2[i % FRAMESAMPLES_HALF] += 1e-3 * out1[0];
+  }
+  *spec2time_ns =
+      static_cast<double>(rtc::TimeNanos() - start_ns) / iterations;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const int frames = argc > 1 ? atoi(argv[1]) : 2000;
+  if (frames < 1) {
+    fprintf(stderr, "Usage: %s [frames]\n", argv[0]);
+    return 1;
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  printf("Kernel: %s\n", WebRtc_UseSSE2() ? "SSE2" : "C");
+#endif
+
+  TransformTables tables;
+  WebRtcIsac_InitTransform(&tables);
+  FFTstr fftstr_obj;
+  double in1[FRAMESAMPLES_HALF];
+  double in2[FRAMESAMPLES_HALF];
+  int16_t re_q7[FRAMESAMPLES_HALF];
+  int16_t im_q7[FRAMESAMPLES_HALF];
+  int16_t expected_re_q7[FRAMESAMPLES_HALF];
+  int16_t expected_im_q7[FRAMESAMPLES_HALF];
+  double out1[FRAMESAMPLES_HALF];
+  double out2[FRAMESAMPLES_HALF];
+  double expected_out1[FRAMESAMPLES_HALF];
+  double expected_out2[FRAMESAMPLES_HALF];
+
+  srand(1);
+  int max_spectrum_difference = 0;
+  int spectrum_values_differ = 0;
+  double max_time_difference = 0;
+  for (int i = 0; i < frames; ++i) {
+    const int kind = i % webrtc::kNumKinds;
+    webrtc::Fill(kind, webrtc::kTimeAmplitude, in1, FRAMESAMPLES_HALF);
+    webrtc::Fill(kind, webrtc::kTimeAmplitude, in2, FRAMESAMPLES_HALF);
+    WebRtcIsac_Time2Spec(&tables, in1, in2, re_q7, im_q7, &fftstr_obj);
+    webrtc::Time2SpecReference(&tables, in1, in2, expected_re_q7,
+                               expected_im_q7, &fftstr_obj);
+    for (int k = 0; k < FRAMESAMPLES_HALF; ++k) {
+      const int difference =
+          std::max(abs(re_q7[k] - expected_re_q7[k]),
+                   abs(im_q7[k] - expected_im_q7[k]));
+      max_spectrum_difference = std::max(max_spectrum_difference, difference);
+      spectrum_values_differ += difference > 0 ? 1 : 0;
+    }
+
+    webrtc::Fill(kind, webrtc::kSpectrumAmplitude, in1, FRAMESAMPLES_HALF);
+    webrtc::Fill(kind, webrtc::kSpectrumAmplitude, in2, FRAMESAMPLES_HALF);
+    WebRtcIsac_Spec2time(&tables, in1, in2, out1, out2, &fftstr_obj);
+    webrtc::Spec2timeReference(&tables, in1, in2, expected_out1,
+                               expected_out2, &fftstr_obj);
+    max_time_difference = std::max(
+        max_time_difference,
+        std::max(webrtc::RelativeDifference(expected_out1, out1,
+                                            FRAMESAMPLES_HALF),
+                 webrtc::RelativeDifference(expected_out2, out2,
+                                            FRAMESAMPLES_HALF)));
+  }
+
+  const bool passed =
+      max_spectrum_difference <= webrtc::kSpectrumTolerance &&
+      max_time_difference <= webrtc::kTimeTolerance;
+  printf("%d frames\n", frames);
+  printf("Time2Spec: %d Q7 values differ, by at most %d (tolerance %d)\n",
+         spectrum_values_differ, max_spectrum_difference,
+         webrtc::kSpectrumTolerance);
+  printf("Spec2time: largest relative difference %g (tolerance %g)\n",
+         max_time_difference, webrtc::kTimeTolerance);
+
+  const int timed = 50 * frames;
+  double time2spec_ns, spec2time_ns, time2spec_before_ns, spec2time_before_ns;
+  webrtc::Time(&tables, true, timed, &time2spec_ns, &spec2time_ns);
+  webrtc::Time(&tables, false, timed, &time2spec_before_ns,
+               &spec2time_before_ns);
+  printf("ns per call: Time2Spec %.0f (before %.0f), Spec2time %.0f "
+         "(before %.0f)\n",
+         time2spec_ns, time2spec_before_ns, spec2time_ns, spec2time_before_ns);
+  printf("%s\n", passed ? "passed" : "FAILED");
+  return passed ? 0 : 1;
+}
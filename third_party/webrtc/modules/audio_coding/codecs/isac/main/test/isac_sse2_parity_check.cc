@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the SSE2 autocorrelation of the iSAC LPC analysis against the C
+// code. The input is split into bands like the encoder does it, and
+// WebRtcIsac_AutoCorrSSE2() and WebRtcIsac_AutoCorrC() are run on windows of
+// the bands with the lengths and orders of the LPC analysis. The
+// autocorrelations, and the coefficients WebRtcIsac_LevDurb() derives from
+// them, must agree within kLpcTolerance. Returns 0 if they do.
+//
+// The SSE2 windowing and autocorrelation of iSAC-fix is checked by
+// isacfix_sse2_parity_check.
+//
+// Usage: isac_sse2_parity_check <input.pcm>
+//
+// The input is 16-bit mono PCM at 16 kHz.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "system_wrappers/include/cpu_features_sse2.h"
+extern "C" {
+#include "modules/audio_coding/codecs/isac/main/source/filter_functions.h"
+#include "modules/audio_coding/codecs/isac/main/source/isac_vad.h"
+#include "modules/audio_coding/codecs/isac/main/source/settings.h"
+#include "modules/audio_coding/codecs/isac/main/source/structs.h"
+}
+
+namespace webrtc {
+namespace {
+
+// Largest difference between SSE2 and C, relative to the largest value of a
+// window. The SSE2 autocorrelation adds the products of every lag in the C
+// order, so any difference is a bug.
+const double kLpcTolerance = 1e-12;
+
+// The length and order of one autocorrelation of the LPC analysis.
+struct AutoCorrSize {
+  size_t length;
+  size_t order;
+};
+
+// Orders ORDERLO + 1 and ORDERHI of the lower and upper band, order
+// UB_LPC_ORDER + 1 of the upper band codec at 32 kHz, and the pitch
+// weighting filter.
+const AutoCorrSize kSizes[] = {{WINLEN, ORDERLO + 1},
+                               {WINLEN, ORDERHI},
+                               {WINLEN, UB_LPC_ORDER + 1},
+                               {PITCH_WLPCWINLEN, PITCH_WLPCORDER}};
+
+const size_t kMaxOrder = ORDERLO + 1;
+
+// Splits |input| into bands like the iSAC encoder, and returns the lower and
+// upper band lookahead signals of all frames.
+void SplitBands(const std::vector<int16_t>& input,
+                std::vector<double>* low,
+                std::vector<double>* high) {
+  PreFiltBankstr filterbank;
+  WebRtcIsac_InitPreFilterbank(&filterbank);
+  float in[FRAMESAMPLES];
+  float low_band[FRAMESAMPLES_HALF];
+  float high_band[FRAMESAMPLES_HALF];
+  double low_band_lookahead[FRAMESAMPLES_HALF];
+  double high_band_lookahead[FRAMESAMPLES_HALF];
+  for (size_t i = 0; i + FRAMESAMPLES <= input.size(); i += FRAMESAMPLES) {
+    for (int k = 0; k < FRAMESAMPLES; ++k) {
+      in[k] = input[i + k];
+    }
+    WebRtcIsac_SplitAndFilterFloat(in, low_band, high_band,
+                                   low_band_lookahead, high_band_lookahead,
+                                   &filterbank);
+    low->insert(low->end(), low_band_lookahead,
+                low_band_lookahead + FRAMESAMPLES_HALF);
+    high->insert(high->end(), high_band_lookahead,
+                 high_band_lookahead + FRAMESAMPLES_HALF);
+  }
+}
+
+// Returns the largest difference between |a| and |b| relative to the largest
+// absolute value of |a|, or 0 if both are zero.
+double RelativeDifference(const double* a, const double* b, size_t length) {
+  double max_value = 0;
+  double max_difference = 0;
+  for (size_t i = 0; i < length; ++i) {
+    max_value = std::max(max_value, fabs(a[i]));
+    max_difference = std::max(max_difference, fabs(a[i] - b[i]));
+  }
+  if (max_difference == 0) {
+    return 0;
+  }
+  return max_value > 0 ? max_difference / max_value : HUGE_VAL;
+}
+
+// Runs the SSE2 and C autocorrelation on sine windowed blocks of |signal|,
+// every UPDATE / 2 samples like the LPC analysis, and returns the largest
+// relative difference of the autocorrelations and the LPC coefficients.
+double CompareAutoCorr(const std::vector<double>& signal,
+                       const AutoCorrSize& size,
+                       int* windows) {
+  std::vector<double> window(size.length);
+  for (size_t i = 0; i < size.length; ++i) {
+    window[i] = sin(M_PI * (i + 0.5) / size.length);
+  }
+  std::vector<double> x(size.length);
+  double r_sse2[kMaxOrder + 1];
+  double r_c[kMaxOrder + 1];
+  double a_sse2[kMaxOrder + 1];
+  double a_c[kMaxOrder + 1];
+  double k[kMaxOrder];
+  double max_difference = 0;
+  for (size_t start = 0; start + size.length <= signal.size();
+       start += UPDATE / 2) {
+    for (size_t i = 0; i < size.length; ++i) {
+      x[i] = signal[start + i] * window[i];
+    }
+    WebRtcIsac_AutoCorrSSE2(r_sse2, &x[0], size.length, size.order);
+    WebRtcIsac_AutoCorrC(r_c, &x[0], size.length, size.order);
+    max_difference = std::max(
+        max_difference, RelativeDifference(r_c, r_sse2, size.order + 1));
+    // Like the LPC analysis, with a white noise floor.
+    r_sse2[0] += 1e-6;
+    r_c[0] += 1e-6;
+    WebRtcIsac_LevDurb(a_sse2, k, r_sse2, size.order);
+    WebRtcIsac_LevDurb(a_c, k, r_c, size.order);
+    max_difference = std::max(
+        max_difference, RelativeDifference(a_c, a_sse2, size.order + 1));
+    ++*windows;
+  }
+  return max_difference;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <input.pcm>\n", argv[0]);
+    return 1;
+  }
+  if (!WebRtc_UseSSE2()) {
+    fprintf(stderr, "SSE2 is not available\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  if (input.size() < FRAMESAMPLES) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+
+  std::vector<double> low;
+  std::vector<double> high;
+  webrtc::SplitBands(input, &low, &high);
+  double max_difference = 0;
+  int windows = 0;
+  for (const webrtc::AutoCorrSize& size : webrtc::kSizes) {
+    max_difference = std::max(
+        max_difference, webrtc::CompareAutoCorr(low, size, &windows));
+    max_difference = std::max(
+        max_difference, webrtc::CompareAutoCorr(high, size, &windows));
+  }
+  const bool within_tolerance = max_difference <= webrtc::kLpcTolerance;
+  printf("iSAC: %d windows, largest relative difference %g (tolerance %g), "
+         "%s\n",
+         windows, max_difference, webrtc::kLpcTolerance,
+         within_tolerance ? "passed" : "FAILED");
+  return within_tolerance && windows > 0 ? 0 : 1;
+}
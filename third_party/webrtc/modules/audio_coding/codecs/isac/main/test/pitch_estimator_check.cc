@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Check of the SSE2 decimation and correlation of WebRtcIsac_PitchAnalysis()
+// against the C versions. The input is split into bands like the encoder
+// does it, and the lower band lookahead of every frame is analyzed once with
+// the SSE2 code and once with the C code, each with its own state, by setting
+// the |use_sse2| flag of the state after initialization. The pitch lags and
+// gains must be identical. Returns 0 if they are.
+//
+// Usage: pitch_estimator_check <input.pcm>
+//
+// The input is 16-bit mono PCM at 16 kHz.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+extern "C" {
+#include "modules/audio_coding/codecs/isac/main/source/isac_vad.h"
+#include "modules/audio_coding/codecs/isac/main/source/pitch_estimator.h"
+#include "modules/audio_coding/codecs/isac/main/source/settings.h"
+#include "modules/audio_coding/codecs/isac/main/source/structs.h"
+}
+
+namespace webrtc {
+namespace {
+
+// The lower band lookahead of one frame, as WebRtcIsac_PitchAnalysis() gets
+// it from the encoder.
+struct Frame {
+  double lookahead[PITCH_FRAME_LEN];
+};
+
+struct Pitch {
+  double lags[PITCH_SUBFRAMES];
+  double gains[PITCH_SUBFRAMES];
+};
+
+// Reads 16 kHz PCM from |file_name| and splits it into |frames|.
+bool ReadFrames(const char* file_name, std::vector<Frame>* frames) {
+  FILE* file = fopen(file_name, "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", file_name);
+    return false;
+  }
+  PreFiltBankstr filterbank;
+  WebRtcIsac_InitPreFilterbank(&filterbank);
+  int16_t block[FRAMESAMPLES];
+  float in[FRAMESAMPLES];
+  float low_band[FRAMESAMPLES_HALF];
+  float high_band[FRAMESAMPLES_HALF];
+  double high_band_lookahead[FRAMESAMPLES_HALF];
+  while (fread(block, sizeof(block[0]), FRAMESAMPLES, file) == FRAMESAMPLES) {
+    for (int i = 0; i < FRAMESAMPLES; ++i) {
+      in[i] = block[i];
+    }
+    Frame frame;
+    WebRtcIsac_SplitAndFilterFloat(in, low_band, high_band, frame.lookahead,
+                                   high_band_lookahead, &filterbank);
+    frames->push_back(frame);
+  }
+  fclose(file);
+  return true;
+}
+
+// Analyzes |frames| with a new state, with the SSE2 code or the C code.
+// Returns false if SSE2 is asked for but not available.
+bool Analyze(const std::vector<Frame>& frames,
+             bool use_sse2,
+             std::vector<Pitch>* pitches) {
+  PitchAnalysisStruct state;
+  WebRtcIsac_InitPitchAnalysis(&state);
+  if (use_sse2 && !state.use_sse2) {
+    fprintf(stderr, "SSE2 is not available\n");
+    return false;
+  }
+  state.use_sse2 = use_sse2 ? 1 : 0;
+  double filtered[PITCH_FRAME_LEN + QLOOKAHEAD];
+  pitches->resize(frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    WebRtcIsac_PitchAnalysis(frames[i].lookahead, filtered, &state,
+                             (*pitches)[i].lags, (*pitches)[i].gains);
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <input.pcm>\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<webrtc::Frame> frames;
+  if (!webrtc::ReadFrames(argv[1], &frames)) {
+    return 1;
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+
+  std::vector<webrtc::Pitch> sse2;
+  std::vector<webrtc::Pitch> c;
+  if (!webrtc::Analyze(frames, true, &sse2) ||
+      !webrtc::Analyze(frames, false, &c)) {
+    return 1;
+  }
+  size_t mismatches = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    for (int k = 0; k < PITCH_SUBFRAMES; ++k) {
+      // Compares the bits, since silence gives NaN gains.
+      if (memcmp(&sse2[i].lags[k], &c[i].lags[k], sizeof(double)) == 0 &&
+          memcmp(&sse2[i].gains[k], &c[i].gains[k], sizeof(double)) == 0) {
+        continue;
+      }
+      if (mismatches == 0) {
+        printf("Frame %d, subframe %d: lag %.17g / %.17g, gain %.17g / %.17g "
+               "(SSE2 / C)\n",
+               static_cast<int>(i), k, sse2[i].lags[k], c[i].lags[k],
+               sse2[i].gains[k], c[i].gains[k]);
+      }
+      ++mismatches;
+    }
+  }
+  printf("%d frames, %d of %d lags and gains differ\n",
+         static_cast<int>(frames.size()), static_cast<int>(mismatches),
+         static_cast<int>(frames.size() * PITCH_SUBFRAMES));
+  return mismatches == 0 ? 0 : 1;
+}
@@ -10,11 +10,22 @@
 
 #include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
 
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/audio_coding/codecs/pcm16b/pcm16b_sse2.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
+#endif
+
 size_t WebRtcPcm16b_Encode(const int16_t* speech,
                            size_t len,
                            uint8_t* encoded) {
-  size_t i;
-  for (i = 0; i < len; ++i) {
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2())
+    i = WebRtcPcm16b_SwapBytesSSE2((const uint8_t*)speech, len, encoded);
+#endif
+  for (; i < len; ++i) {
     uint16_t s = speech[i];
     encoded[2 * i] = s >> 8;
     encoded[2 * i + 1] = s;
@@ -25,8 +36,39 @@ size_t WebRtcPcm16b_Encode(const int16_t* speech,
 size_t WebRtcPcm16b_Decode(const uint8_t* encoded,
                            size_t len,
                            int16_t* speech) {
-  size_t i;
-  for (i = 0; i < len / 2; ++i)
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2())
+    i = WebRtcPcm16b_SwapBytesSSE2(encoded, len / 2, (uint8_t*)speech);
+#endif
+  for (; i < len / 2; ++i)
     speech[i] = encoded[2 * i] << 8 | encoded[2 * i + 1];
   return len / 2;
 }
+
+size_t WebRtcPcm16b_EncodeInPlace(int16_t* speech, size_t len) {
+#if defined(WEBRTC_ARCH_LITTLE_ENDIAN)
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2())
+    i = WebRtcPcm16b_SwapBytesSSE2((const uint8_t*)speech, len,
+                                   (uint8_t*)speech);
+#endif
+  for (; i < len; ++i) {
+    uint16_t s = speech[i];
+    speech[i] = (int16_t)(uint16_t)(s << 8 | s >> 8);
+  }
+#endif
+  return 2 * len;
+}
+
+size_t WebRtcPcm16b_DecodeInPlace(uint8_t* encoded,
+                                  size_t len,
+                                  int16_t** speech) {
+  RTC_DCHECK_EQ((uintptr_t)encoded % sizeof(int16_t), 0);
+  *speech = (int16_t*)encoded;
+  // Swapping the bytes of the payload in place is the same operation as
+  // encoding it in place.
+  WebRtcPcm16b_EncodeInPlace(*speech, len / 2);
+  return len / 2;
+}
@@ -56,6 +56,49 @@ size_t WebRtcPcm16b_Encode(const int16_t* speech, size_t len, uint8_t* encoded);
 
 size_t WebRtcPcm16b_Decode(const uint8_t* encoded, size_t len, int16_t* speech);
 
+/****************************************************************************
+ * WebRtcPcm16b_EncodeInPlace(...)
+ *
+ * "Encode" a sample vector to 16 bit linear in place, so that its memory
+ * can be used as the payload without a copy. Nothing is converted on big
+ * endian targets.
+ *
+ * Input:
+ *              - speech        : Input speech vector
+ *              - len           : Number of samples in speech vector
+ *
+ * Output:
+ *              - speech        : Encoded data vector (big endian 16 bit)
+ *
+ * Returned value               : Length (in bytes) of coded data.
+ *                                Always equal to twice the len input parameter.
+ */
+
+size_t WebRtcPcm16b_EncodeInPlace(int16_t* speech, size_t len);
+
+/****************************************************************************
+ * WebRtcPcm16b_DecodeInPlace(...)
+ *
+ * "Decode" a vector to 16 bit linear in place, e.g. in the payload of a
+ * packet, and return a view of the samples without a copy. Nothing is
+ * converted on big endian targets.
+ *
+ * Input:
+ *              - encoded       : Encoded data vector (big endian 16 bit),
+ *                                aligned to 2 bytes
+ *              - len           : Number of bytes in encoded
+ *
+ * Output:
+ *              - speech        : Decoded speech vector, which points to
+ *                                the memory of encoded
+ *
+ * Returned value               : Samples in speech
+ */
+
+size_t WebRtcPcm16b_DecodeInPlace(uint8_t* encoded,
+                                  size_t len,
+                                  int16_t** speech);
+
 #ifdef __cplusplus
 }
 #endif
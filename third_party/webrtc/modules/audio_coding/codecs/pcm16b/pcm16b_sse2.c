@@ -0,0 +1,31 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/pcm16b/pcm16b_sse2.h"
+
+// A 16-bit byte swap is two shifts and an or, which is as fast as a byte
+// shuffle.
+static __inline __m128i SwapBytes(__m128i v) {
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+size_t WebRtcPcm16b_SwapBytesSSE2(const uint8_t* in, size_t len, uint8_t* out) {
+  size_t i;
+  // Both vectors are loaded before they are stored, for swapping in place.
+  for (i = 0; i + 16 <= len; i += 16) {
+    const __m128i v0 = _mm_loadu_si128((const __m128i*)&in[2 * i]);
+    const __m128i v1 = _mm_loadu_si128((const __m128i*)&in[2 * i + 16]);
+    _mm_storeu_si128((__m128i*)&out[2 * i], SwapBytes(v0));
+    _mm_storeu_si128((__m128i*)&out[2 * i + 16], SwapBytes(v1));
+  }
+  return i;
+}
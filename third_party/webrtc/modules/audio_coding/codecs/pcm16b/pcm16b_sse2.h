@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 byte swapping of 16-bit samples. Only for use by pcm16b.c.
+
+#ifndef MODULES_AUDIO_CODING_CODECS_PCM16B_PCM16B_SSE2_H_
+#define MODULES_AUDIO_CODING_CODECS_PCM16B_PCM16B_SSE2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Swap the bytes of the largest multiple of 16 of the |len| 16-bit words at
+// |in| into |out|, and return the number of words swapped. |in| and |out|
+// may be equal, and need not be aligned.
+size_t WebRtcPcm16b_SwapBytesSSE2(const uint8_t* in, size_t len, uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MODULES_AUDIO_CODING_CODECS_PCM16B_PCM16B_SSE2_H_
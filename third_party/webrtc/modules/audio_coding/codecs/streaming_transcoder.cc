@@ -0,0 +1,595 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/streaming_transcoder.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "rtc_base/atomicops.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// 120 ms at 16 kHz, which covers the largest payloads of all decoders.
+const size_t kMaxDecodedSamples = 1920;
+// 60 ms at 16 kHz.
+const size_t kMaxEncoderFrameSamples = 960;
+
+int SampleRateHz(StreamingTranscoder::Codec codec) {
+  switch (codec) {
+    case StreamingTranscoder::kG722:
+    case StreamingTranscoder::kIsac:
+    case StreamingTranscoder::kIsacFix:
+    case StreamingTranscoder::kPcm16b16kHz:
+      return 16000;
+    default:
+      return 8000;
+  }
+}
+
+// Returns the number of codec frames of |codec_frame_samples| that conceal a
+// lost payload of |frame_samples|, at least one.
+size_t LostFrames(size_t frame_samples, size_t codec_frame_samples) {
+  return std::max<size_t>(frame_samples / codec_frame_samples, 1);
+}
+
+class Decoder {
+ public:
+  virtual ~Decoder() {}
+  // Returns the number of samples decoded to |decoded|, which holds
+  // kMaxDecodedSamples, or -1 on error.
+  virtual int Decode(const uint8_t* payload, size_t bytes,
+                     int16_t* decoded) = 0;
+  // Conceals a lost frame of |frame_samples|. Codecs without packet loss
+  // concealment produce silence.
+  virtual int DecodePlc(size_t frame_samples, int16_t* decoded) {
+    std::fill(decoded, decoded + frame_samples, 0);
+    return static_cast<int>(frame_samples);
+  }
+};
+
+class Encoder {
+ public:
+  virtual ~Encoder() {}
+  // Number of samples passed to Encode().
+  virtual size_t input_samples() const = 0;
+  // Returns the number of bytes encoded, which is 0 while the encoder is
+  // still buffering a packet, or -1 on error.
+  virtual int Encode(const int16_t* audio, uint8_t* encoded) = 0;
+};
+
+class G711Decoder : public Decoder {
+ public:
+  explicit G711Decoder(bool ulaw) : ulaw_(ulaw) {}
+  int Decode(const uint8_t* payload, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    if (bytes > kMaxDecodedSamples) {
+      return -1;
+    }
+    return static_cast<int>(
+        ulaw_ ? WebRtcG711_DecodeU(payload, bytes, decoded, &speech_type)
+              : WebRtcG711_DecodeA(payload, bytes, decoded, &speech_type));
+  }
+
+ private:
+  const bool ulaw_;
+};
+
+class G711Encoder : public Encoder {
+ public:
+  G711Encoder(bool ulaw, size_t frame_samples)
+      : ulaw_(ulaw), frame_samples_(frame_samples) {}
+  size_t input_samples() const override { return frame_samples_; }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(
+        ulaw_ ? WebRtcG711_EncodeU(audio, frame_samples_, encoded)
+              : WebRtcG711_EncodeA(audio, frame_samples_, encoded));
+  }
+
+ private:
+  const bool ulaw_;
+  const size_t frame_samples_;
+};
+
+class G722Decoder : public Decoder {
+ public:
+  explicit G722Decoder(CodecInstanceArena* arena)
+      : arena_(arena), inst_(arena->CreateG722Decoder()) {
+    if (inst_) {
+      WebRtcG722_DecoderInit(inst_);
+    }
+  }
+  ~G722Decoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  int Decode(const uint8_t* payload, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    if (2 * bytes > kMaxDecodedSamples) {
+      return -1;
+    }
+    return static_cast<int>(
+        WebRtcG722_Decode(inst_, payload, bytes, decoded, &speech_type));
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  G722DecInst* const inst_;
+};
+
+class G722Encoder : public Encoder {
+ public:
+  G722Encoder(CodecInstanceArena* arena, size_t frame_samples)
+      : arena_(arena),
+        inst_(arena->CreateG722Encoder()),
+        frame_samples_(frame_samples) {
+    if (inst_) {
+      WebRtcG722_EncoderInit(inst_);
+    }
+  }
+  ~G722Encoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  size_t input_samples() const override { return frame_samples_; }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(
+        WebRtcG722_Encode(inst_, audio, frame_samples_, encoded));
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  G722EncInst* const inst_;
+  const size_t frame_samples_;
+};
+
+class IlbcDecoder : public Decoder {
+ public:
+  explicit IlbcDecoder(CodecInstanceArena* arena)
+      : arena_(arena), inst_(arena->CreateIlbcDecoder()) {
+    // The decoder switches mode to match the payloads.
+    if (inst_) {
+      WebRtcIlbcfix_DecoderInit(inst_, 20);
+    }
+  }
+  ~IlbcDecoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  int Decode(const uint8_t* payload, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    const int decoded_samples =
+        WebRtcIlbcfix_Decode(inst_, payload, bytes, decoded, &speech_type);
+    // The decoder follows the mode of the payloads, which hold frames of 50
+    // bytes in 30 ms mode and of 38 bytes in 20 ms mode.
+    if (decoded_samples > 0) {
+      codec_frame_samples_ = bytes % 50 == 0 ? 240 : 160;
+    }
+    return decoded_samples;
+  }
+  int DecodePlc(size_t frame_samples, int16_t* decoded) override {
+    return static_cast<int>(WebRtcIlbcfix_DecodePlc(
+        inst_, decoded, LostFrames(frame_samples, codec_frame_samples_)));
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  IlbcDecoderInstance* const inst_;
+  size_t codec_frame_samples_ = 160;
+};
+
+class IlbcEncoder : public Encoder {
+ public:
+  IlbcEncoder(CodecInstanceArena* arena, int frame_ms)
+      : arena_(arena),
+        inst_(arena->CreateIlbcEncoder()),
+        frame_samples_(8 * frame_ms) {
+    // 40 and 60 ms packets hold two frames of 20 and 30 ms.
+    if (inst_) {
+      WebRtcIlbcfix_EncoderInit(inst_, frame_ms % 30 == 0 ? 30 : 20);
+    }
+  }
+  ~IlbcEncoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  size_t input_samples() const override { return frame_samples_; }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIlbcfix_Encode(inst_, audio, frame_samples_, encoded);
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  IlbcEncoderInstance* const inst_;
+  const size_t frame_samples_;
+};
+
+class IsacDecoder : public Decoder {
+ public:
+  explicit IsacDecoder(CodecInstanceArena* arena)
+      : arena_(arena), inst_(arena->CreateIsac()) {
+    if (inst_) {
+      WebRtcIsac_DecoderInit(inst_);
+    }
+  }
+  ~IsacDecoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  int Decode(const uint8_t* payload, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return WebRtcIsac_Decode(inst_, payload, bytes, decoded, &speech_type);
+  }
+  int DecodePlc(size_t frame_samples, int16_t* decoded) override {
+    // Every concealed frame is 30 ms, at most two of them.
+    return static_cast<int>(
+        WebRtcIsac_DecodePlc(inst_, decoded, LostFrames(frame_samples, 480)));
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  ISACStruct* const inst_;
+};
+
+// iSAC takes 10 ms at a time, and returns a packet when it has a frame.
+class IsacEncoder : public Encoder {
+ public:
+  IsacEncoder(CodecInstanceArena* arena, int frame_ms)
+      : arena_(arena), inst_(arena->CreateIsac()) {
+    if (inst_) {
+      WebRtcIsac_EncoderInit(inst_, 1);
+      WebRtcIsac_Control(inst_, 32000, frame_ms);
+    }
+  }
+  ~IsacEncoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  size_t input_samples() const override { return 160; }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIsac_Encode(inst_, audio, encoded);
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  ISACStruct* const inst_;
+};
+
+class IsacFixDecoder : public Decoder {
+ public:
+  explicit IsacFixDecoder(CodecInstanceArena* arena)
+      : arena_(arena), inst_(arena->CreateIsacFix()) {
+    if (inst_) {
+      WebRtcIsacfix_DecoderInit(inst_);
+    }
+  }
+  ~IsacFixDecoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  int Decode(const uint8_t* payload, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return WebRtcIsacfix_Decode(inst_, payload, bytes, decoded, &speech_type);
+  }
+  int DecodePlc(size_t frame_samples, int16_t* decoded) override {
+    // Every concealed frame is 30 ms, at most two of them.
+    return static_cast<int>(WebRtcIsacfix_DecodePlc(
+        inst_, decoded, LostFrames(frame_samples, 480)));
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  ISACFIX_MainStruct* const inst_;
+};
+
+class IsacFixEncoder : public Encoder {
+ public:
+  IsacFixEncoder(CodecInstanceArena* arena, int frame_ms)
+      : arena_(arena), inst_(arena->CreateIsacFix()) {
+    if (inst_) {
+      WebRtcIsacfix_EncoderInit(inst_, 1);
+      WebRtcIsacfix_Control(inst_, 32000, frame_ms);
+    }
+  }
+  ~IsacFixEncoder() override { arena_->Free(inst_); }
+  bool ok() const { return inst_ != nullptr; }
+  size_t input_samples() const override { return 160; }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIsacfix_Encode(inst_, audio, encoded);
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  ISACFIX_MainStruct* const inst_;
+};
+
+class Pcm16bDecoder : public Decoder {
+ public:
+  int Decode(const uint8_t* payload, size_t bytes, int16_t* decoded) override {
+    if (bytes / 2 > kMaxDecodedSamples) {
+      return -1;
+    }
+    return static_cast<int>(WebRtcPcm16b_Decode(payload, bytes, decoded));
+  }
+};
+
+class Pcm16bEncoder : public Encoder {
+ public:
+  explicit Pcm16bEncoder(size_t frame_samples)
+      : frame_samples_(frame_samples) {}
+  size_t input_samples() const override { return frame_samples_; }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(
+        WebRtcPcm16b_Encode(audio, frame_samples_, encoded));
+  }
+
+ private:
+  const size_t frame_samples_;
+};
+
+template <typename T>
+std::unique_ptr<T> CheckCreated(std::unique_ptr<T> codec) {
+  return codec->ok() ? std::move(codec) : nullptr;
+}
+
+std::unique_ptr<Decoder> CreateDecoder(StreamingTranscoder::Codec codec,
+                                       CodecInstanceArena* arena) {
+  switch (codec) {
+    case StreamingTranscoder::kPcmu:
+    case StreamingTranscoder::kPcma:
+      return std::unique_ptr<Decoder>(
+          new G711Decoder(codec == StreamingTranscoder::kPcmu));
+    case StreamingTranscoder::kG722:
+      return CheckCreated(std::unique_ptr<G722Decoder>(
+          new G722Decoder(arena)));
+    case StreamingTranscoder::kIlbc:
+      return CheckCreated(std::unique_ptr<IlbcDecoder>(
+          new IlbcDecoder(arena)));
+    case StreamingTranscoder::kIsac:
+      return CheckCreated(std::unique_ptr<IsacDecoder>(
+          new IsacDecoder(arena)));
+    case StreamingTranscoder::kIsacFix:
+      return CheckCreated(std::unique_ptr<IsacFixDecoder>(
+          new IsacFixDecoder(arena)));
+    case StreamingTranscoder::kPcm16b8kHz:
+    case StreamingTranscoder::kPcm16b16kHz:
+      return std::unique_ptr<Decoder>(new Pcm16bDecoder());
+  }
+  return nullptr;
+}
+
+std::unique_ptr<Encoder> CreateEncoder(StreamingTranscoder::Codec codec,
+                                       int frame_ms,
+                                       CodecInstanceArena* arena) {
+  const size_t frame_samples = SampleRateHz(codec) / 1000 * frame_ms;
+  switch (codec) {
+    case StreamingTranscoder::kPcmu:
+    case StreamingTranscoder::kPcma:
+    case StreamingTranscoder::kG722:
+    case StreamingTranscoder::kPcm16b8kHz:
+    case StreamingTranscoder::kPcm16b16kHz:
+      if (frame_ms % 10 != 0 || frame_ms < 10 || frame_ms > 60) {
+        return nullptr;
+      }
+      break;
+    case StreamingTranscoder::kIlbc:
+      if (frame_ms != 20 && frame_ms != 30 && frame_ms != 40 &&
+          frame_ms != 60) {
+        return nullptr;
+      }
+      break;
+    case StreamingTranscoder::kIsac:
+    case StreamingTranscoder::kIsacFix:
+      if (frame_ms != 30 && frame_ms != 60) {
+        return nullptr;
+      }
+      break;
+  }
+
+  switch (codec) {
+    case StreamingTranscoder::kPcmu:
+    case StreamingTranscoder::kPcma:
+      return std::unique_ptr<Encoder>(
+          new G711Encoder(codec == StreamingTranscoder::kPcmu, frame_samples));
+    case StreamingTranscoder::kG722:
+      return CheckCreated(std::unique_ptr<G722Encoder>(
+          new G722Encoder(arena, frame_samples)));
+    case StreamingTranscoder::kIlbc:
+      return CheckCreated(std::unique_ptr<IlbcEncoder>(
+          new IlbcEncoder(arena, frame_ms)));
+    case StreamingTranscoder::kIsac:
+      return CheckCreated(std::unique_ptr<IsacEncoder>(
+          new IsacEncoder(arena, frame_ms)));
+    case StreamingTranscoder::kIsacFix:
+      return CheckCreated(std::unique_ptr<IsacFixEncoder>(
+          new IsacFixEncoder(arena, frame_ms)));
+    case StreamingTranscoder::kPcm16b8kHz:
+    case StreamingTranscoder::kPcm16b16kHz:
+      return std::unique_ptr<Encoder>(new Pcm16bEncoder(frame_samples));
+  }
+  return nullptr;
+}
+
+class StreamingTranscoderImpl : public StreamingTranscoder {
+ public:
+  StreamingTranscoderImpl(std::unique_ptr<Decoder> decoder,
+                          int decoder_rate_hz,
+                          std::unique_ptr<Encoder> encoder,
+                          int encoder_rate_hz)
+      : decoder_(std::move(decoder)),
+        encoder_(std::move(encoder)),
+        decoder_rate_hz_(decoder_rate_hz),
+        encoder_rate_hz_(encoder_rate_hz),
+        decoded_(new int16_t[kMaxDecodedSamples + 1]),
+        buffer_(new int16_t[2 * kMaxDecodedSamples + kMaxEncoderFrameSamples]),
+        last_frame_samples_(decoder_rate_hz / 50) {
+    memset(resampler_state_, 0, sizeof(resampler_state_));
+  }
+
+  int Transcode(const uint8_t* payload,
+                size_t payload_bytes,
+                Packets* packets) override;
+
+ private:
+  // Appends |length| decoded samples to |buffer_|, at the encoder rate.
+  void Resample(size_t length);
+
+  const std::unique_ptr<Decoder> decoder_;
+  const std::unique_ptr<Encoder> encoder_;
+  const int decoder_rate_hz_;
+  const int encoder_rate_hz_;
+  // Decoded audio, preceded by an odd sample left over from the previous
+  // payload when downsampling.
+  const std::unique_ptr<int16_t[]> decoded_;
+  // Audio at the encoder rate waiting to be encoded.
+  const std::unique_ptr<int16_t[]> buffer_;
+  size_t buffered_ = 0;
+  bool carry_ = false;
+  size_t last_frame_samples_;
+  int32_t resampler_state_[8];
+};
+
+void StreamingTranscoderImpl::Resample(size_t length) {
+  int16_t* const out = &buffer_[buffered_];
+  if (encoder_rate_hz_ == decoder_rate_hz_) {
+    std::copy(&decoded_[1], &decoded_[1 + length], out);
+    buffered_ += length;
+  } else if (encoder_rate_hz_ > decoder_rate_hz_) {
+    WebRtcSpl_UpsampleBy2(&decoded_[1], length, out, resampler_state_);
+    buffered_ += 2 * length;
+  } else {
+    // Downsample pairs of samples, keeping an odd one for the next payload.
+    const int16_t* in = carry_ ? &decoded_[0] : &decoded_[1];
+    const size_t total = length + (carry_ ? 1 : 0);
+    WebRtcSpl_DownsampleBy2(in, total & ~1, out, resampler_state_);
+    buffered_ += total / 2;
+    carry_ = (total & 1) != 0;
+    if (carry_) {
+      decoded_[0] = in[total - 1];
+    }
+  }
+}
+
+int StreamingTranscoderImpl::Transcode(const uint8_t* payload,
+                                       size_t payload_bytes,
+                                       Packets* packets) {
+  packets->payload.SetSize(0);
+  packets->bytes.clear();
+
+  const int decoded =
+      payload ? decoder_->Decode(payload, payload_bytes, &decoded_[1])
+              : decoder_->DecodePlc(last_frame_samples_, &decoded_[1]);
+  if (decoded < 0 || static_cast<size_t>(decoded) > kMaxDecodedSamples) {
+    return -1;
+  }
+  if (decoded > 0) {
+    last_frame_samples_ = decoded;
+  }
+  Resample(decoded);
+
+  const size_t input_samples = encoder_->input_samples();
+  size_t position = 0;
+  uint8_t encoded[kMaxPayloadBytes];
+  for (; buffered_ - position >= input_samples; position += input_samples) {
+    const int bytes = encoder_->Encode(&buffer_[position], encoded);
+    if (bytes < 0) {
+      return -1;
+    }
+    if (bytes > 0) {
+      packets->payload.AppendData(encoded, bytes);
+      packets->bytes.push_back(bytes);
+    }
+  }
+  std::copy(&buffer_[position], &buffer_[buffered_], &buffer_[0]);
+  buffered_ -= position;
+  return static_cast<int>(packets->bytes.size());
+}
+
+}  // namespace
+
+const size_t StreamingTranscoder::kMaxPayloadBytes;
+
+std::unique_ptr<StreamingTranscoder> StreamingTranscoder::Create(
+    const Config& config,
+    CodecInstanceArena* arena) {
+  std::unique_ptr<Decoder> decoder = CreateDecoder(config.decoder, arena);
+  std::unique_ptr<Encoder> encoder =
+      CreateEncoder(config.encoder, config.encoder_frame_ms, arena);
+  if (!decoder || !encoder) {
+    return nullptr;
+  }
+  return std::unique_ptr<StreamingTranscoder>(new StreamingTranscoderImpl(
+      std::move(decoder), SampleRateHz(config.decoder), std::move(encoder),
+      SampleRateHz(config.encoder)));
+}
+
+TranscoderPool::Worker::Worker(TranscoderPool* pool)
+    : pool(pool),
+      thread(&TranscoderPool::WorkerThread, this, "TranscoderWorker"),
+      wake(false, false) {}
+
+TranscoderPool::TranscoderPool(size_t num_workers) : done_(false, false) {
+  RTC_DCHECK_GT(num_workers, 0);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back(new Worker(this));
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Start();
+  }
+}
+
+TranscoderPool::~TranscoderPool() {
+  rtc::AtomicOps::ReleaseStore(&stop_, 1);
+  for (auto& worker : workers_) {
+    worker->wake.Set();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.Stop();
+  }
+}
+
+void TranscoderPool::Process(rtc::ArrayView<Job> jobs) {
+  if (jobs.empty()) {
+    return;
+  }
+  rtc::AtomicOps::ReleaseStore(&pending_jobs_, static_cast<int>(jobs.size()));
+  {
+    rtc::CritScope cs(&lock_);
+    jobs_ = jobs;
+    next_job_ = 0;
+  }
+  for (auto& worker : workers_) {
+    worker->wake.Set();
+  }
+  done_.Wait(rtc::Event::kForever);
+}
+
+void TranscoderPool::WorkerThread(void* obj) {
+  Worker* worker = static_cast<Worker*>(obj);
+  worker->pool->RunWorker(worker);
+}
+
+TranscoderPool::Job* TranscoderPool::TakeJob() {
+  rtc::CritScope cs(&lock_);
+  if (next_job_ >= jobs_.size()) {
+    return nullptr;
+  }
+  return &jobs_[next_job_++];
+}
+
+void TranscoderPool::RunWorker(Worker* worker) {
+  while (!rtc::AtomicOps::AcquireLoad(&stop_)) {
+    Job* job = TakeJob();
+    if (!job) {
+      worker->wake.Wait(rtc::Event::kForever);
+      continue;
+    }
+    job->result = job->transcoder->Transcode(job->payload, job->payload_bytes,
+                                             job->packets);
+    if (rtc::AtomicOps::Decrement(&pending_jobs_) == 0) {
+      done_.Set();
+    }
+  }
+}
+
+}  // namespace webrtc
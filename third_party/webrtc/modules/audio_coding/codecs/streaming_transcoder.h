@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_STREAMING_TRANSCODER_H_
+#define MODULES_AUDIO_CODING_CODECS_STREAMING_TRANSCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_coding/codecs/codec_instance_arena.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Transcodes one stream between two of the in-tree codecs. Every payload is
+// decoded, converted to the sample rate of the encoder with the SPL by-2
+// resamplers, and buffered until the encoder has a full frame, so that the
+// frame sizes of the two sides are independent. All buffers are allocated up
+// front.
+class StreamingTranscoder {
+ public:
+  enum Codec {
+    kPcmu,         // 8 kHz.
+    kPcma,         // 8 kHz.
+    kG722,         // 16 kHz, 64 kbps.
+    kIlbc,         // 8 kHz.
+    kIsac,         // 16 kHz, 32 kbps.
+    kIsacFix,      // 16 kHz, 32 kbps.
+    kPcm16b8kHz,
+    kPcm16b16kHz
+  };
+
+  struct Config {
+    Codec decoder = kPcmu;
+    Codec encoder = kPcmu;
+    // Frame size of the encoder: a multiple of 10 ms up to 60 ms for G.711,
+    // G.722 and PCM16B, 20, 30, 40 or 60 ms for iLBC, and 30 or 60 ms for
+    // iSAC. The frame size of the decoder follows from the payloads.
+    int encoder_frame_ms = 20;
+  };
+
+  // Encoded packets, stored back to back in |payload|.
+  struct Packets {
+    rtc::Buffer payload;
+    std::vector<size_t> bytes;
+  };
+
+  // The largest payload that is accepted or produced.
+  static const size_t kMaxPayloadBytes = 1920;
+
+  // Returns null if |config| is not supported. The codec states are placed in
+  // |arena|, which must outlive the transcoder.
+  static std::unique_ptr<StreamingTranscoder> Create(
+      const Config& config,
+      CodecInstanceArena* arena);
+
+  virtual ~StreamingTranscoder() {}
+
+  // Decodes one payload and encodes all frames that become complete, which
+  // replace the contents of |packets|. A null |payload| conceals a lost
+  // packet. Returns the number of packets, or -1 on error.
+  virtual int Transcode(const uint8_t* payload,
+                        size_t payload_bytes,
+                        Packets* packets) = 0;
+};
+
+// Transcodes the payloads of many streams on a pool of worker threads. The
+// streams are independent, so every worker just takes the next job.
+class TranscoderPool {
+ public:
+  struct Job {
+    StreamingTranscoder* transcoder = nullptr;
+    const uint8_t* payload = nullptr;
+    size_t payload_bytes = 0;
+    StreamingTranscoder::Packets* packets = nullptr;
+    // Set by Process().
+    int result = 0;
+  };
+
+  // Starts |num_workers| threads, typically one per core.
+  explicit TranscoderPool(size_t num_workers);
+  ~TranscoderPool();
+
+  // Runs all of |jobs| and returns when they are done. A transcoder may only
+  // appear in one of the jobs.
+  void Process(rtc::ArrayView<Job> jobs);
+
+  size_t num_workers() const { return workers_.size(); }
+
+ private:
+  struct Worker {
+    explicit Worker(TranscoderPool* pool);
+
+    TranscoderPool* const pool;
+    rtc::PlatformThread thread;
+    rtc::Event wake;
+  };
+
+  static void WorkerThread(void* obj);
+  void RunWorker(Worker* worker);
+  // Returns the next job to run, or null.
+  Job* TakeJob();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  rtc::CriticalSection lock_;
+  rtc::ArrayView<Job> jobs_ RTC_GUARDED_BY(lock_);
+  size_t next_job_ RTC_GUARDED_BY(lock_) = 0;
+  volatile int pending_jobs_ = 0;
+  volatile int stop_ = 0;
+  rtc::Event done_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(TranscoderPool);
+};
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_CODECS_STREAMING_TRANSCODER_H_
@@ -0,0 +1,386 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Memory per stream and encoding time per stream of many encoder instances,
+// created one by one with the Create functions of a codec and then in a
+// CodecInstanceArena. The memory is the growth of the resident set while the
+// instances are created and initialized, on Linux, and for the arena also the
+// memory it reserved in slabs. The encoders are then run in turn, one 10 or
+// 20 ms frame per stream, so that with enough streams their states no longer
+// fit in the caches, and the time per frame shows the cost of the cache
+// misses.
+//
+// Every run measures one codec, since memory freed by the first codec would
+// be reused by the next and hide its growth.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/codecs/codec_instance_arena.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/timeutils.h"
+
+#if defined(WEBRTC_LINUX)
+#include <unistd.h>
+#endif
+
+DEFINE_string(codec, "isac", "Codec to run: ilbc, isac, isacfix or g722.");
+DEFINE_int(streams, 1000, "Number of encoder instances.");
+DEFINE_int(frames, 50, "Number of frames encoded by every instance.");
+DEFINE_bool(help, false, "Prints this message.");
+
+namespace webrtc {
+namespace {
+
+const size_t kMaxPayloadBytes = 1000;
+
+// Resident memory of the process in bytes, or 0 where it is not known.
+size_t ResidentBytes() {
+#if defined(WEBRTC_LINUX)
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (!file) {
+    return 0;
+  }
+  unsigned long size_pages = 0;
+  unsigned long resident_pages = 0;
+  const int fields = fscanf(file, "%lu %lu", &size_pages, &resident_pages);
+  fclose(file);
+  if (fields != 2) {
+    return 0;
+  }
+  return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+// The encoder instances of one codec, created with the Create functions of
+// the codec if |arena| is null, and in |arena| otherwise.
+class Encoders {
+ public:
+  explicit Encoders(CodecInstanceArena* arena) : arena_(arena) {}
+  virtual ~Encoders() {}
+  virtual CodecInstanceArena::Codec codec() const = 0;
+  virtual size_t frame_samples() const = 0;
+  // Creates and initializes one more instance. Returns false on error.
+  virtual bool Add() = 0;
+  // Returns the number of bytes encoded, or -1 on error.
+  virtual int Encode(size_t stream, const int16_t* audio,
+                     uint8_t* encoded) = 0;
+
+ protected:
+  CodecInstanceArena* const arena_;
+};
+
+// iLBC in 20 ms mode.
+class IlbcEncoders : public Encoders {
+ public:
+  explicit IlbcEncoders(CodecInstanceArena* arena) : Encoders(arena) {}
+  ~IlbcEncoders() override {
+    for (IlbcEncoderInstance* inst : instances_) {
+      if (arena_) {
+        arena_->Free(inst);
+      } else {
+        WebRtcIlbcfix_EncoderFree(inst);
+      }
+    }
+  }
+  CodecInstanceArena::Codec codec() const override {
+    return CodecInstanceArena::kIlbcEncoder;
+  }
+  size_t frame_samples() const override { return 160; }
+  bool Add() override {
+    IlbcEncoderInstance* inst = nullptr;
+    if (arena_) {
+      inst = arena_->CreateIlbcEncoder();
+    } else {
+      WebRtcIlbcfix_EncoderCreate(&inst);
+    }
+    if (!inst) {
+      return false;
+    }
+    instances_.push_back(inst);
+    return WebRtcIlbcfix_EncoderInit(inst, 20) == 0;
+  }
+  int Encode(size_t stream, const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIlbcfix_Encode(instances_[stream], audio, frame_samples(),
+                                encoded);
+  }
+
+ private:
+  std::vector<IlbcEncoderInstance*> instances_;
+};
+
+// iSAC in wideband, channel independent mode at 32 kbps with 30 ms frames,
+// given 10 ms at a time.
+class IsacEncoders : public Encoders {
+ public:
+  explicit IsacEncoders(CodecInstanceArena* arena) : Encoders(arena) {}
+  ~IsacEncoders() override {
+    for (ISACStruct* inst : instances_) {
+      if (arena_) {
+        arena_->Free(inst);
+      } else {
+        WebRtcIsac_Free(inst);
+      }
+    }
+  }
+  CodecInstanceArena::Codec codec() const override {
+    return CodecInstanceArena::kIsac;
+  }
+  size_t frame_samples() const override { return 160; }
+  bool Add() override {
+    ISACStruct* inst = nullptr;
+    if (arena_) {
+      inst = arena_->CreateIsac();
+    } else {
+      WebRtcIsac_Create(&inst);
+    }
+    if (!inst) {
+      return false;
+    }
+    instances_.push_back(inst);
+    return WebRtcIsac_EncoderInit(inst, 1) == 0 &&
+           WebRtcIsac_Control(inst, 32000, 30) == 0;
+  }
+  int Encode(size_t stream, const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIsac_Encode(instances_[stream], audio, encoded);
+  }
+
+ private:
+  std::vector<ISACStruct*> instances_;
+};
+
+class IsacFixEncoders : public Encoders {
+ public:
+  explicit IsacFixEncoders(CodecInstanceArena* arena) : Encoders(arena) {}
+  ~IsacFixEncoders() override {
+    for (ISACFIX_MainStruct* inst : instances_) {
+      if (arena_) {
+        arena_->Free(inst);
+      } else {
+        WebRtcIsacfix_Free(inst);
+      }
+    }
+  }
+  CodecInstanceArena::Codec codec() const override {
+    return CodecInstanceArena::kIsacFix;
+  }
+  size_t frame_samples() const override { return 160; }
+  bool Add() override {
+    ISACFIX_MainStruct* inst = nullptr;
+    if (arena_) {
+      inst = arena_->CreateIsacFix();
+    } else {
+      WebRtcIsacfix_Create(&inst);
+    }
+    if (!inst) {
+      return false;
+    }
+    instances_.push_back(inst);
+    return WebRtcIsacfix_EncoderInit(inst, 1) == 0 &&
+           WebRtcIsacfix_Control(inst, 32000, 30) == 0;
+  }
+  int Encode(size_t stream, const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIsacfix_Encode(instances_[stream], audio, encoded);
+  }
+
+ private:
+  std::vector<ISACFIX_MainStruct*> instances_;
+};
+
+// G.722 with 10 ms frames.
+class G722Encoders : public Encoders {
+ public:
+  explicit G722Encoders(CodecInstanceArena* arena) : Encoders(arena) {}
+  ~G722Encoders() override {
+    for (G722EncInst* inst : instances_) {
+      if (arena_) {
+        arena_->Free(inst);
+      } else {
+        WebRtcG722_FreeEncoder(inst);
+      }
+    }
+  }
+  CodecInstanceArena::Codec codec() const override {
+    return CodecInstanceArena::kG722Encoder;
+  }
+  size_t frame_samples() const override { return 160; }
+  bool Add() override {
+    G722EncInst* inst = nullptr;
+    if (arena_) {
+      inst = arena_->CreateG722Encoder();
+    } else {
+      WebRtcG722_CreateEncoder(&inst);
+    }
+    if (!inst) {
+      return false;
+    }
+    instances_.push_back(inst);
+    return WebRtcG722_EncoderInit(inst) == 0;
+  }
+  int Encode(size_t stream, const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(WebRtcG722_Encode(instances_[stream], audio,
+                                              frame_samples(), encoded));
+  }
+
+ private:
+  std::vector<G722EncInst*> instances_;
+};
+
+std::unique_ptr<Encoders> CreateEncoders(const std::string& name,
+                                         CodecInstanceArena* arena) {
+  if (name == "ilbc") {
+    return std::unique_ptr<Encoders>(new IlbcEncoders(arena));
+  }
+  if (name == "isac") {
+    return std::unique_ptr<Encoders>(new IsacEncoders(arena));
+  }
+  if (name == "isacfix") {
+    return std::unique_ptr<Encoders>(new IsacFixEncoders(arena));
+  }
+  if (name == "g722") {
+    return std::unique_ptr<Encoders>(new G722Encoders(arena));
+  }
+  return nullptr;
+}
+
+struct Result {
+  // Growth of the resident memory per stream, or 0 where it is not known.
+  size_t resident_bytes = 0;
+  int64_t frame_ns = 0;
+  size_t errors = 0;
+};
+
+// Creates |streams| encoders, and encodes |frames| frames of |input| with
+// every one of them in turn. Returns false if an encoder cannot be created.
+bool Run(Encoders* encoders,
+         const std::vector<int16_t>& input,
+         size_t streams,
+         size_t frames,
+         Result* result) {
+  const size_t start_bytes = ResidentBytes();
+  for (size_t i = 0; i < streams; ++i) {
+    if (!encoders->Add()) {
+      fprintf(stderr, "Cannot create encoder %d\n", static_cast<int>(i));
+      return false;
+    }
+  }
+  const size_t end_bytes = ResidentBytes();
+  if (start_bytes > 0 && end_bytes > start_bytes) {
+    result->resident_bytes = (end_bytes - start_bytes) / streams;
+  }
+
+  const size_t frame_samples = encoders->frame_samples();
+  const size_t input_frames = input.size() / frame_samples;
+  uint8_t payload[kMaxPayloadBytes];
+  const int64_t start_ns = rtc::TimeNanos();
+  for (size_t n = 0; n < frames; ++n) {
+    const int16_t* audio = &input[(n % input_frames) * frame_samples];
+    for (size_t i = 0; i < streams; ++i) {
+      if (encoders->Encode(i, audio, payload) < 0) {
+        ++result->errors;
+      }
+    }
+  }
+  result->frame_ns =
+      (rtc::TimeNanos() - start_ns) / static_cast<int64_t>(frames * streams);
+  return true;
+}
+
+void PrintResult(const char* name, const Result& result) {
+  if (result.resident_bytes > 0) {
+    printf("%-6s %10d", name, static_cast<int>(result.resident_bytes));
+  } else {
+    printf("%-6s %10s", name, "n/a");
+  }
+  printf(" %12d", static_cast<int>(result.frame_ns));
+  if (result.errors > 0) {
+    printf("  %d frames failed", static_cast<int>(result.errors));
+  }
+  printf("\n");
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const std::string usage =
+      "Measures the memory and encoding time per stream of many encoder "
+      "instances, created by the codec and in a CodecInstanceArena.\n"
+      "Usage: " + std::string(argv[0]) + " [flags]\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) ||
+      FLAG_help || argc > 1) {
+    printf("%s", usage.c_str());
+    if (FLAG_help) {
+      rtc::FlagList::Print(nullptr, false);
+      return 0;
+    }
+    return 1;
+  }
+  if (FLAG_streams < 1 || FLAG_frames < 1) {
+    fprintf(stderr, "--streams and --frames must be positive\n");
+    return 1;
+  }
+  const size_t streams = static_cast<size_t>(FLAG_streams);
+  const size_t frames = static_cast<size_t>(FLAG_frames);
+
+  // One second of a tone in noise, at the 16 kHz of iSAC and G.722 and read
+  // as 8 kHz by iLBC.
+  std::vector<int16_t> input(16000);
+  srand(1);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<int16_t>((i % 64 < 32 ? 3000 : -3000) +
+                                    rand() % 2001 - 1000);
+  }
+
+  // The instances made by the codec come first, while the heap is fresh.
+  webrtc::Result heap;
+  {
+    std::unique_ptr<webrtc::Encoders> encoders =
+        webrtc::CreateEncoders(FLAG_codec, nullptr);
+    if (!encoders) {
+      fprintf(stderr, "Unknown codec %s\n", FLAG_codec);
+      return 1;
+    }
+    if (!webrtc::Run(encoders.get(), input, streams, frames, &heap)) {
+      return 1;
+    }
+  }
+
+  webrtc::Result arena_result;
+  webrtc::CodecInstanceArena::Footprint footprint;
+  {
+    webrtc::CodecInstanceArena arena;
+    std::unique_ptr<webrtc::Encoders> encoders =
+        webrtc::CreateEncoders(FLAG_codec, &arena);
+    if (!webrtc::Run(encoders.get(), input, streams, frames, &arena_result)) {
+      return 1;
+    }
+    footprint = arena.GetFootprint(encoders->codec());
+  }
+
+  printf("%s, %d streams, %d frames\n", FLAG_codec,
+         static_cast<int>(streams), static_cast<int>(frames));
+  printf("State %d bytes, slot %d bytes, %d slabs reserving %d bytes per "
+         "stream\n",
+         static_cast<int>(footprint.state_bytes),
+         static_cast<int>(footprint.slot_bytes),
+         static_cast<int>(footprint.slabs),
+         static_cast<int>(footprint.reserved_bytes / streams));
+  printf("%-6s %10s %12s\n", "", "RSS/stream", "ns/frame");
+  webrtc::PrintResult("heap", heap);
+  webrtc::PrintResult("arena", arena_result);
+  return 0;
+}
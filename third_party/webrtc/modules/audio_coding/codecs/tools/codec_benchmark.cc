@@ -0,0 +1,723 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Encodes and decodes a corpus of audio files with the in-tree codecs, and
+// reports for each codec the speed, the frame times, the instance memory and
+// the SNR of the decoded audio, as text or as JSON. PCM16B can code frames of
+// several interleaved channels, e.g. for multi-channel L16 at 48 kHz.
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/wav_file.h"
+#include "modules/audio_coding/codecs/codec_instance_arena.h"
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/system/arch.h"
+#include "rtc_base/timeutils.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+DEFINE_string(codecs,
+              "ilbc20,ilbc30,isac,isacfix,pcmu,pcma,g722,pcm16b,pcm16b48",
+              "Comma separated list of the codecs to run.");
+DEFINE_int(rate,
+           16000,
+           "Sample rate of raw input files, 8000 or 16000 Hz. WAV files "
+           "give their own.");
+DEFINE_int(channels,
+           1,
+           "Number of interleaved channels of pcm16b and pcm16b48. Every "
+           "channel carries the input.");
+DEFINE_int(loops, 1, "Number of times to code every file.");
+DEFINE_string(json, "", "Write the results as JSON to this file, or - for "
+                        "stdout.");
+DEFINE_bool(help, false, "Prints this message.");
+
+namespace webrtc {
+namespace {
+
+const int kMaxChannels = 8;
+
+// Common interface of the codecs under test. Every frame is encoded to one
+// payload, which is decoded right away.
+class BenchmarkCodec {
+ public:
+  virtual ~BenchmarkCodec() {}
+  virtual const char* name() const = 0;
+  virtual int sample_rate_hz() const = 0;
+  // Samples of one channel in a frame.
+  virtual size_t frame_samples() const = 0;
+  // Frames hold this many channels, interleaved.
+  virtual size_t num_channels() const { return 1; }
+  // Memory of the encoder and decoder state.
+  virtual size_t instance_bytes() const = 0;
+  // False if the encoder or decoder state could not be created.
+  virtual bool ok() const { return true; }
+  virtual void Reset() = 0;
+  // Return the number of bytes encoded and samples decoded, of all channels,
+  // or -1 on error.
+  virtual int Encode(const int16_t* audio, uint8_t* encoded) = 0;
+  virtual int Decode(const uint8_t* encoded, size_t bytes,
+                     int16_t* decoded) = 0;
+};
+
+class IlbcCodec : public BenchmarkCodec {
+ public:
+  IlbcCodec(CodecInstanceArena* arena, int16_t mode)
+      : arena_(arena),
+        mode_(mode),
+        encoder_(arena->CreateIlbcEncoder()),
+        decoder_(arena->CreateIlbcDecoder()) {}
+  ~IlbcCodec() override {
+    arena_->Free(encoder_);
+    arena_->Free(decoder_);
+  }
+  const char* name() const override {
+    return mode_ == 20 ? "ilbc20" : "ilbc30";
+  }
+  int sample_rate_hz() const override { return 8000; }
+  size_t frame_samples() const override { return mode_ == 20 ? 160 : 240; }
+  size_t instance_bytes() const override {
+    return arena_->GetFootprint(CodecInstanceArena::kIlbcEncoder).state_bytes +
+           arena_->GetFootprint(CodecInstanceArena::kIlbcDecoder).state_bytes;
+  }
+  bool ok() const override { return encoder_ && decoder_; }
+  void Reset() override {
+    WebRtcIlbcfix_EncoderInit(encoder_, mode_);
+    WebRtcIlbcfix_DecoderInit(decoder_, mode_);
+  }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return WebRtcIlbcfix_Encode(encoder_, audio, frame_samples(), encoded);
+  }
+  int Decode(const uint8_t* encoded, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return WebRtcIlbcfix_Decode(decoder_, encoded, bytes, decoded,
+                                &speech_type);
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  const int16_t mode_;
+  IlbcEncoderInstance* const encoder_;
+  IlbcDecoderInstance* const decoder_;
+};
+
+// iSAC in wideband, channel independent mode at 32 kbps with 30 ms frames.
+// The encoder takes 10 ms at a time, and returns the payload with the last.
+class IsacCodec : public BenchmarkCodec {
+ public:
+  explicit IsacCodec(CodecInstanceArena* arena)
+      : arena_(arena), inst_(arena->CreateIsac()) {}
+  ~IsacCodec() override { arena_->Free(inst_); }
+  const char* name() const override { return "isac"; }
+  int sample_rate_hz() const override { return 16000; }
+  size_t frame_samples() const override { return 480; }
+  size_t instance_bytes() const override {
+    return arena_->GetFootprint(CodecInstanceArena::kIsac).state_bytes;
+  }
+  bool ok() const override { return inst_ != nullptr; }
+  void Reset() override {
+    WebRtcIsac_EncoderInit(inst_, 1);
+    WebRtcIsac_Control(inst_, 32000, 30);
+    WebRtcIsac_DecoderInit(inst_);
+  }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    int bytes = 0;
+    for (size_t i = 0; i < 3 && bytes == 0; ++i) {
+      bytes = WebRtcIsac_Encode(inst_, &audio[160 * i], encoded);
+    }
+    return bytes;
+  }
+  int Decode(const uint8_t* encoded, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return WebRtcIsac_Decode(inst_, encoded, bytes, decoded, &speech_type);
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  ISACStruct* const inst_;
+};
+
+class IsacFixCodec : public BenchmarkCodec {
+ public:
+  explicit IsacFixCodec(CodecInstanceArena* arena)
+      : arena_(arena), inst_(arena->CreateIsacFix()) {}
+  ~IsacFixCodec() override { arena_->Free(inst_); }
+  const char* name() const override { return "isacfix"; }
+  int sample_rate_hz() const override { return 16000; }
+  size_t frame_samples() const override { return 480; }
+  size_t instance_bytes() const override {
+    return arena_->GetFootprint(CodecInstanceArena::kIsacFix).state_bytes;
+  }
+  bool ok() const override { return inst_ != nullptr; }
+  void Reset() override {
+    WebRtcIsacfix_EncoderInit(inst_, 1);
+    WebRtcIsacfix_Control(inst_, 32000, 30);
+    WebRtcIsacfix_DecoderInit(inst_);
+  }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    int bytes = 0;
+    for (size_t i = 0; i < 3 && bytes == 0; ++i) {
+      bytes = WebRtcIsacfix_Encode(inst_, &audio[160 * i], encoded);
+    }
+    return bytes;
+  }
+  int Decode(const uint8_t* encoded, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return WebRtcIsacfix_Decode(inst_, encoded, bytes, decoded, &speech_type);
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  ISACFIX_MainStruct* const inst_;
+};
+
+// G.711 with 20 ms frames. The codec has no state.
+class G711Codec : public BenchmarkCodec {
+ public:
+  explicit G711Codec(bool ulaw) : ulaw_(ulaw) {}
+  const char* name() const override { return ulaw_ ? "pcmu" : "pcma"; }
+  int sample_rate_hz() const override { return 8000; }
+  size_t frame_samples() const override { return 160; }
+  size_t instance_bytes() const override { return 0; }
+  void Reset() override {}
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(
+        ulaw_ ? WebRtcG711_EncodeU(audio, frame_samples(), encoded)
+              : WebRtcG711_EncodeA(audio, frame_samples(), encoded));
+  }
+  int Decode(const uint8_t* encoded, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return static_cast<int>(
+        ulaw_ ? WebRtcG711_DecodeU(encoded, bytes, decoded, &speech_type)
+              : WebRtcG711_DecodeA(encoded, bytes, decoded, &speech_type));
+  }
+
+ private:
+  const bool ulaw_;
+};
+
+// G.722 at 64 kbps with 20 ms frames.
+class G722Codec : public BenchmarkCodec {
+ public:
+  explicit G722Codec(CodecInstanceArena* arena)
+      : arena_(arena),
+        encoder_(arena->CreateG722Encoder()),
+        decoder_(arena->CreateG722Decoder()) {}
+  ~G722Codec() override {
+    arena_->Free(encoder_);
+    arena_->Free(decoder_);
+  }
+  const char* name() const override { return "g722"; }
+  int sample_rate_hz() const override { return 16000; }
+  size_t frame_samples() const override { return 320; }
+  size_t instance_bytes() const override {
+    return arena_->GetFootprint(CodecInstanceArena::kG722Encoder).state_bytes +
+           arena_->GetFootprint(CodecInstanceArena::kG722Decoder).state_bytes;
+  }
+  bool ok() const override { return encoder_ && decoder_; }
+  void Reset() override {
+    WebRtcG722_EncoderInit(encoder_);
+    WebRtcG722_DecoderInit(decoder_);
+  }
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(
+        WebRtcG722_Encode(encoder_, audio, frame_samples(), encoded));
+  }
+  int Decode(const uint8_t* encoded, size_t bytes, int16_t* decoded) override {
+    int16_t speech_type;
+    return static_cast<int>(
+        WebRtcG722_Decode(decoder_, encoded, bytes, decoded, &speech_type));
+  }
+
+ private:
+  CodecInstanceArena* const arena_;
+  G722EncInst* const encoder_;
+  G722DecInst* const decoder_;
+};
+
+// PCM16B at 16 or 48 kHz with 20 ms frames of |num_channels| interleaved
+// channels. The codec has no state.
+class Pcm16bCodec : public BenchmarkCodec {
+ public:
+  Pcm16bCodec(int sample_rate_hz, size_t num_channels)
+      : sample_rate_hz_(sample_rate_hz), num_channels_(num_channels) {
+    name_ = sample_rate_hz == 48000 ? "pcm16b48" : "pcm16b";
+    if (num_channels > 1) {
+      name_ += "x" + std::to_string(num_channels);
+    }
+  }
+  const char* name() const override { return name_.c_str(); }
+  int sample_rate_hz() const override { return sample_rate_hz_; }
+  size_t frame_samples() const override {
+    return static_cast<size_t>(sample_rate_hz_ / 50);
+  }
+  size_t num_channels() const override { return num_channels_; }
+  size_t instance_bytes() const override { return 0; }
+  void Reset() override {}
+  int Encode(const int16_t* audio, uint8_t* encoded) override {
+    return static_cast<int>(WebRtcPcm16b_Encode(
+        audio, frame_samples() * num_channels_, encoded));
+  }
+  int Decode(const uint8_t* encoded, size_t bytes, int16_t* decoded) override {
+    return static_cast<int>(WebRtcPcm16b_Decode(encoded, bytes, decoded));
+  }
+
+ private:
+  const int sample_rate_hz_;
+  const size_t num_channels_;
+  std::string name_;
+};
+
+std::unique_ptr<BenchmarkCodec> CreateCodec(const std::string& name,
+                                            CodecInstanceArena* arena) {
+  if (name == "ilbc20" || name == "ilbc30") {
+    return std::unique_ptr<BenchmarkCodec>(
+        new IlbcCodec(arena, name == "ilbc20" ? 20 : 30));
+  }
+  if (name == "isac") {
+    return std::unique_ptr<BenchmarkCodec>(new IsacCodec(arena));
+  }
+  if (name == "isacfix") {
+    return std::unique_ptr<BenchmarkCodec>(new IsacFixCodec(arena));
+  }
+  if (name == "pcmu" || name == "pcma") {
+    return std::unique_ptr<BenchmarkCodec>(new G711Codec(name == "pcmu"));
+  }
+  if (name == "g722") {
+    return std::unique_ptr<BenchmarkCodec>(new G722Codec(arena));
+  }
+  if (name == "pcm16b" || name == "pcm16b48") {
+    return std::unique_ptr<BenchmarkCodec>(new Pcm16bCodec(
+        name == "pcm16b" ? 16000 : 48000, static_cast<size_t>(FLAG_channels)));
+  }
+  return nullptr;
+}
+
+struct Audio {
+  std::string name;
+  int sample_rate_hz;
+  std::vector<int16_t> samples;
+};
+
+bool ReadAudio(const std::string& file_name, Audio* audio) {
+  audio->name = file_name;
+  audio->samples.clear();
+  const size_t dot = file_name.rfind('.');
+  if (dot != std::string::npos && file_name.substr(dot) == ".wav") {
+    WavReader reader(file_name);
+    if (reader.num_channels() != 1) {
+      fprintf(stderr, "%s: only mono files are supported\n",
+              file_name.c_str());
+      return false;
+    }
+    audio->sample_rate_hz = reader.sample_rate();
+    audio->samples.resize(reader.num_samples());
+    audio->samples.resize(
+        reader.ReadSamples(audio->samples.size(), audio->samples.data()));
+  } else {
+    FILE* file = fopen(file_name.c_str(), "rb");
+    if (!file) {
+      fprintf(stderr, "Cannot open %s\n", file_name.c_str());
+      return false;
+    }
+    int16_t buffer[1024];
+    size_t read = 0;
+    while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+      audio->samples.insert(audio->samples.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    audio->sample_rate_hz = FLAG_rate;
+  }
+  if (audio->sample_rate_hz != 8000 && audio->sample_rate_hz != 16000) {
+    fprintf(stderr, "%s: the sample rate must be 8000 or 16000 Hz\n",
+            file_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Converts |in| to 48 kHz in blocks of 10 ms. A partial last block is
+// dropped.
+std::vector<int16_t> ResampleTo48khz(const Audio& in) {
+  const size_t in_block = static_cast<size_t>(in.sample_rate_hz / 100);
+  const size_t num_blocks = in.samples.size() / in_block;
+  std::vector<int16_t> out(num_blocks * 480);
+  int32_t tmpmem[512];
+  WebRtcSpl_State8khzTo48khz state_8khz;
+  WebRtcSpl_State16khzTo48khz state_16khz;
+  WebRtcSpl_ResetResample8khzTo48khz(&state_8khz);
+  WebRtcSpl_ResetResample16khzTo48khz(&state_16khz);
+  for (size_t n = 0; n < num_blocks; ++n) {
+    if (in.sample_rate_hz == 8000) {
+      WebRtcSpl_Resample8khzTo48khz(&in.samples[n * in_block], &out[n * 480],
+                                    &state_8khz, tmpmem);
+    } else {
+      WebRtcSpl_Resample16khzTo48khz(&in.samples[n * in_block], &out[n * 480],
+                                     &state_16khz, tmpmem);
+    }
+  }
+  return out;
+}
+
+// Converts |in| to |sample_rate_hz|, which is either the same rate, half or
+// twice of it, or 48 kHz.
+std::vector<int16_t> Resample(const Audio& in, int sample_rate_hz) {
+  int32_t state[8] = {0};
+  std::vector<int16_t> out;
+  if (sample_rate_hz == 48000) {
+    out = ResampleTo48khz(in);
+  } else if (sample_rate_hz == in.sample_rate_hz) {
+    out = in.samples;
+  } else if (sample_rate_hz < in.sample_rate_hz) {
+    out.resize(in.samples.size() / 2);
+    WebRtcSpl_DownsampleBy2(in.samples.data(), out.size() * 2, out.data(),
+                            state);
+  } else {
+    out.resize(in.samples.size() * 2);
+    WebRtcSpl_UpsampleBy2(in.samples.data(), in.samples.size(), out.data(),
+                          state);
+  }
+  return out;
+}
+
+int64_t Cycles() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  return static_cast<int64_t>(__rdtsc());
+#else
+  return 0;
+#endif
+}
+
+// Timings of one direction, encoding or decoding.
+struct Timings {
+  std::vector<int64_t> frame_ns;
+  int64_t total_ns = 0;
+  int64_t total_cycles = 0;
+
+  void Add(int64_t ns, int64_t cycles) {
+    frame_ns.push_back(ns);
+    total_ns += ns;
+    total_cycles += cycles;
+  }
+  double Percentile(double p) {
+    if (frame_ns.empty()) {
+      return 0.0;
+    }
+    const size_t index = std::min(
+        static_cast<size_t>(p / 100.0 * frame_ns.size()), frame_ns.size() - 1);
+    std::nth_element(frame_ns.begin(), frame_ns.begin() + index,
+                     frame_ns.end());
+    return frame_ns[index] / 1000.0;
+  }
+};
+
+struct Result {
+  std::string codec;
+  int sample_rate_hz = 0;
+  size_t frame_samples = 0;
+  size_t num_channels = 1;
+  size_t instance_bytes = 0;
+  size_t frames = 0;
+  size_t errors = 0;
+  size_t payload_bytes = 0;
+  Timings encode;
+  Timings decode;
+  // Sums for the SNR over all files.
+  double signal_energy = 0.0;
+  double noise_energy = 0.0;
+};
+
+// Returns the delay of |decoded| relative to |reference| that maximizes the
+// cross-correlation over the first seconds, up to |max_delay| samples. The
+// delay is a multiple of |step|, the number of interleaved channels.
+size_t FindDelay(const std::vector<int16_t>& reference,
+                 const std::vector<int16_t>& decoded,
+                 size_t max_delay,
+                 size_t length,
+                 size_t step) {
+  length = std::min(length, std::min(reference.size(), decoded.size()));
+  size_t best_delay = 0;
+  double best = -1e300;
+  for (size_t delay = 0; delay <= max_delay && delay < length;
+       delay += step) {
+    double correlation = 0.0;
+    for (size_t i = 0; i + delay < length; ++i) {
+      correlation += static_cast<double>(reference[i]) * decoded[i + delay];
+    }
+    if (correlation > best) {
+      best = correlation;
+      best_delay = delay;
+    }
+  }
+  return best_delay;
+}
+
+void RunCodec(BenchmarkCodec* codec, const Audio& audio, Result* result) {
+  const std::vector<int16_t> mono = Resample(audio, codec->sample_rate_hz());
+  const size_t num_channels = codec->num_channels();
+  // Every channel carries the input, interleaved.
+  std::vector<int16_t> input(mono.size() * num_channels);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = mono[i / num_channels];
+  }
+  const size_t frame_samples = codec->frame_samples() * num_channels;
+  const size_t num_frames = input.size() / frame_samples;
+  std::vector<int16_t> decoded(num_frames * frame_samples);
+  std::vector<uint8_t> payload(2 * frame_samples);
+  std::vector<int16_t> output(frame_samples);
+
+  for (int loop = 0; loop < FLAG_loops; ++loop) {
+    codec->Reset();
+    for (size_t n = 0; n < num_frames; ++n) {
+      int64_t start_ns = rtc::TimeNanos();
+      int64_t start_cycles = Cycles();
+      const int bytes =
+          codec->Encode(&input[n * frame_samples], payload.data());
+      result->encode.Add(rtc::TimeNanos() - start_ns,
+                         Cycles() - start_cycles);
+
+      int samples = 0;
+      if (bytes > 0) {
+        start_ns = rtc::TimeNanos();
+        start_cycles = Cycles();
+        samples = codec->Decode(payload.data(), bytes, output.data());
+        result->decode.Add(rtc::TimeNanos() - start_ns,
+                           Cycles() - start_cycles);
+        result->payload_bytes += bytes;
+      }
+      ++result->frames;
+      if (bytes <= 0 || samples != static_cast<int>(frame_samples)) {
+        ++result->errors;
+        std::fill(output.begin(), output.end(), 0);
+      }
+      std::copy(output.begin(), output.end(),
+                decoded.begin() + n * frame_samples);
+    }
+  }
+
+  // Compare the decoded audio of the last loop with the input, aligned for
+  // the delay of the codec.
+  const size_t delay =
+      FindDelay(input, decoded, 2 * frame_samples,
+                2 * codec->sample_rate_hz() * num_channels, num_channels);
+  for (size_t i = 0; i + delay < decoded.size(); ++i) {
+    const double error = static_cast<double>(decoded[i + delay]) - input[i];
+    result->signal_energy += static_cast<double>(input[i]) * input[i];
+    result->noise_energy += error * error;
+  }
+}
+
+double Snr(const Result& result) {
+  if (result.noise_energy <= 0.0) {
+    return 999.0;
+  }
+  return 10.0 * log10(std::max(result.signal_energy, 1.0) /
+                      result.noise_energy);
+}
+
+double RealTimeFactor(const Result& result, const Timings& timings) {
+  const double audio_ns = 1e9 * result.frames * result.frame_samples /
+                          result.sample_rate_hz;
+  return timings.total_ns > 0 ? audio_ns / timings.total_ns : 0.0;
+}
+
+void PrintText(std::vector<Result>* results) {
+  printf("%-10s %9s %9s %9s %9s %9s %9s %9s %9s %8s %7s\n", "codec",
+         "enc xRT", "enc cyc", "enc p50", "enc p99", "dec xRT", "dec cyc",
+         "dec p50", "dec p99", "mem", "SNR");
+  for (Result& r : *results) {
+    const size_t frames = std::max<size_t>(r.frames, 1);
+    const size_t decoded = std::max<size_t>(r.decode.frame_ns.size(), 1);
+    printf("%-10s %9.1f %9lld %8.1fu %8.1fu %9.1f %9lld %8.1fu %8.1fu %8d "
+           "%7.2f\n",
+           r.codec.c_str(), RealTimeFactor(r, r.encode),
+           static_cast<long long>(r.encode.total_cycles / frames),
+           r.encode.Percentile(50), r.encode.Percentile(99),
+           RealTimeFactor(r, r.decode),
+           static_cast<long long>(r.decode.total_cycles / decoded),
+           r.decode.Percentile(50), r.decode.Percentile(99),
+           static_cast<int>(r.instance_bytes), Snr(r));
+    if (r.errors > 0) {
+      printf("  %d frames failed\n", static_cast<int>(r.errors));
+    }
+  }
+}
+
+void PrintTimings(FILE* file, const char* name, const Result& result,
+                  Timings* timings, size_t frames) {
+  fprintf(file,
+          "      \"%s\": {\"xrt\": %.2f, \"cycles_per_frame\": %lld, "
+          "\"p50_us\": %.2f, \"p99_us\": %.2f}",
+          name, RealTimeFactor(result, *timings),
+          static_cast<long long>(timings->total_cycles /
+                                 std::max<size_t>(frames, 1)),
+          timings->Percentile(50), timings->Percentile(99));
+}
+
+// Returns |text| as the contents of a JSON string, with backslashes, quotes
+// and control characters escaped, so that Windows paths stay valid JSON.
+std::string JsonEscape(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char code[7];
+      snprintf(code, sizeof(code), "\\u%04x", c);
+      escaped += code;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void PrintJson(FILE* file,
+               const std::vector<std::string>& inputs,
+               std::vector<Result>* results) {
+  fprintf(file, "{\n  \"inputs\": [");
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    fprintf(file, "%s\"%s\"", i > 0 ? ", " : "",
+            JsonEscape(inputs[i]).c_str());
+  }
+  fprintf(file, "],\n  \"loops\": %d,\n  \"codecs\": [\n", FLAG_loops);
+  for (size_t i = 0; i < results->size(); ++i) {
+    Result& r = (*results)[i];
+    const double seconds =
+        static_cast<double>(r.frames) * r.frame_samples / r.sample_rate_hz;
+    fprintf(file, "    {\n      \"name\": \"%s\",\n",
+            JsonEscape(r.codec).c_str());
+    fprintf(file, "      \"sample_rate_hz\": %d,\n", r.sample_rate_hz);
+    fprintf(file, "      \"frame_ms\": %d,\n",
+            static_cast<int>(1000 * r.frame_samples / r.sample_rate_hz));
+    fprintf(file, "      \"channels\": %d,\n",
+            static_cast<int>(r.num_channels));
+    fprintf(file, "      \"frames\": %d,\n", static_cast<int>(r.frames));
+    fprintf(file, "      \"errors\": %d,\n", static_cast<int>(r.errors));
+    fprintf(file, "      \"bitrate_bps\": %.0f,\n",
+            seconds > 0 ? 8.0 * r.payload_bytes / seconds : 0.0);
+    fprintf(file, "      \"instance_bytes\": %d,\n",
+            static_cast<int>(r.instance_bytes));
+    fprintf(file, "      \"snr_db\": %.2f,\n", Snr(r));
+    PrintTimings(file, "encode", r, &r.encode, r.frames);
+    fprintf(file, ",\n");
+    PrintTimings(file, "decode", r, &r.decode, r.decode.frame_ns.size());
+    fprintf(file, "\n    }%s\n", i + 1 < results->size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const std::string usage =
+      "Encodes and decodes audio files with the in-tree codecs and reports "
+      "the speed, frame times, instance memory and SNR of every codec.\n"
+      "Usage: " + std::string(argv[0]) + " [flags] input1 [input2 ...]\n"
+      "Inputs are mono WAV files, or raw 16-bit PCM at --rate.\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) ||
+      FLAG_help || argc < 2) {
+    printf("%s", usage.c_str());
+    if (FLAG_help) {
+      rtc::FlagList::Print(nullptr, false);
+      return 0;
+    }
+    return 1;
+  }
+  if (FLAG_loops < 1) {
+    fprintf(stderr, "--loops must be positive\n");
+    return 1;
+  }
+  if (FLAG_channels < 1 || FLAG_channels > webrtc::kMaxChannels) {
+    fprintf(stderr, "--channels must be between 1 and %d\n",
+            webrtc::kMaxChannels);
+    return 1;
+  }
+
+  webrtc::CodecInstanceArena arena;
+  std::vector<std::unique_ptr<webrtc::BenchmarkCodec>> codecs;
+  std::vector<webrtc::Result> results;
+  const std::string codec_list = FLAG_codecs;
+  for (size_t start = 0; start <= codec_list.size();) {
+    size_t end = codec_list.find(',', start);
+    if (end == std::string::npos) {
+      end = codec_list.size();
+    }
+    const std::string name = codec_list.substr(start, end - start);
+    start = end + 1;
+    if (name.empty()) {
+      continue;
+    }
+    std::unique_ptr<webrtc::BenchmarkCodec> codec =
+        webrtc::CreateCodec(name, &arena);
+    if (!codec) {
+      fprintf(stderr, "Unknown codec %s\n", name.c_str());
+      return 1;
+    }
+    if (!codec->ok()) {
+      fprintf(stderr, "Cannot create the instances of %s\n", name.c_str());
+      return 1;
+    }
+    webrtc::Result result;
+    result.codec = codec->name();
+    result.sample_rate_hz = codec->sample_rate_hz();
+    result.frame_samples = codec->frame_samples();
+    result.num_channels = codec->num_channels();
+    result.instance_bytes = codec->instance_bytes();
+    results.push_back(result);
+    codecs.push_back(std::move(codec));
+  }
+
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i) {
+    webrtc::Audio audio;
+    if (!webrtc::ReadAudio(argv[i], &audio)) {
+      return 1;
+    }
+    inputs.push_back(argv[i]);
+    for (size_t j = 0; j < codecs.size(); ++j) {
+      webrtc::RunCodec(codecs[j].get(), audio, &results[j]);
+    }
+  }
+
+  const std::string json = FLAG_json;
+  if (json.empty()) {
+    webrtc::PrintText(&results);
+  } else {
+    FILE* file = json == "-" ? stdout : fopen(json.c_str(), "w");
+    if (!file) {
+      fprintf(stderr, "Cannot open %s\n", json.c_str());
+      return 1;
+    }
+    webrtc::PrintJson(file, inputs, &results);
+    if (file != stdout) {
+      fclose(file);
+    }
+  }
+  return 0;
+}
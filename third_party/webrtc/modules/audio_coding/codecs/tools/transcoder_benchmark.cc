@@ -0,0 +1,290 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Transcodes many streams between pairs of the in-tree codecs on a pool of
+// worker threads, and reports for each pair how many streams one core can
+// transcode in real time.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/wav_file.h"
+#include "modules/audio_coding/codecs/codec_instance_arena.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "modules/audio_coding/codecs/streaming_transcoder.h"
+#include "rtc_base/flags.h"
+#include "rtc_base/timeutils.h"
+
+DEFINE_string(pairs,
+              "pcmu-ilbc,g722-pcma",
+              "Comma separated list of decoder-encoder pairs. The codecs are "
+              "pcmu, pcma, g722, ilbc, isac, isacfix, pcm16b8 and pcm16b16.");
+DEFINE_int(streams, 100, "Number of streams transcoded at the same time.");
+DEFINE_int(workers, 1, "Number of worker threads.");
+DEFINE_int(seconds, 10, "Seconds of audio transcoded for every stream.");
+DEFINE_int(source_frame_ms,
+           0,
+           "Frame size of the incoming payloads, or 0 for 20 ms (30 ms for "
+           "iSAC).");
+DEFINE_int(frame_ms,
+           0,
+           "Frame size of the outgoing payloads, or 0 for 20 ms (30 ms for "
+           "iSAC).");
+DEFINE_int(rate,
+           16000,
+           "Sample rate of raw input files, 8000 or 16000 Hz. WAV files "
+           "give their own.");
+DEFINE_bool(help, false, "Prints this message.");
+
+namespace webrtc {
+namespace {
+
+struct CodecName {
+  const char* name;
+  StreamingTranscoder::Codec codec;
+};
+
+const CodecName kCodecNames[] = {
+    {"pcmu", StreamingTranscoder::kPcmu},
+    {"pcma", StreamingTranscoder::kPcma},
+    {"g722", StreamingTranscoder::kG722},
+    {"ilbc", StreamingTranscoder::kIlbc},
+    {"isac", StreamingTranscoder::kIsac},
+    {"isacfix", StreamingTranscoder::kIsacFix},
+    {"pcm16b8", StreamingTranscoder::kPcm16b8kHz},
+    {"pcm16b16", StreamingTranscoder::kPcm16b16kHz},
+};
+
+bool ParseCodec(const std::string& name, StreamingTranscoder::Codec* codec) {
+  for (const CodecName& entry : kCodecNames) {
+    if (name == entry.name) {
+      *codec = entry.codec;
+      return true;
+    }
+  }
+  return false;
+}
+
+int DefaultFrameMs(StreamingTranscoder::Codec codec) {
+  return codec == StreamingTranscoder::kIsac ||
+                 codec == StreamingTranscoder::kIsacFix
+             ? 30
+             : 20;
+}
+
+bool ReadAudio(const std::string& file_name,
+               std::vector<int16_t>* samples,
+               int* sample_rate_hz) {
+  const size_t dot = file_name.rfind('.');
+  if (dot != std::string::npos && file_name.substr(dot) == ".wav") {
+    WavReader reader(file_name);
+    if (reader.num_channels() != 1) {
+      fprintf(stderr, "%s: only mono files are supported\n",
+              file_name.c_str());
+      return false;
+    }
+    *sample_rate_hz = reader.sample_rate();
+    samples->resize(reader.num_samples());
+    samples->resize(reader.ReadSamples(samples->size(), samples->data()));
+  } else {
+    FILE* file = fopen(file_name.c_str(), "rb");
+    if (!file) {
+      fprintf(stderr, "Cannot open %s\n", file_name.c_str());
+      return false;
+    }
+    int16_t buffer[1024];
+    size_t read = 0;
+    while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+      samples->insert(samples->end(), buffer, buffer + read);
+    }
+    fclose(file);
+    *sample_rate_hz = FLAG_rate;
+  }
+  if (*sample_rate_hz != 8000 && *sample_rate_hz != 16000) {
+    fprintf(stderr, "%s: the sample rate must be 8000 or 16000 Hz\n",
+            file_name.c_str());
+    return false;
+  }
+  if (samples->empty()) {
+    fprintf(stderr, "%s is empty\n", file_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Encodes |seconds| of |samples|, repeated as needed, with |codec|. The
+// encoder is itself a transcoder from PCM16B at the rate of the input.
+bool EncodeSource(const std::vector<int16_t>& samples,
+                  int sample_rate_hz,
+                  StreamingTranscoder::Codec codec,
+                  CodecInstanceArena* arena,
+                  std::vector<rtc::Buffer>* payloads) {
+  StreamingTranscoder::Config config;
+  config.decoder = sample_rate_hz == 8000 ? StreamingTranscoder::kPcm16b8kHz
+                                          : StreamingTranscoder::kPcm16b16kHz;
+  config.encoder = codec;
+  config.encoder_frame_ms = FLAG_source_frame_ms > 0 ? FLAG_source_frame_ms
+                                                     : DefaultFrameMs(codec);
+  std::unique_ptr<StreamingTranscoder> encoder =
+      StreamingTranscoder::Create(config, arena);
+  if (!encoder) {
+    fprintf(stderr, "Unsupported source frame size %d ms\n",
+            config.encoder_frame_ms);
+    return false;
+  }
+  const size_t block = static_cast<size_t>(sample_rate_hz / 100);
+  const size_t blocks = static_cast<size_t>(FLAG_seconds) * 100;
+  std::vector<int16_t> audio(block);
+  uint8_t pcm[2 * 160];
+  StreamingTranscoder::Packets packets;
+  size_t position = 0;
+  for (size_t i = 0; i < blocks; ++i) {
+    for (size_t j = 0; j < block; ++j) {
+      audio[j] = samples[position];
+      position = (position + 1) % samples.size();
+    }
+    const size_t pcm_bytes = WebRtcPcm16b_Encode(audio.data(), block, pcm);
+    if (encoder->Transcode(pcm, pcm_bytes, &packets) < 0) {
+      return false;
+    }
+    size_t offset = 0;
+    for (size_t bytes : packets.bytes) {
+      payloads->emplace_back(packets.payload.data() + offset, bytes);
+      offset += bytes;
+    }
+  }
+  return !payloads->empty();
+}
+
+// Returns the number of streams that one core transcodes in real time, or a
+// negative number on error.
+double RunPair(const std::string& pair,
+               const std::vector<int16_t>& samples,
+               int sample_rate_hz,
+               TranscoderPool* pool) {
+  const size_t dash = pair.find('-');
+  StreamingTranscoder::Config config;
+  if (dash == std::string::npos ||
+      !ParseCodec(pair.substr(0, dash), &config.decoder) ||
+      !ParseCodec(pair.substr(dash + 1), &config.encoder)) {
+    fprintf(stderr, "Unknown pair %s\n", pair.c_str());
+    return -1;
+  }
+  config.encoder_frame_ms =
+      FLAG_frame_ms > 0 ? FLAG_frame_ms : DefaultFrameMs(config.encoder);
+
+  CodecInstanceArena arena;
+  std::vector<rtc::Buffer> payloads;
+  if (!EncodeSource(samples, sample_rate_hz, config.decoder, &arena,
+                    &payloads)) {
+    fprintf(stderr, "%s: cannot encode the input\n", pair.c_str());
+    return -1;
+  }
+
+  const size_t num_streams = static_cast<size_t>(FLAG_streams);
+  std::vector<std::unique_ptr<StreamingTranscoder>> transcoders;
+  std::vector<StreamingTranscoder::Packets> packets(num_streams);
+  std::vector<TranscoderPool::Job> jobs(num_streams);
+  for (size_t i = 0; i < num_streams; ++i) {
+    transcoders.push_back(StreamingTranscoder::Create(config, &arena));
+    if (!transcoders.back()) {
+      fprintf(stderr, "%s: unsupported frame size %d ms\n", pair.c_str(),
+              config.encoder_frame_ms);
+      return -1;
+    }
+    jobs[i].transcoder = transcoders.back().get();
+    jobs[i].packets = &packets[i];
+  }
+
+  // Every stream starts at a different payload, so that the workers do not
+  // all code the same audio at the same time.
+  size_t output_packets = 0;
+  size_t output_bytes = 0;
+  const int64_t start_us = rtc::TimeMicros();
+  for (size_t tick = 0; tick < payloads.size(); ++tick) {
+    for (size_t i = 0; i < num_streams; ++i) {
+      const rtc::Buffer& payload = payloads[(tick + i * 7) % payloads.size()];
+      jobs[i].payload = payload.data();
+      jobs[i].payload_bytes = payload.size();
+    }
+    pool->Process(jobs);
+    for (size_t i = 0; i < num_streams; ++i) {
+      if (jobs[i].result < 0) {
+        fprintf(stderr, "%s: transcoding failed\n", pair.c_str());
+        return -1;
+      }
+      output_packets += jobs[i].result;
+      output_bytes += packets[i].payload.size();
+    }
+  }
+  const double wall_seconds = (rtc::TimeMicros() - start_us) * 1e-6;
+
+  const double audio_seconds =
+      static_cast<double>(num_streams) * FLAG_seconds;
+  const double legs_per_core =
+      audio_seconds / wall_seconds / pool->num_workers();
+  printf("%-16s %6zu %8d %10.3f %10.1f %10.1f\n", pair.c_str(), num_streams,
+         config.encoder_frame_ms, wall_seconds,
+         8.0 * output_bytes / audio_seconds / 1000, legs_per_core);
+  return legs_per_core;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  const std::string usage =
+      "Transcodes many streams between pairs of the in-tree codecs and "
+      "reports how many streams one core transcodes in real time.\n"
+      "Usage: " + std::string(argv[0]) + " [flags] input\n"
+      "The input is a mono WAV file, or raw 16-bit PCM at --rate.\n";
+  if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) ||
+      FLAG_help || argc != 2) {
+    printf("%s", usage.c_str());
+    if (FLAG_help) {
+      rtc::FlagList::Print(nullptr, false);
+      return 0;
+    }
+    return 1;
+  }
+  if (FLAG_streams < 1 || FLAG_workers < 1 || FLAG_seconds < 1) {
+    fprintf(stderr, "--streams, --workers and --seconds must be positive\n");
+    return 1;
+  }
+
+  std::vector<int16_t> samples;
+  int sample_rate_hz = 0;
+  if (!webrtc::ReadAudio(argv[1], &samples, &sample_rate_hz)) {
+    return 1;
+  }
+
+  webrtc::TranscoderPool pool(FLAG_workers);
+  printf("%-16s %6s %8s %10s %10s %10s\n", "pair", "streams", "frame_ms",
+         "wall_s", "out_kbps", "legs/core");
+  const std::string pairs = FLAG_pairs;
+  for (size_t start = 0; start <= pairs.size();) {
+    size_t end = pairs.find(',', start);
+    if (end == std::string::npos) {
+      end = pairs.size();
+    }
+    const std::string pair = pairs.substr(start, end - start);
+    start = end + 1;
+    if (!pair.empty() &&
+        webrtc::RunPair(pair, samples, sample_rate_hz, &pool) < 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
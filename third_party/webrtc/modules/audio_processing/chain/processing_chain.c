@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/chain/processing_chain.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/vad/include/webrtc_vad.h"
+#include "modules/audio_processing/ns/noise_suppression.h"
+
+// Up to two bands of 10 ms at 16 kHz.
+enum { kMaxBands = 2, kMaxBandLength = 160 };
+
+struct ProcessingChain {
+  NsHandle* ns;
+  VadInst* vad;
+  void* agc;
+
+  uint32_t fs;
+  size_t num_bands;
+  size_t band_length;
+  int16_t agc_mode;
+  // Microphone level fed back from one AGC call to the next, as the audio
+  // processing module does for the digital modes.
+  int32_t capture_level;
+
+  // States of the band split and merge at 32 kHz.
+  int32_t analysis_state1[6];
+  int32_t analysis_state2[6];
+  int32_t synthesis_state1[6];
+  int32_t synthesis_state2[6];
+
+  int16_t bands[kMaxBands][kMaxBandLength];
+  float bands_f[kMaxBands][kMaxBandLength];
+
+  int init_flag;
+};
+
+// Rounds to the nearest integer with saturation, like FloatS16ToS16() of
+// common_audio/include/audio_util.h.
+static int16_t FloatS16ToS16(float v) {
+  if (v > 0) {
+    return v >= 32766.5f ? 32767 : (int16_t)(v + 0.5f);
+  }
+  return v <= -32767.5f ? -32768 : (int16_t)(v - 0.5f);
+}
+
+ProcessingChain* WebRtcChain_Create() {
+  ProcessingChain* self = malloc(sizeof(ProcessingChain));
+  if (self == NULL) {
+    return NULL;
+  }
+  self->ns = WebRtcNs_Create();
+  self->vad = WebRtcVad_Create();
+  self->agc = WebRtcAgc_Create();
+  self->init_flag = 0;
+  if (self->ns == NULL || self->vad == NULL || self->agc == NULL) {
+    WebRtcChain_Free(self);
+    return NULL;
+  }
+  return self;
+}
+
+void WebRtcChain_Free(ProcessingChain* self) {
+  if (self == NULL) {
+    return;
+  }
+  if (self->ns != NULL) {
+    WebRtcNs_Free(self->ns);
+  }
+  if (self->vad != NULL) {
+    WebRtcVad_Free(self->vad);
+  }
+  if (self->agc != NULL) {
+    WebRtcAgc_Free(self->agc);
+  }
+  free(self);
+}
+
+int WebRtcChain_Init(ProcessingChain* self,
+                     uint32_t fs,
+                     int ns_policy,
+                     int vad_mode,
+                     int16_t agc_mode,
+                     WebRtcAgcConfig agc_config) {
+  if (self == NULL) {
+    return -1;
+  }
+  self->init_flag = 0;
+
+  if (fs == 8000 || fs == 16000) {
+    self->num_bands = 1;
+    self->band_length = fs / 100;
+  } else if (fs == 32000) {
+    // The 48 kHz three band split is only available in C++, and not here.
+    self->num_bands = 2;
+    self->band_length = 160;
+  } else {
+    return -1;
+  }
+  if (agc_mode != kAgcModeAdaptiveDigital && agc_mode != kAgcModeFixedDigital) {
+    return -1;
+  }
+
+  if (WebRtcNs_Init(self->ns, fs) != 0 ||
+      WebRtcNs_set_policy(self->ns, ns_policy) != 0) {
+    return -1;
+  }
+  if (WebRtcVad_Init(self->vad) != 0 ||
+      WebRtcVad_set_mode(self->vad, vad_mode) != 0) {
+    return -1;
+  }
+  if (WebRtcAgc_Init(self->agc, 0, 255, agc_mode, fs) != 0 ||
+      WebRtcAgc_set_config(self->agc, agc_config) != 0) {
+    return -1;
+  }
+
+  self->fs = fs;
+  self->agc_mode = agc_mode;
+  self->capture_level = 0;
+  memset(self->analysis_state1, 0, sizeof(self->analysis_state1));
+  memset(self->analysis_state2, 0, sizeof(self->analysis_state2));
+  memset(self->synthesis_state1, 0, sizeof(self->synthesis_state1));
+  memset(self->synthesis_state2, 0, sizeof(self->synthesis_state2));
+  self->init_flag = 1;
+  return 0;
+}
+
+int WebRtcChain_Process(ProcessingChain* self,
+                        const int16_t* in_frame,
+                        int16_t* out_frame,
+                        int* vad_decision) {
+  int16_t* bands[kMaxBands];
+  const int16_t* const_bands[kMaxBands];
+  float* bands_f[kMaxBands];
+  const float* const_bands_f[kMaxBands];
+  int vad_fs;
+  int32_t capture_level = 0;
+  uint8_t saturation_warning = 0;
+  size_t i, j;
+
+  if (self == NULL || self->init_flag == 0 || in_frame == NULL ||
+      out_frame == NULL || vad_decision == NULL) {
+    return -1;
+  }
+  // The VAD runs on the lowest band, at up to 16 kHz.
+  vad_fs = self->num_bands == 1 ? (int)self->fs : 16000;
+  for (i = 0; i < self->num_bands; ++i) {
+    bands[i] = self->bands[i];
+    const_bands[i] = self->bands[i];
+    bands_f[i] = self->bands_f[i];
+    const_bands_f[i] = self->bands_f[i];
+  }
+
+  // Split into bands once, for all modules.
+  if (self->num_bands == 2) {
+    WebRtcSpl_AnalysisQMF(in_frame, 2 * self->band_length, bands[0], bands[1],
+                          self->analysis_state1, self->analysis_state2);
+  } else {
+    memcpy(bands[0], in_frame, self->band_length * sizeof(int16_t));
+  }
+
+  if (self->agc_mode == kAgcModeAdaptiveDigital) {
+    if (WebRtcAgc_VirtualMic(self->agc, bands, self->num_bands,
+                             self->band_length, 0, &capture_level) != 0) {
+      return -1;
+    }
+    self->capture_level = capture_level;
+  }
+
+  for (i = 0; i < self->num_bands; ++i) {
+    for (j = 0; j < self->band_length; ++j) {
+      bands_f[i][j] = bands[i][j];
+    }
+  }
+  // Analyzes and suppresses the noise of the frame with one transform.
+  WebRtcNs_AnalyzeAndProcess(self->ns, const_bands_f, self->num_bands,
+                             bands_f);
+  for (i = 0; i < self->num_bands; ++i) {
+    for (j = 0; j < self->band_length; ++j) {
+      bands[i][j] = FloatS16ToS16(bands_f[i][j]);
+    }
+  }
+
+  *vad_decision =
+      WebRtcVad_Process(self->vad, vad_fs, bands[0], self->band_length);
+  if (*vad_decision < 0) {
+    return -1;
+  }
+
+  if (WebRtcAgc_Process(self->agc, const_bands, self->num_bands,
+                        self->band_length, bands, self->capture_level,
+                        &capture_level, 0, &saturation_warning) != 0) {
+    return -1;
+  }
+  self->capture_level = capture_level;
+
+  // Merge the bands once.
+  if (self->num_bands == 2) {
+    WebRtcSpl_SynthesisQMF(bands[0], bands[1], self->band_length, out_frame,
+                           self->synthesis_state1, self->synthesis_state2);
+  } else {
+    memcpy(out_frame, bands[0], self->band_length * sizeof(int16_t));
+  }
+  return 0;
+}
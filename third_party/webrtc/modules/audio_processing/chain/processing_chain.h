@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Per-stream capture chain of the floating point noise suppression, the VAD
+// and the legacy digital AGC, in the order the audio processing module runs
+// them. The chain splits each 10 ms frame into bands once, converts them to
+// float and back once, and windows and transforms the frame once for both the
+// analysis and the suppression of the noise suppressor. The output and the
+// VAD decisions are bit exact with running the modules one after the other
+// on the same band split.
+
+#ifndef MODULES_AUDIO_PROCESSING_CHAIN_PROCESSING_CHAIN_H_
+#define MODULES_AUDIO_PROCESSING_CHAIN_PROCESSING_CHAIN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "modules/audio_processing/agc/legacy/gain_control.h"
+
+typedef struct ProcessingChain ProcessingChain;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * This function creates an instance of the processing chain, along with the
+ * noise suppression, VAD and AGC instances it runs.
+ *
+ * Return value         : Processing chain instance, or NULL on failure.
+ */
+ProcessingChain* WebRtcChain_Create(void);
+
+/*
+ * This function frees the dynamic memory of a processing chain instance.
+ *
+ * Input:
+ *      - self          : Pointer to the instance that should be freed
+ */
+void WebRtcChain_Free(ProcessingChain* self);
+
+/*
+ * This function initializes a processing chain instance and has to be called
+ * before any other processing is made.
+ *
+ * Input:
+ *      - self          : Processing chain instance.
+ *      - fs            : Sampling frequency: 8000, 16000 or 32000 Hz.
+ *      - ns_policy     : Noise suppression policy, 0: Mild, 1: Medium,
+ *                        2: Aggressive, 3: Very aggressive.
+ *      - vad_mode      : VAD aggressiveness mode, 0 to 3.
+ *      - agc_mode      : kAgcModeAdaptiveDigital or kAgcModeFixedDigital. The
+ *                        analog mode needs a microphone level from outside
+ *                        and is not supported.
+ *      - agc_config    : AGC target level, compression gain and limiter.
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcChain_Init(ProcessingChain* self,
+                     uint32_t fs,
+                     int ns_policy,
+                     int vad_mode,
+                     int16_t agc_mode,
+                     WebRtcAgcConfig agc_config);
+
+/*
+ * This function processes a 10 ms frame of the capture stream through the
+ * noise suppression, the VAD and the AGC.
+ *
+ * Input:
+ *      - self          : Processing chain instance.
+ *      - in_frame      : Frame of fs / 100 samples.
+ *
+ * Output:
+ *      - self          : Updated instance.
+ *      - out_frame     : Processed frame of fs / 100 samples. May be the same
+ *                        buffer as |in_frame|.
+ *      - vad_decision  : VAD decision on the noise suppressed frame, 1 for
+ *                        active voice and 0 otherwise.
+ *
+ * Return value         :  0 - Ok
+ *                        -1 - Error
+ */
+int WebRtcChain_Process(ProcessingChain* self,
+                        const int16_t* in_frame,
+                        int16_t* out_frame,
+                        int* vad_decision);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MODULES_AUDIO_PROCESSING_CHAIN_PROCESSING_CHAIN_H_
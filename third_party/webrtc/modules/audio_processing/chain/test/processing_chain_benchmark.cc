@@ -0,0 +1,276 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Benchmark of the processing chain against the same modules run one after
+// the other on the same band split, as the audio processing module runs them,
+// where the noise suppressor windows and transforms each frame once for its
+// analysis and once more for the suppression. Verifies that the outputs and
+// the VAD decisions are identical, and reports the time per 10 ms frame of
+// both. Returns 0 if they are identical.
+//
+// Usage: processing_chain_benchmark <input.pcm> [rate] [policy] [agc_mode]
+//                                   [loops]
+//
+// The input is 16-bit mono PCM at |rate|, 8000, 16000 (default) or 32000 Hz.
+// |policy| is the noise suppression policy, 0 to 3, and |agc_mode| is 2 for
+// the adaptive digital (default) or 3 for the fixed digital AGC.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "common_audio/vad/include/webrtc_vad.h"
+#include "modules/audio_processing/agc/legacy/gain_control.h"
+#include "modules/audio_processing/chain/processing_chain.h"
+#include "modules/audio_processing/ns/noise_suppression.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const int kFrameMs = 10;
+const int kVadMode = 2;
+const size_t kMaxBands = 2;
+const size_t kMaxBandLength = 160;
+
+WebRtcAgcConfig AgcConfig() {
+  WebRtcAgcConfig config;
+  config.targetLevelDbfs = 3;
+  config.compressionGaindB = 9;
+  config.limiterEnable = kAgcTrue;
+  return config;
+}
+
+// The modules of the chain, each run on its own.
+class Modules {
+ public:
+  Modules(int rate, int policy, int16_t agc_mode)
+      : ns_(WebRtcNs_Create()),
+        vad_(WebRtcVad_Create()),
+        agc_(WebRtcAgc_Create()),
+        num_bands_(rate == 32000 ? 2 : 1),
+        band_length_(rate == 8000 ? 80 : 160),
+        vad_rate_(rate == 32000 ? 16000 : rate),
+        agc_mode_(agc_mode),
+        capture_level_(0) {
+    WebRtcNs_Init(ns_, rate);
+    WebRtcNs_set_policy(ns_, policy);
+    WebRtcVad_Init(vad_);
+    WebRtcVad_set_mode(vad_, kVadMode);
+    WebRtcAgc_Init(agc_, 0, 255, agc_mode, rate);
+    WebRtcAgc_set_config(agc_, AgcConfig());
+    memset(analysis_state1_, 0, sizeof(analysis_state1_));
+    memset(analysis_state2_, 0, sizeof(analysis_state2_));
+    memset(synthesis_state1_, 0, sizeof(synthesis_state1_));
+    memset(synthesis_state2_, 0, sizeof(synthesis_state2_));
+    for (size_t band = 0; band < kMaxBands; ++band) {
+      bands_[band] = bands_data_[band];
+      bands_f_[band] = bands_f_data_[band];
+    }
+  }
+  ~Modules() {
+    WebRtcNs_Free(ns_);
+    WebRtcVad_Free(vad_);
+    WebRtcAgc_Free(agc_);
+  }
+
+  int Process(const int16_t* in, int16_t* out) {
+    if (num_bands_ == 2) {
+      WebRtcSpl_AnalysisQMF(in, 2 * band_length_, bands_[0], bands_[1],
+                            analysis_state1_, analysis_state2_);
+    } else {
+      memcpy(bands_[0], in, band_length_ * sizeof(in[0]));
+    }
+    int32_t capture_level = 0;
+    if (agc_mode_ == kAgcModeAdaptiveDigital) {
+      WebRtcAgc_VirtualMic(agc_, bands_, num_bands_, band_length_, 0,
+                           &capture_level);
+      capture_level_ = capture_level;
+    }
+
+    ToFloat();
+    WebRtcNs_Analyze(ns_, bands_f_[0]);
+    WebRtcNs_Process(ns_, bands_f_, num_bands_, bands_f_);
+    ToInt16();
+
+    const int decision =
+        WebRtcVad_Process(vad_, vad_rate_, bands_[0], band_length_);
+
+    uint8_t saturation_warning = 0;
+    WebRtcAgc_Process(agc_, bands_, num_bands_, band_length_, bands_,
+                      capture_level_, &capture_level, 0, &saturation_warning);
+    capture_level_ = capture_level;
+
+    if (num_bands_ == 2) {
+      WebRtcSpl_SynthesisQMF(bands_[0], bands_[1], band_length_, out,
+                             synthesis_state1_, synthesis_state2_);
+    } else {
+      memcpy(out, bands_[0], band_length_ * sizeof(out[0]));
+    }
+    return decision;
+  }
+
+ private:
+  void ToFloat() {
+    for (size_t band = 0; band < num_bands_; ++band) {
+      for (size_t i = 0; i < band_length_; ++i) {
+        bands_f_[band][i] = bands_[band][i];
+      }
+    }
+  }
+  void ToInt16() {
+    for (size_t band = 0; band < num_bands_; ++band) {
+      for (size_t i = 0; i < band_length_; ++i) {
+        bands_[band][i] = FloatS16ToS16(bands_f_[band][i]);
+      }
+    }
+  }
+
+  NsHandle* ns_;
+  VadInst* vad_;
+  void* agc_;
+  const size_t num_bands_;
+  const size_t band_length_;
+  const int vad_rate_;
+  const int16_t agc_mode_;
+  int32_t capture_level_;
+  int32_t analysis_state1_[6];
+  int32_t analysis_state2_[6];
+  int32_t synthesis_state1_[6];
+  int32_t synthesis_state2_[6];
+  int16_t bands_data_[kMaxBands][kMaxBandLength];
+  float bands_f_data_[kMaxBands][kMaxBandLength];
+  int16_t* bands_[kMaxBands];
+  float* bands_f_[kMaxBands];
+};
+
+class Chain {
+ public:
+  Chain(int rate, int policy, int16_t agc_mode)
+      : handle_(WebRtcChain_Create()) {
+    WebRtcChain_Init(handle_, rate, policy, kVadMode, agc_mode, AgcConfig());
+  }
+  ~Chain() { WebRtcChain_Free(handle_); }
+
+  int Process(const int16_t* in, int16_t* out) {
+    int decision = -1;
+    WebRtcChain_Process(handle_, in, out, &decision);
+    return decision;
+  }
+
+ private:
+  ProcessingChain* handle_;
+};
+
+// Runs the frames of |input| through a new |Processor|, writes the output to
+// |output| and the VAD decisions to |decisions|, and returns the time spent.
+template <typename Processor>
+int64_t Run(const std::vector<int16_t>& input,
+            size_t frame_length,
+            int rate,
+            int policy,
+            int16_t agc_mode,
+            std::vector<int16_t>* output,
+            std::vector<int>* decisions) {
+  const size_t num_frames = input.size() / frame_length;
+  Processor processor(rate, policy, agc_mode);
+  output->resize(num_frames * frame_length);
+  decisions->resize(num_frames);
+  const int64_t start_ns = rtc::TimeNanos();
+  for (size_t frame = 0; frame < num_frames; ++frame) {
+    (*decisions)[frame] =
+        processor.Process(&input[frame * frame_length],
+                          &(*output)[frame * frame_length]);
+  }
+  return rtc::TimeNanos() - start_ns;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <input.pcm> [rate] [policy] [agc_mode] [loops]\n",
+            argv[0]);
+    return 1;
+  }
+  const int rate = argc > 2 ? atoi(argv[2]) : 16000;
+  const int policy = argc > 3 ? atoi(argv[3]) : 0;
+  const int16_t agc_mode = static_cast<int16_t>(
+      argc > 4 ? atoi(argv[4]) : kAgcModeAdaptiveDigital);
+  const int loops = argc > 5 ? atoi(argv[5]) : 3;
+  if ((rate != 8000 && rate != 16000 && rate != 32000) || policy < 0 ||
+      policy > 3 ||
+      (agc_mode != kAgcModeAdaptiveDigital &&
+       agc_mode != kAgcModeFixedDigital) ||
+      loops < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  const size_t frame_length =
+      static_cast<size_t>(rate / 1000 * webrtc::kFrameMs);
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  const size_t num_frames = input.size() / frame_length;
+  if (num_frames == 0) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+
+  // Alternates between the two, so that both see the same load.
+  std::vector<int16_t> modules_output;
+  std::vector<int16_t> chain_output;
+  std::vector<int> modules_decisions;
+  std::vector<int> chain_decisions;
+  int64_t modules_ns = 0;
+  int64_t chain_ns = 0;
+  bool identical = true;
+  for (int loop = 0; loop < loops; ++loop) {
+    modules_ns += webrtc::Run<webrtc::Modules>(input, frame_length, rate,
+                                               policy, agc_mode,
+                                               &modules_output,
+                                               &modules_decisions);
+    chain_ns += webrtc::Run<webrtc::Chain>(input, frame_length, rate, policy,
+                                           agc_mode, &chain_output,
+                                           &chain_decisions);
+    identical = identical && chain_output == modules_output &&
+                chain_decisions == modules_decisions;
+  }
+
+  const double modules_per_frame_ns =
+      static_cast<double>(modules_ns) / (num_frames * loops);
+  const double chain_per_frame_ns =
+      static_cast<double>(chain_ns) / (num_frames * loops);
+  printf("%d Hz, policy %d, AGC mode %d, %d frames of %d ms\n", rate, policy,
+         agc_mode, static_cast<int>(num_frames), webrtc::kFrameMs);
+  printf("%-10s %12s\n", "", "ns/frame");
+  printf("%-10s %12.0f\n", "modules", modules_per_frame_ns);
+  printf("%-10s %12.0f\n", "chain", chain_per_frame_ns);
+  printf("Chain saves %.1f %% per frame, output %s\n",
+         100.0 * (1.0 - chain_per_frame_ns / modules_per_frame_ns),
+         identical ? "identical" : "DIFFERENT");
+  return identical ? 0 : 1;
+}
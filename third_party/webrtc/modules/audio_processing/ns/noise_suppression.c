@@ -47,6 +47,14 @@ void WebRtcNs_Process(NsHandle* NS_inst,
                        outframe);
 }
 
+void WebRtcNs_AnalyzeAndProcess(NsHandle* NS_inst,
+                                const float* const* spframe,
+                                size_t num_bands,
+                                float* const* outframe) {
+  WebRtcNs_AnalyzeAndProcessCore((NoiseSuppressionC*)NS_inst, spframe,
+                                 num_bands, outframe);
+}
+
 float WebRtcNs_prior_speech_probability(NsHandle* handle) {
   NoiseSuppressionC* self = (NoiseSuppressionC*)handle;
   if (handle == NULL) {
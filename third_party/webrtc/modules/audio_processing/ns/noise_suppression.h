@@ -96,6 +96,26 @@ void WebRtcNs_Process(NsHandle* NS_inst,
                       size_t num_bands,
                       float* const* outframe);
 
+/*
+ * Does the same as WebRtcNs_Analyze() followed by WebRtcNs_Process() with the
+ * same frame, for streams without processing in between, but windows and
+ * transforms the frame only once. Streams should not mix it with the two
+ * separate calls.
+ *
+ * Input
+ *      - NS_inst       : Noise suppression instance.
+ *      - spframe       : Pointer to speech frame buffer for each band
+ *      - num_bands     : Number of bands
+ *
+ * Output:
+ *      - NS_inst       : Updated NS instance
+ *      - outframe      : Pointer to output frame for each band
+ */
+void WebRtcNs_AnalyzeAndProcess(NsHandle* NS_inst,
+                                const float* const* spframe,
+                                size_t num_bands,
+                                float* const* outframe);
+
 /* Returns the internally used prior speech probability of the current frame.
  * There is a frequency bin based one as well, with which this should not be
  * confused.
@@ -14,211 +14,15 @@
 
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
-#include "common_audio/third_party/fft4g/fft4g.h"
 #include "modules/audio_processing/ns/noise_suppression.h"
 #include "modules/audio_processing/ns/ns_core.h"
 #include "modules/audio_processing/ns/windows_private.h"
-
-// Set Feature Extraction Parameters.
-static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
-  // Bin size of histogram.
-  self->featureExtractionParams.binSizeLrt = 0.1f;
-  self->featureExtractionParams.binSizeSpecFlat = 0.05f;
-  self->featureExtractionParams.binSizeSpecDiff = 0.1f;
-
-  // Range of histogram over which LRT threshold is computed.
-  self->featureExtractionParams.rangeAvgHistLrt = 1.f;
-
-  // Scale parameters: multiply dominant peaks of the histograms by scale factor
-  // to obtain thresholds for prior model.
-  // For LRT and spectral difference.
-  self->featureExtractionParams.factor1ModelPars = 1.2f;
-  // For spectral_flatness: used when noise is flatter than speech.
-  self->featureExtractionParams.factor2ModelPars = 0.9f;
-
-  // Peak limit for spectral flatness (varies between 0 and 1).
-  self->featureExtractionParams.thresPosSpecFlat = 0.6f;
-
-  // Limit on spacing of two highest peaks in histogram: spacing determined by
-  // bin size.
-  self->featureExtractionParams.limitPeakSpacingSpecFlat =
-      2 * self->featureExtractionParams.binSizeSpecFlat;
-  self->featureExtractionParams.limitPeakSpacingSpecDiff =
-      2 * self->featureExtractionParams.binSizeSpecDiff;
-
-  // Limit on relevance of second peak.
-  self->featureExtractionParams.limitPeakWeightsSpecFlat = 0.5f;
-  self->featureExtractionParams.limitPeakWeightsSpecDiff = 0.5f;
-
-  // Fluctuation limit of LRT feature.
-  self->featureExtractionParams.thresFluctLrt = 0.05f;
-
-  // Limit on the max and min values for the feature thresholds.
-  self->featureExtractionParams.maxLrt = 1.f;
-  self->featureExtractionParams.minLrt = 0.2f;
-
-  self->featureExtractionParams.maxSpecFlat = 0.95f;
-  self->featureExtractionParams.minSpecFlat = 0.1f;
-
-  self->featureExtractionParams.maxSpecDiff = 1.f;
-  self->featureExtractionParams.minSpecDiff = 0.16f;
-
-  // Criteria of weight of histogram peak to accept/reject feature.
-  self->featureExtractionParams.thresWeightSpecFlat =
-      (int)(0.3 * (self->modelUpdatePars[1]));  // For spectral flatness.
-  self->featureExtractionParams.thresWeightSpecDiff =
-      (int)(0.3 * (self->modelUpdatePars[1]));  // For spectral difference.
-}
-
-// Initialize state.
-int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
-  int i;
-  // Check for valid pointer.
-  if (self == NULL) {
-    return -1;
-  }
-
-  // Initialization of struct.
-  if (fs == 8000 || fs == 16000 || fs == 32000 || fs == 48000) {
-    self->fs = fs;
-  } else {
-    return -1;
-  }
-  self->windShift = 0;
-  // We only support 10ms frames.
-  if (fs == 8000) {
-    self->blockLen = 80;
-    self->anaLen = 128;
-    self->window = kBlocks80w128;
-  } else {
-    self->blockLen = 160;
-    self->anaLen = 256;
-    self->window = kBlocks160w256;
-  }
-  self->magnLen = self->anaLen / 2 + 1;  // Number of frequency bins.
-
-  // Initialize FFT work arrays.
-  self->ip[0] = 0;  // Setting this triggers initialization.
-  memset(self->dataBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
-  WebRtc_rdft(self->anaLen, 1, self->dataBuf, self->ip, self->wfft);
-
-  memset(self->analyzeBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
-  memset(self->dataBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
-  memset(self->syntBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
-
-  // For HB processing.
-  memset(self->dataBufHB,
-         0,
-         sizeof(float) * NUM_HIGH_BANDS_MAX * ANAL_BLOCKL_MAX);
-
-  // For quantile noise estimation.
-  memset(self->quantile, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  for (i = 0; i < SIMULT * HALF_ANAL_BLOCKL; i++) {
-    self->lquantile[i] = 8.f;
-    self->density[i] = 0.3f;
-  }
-
-  for (i = 0; i < SIMULT; i++) {
-    self->counter[i] =
-        (int)floor((float)(END_STARTUP_LONG * (i + 1)) / (float)SIMULT);
-  }
-
-  self->updates = 0;
-
-  // Wiener filter initialization.
-  for (i = 0; i < HALF_ANAL_BLOCKL; i++) {
-    self->smooth[i] = 1.f;
-  }
-
-  // Set the aggressiveness: default.
-  self->aggrMode = 0;
-
-  // Initialize variables for new method.
-  self->priorSpeechProb = 0.5f;  // Prior prob for speech/noise.
-  // Previous analyze mag spectrum.
-  memset(self->magnPrevAnalyze, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  // Previous process mag spectrum.
-  memset(self->magnPrevProcess, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  // Current noise-spectrum.
-  memset(self->noise, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  // Previous noise-spectrum.
-  memset(self->noisePrev, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  // Conservative noise spectrum estimate.
-  memset(self->magnAvgPause, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  // For estimation of HB in second pass.
-  memset(self->speechProb, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  // Initial average magnitude spectrum.
-  memset(self->initMagnEst, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-  for (i = 0; i < HALF_ANAL_BLOCKL; i++) {
-    // Smooth LR (same as threshold).
-    self->logLrtTimeAvg[i] = LRT_FEATURE_THR;
-  }
-
-  // Feature quantities.
-  // Spectral flatness (start on threshold).
-  self->featureData[0] = SF_FEATURE_THR;
-  self->featureData[1] = 0.f;  // Spectral entropy: not used in this version.
-  self->featureData[2] = 0.f;  // Spectral variance: not used in this version.
-  // Average LRT factor (start on threshold).
-  self->featureData[3] = LRT_FEATURE_THR;
-  // Spectral template diff (start on threshold).
-  self->featureData[4] = SF_FEATURE_THR;
-  self->featureData[5] = 0.f;  // Normalization for spectral difference.
-  // Window time-average of input magnitude spectrum.
-  self->featureData[6] = 0.f;
-
-  memset(self->parametricNoise, 0, sizeof(float) * HALF_ANAL_BLOCKL);
-
-  // Histogram quantities: used to estimate/update thresholds for features.
-  memset(self->histLrt, 0, sizeof(int) * HIST_PAR_EST);
-  memset(self->histSpecFlat, 0, sizeof(int) * HIST_PAR_EST);
-  memset(self->histSpecDiff, 0, sizeof(int) * HIST_PAR_EST);
-
-
-  self->blockInd = -1;  // Frame counter.
-  // Default threshold for LRT feature.
-  self->priorModelPars[0] = LRT_FEATURE_THR;
-  // Threshold for spectral flatness: determined on-line.
-  self->priorModelPars[1] = 0.5f;
-  // sgn_map par for spectral measure: 1 for flatness measure.
-  self->priorModelPars[2] = 1.f;
-  // Threshold for template-difference feature: determined on-line.
-  self->priorModelPars[3] = 0.5f;
-  // Default weighting parameter for LRT feature.
-  self->priorModelPars[4] = 1.f;
-  // Default weighting parameter for spectral flatness feature.
-  self->priorModelPars[5] = 0.f;
-  // Default weighting parameter for spectral difference feature.
-  self->priorModelPars[6] = 0.f;
-
-  // Update flag for parameters:
-  // 0 no update, 1 = update once, 2 = update every window.
-  self->modelUpdatePars[0] = 2;
-  self->modelUpdatePars[1] = 500;  // Window for update.
-  // Counter for update of conservative noise spectrum.
-  self->modelUpdatePars[2] = 0;
-  // Counter if the feature thresholds are updated during the sequence.
-  self->modelUpdatePars[3] = self->modelUpdatePars[1];
-
-  self->signalEnergy = 0.0;
-  self->sumMagn = 0.0;
-  self->whiteNoiseLevel = 0.0;
-  self->pinkNoiseNumerator = 0.0;
-  self->pinkNoiseExp = 0.0;
-
-  set_feature_extraction_parameters(self);
-
-  // Default mode.
-  WebRtcNs_set_policy_core(self, 0);
-
-  self->initFlag = 1;
-  return 0;
-}
+#include "system_wrappers/include/cpu_features_sse2.h"
 
 // Estimate noise.
-static void NoiseEstimation(NoiseSuppressionC* self,
-                            float* magn,
-                            float* noise) {
+void WebRtcNs_NoiseEstimationC(NoiseSuppressionC* self,
+                               float* magn,
+                               float* noise) {
   size_t i, s, offset;
   float lmagn[HALF_ANAL_BLOCKL], delta;
 
@@ -522,8 +326,8 @@ static void FeatureParameterExtraction(NoiseSuppressionC* self, int flag) {
 // Compute spectral flatness on input spectrum.
 // |magnIn| is the magnitude spectrum.
 // Spectral flatness is returned in self->featureData[0].
-static void ComputeSpectralFlatness(NoiseSuppressionC* self,
-                                    const float* magnIn) {
+void WebRtcNs_ComputeSpectralFlatnessC(NoiseSuppressionC* self,
+                                       const float* magnIn) {
   size_t i;
   size_t shiftLP = 1;  // Option to remove first bin(s) from spectral measures.
   float avgSpectralFlatnessNum, avgSpectralFlatnessDen, spectralTmp;
@@ -565,11 +369,11 @@ static void ComputeSpectralFlatness(NoiseSuppressionC* self,
 // Outputs:
 //   * |snrLocPrior| is the computed prior SNR.
 //   * |snrLocPost| is the computed post SNR.
-static void ComputeSnr(const NoiseSuppressionC* self,
-                       const float* magn,
-                       const float* noise,
-                       float* snrLocPrior,
-                       float* snrLocPost) {
+void WebRtcNs_ComputeSnrC(const NoiseSuppressionC* self,
+                          const float* magn,
+                          const float* noise,
+                          float* snrLocPrior,
+                          float* snrLocPost) {
   size_t i;
 
   for (i = 0; i < self->magnLen; i++) {
@@ -635,6 +439,44 @@ static void ComputeSpectralDifference(NoiseSuppressionC* self,
       SPECT_DIFF_TAVG * (avgDiffNormMagn - self->featureData[4]);
 }
 
+// Update the time-smoothed log LRT factor of every frequency.
+// |snrLocPrior| is the prior SNR for each frequency.
+// |snrLocPost| is the post SNR for each frequency.
+// Returns the sum over all frequencies of the smooth log LRT.
+float WebRtcNs_UpdateLogLrtTimeAvgC(NoiseSuppressionC* self,
+                                    const float* snrLocPrior,
+                                    const float* snrLocPost) {
+  size_t i;
+  float logLrtTimeAvgKsum, besselTmp;
+  float tmpFloat1, tmpFloat2;
+
+  logLrtTimeAvgKsum = 0.0;
+  for (i = 0; i < self->magnLen; i++) {
+    tmpFloat1 = 1.f + 2.f * snrLocPrior[i];
+    tmpFloat2 = 2.f * snrLocPrior[i] / (tmpFloat1 + 0.0001f);
+    besselTmp = (snrLocPost[i] + 1.f) * tmpFloat2;
+    self->logLrtTimeAvg[i] +=
+        LRT_TAVG * (besselTmp - (float)log(tmpFloat1) - self->logLrtTimeAvg[i]);
+    logLrtTimeAvgKsum += self->logLrtTimeAvg[i];
+  }
+  return logLrtTimeAvgKsum;
+}
+
+// Combine the prior model, given by |gainPrior|, with the LR factor of every
+// frequency to the final speech probability |probSpeechFinal|.
+void WebRtcNs_ComputeSpeechProbC(const NoiseSuppressionC* self,
+                                 float gainPrior,
+                                 float* probSpeechFinal) {
+  size_t i;
+  float invLrt;
+
+  for (i = 0; i < self->magnLen; i++) {
+    invLrt = (float)exp(-self->logLrtTimeAvg[i]);
+    invLrt = (float)gainPrior * invLrt;
+    probSpeechFinal[i] = 1.f / (1.f + invLrt);
+  }
+}
+
 // Compute speech/noise probability.
 // Speech/noise probability is returned in |probSpeechFinal|.
 // |magn| is the input magnitude spectrum.
@@ -645,12 +487,11 @@ static void SpeechNoiseProb(NoiseSuppressionC* self,
                             float* probSpeechFinal,
                             const float* snrLocPrior,
                             const float* snrLocPost) {
-  size_t i;
   int sgnMap;
-  float invLrt, gainPrior, indPrior;
-  float logLrtTimeAvgKsum, besselTmp;
+  float gainPrior, indPrior;
+  float logLrtTimeAvgKsum;
   float indicator0, indicator1, indicator2;
-  float tmpFloat1, tmpFloat2;
+  float tmpFloat1;
   float weightIndPrior0, weightIndPrior1, weightIndPrior2;
   float threshPrior0, threshPrior1, threshPrior2;
   float widthPrior, widthPrior0, widthPrior1, widthPrior2;
@@ -675,15 +516,8 @@ static void SpeechNoiseProb(NoiseSuppressionC* self,
 
   // Compute feature based on average LR factor.
   // This is the average over all frequencies of the smooth log LRT.
-  logLrtTimeAvgKsum = 0.0;
-  for (i = 0; i < self->magnLen; i++) {
-    tmpFloat1 = 1.f + 2.f * snrLocPrior[i];
-    tmpFloat2 = 2.f * snrLocPrior[i] / (tmpFloat1 + 0.0001f);
-    besselTmp = (snrLocPost[i] + 1.f) * tmpFloat2;
-    self->logLrtTimeAvg[i] +=
-        LRT_TAVG * (besselTmp - (float)log(tmpFloat1) - self->logLrtTimeAvg[i]);
-    logLrtTimeAvgKsum += self->logLrtTimeAvg[i];
-  }
+  logLrtTimeAvgKsum =
+      WebRtcNs_UpdateLogLrtTimeAvg(self, snrLocPrior, snrLocPost);
   logLrtTimeAvgKsum = (float)logLrtTimeAvgKsum / (self->magnLen);
   self->featureData[3] = logLrtTimeAvgKsum;
   // Done with computation of LR factor.
@@ -744,11 +578,7 @@ static void SpeechNoiseProb(NoiseSuppressionC* self,
 
   // Final speech probability: combine prior model with LR factor:.
   gainPrior = (1.f - self->priorSpeechProb) / (self->priorSpeechProb + 0.0001f);
-  for (i = 0; i < self->magnLen; i++) {
-    invLrt = (float)exp(-self->logLrtTimeAvg[i]);
-    invLrt = (float)gainPrior * invLrt;
-    probSpeechFinal[i] = 1.f / (1.f + invLrt);
-  }
+  WebRtcNs_ComputeSpeechProb(self, gainPrior, probSpeechFinal);
 }
 
 // Update the noise features.
@@ -759,7 +589,7 @@ static void FeatureUpdate(NoiseSuppressionC* self,
                           const float* magn,
                           int updateParsFlag) {
   // Compute spectral flatness on input spectrum.
-  ComputeSpectralFlatness(self, magn);
+  WebRtcNs_ComputeSpectralFlatness(self, magn);
   // Compute difference of input spectrum with learned/estimated noise spectrum.
   ComputeSpectralDifference(self, magn);
   // Compute histograms for parameter decisions (thresholds and weights for
@@ -897,7 +727,7 @@ static void FFT(NoiseSuppressionC* self,
 
   RTC_DCHECK_EQ(magnitude_length, time_data_length / 2 + 1);
 
-  WebRtc_rdft(time_data_length, 1, time_data, self->ip, self->wfft);
+  WebRtc_RdftForward(self->fftPlan, time_data);
 
   imag[0] = 0;
   real[0] = time_data[0];
@@ -939,7 +769,7 @@ static void IFFT(NoiseSuppressionC* self,
     time_data[2 * i] = real[i];
     time_data[2 * i + 1] = imag[i];
   }
-  WebRtc_rdft(time_data_length, -1, time_data, self->ip, self->wfft);
+  WebRtc_RdftInverse(self->fftPlan, time_data);
 
   for (i = 0; i < time_data_length; ++i) {
     time_data[i] *= 2.f / time_data_length;  // FFT scaling.
@@ -985,9 +815,9 @@ static void Windowing(const float* window,
 //   * |magn| is the signal magnitude spectrum estimate.
 // Output:
 //   * |theFilter| is the frequency response of the computed Wiener filter.
-static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
-                                       const float* magn,
-                                       float* theFilter) {
+void WebRtcNs_ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                          const float* magn,
+                                          float* theFilter) {
   size_t i;
   float snrPrior, previousEstimateStsa, currentEstimateStsa;
 
@@ -1009,25 +839,253 @@ static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
   }  // End of loop over frequencies.
 }
 
-// Changes the aggressiveness of the noise suppression method.
-// |mode| = 0 is mild (6dB), |mode| = 1 is medium (10dB) and |mode| = 2 is
-// aggressive (15dB).
-// Returns 0 on success and -1 otherwise.
-int WebRtcNs_set_policy_core(NoiseSuppressionC* self, int mode) {
-  // Allow for modes: 0, 1, 2, 3.
-  if (mode < 0 || mode > 3) {
-    return (-1);
-  }
+// Declare function pointers.
+NoiseEstimation WebRtcNs_NoiseEstimation;
+ComputeSpectralFlatness WebRtcNs_ComputeSpectralFlatness;
+ComputeSnr WebRtcNs_ComputeSnr;
+UpdateLogLrtTimeAvg WebRtcNs_UpdateLogLrtTimeAvg;
+ComputeSpeechProb WebRtcNs_ComputeSpeechProb;
+ComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Initialize function pointers for x86 platforms with SSE2.
+static void WebRtcNs_InitSSE2(void) {
+  WebRtcNs_NoiseEstimation = WebRtcNs_NoiseEstimationSSE2;
+  WebRtcNs_ComputeSpectralFlatness = WebRtcNs_ComputeSpectralFlatnessSSE2;
+  WebRtcNs_ComputeSnr = WebRtcNs_ComputeSnrSSE2;
+  WebRtcNs_UpdateLogLrtTimeAvg = WebRtcNs_UpdateLogLrtTimeAvgSSE2;
+  WebRtcNs_ComputeSpeechProb = WebRtcNs_ComputeSpeechProbSSE2;
+  WebRtcNs_ComputeDdBasedWienerFilter =
+      WebRtcNs_ComputeDdBasedWienerFilterSSE2;
+}
+#endif
 
-  self->aggrMode = mode;
-  if (mode == 0) {
-    self->overdrive = 1.f;
-    self->denoiseBound = 0.5f;
-    self->gainmap = 0;
-  } else if (mode == 1) {
-    // self->overdrive = 1.25f;
-    self->overdrive = 1.f;
-    self->denoiseBound = 0.25f;
+// Set Feature Extraction Parameters.
+static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
+  // Bin size of histogram.
+  self->featureExtractionParams.binSizeLrt = 0.1f;
+  self->featureExtractionParams.binSizeSpecFlat = 0.05f;
+  self->featureExtractionParams.binSizeSpecDiff = 0.1f;
+
+  // Range of histogram over which LRT threshold is computed.
+  self->featureExtractionParams.rangeAvgHistLrt = 1.f;
+
+  // Scale parameters: multiply dominant peaks of the histograms by scale factor
+  // to obtain thresholds for prior model.
+  // For LRT and spectral difference.
+  self->featureExtractionParams.factor1ModelPars = 1.2f;
+  // For spectral_flatness: used when noise is flatter than speech.
+  self->featureExtractionParams.factor2ModelPars = 0.9f;
+
+  // Peak limit for spectral flatness (varies between 0 and 1).
+  self->featureExtractionParams.thresPosSpecFlat = 0.6f;
+
+  // Limit on spacing of two highest peaks in histogram: spacing determined by
+  // bin size.
+  self->featureExtractionParams.limitPeakSpacingSpecFlat =
+      2 * self->featureExtractionParams.binSizeSpecFlat;
+  self->featureExtractionParams.limitPeakSpacingSpecDiff =
+      2 * self->featureExtractionParams.binSizeSpecDiff;
+
+  // Limit on relevance of second peak.
+  self->featureExtractionParams.limitPeakWeightsSpecFlat = 0.5f;
+  self->featureExtractionParams.limitPeakWeightsSpecDiff = 0.5f;
+
+  // Fluctuation limit of LRT feature.
+  self->featureExtractionParams.thresFluctLrt = 0.05f;
+
+  // Limit on the max and min values for the feature thresholds.
+  self->featureExtractionParams.maxLrt = 1.f;
+  self->featureExtractionParams.minLrt = 0.2f;
+
+  self->featureExtractionParams.maxSpecFlat = 0.95f;
+  self->featureExtractionParams.minSpecFlat = 0.1f;
+
+  self->featureExtractionParams.maxSpecDiff = 1.f;
+  self->featureExtractionParams.minSpecDiff = 0.16f;
+
+  // Criteria of weight of histogram peak to accept/reject feature.
+  self->featureExtractionParams.thresWeightSpecFlat =
+      (int)(0.3 * (self->modelUpdatePars[1]));  // For spectral flatness.
+  self->featureExtractionParams.thresWeightSpecDiff =
+      (int)(0.3 * (self->modelUpdatePars[1]));  // For spectral difference.
+}
+
+// Initialize state.
+int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
+  int i;
+  // Check for valid pointer.
+  if (self == NULL) {
+    return -1;
+  }
+
+  // Initialization of struct.
+  if (fs == 8000 || fs == 16000 || fs == 32000 || fs == 48000) {
+    self->fs = fs;
+  } else {
+    return -1;
+  }
+  self->windShift = 0;
+  // We only support 10ms frames.
+  if (fs == 8000) {
+    self->blockLen = 80;
+    self->anaLen = 128;
+    self->window = kBlocks80w128;
+  } else {
+    self->blockLen = 160;
+    self->anaLen = 256;
+    self->window = kBlocks160w256;
+  }
+  self->magnLen = self->anaLen / 2 + 1;  // Number of frequency bins.
+
+  self->fftPlan = WebRtc_GetRdftPlan(self->anaLen);
+
+  memset(self->analyzeBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
+  memset(self->dataBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
+  memset(self->syntBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
+
+  // For HB processing.
+  memset(self->dataBufHB,
+         0,
+         sizeof(float) * NUM_HIGH_BANDS_MAX * ANAL_BLOCKL_MAX);
+
+  // For quantile noise estimation.
+  memset(self->quantile, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  for (i = 0; i < SIMULT * HALF_ANAL_BLOCKL; i++) {
+    self->lquantile[i] = 8.f;
+    self->density[i] = 0.3f;
+  }
+
+  for (i = 0; i < SIMULT; i++) {
+    self->counter[i] =
+        (int)floor((float)(END_STARTUP_LONG * (i + 1)) / (float)SIMULT);
+  }
+
+  self->updates = 0;
+
+  // Wiener filter initialization.
+  for (i = 0; i < HALF_ANAL_BLOCKL; i++) {
+    self->smooth[i] = 1.f;
+  }
+
+  // Set the aggressiveness: default.
+  self->aggrMode = 0;
+
+  // Initialize variables for new method.
+  self->priorSpeechProb = 0.5f;  // Prior prob for speech/noise.
+  // Previous analyze mag spectrum.
+  memset(self->magnPrevAnalyze, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  // Previous process mag spectrum.
+  memset(self->magnPrevProcess, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  // Current noise-spectrum.
+  memset(self->noise, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  // Previous noise-spectrum.
+  memset(self->noisePrev, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  // Conservative noise spectrum estimate.
+  memset(self->magnAvgPause, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  // For estimation of HB in second pass.
+  memset(self->speechProb, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  // Initial average magnitude spectrum.
+  memset(self->initMagnEst, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+  for (i = 0; i < HALF_ANAL_BLOCKL; i++) {
+    // Smooth LR (same as threshold).
+    self->logLrtTimeAvg[i] = LRT_FEATURE_THR;
+  }
+
+  // Feature quantities.
+  // Spectral flatness (start on threshold).
+  self->featureData[0] = SF_FEATURE_THR;
+  self->featureData[1] = 0.f;  // Spectral entropy: not used in this version.
+  self->featureData[2] = 0.f;  // Spectral variance: not used in this version.
+  // Average LRT factor (start on threshold).
+  self->featureData[3] = LRT_FEATURE_THR;
+  // Spectral template diff (start on threshold).
+  self->featureData[4] = SF_FEATURE_THR;
+  self->featureData[5] = 0.f;  // Normalization for spectral difference.
+  // Window time-average of input magnitude spectrum.
+  self->featureData[6] = 0.f;
+
+  memset(self->parametricNoise, 0, sizeof(float) * HALF_ANAL_BLOCKL);
+
+  // Histogram quantities: used to estimate/update thresholds for features.
+  memset(self->histLrt, 0, sizeof(int) * HIST_PAR_EST);
+  memset(self->histSpecFlat, 0, sizeof(int) * HIST_PAR_EST);
+  memset(self->histSpecDiff, 0, sizeof(int) * HIST_PAR_EST);
+
+
+  self->blockInd = -1;  // Frame counter.
+  // Default threshold for LRT feature.
+  self->priorModelPars[0] = LRT_FEATURE_THR;
+  // Threshold for spectral flatness: determined on-line.
+  self->priorModelPars[1] = 0.5f;
+  // sgn_map par for spectral measure: 1 for flatness measure.
+  self->priorModelPars[2] = 1.f;
+  // Threshold for template-difference feature: determined on-line.
+  self->priorModelPars[3] = 0.5f;
+  // Default weighting parameter for LRT feature.
+  self->priorModelPars[4] = 1.f;
+  // Default weighting parameter for spectral flatness feature.
+  self->priorModelPars[5] = 0.f;
+  // Default weighting parameter for spectral difference feature.
+  self->priorModelPars[6] = 0.f;
+
+  // Update flag for parameters:
+  // 0 no update, 1 = update once, 2 = update every window.
+  self->modelUpdatePars[0] = 2;
+  self->modelUpdatePars[1] = 500;  // Window for update.
+  // Counter for update of conservative noise spectrum.
+  self->modelUpdatePars[2] = 0;
+  // Counter if the feature thresholds are updated during the sequence.
+  self->modelUpdatePars[3] = self->modelUpdatePars[1];
+
+  self->signalEnergy = 0.0;
+  self->sumMagn = 0.0;
+  self->whiteNoiseLevel = 0.0;
+  self->pinkNoiseNumerator = 0.0;
+  self->pinkNoiseExp = 0.0;
+
+  set_feature_extraction_parameters(self);
+
+  // Default mode.
+  WebRtcNs_set_policy_core(self, 0);
+
+  // Initialize function pointers.
+  WebRtcNs_NoiseEstimation = WebRtcNs_NoiseEstimationC;
+  WebRtcNs_ComputeSpectralFlatness = WebRtcNs_ComputeSpectralFlatnessC;
+  WebRtcNs_ComputeSnr = WebRtcNs_ComputeSnrC;
+  WebRtcNs_UpdateLogLrtTimeAvg = WebRtcNs_UpdateLogLrtTimeAvgC;
+  WebRtcNs_ComputeSpeechProb = WebRtcNs_ComputeSpeechProbC;
+  WebRtcNs_ComputeDdBasedWienerFilter = WebRtcNs_ComputeDdBasedWienerFilterC;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtcNs_InitSSE2();
+  }
+#endif
+
+  self->initFlag = 1;
+  return 0;
+}
+
+// Changes the aggressiveness of the noise suppression method.
+// |mode| = 0 is mild (6dB), |mode| = 1 is medium (10dB) and |mode| = 2 is
+// aggressive (15dB).
+// Returns 0 on success and -1 otherwise.
+int WebRtcNs_set_policy_core(NoiseSuppressionC* self, int mode) {
+  // Allow for modes: 0, 1, 2, 3.
+  if (mode < 0 || mode > 3) {
+    return (-1);
+  }
+
+  self->aggrMode = mode;
+  if (mode == 0) {
+    self->overdrive = 1.f;
+    self->denoiseBound = 0.5f;
+    self->gainmap = 0;
+  } else if (mode == 1) {
+    // self->overdrive = 1.25f;
+    self->overdrive = 1.f;
+    self->denoiseBound = 0.25f;
     self->gainmap = 1;
   } else if (mode == 2) {
     // self->overdrive = 1.25f;
@@ -1043,18 +1101,20 @@ int WebRtcNs_set_policy_core(NoiseSuppressionC* self, int mode) {
   return 0;
 }
 
-void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
+// Updates the noise estimate and the speech probability with the spectrum of
+// the analyzed frame, which is not modified.
+static void AnalyzeSpectrum(NoiseSuppressionC* self,
+                            const float* real,
+                            const float* imag,
+                            float* magn) {
   size_t i;
   const size_t kStartBand = 5;  // Skip first frequency bins during estimation.
   int updateParsFlag;
-  float energy;
   float signalEnergy = 0.f;
   float sumMagn = 0.f;
   float tmpFloat1, tmpFloat2, tmpFloat3;
-  float winData[ANAL_BLOCKL_MAX];
-  float magn[HALF_ANAL_BLOCKL], noise[HALF_ANAL_BLOCKL];
+  float noise[HALF_ANAL_BLOCKL];
   float snrLocPost[HALF_ANAL_BLOCKL], snrLocPrior[HALF_ANAL_BLOCKL];
-  float real[ANAL_BLOCKL_MAX], imag[HALF_ANAL_BLOCKL];
   // Variables during startup.
   float sum_log_i = 0.0;
   float sum_log_i_square = 0.0;
@@ -1063,32 +1123,8 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   float parametric_exp = 0.0;
   float parametric_num = 0.0;
 
-  // Check that initiation has been done.
-  RTC_DCHECK_EQ(1, self->initFlag);
   updateParsFlag = self->modelUpdatePars[0];
 
-  // Update analysis buffer for L band.
-  UpdateBuffer(speechFrame, self->blockLen, self->anaLen, self->analyzeBuf);
-
-  Windowing(self->window, self->analyzeBuf, self->anaLen, winData);
-  energy = Energy(winData, self->anaLen);
-  if (energy == 0.0) {
-    // We want to avoid updating statistics in this case:
-    // Updating feature statistics when we have zeros only will cause
-    // thresholds to move towards zero signal situations. This in turn has the
-    // effect that once the signal is "turned on" (non-zero values) everything
-    // will be treated as speech and there is no noise suppression effect.
-    // Depending on the duration of the inactive signal it takes a
-    // considerable amount of time for the system to learn what is noise and
-    // what is speech.
-    self->signalEnergy = 0;
-    return;
-  }
-
-  self->blockInd++;  // Update the block index only when we process a block.
-
-  FFT(self, winData, self->anaLen, self->magnLen, real, imag, magn);
-
   for (i = 0; i < self->magnLen; i++) {
     signalEnergy += real[i] * real[i] + imag[i] * imag[i];
     sumMagn += magn[i];
@@ -1108,7 +1144,7 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   self->sumMagn = sumMagn;
 
   // Quantile noise estimate.
-  NoiseEstimation(self, magn, noise);
+  WebRtcNs_NoiseEstimation(self, magn, noise);
   // Compute simplified noise model during startup.
   if (self->blockInd < END_STARTUP_SHORT) {
     // Estimate White noise.
@@ -1173,7 +1209,7 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   }
 
   // Post and prior SNR needed for SpeechNoiseProb.
-  ComputeSnr(self, magn, noise, snrLocPrior, snrLocPost);
+  WebRtcNs_ComputeSnr(self, magn, noise, snrLocPrior, snrLocPost);
 
   FeatureUpdate(self, magn, updateParsFlag);
   SpeechNoiseProb(self, self->speechProb, snrLocPrior, snrLocPost);
@@ -1184,20 +1220,107 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   memcpy(self->magnPrevAnalyze, magn, sizeof(*magn) * self->magnLen);
 }
 
-void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
-                          const float* const* speechFrame,
-                          size_t num_bands,
-                          float* const* outFrame) {
-  // Main routine for noise reduction.
+void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
+  float energy;
+  float winData[ANAL_BLOCKL_MAX];
+  float magn[HALF_ANAL_BLOCKL];
+  float real[ANAL_BLOCKL_MAX], imag[HALF_ANAL_BLOCKL];
+
+  // Check that initiation has been done.
+  RTC_DCHECK_EQ(1, self->initFlag);
+
+  // Update analysis buffer for L band.
+  UpdateBuffer(speechFrame, self->blockLen, self->anaLen, self->analyzeBuf);
+
+  Windowing(self->window, self->analyzeBuf, self->anaLen, winData);
+  energy = Energy(winData, self->anaLen);
+  if (energy == 0.0) {
+    // We want to avoid updating statistics in this case:
+    // Updating feature statistics when we have zeros only will cause
+    // thresholds to move towards zero signal situations. This in turn has the
+    // effect that once the signal is "turned on" (non-zero values) everything
+    // will be treated as speech and there is no noise suppression effect.
+    // Depending on the duration of the inactive signal it takes a
+    // considerable amount of time for the system to learn what is noise and
+    // what is speech.
+    self->signalEnergy = 0;
+    return;
+  }
+
+  self->blockInd++;  // Update the block index only when we process a block.
+
+  FFT(self, winData, self->anaLen, self->magnLen, real, imag, magn);
+  AnalyzeSpectrum(self, real, imag, magn);
+}
+
+// Updates the buffers of all bands with |speechFrame| and windows the one of
+// the L band into |winData|. Returns the energy of |winData|.
+static float UpdateProcessBuffers(NoiseSuppressionC* self,
+                                  const float* const* speechFrame,
+                                  size_t num_bands,
+                                  float* winData) {
+  size_t i;
+
+  // Update analysis buffer for L band.
+  UpdateBuffer(speechFrame[0], self->blockLen, self->anaLen, self->dataBuf);
+
+  // Update analysis buffer for H bands.
+  for (i = 1; i < num_bands; ++i) {
+    UpdateBuffer(speechFrame[i],
+                 self->blockLen,
+                 self->anaLen,
+                 self->dataBufHB[i - 1]);
+  }
+
+  Windowing(self->window, self->dataBuf, self->anaLen, winData);
+  return Energy(winData, self->anaLen);
+}
+
+// Synthesizes the special case of zero input.
+static void ProcessZeroFrame(NoiseSuppressionC* self,
+                             size_t num_bands,
+                             float* const* outFrame) {
+  float fout[BLOCKL_MAX];
+  size_t i, j;
+
+  // Read out fully processed segment.
+  for (i = self->windShift; i < self->blockLen + self->windShift; i++) {
+    fout[i - self->windShift] = self->syntBuf[i];
+  }
+  // Update synthesis buffer.
+  UpdateBuffer(NULL, self->blockLen, self->anaLen, self->syntBuf);
+
+  for (i = 0; i < self->blockLen; ++i)
+    outFrame[0][i] =
+        WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX, fout[i], WEBRTC_SPL_WORD16_MIN);
+
+  // For time-domain gain of HB.
+  for (i = 1; i < num_bands; ++i) {
+    for (j = 0; j < self->blockLen; ++j) {
+      outFrame[i][j] = WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX,
+                                      self->dataBufHB[i - 1][j],
+                                      WEBRTC_SPL_WORD16_MIN);
+    }
+  }
+}
+
+// Suppresses the noise in the spectrum |real|, |imag| and |magn| of the
+// windowed L band frame, which has the energy |energy1|, and applies the
+// corresponding gain to the H bands. |winData| is used as scratch.
+static void ProcessSpectrum(NoiseSuppressionC* self,
+                            size_t num_bands,
+                            float* const* outFrame,
+                            float energy1,
+                            float* winData,
+                            float* real,
+                            float* imag,
+                            float* magn) {
   int flagHB = 0;
   size_t i, j;
 
-  float energy1, energy2, gain, factor, factor1, factor2;
+  float energy2, gain, factor, factor1, factor2;
   float fout[BLOCKL_MAX];
-  float winData[ANAL_BLOCKL_MAX];
-  float magn[HALF_ANAL_BLOCKL];
   float theFilter[HALF_ANAL_BLOCKL], theFilterTmp[HALF_ANAL_BLOCKL];
-  float real[ANAL_BLOCKL_MAX], imag[HALF_ANAL_BLOCKL];
 
   // SWB variables.
   int deltaBweHB = 1;
@@ -1208,15 +1331,9 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
   float avgProbSpeechHB, avgProbSpeechHBTmp, avgFilterGainHB, gainModHB;
   float sumMagnAnalyze, sumMagnProcess;
 
-  // Check that initiation has been done.
-  RTC_DCHECK_EQ(1, self->initFlag);
-  RTC_DCHECK_LE(num_bands - 1, NUM_HIGH_BANDS_MAX);
-
-  const float* const* speechFrameHB = NULL;
   float* const* outFrameHB = NULL;
   size_t num_high_bands = 0;
   if (num_bands > 1) {
-    speechFrameHB = &speechFrame[1];
     outFrameHB = &outFrame[1];
     num_high_bands = num_bands - 1;
     flagHB = 1;
@@ -1225,57 +1342,13 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
     deltaGainHB = deltaBweHB;
   }
 
-  // Update analysis buffer for L band.
-  UpdateBuffer(speechFrame[0], self->blockLen, self->anaLen, self->dataBuf);
-
-  if (flagHB == 1) {
-    // Update analysis buffer for H bands.
-    for (i = 0; i < num_high_bands; ++i) {
-      UpdateBuffer(speechFrameHB[i],
-                   self->blockLen,
-                   self->anaLen,
-                   self->dataBufHB[i]);
-    }
-  }
-
-  Windowing(self->window, self->dataBuf, self->anaLen, winData);
-  energy1 = Energy(winData, self->anaLen);
-  if (energy1 == 0.0 || self->signalEnergy == 0) {
-    // Synthesize the special case of zero input.
-    // Read out fully processed segment.
-    for (i = self->windShift; i < self->blockLen + self->windShift; i++) {
-      fout[i - self->windShift] = self->syntBuf[i];
-    }
-    // Update synthesis buffer.
-    UpdateBuffer(NULL, self->blockLen, self->anaLen, self->syntBuf);
-
-    for (i = 0; i < self->blockLen; ++i)
-      outFrame[0][i] =
-          WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX, fout[i], WEBRTC_SPL_WORD16_MIN);
-
-    // For time-domain gain of HB.
-    if (flagHB == 1) {
-      for (i = 0; i < num_high_bands; ++i) {
-        for (j = 0; j < self->blockLen; ++j) {
-          outFrameHB[i][j] = WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX,
-                                            self->dataBufHB[i][j],
-                                            WEBRTC_SPL_WORD16_MIN);
-        }
-      }
-    }
-
-    return;
-  }
-
-  FFT(self, winData, self->anaLen, self->magnLen, real, imag, magn);
-
   if (self->blockInd < END_STARTUP_SHORT) {
     for (i = 0; i < self->magnLen; i++) {
       self->initMagnEst[i] += magn[i];
     }
   }
 
-  ComputeDdBasedWienerFilter(self, magn, theFilter);
+  WebRtcNs_ComputeDdBasedWienerFilter(self, magn, theFilter);
 
   for (i = 0; i < self->magnLen; i++) {
     // Flooring bottom.
@@ -1418,3 +1491,64 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
     }
   }  // End of H band gain computation.
 }
+
+void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
+                          const float* const* speechFrame,
+                          size_t num_bands,
+                          float* const* outFrame) {
+  // Main routine for noise reduction.
+  float energy1;
+  float winData[ANAL_BLOCKL_MAX];
+  float magn[HALF_ANAL_BLOCKL];
+  float real[ANAL_BLOCKL_MAX], imag[HALF_ANAL_BLOCKL];
+
+  // Check that initiation has been done.
+  RTC_DCHECK_EQ(1, self->initFlag);
+  RTC_DCHECK_LE(num_bands - 1, NUM_HIGH_BANDS_MAX);
+
+  energy1 = UpdateProcessBuffers(self, speechFrame, num_bands, winData);
+  if (energy1 == 0.0 || self->signalEnergy == 0) {
+    ProcessZeroFrame(self, num_bands, outFrame);
+    return;
+  }
+
+  FFT(self, winData, self->anaLen, self->magnLen, real, imag, magn);
+  ProcessSpectrum(self, num_bands, outFrame, energy1, winData, real, imag,
+                  magn);
+}
+
+void WebRtcNs_AnalyzeAndProcessCore(NoiseSuppressionC* self,
+                                    const float* const* speechFrame,
+                                    size_t num_bands,
+                                    float* const* outFrame) {
+  float energy;
+  float winData[ANAL_BLOCKL_MAX];
+  float magn[HALF_ANAL_BLOCKL];
+  float real[ANAL_BLOCKL_MAX], imag[HALF_ANAL_BLOCKL];
+
+  // Check that initiation has been done.
+  RTC_DCHECK_EQ(1, self->initFlag);
+  RTC_DCHECK_LE(num_bands - 1, NUM_HIGH_BANDS_MAX);
+
+  // The analysis and the processing buffers hold the same frames, so that
+  // the windowed frame and its spectrum serve both.
+  UpdateBuffer(speechFrame[0], self->blockLen, self->anaLen, self->analyzeBuf);
+  energy = UpdateProcessBuffers(self, speechFrame, num_bands, winData);
+  if (energy == 0.0) {
+    // See WebRtcNs_AnalyzeCore().
+    self->signalEnergy = 0;
+    ProcessZeroFrame(self, num_bands, outFrame);
+    return;
+  }
+
+  self->blockInd++;  // Update the block index only when we process a block.
+
+  FFT(self, winData, self->anaLen, self->magnLen, real, imag, magn);
+  AnalyzeSpectrum(self, real, imag, magn);
+  if (self->signalEnergy == 0) {
+    ProcessZeroFrame(self, num_bands, outFrame);
+    return;
+  }
+  ProcessSpectrum(self, num_bands, outFrame, energy, winData, real, imag,
+                  magn);
+}
@@ -11,7 +11,12 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/rdft_plan.h"
 #include "modules/audio_processing/ns/defines.h"
+#include "rtc_base/system/arch.h"
 
 typedef struct NSParaExtract_ {
   // Bin size of histogram.
@@ -73,9 +78,8 @@ typedef struct NoiseSuppressionC_ {
   float overdrive;
   float denoiseBound;
   int gainmap;
-  // FFT work arrays.
-  size_t ip[IP_LENGTH];
-  float wfft[W_LENGTH];
+  // FFT plan, shared with all instances of the same analysis length.
+  const RdftPlan* fftPlan;
 
   // Parameters for new method: some not needed, will reduce/cleanup later.
   int32_t blockInd;        // Frame index counter.
@@ -183,6 +187,119 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
                           size_t num_bands,
                           float* const* outFrame);
 
+/****************************************************************************
+ * WebRtcNs_AnalyzeAndProcessCore
+ *
+ * Estimate the background noise and do noise suppression, like
+ * WebRtcNs_AnalyzeCore() followed by WebRtcNs_ProcessCore() with the same L
+ * band frame, with one transform of the frame.
+ *
+ * Input:
+ *      - self          : Instance that should be initialized
+ *      - inFrame       : Input speech frame for each band
+ *      - num_bands     : Number of bands
+ *
+ * Output:
+ *      - self          : Updated instance
+ *      - outFrame      : Output speech frame for each band
+ */
+void WebRtcNs_AnalyzeAndProcessCore(NoiseSuppressionC* self,
+                                    const float* const* inFrame,
+                                    size_t num_bands,
+                                    float* const* outFrame);
+
+/****************************************************************************
+ * Some function pointers, for internal per-frequency loops shared by SSE2 and
+ * generic C code.
+ */
+// Quantile noise estimation.
+typedef void (*NoiseEstimation)(NoiseSuppressionC* self,
+                                float* magn,
+                                float* noise);
+extern NoiseEstimation WebRtcNs_NoiseEstimation;
+
+// Compute spectral flatness on input spectrum, and update the feature in
+// self->featureData[0].
+typedef void (*ComputeSpectralFlatness)(NoiseSuppressionC* self,
+                                        const float* magnIn);
+extern ComputeSpectralFlatness WebRtcNs_ComputeSpectralFlatness;
+
+// Compute prior and post SNR based on quantile noise estimation.
+typedef void (*ComputeSnr)(const NoiseSuppressionC* self,
+                           const float* magn,
+                           const float* noise,
+                           float* snrLocPrior,
+                           float* snrLocPost);
+extern ComputeSnr WebRtcNs_ComputeSnr;
+
+// Update the time-smoothed log LRT factor of every frequency, and return the
+// sum over all frequencies.
+typedef float (*UpdateLogLrtTimeAvg)(NoiseSuppressionC* self,
+                                     const float* snrLocPrior,
+                                     const float* snrLocPost);
+extern UpdateLogLrtTimeAvg WebRtcNs_UpdateLogLrtTimeAvg;
+
+// Combine the prior speech model with the LR factor of every frequency to the
+// final speech probability.
+typedef void (*ComputeSpeechProb)(const NoiseSuppressionC* self,
+                                  float gainPrior,
+                                  float* probSpeechFinal);
+extern ComputeSpeechProb WebRtcNs_ComputeSpeechProb;
+
+// Estimate prior SNR decision-directed and compute DD based Wiener Filter.
+typedef void (*ComputeDdBasedWienerFilter)(const NoiseSuppressionC* self,
+                                           const float* magn,
+                                           float* theFilter);
+extern ComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+// For the above function pointers, functions for generic platforms are declared
+// below and defined in file ns_core.c.
+void WebRtcNs_NoiseEstimationC(NoiseSuppressionC* self,
+                               float* magn,
+                               float* noise);
+void WebRtcNs_ComputeSpectralFlatnessC(NoiseSuppressionC* self,
+                                       const float* magnIn);
+void WebRtcNs_ComputeSnrC(const NoiseSuppressionC* self,
+                          const float* magn,
+                          const float* noise,
+                          float* snrLocPrior,
+                          float* snrLocPost);
+float WebRtcNs_UpdateLogLrtTimeAvgC(NoiseSuppressionC* self,
+                                    const float* snrLocPrior,
+                                    const float* snrLocPost);
+void WebRtcNs_ComputeSpeechProbC(const NoiseSuppressionC* self,
+                                 float gainPrior,
+                                 float* probSpeechFinal);
+void WebRtcNs_ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                          const float* magn,
+                                          float* theFilter);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Those for x86 platforms with SSE2 are declared below and defined in file
+// ns_core_sse2.c. The logarithms and exponentials of the SSE2 functions are
+// polynomial approximations, with an error of about one unit in the last
+// place, so their results deviate slightly from those of the C functions.
+void WebRtcNs_NoiseEstimationSSE2(NoiseSuppressionC* self,
+                                  float* magn,
+                                  float* noise);
+void WebRtcNs_ComputeSpectralFlatnessSSE2(NoiseSuppressionC* self,
+                                          const float* magnIn);
+void WebRtcNs_ComputeSnrSSE2(const NoiseSuppressionC* self,
+                             const float* magn,
+                             const float* noise,
+                             float* snrLocPrior,
+                             float* snrLocPost);
+float WebRtcNs_UpdateLogLrtTimeAvgSSE2(NoiseSuppressionC* self,
+                                       const float* snrLocPrior,
+                                       const float* snrLocPost);
+void WebRtcNs_ComputeSpeechProbSSE2(const NoiseSuppressionC* self,
+                                    float gainPrior,
+                                    float* probSpeechFinal);
+void WebRtcNs_ComputeDdBasedWienerFilterSSE2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,425 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* This file contains the per-frequency loops of the noise suppressor for x86
+ * platforms with SSE2. API's are in ns_core.h. Apart from the logarithms and
+ * exponentials, which are polynomial approximations here, and the order of
+ * the summations, results are bit exact with the c code for generic platforms.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include "modules/audio_processing/ns/ns_core.h"
+
+// Natural logarithm of the four positive, normal values of |x|. The mantissa
+// is reduced to [sqrt(0.5), sqrt(2)) and the logarithm of it is approximated
+// by a polynomial of degree 9 (Cephes logf).
+static __m128 LogSSE2(__m128 x) {
+  const __m128 kMinNormPos = _mm_castsi128_ps(_mm_set1_epi32(0x00800000));
+  const __m128 kInvMantMask = _mm_castsi128_ps(_mm_set1_epi32(~0x7f800000));
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  __m128i exponent;
+  __m128 e, mask, z, y, tmp;
+
+  x = _mm_max_ps(x, kMinNormPos);
+  exponent = _mm_srli_epi32(_mm_castps_si128(x), 23);
+  // Keep the mantissa in [0.5, 1).
+  x = _mm_or_ps(_mm_and_ps(x, kInvMantMask), kHalf);
+  exponent = _mm_sub_epi32(exponent, _mm_set1_epi32(0x7f));
+  e = _mm_add_ps(_mm_cvtepi32_ps(exponent), kOne);
+
+  // If the mantissa is below sqrt(0.5), double it and decrement the exponent.
+  mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+  tmp = _mm_and_ps(x, mask);
+  x = _mm_sub_ps(x, kOne);
+  e = _mm_sub_ps(e, _mm_and_ps(kOne, mask));
+  x = _mm_add_ps(x, tmp);
+
+  z = _mm_mul_ps(x, x);
+  y = _mm_set1_ps(7.0376836292e-2f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+  y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+  // Add the exponent times log(2), split in two parts for accuracy.
+  y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+  y = _mm_sub_ps(y, _mm_mul_ps(z, kHalf));
+  x = _mm_add_ps(x, y);
+  return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
+
+// Exponential of the four values of |x|, which are limited to +-88.376. The
+// argument is reduced to [-log(2) / 2, log(2) / 2] and the exponential of it is
+// approximated by a polynomial of degree 7 (Cephes expf).
+static __m128 ExpSSE2(__m128 x) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  __m128i exponent;
+  __m128 fx, tmp, mask, z, y;
+
+  x = _mm_min_ps(x, _mm_set1_ps(88.3762626647949f));
+  x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+  // Round x / log(2) to the nearest integer |fx|.
+  fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)),
+                  _mm_set1_ps(0.5f));
+  tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+  mask = _mm_and_ps(_mm_cmpgt_ps(tmp, fx), kOne);
+  fx = _mm_sub_ps(tmp, mask);
+
+  // Subtract fx * log(2), split in two parts for accuracy.
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+  x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+  z = _mm_mul_ps(x, x);
+  y = _mm_set1_ps(1.9875691500e-4f);
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+  y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+  y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), kOne);
+
+  // Scale by 2^fx.
+  exponent = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f));
+  exponent = _mm_slli_epi32(exponent, 23);
+  return _mm_mul_ps(y, _mm_castsi128_ps(exponent));
+}
+
+static float LogScalarSSE2(float x) {
+  return _mm_cvtss_f32(LogSSE2(_mm_set1_ps(x)));
+}
+
+static float ExpScalarSSE2(float x) {
+  return _mm_cvtss_f32(ExpSSE2(_mm_set1_ps(x)));
+}
+
+static float HorizontalSumSSE2(__m128 sum) {
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+}
+
+void WebRtcNs_NoiseEstimationSSE2(NoiseSuppressionC* self,
+                                  float* magn,
+                                  float* noise) {
+  const float kDensityUpdate = 1.f / (2.f * WIDTH);
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kFactor = _mm_set1_ps(FACTOR);
+  const __m128 kQuantile = _mm_set1_ps(QUANTILE);
+  const __m128 kOneMinusQuantile = _mm_set1_ps(1.f - QUANTILE);
+  const __m128 kWidth = _mm_set1_ps(WIDTH);
+  const __m128 kAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  size_t i, s, offset = 0;
+  float lmagn[HALF_ANAL_BLOCKL], delta;
+
+  if (self->updates < END_STARTUP_LONG) {
+    self->updates++;
+  }
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    _mm_storeu_ps(&lmagn[i], LogSSE2(_mm_loadu_ps(&magn[i])));
+  }
+  for (; i < self->magnLen; i++) {
+    lmagn[i] = LogScalarSSE2(magn[i]);
+  }
+
+  // Loop over simultaneous estimates.
+  for (s = 0; s < SIMULT; s++) {
+    const float counter = (float)self->counter[s];
+    const float counter_plus_one = (float)(self->counter[s] + 1);
+    const __m128 counter_v = _mm_set1_ps(counter);
+    const __m128 counter_plus_one_v = _mm_set1_ps(counter_plus_one);
+    const __m128 density_update_v = _mm_set1_ps(kDensityUpdate);
+    float* lquantile = &self->lquantile[s * self->magnLen];
+    float* density = &self->density[s * self->magnLen];
+    offset = s * self->magnLen;
+
+    for (i = 0; i + 4 <= self->magnLen; i += 4) {
+      const __m128 lmagn_v = _mm_loadu_ps(&lmagn[i]);
+      __m128 lquantile_v = _mm_loadu_ps(&lquantile[i]);
+      __m128 density_v = _mm_loadu_ps(&density[i]);
+      __m128 mask, delta_v, up, down;
+
+      // Compute delta.
+      mask = _mm_cmpgt_ps(density_v, kOne);
+      delta_v = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(kFactor, density_v)),
+                          _mm_andnot_ps(mask, kFactor));
+
+      // Update log quantile estimate.
+      up = _mm_add_ps(lquantile_v,
+                      _mm_div_ps(_mm_mul_ps(kQuantile, delta_v),
+                                 counter_plus_one_v));
+      down = _mm_sub_ps(lquantile_v,
+                        _mm_div_ps(_mm_mul_ps(kOneMinusQuantile, delta_v),
+                                   counter_plus_one_v));
+      mask = _mm_cmpgt_ps(lmagn_v, lquantile_v);
+      lquantile_v = _mm_or_ps(_mm_and_ps(mask, up), _mm_andnot_ps(mask, down));
+      _mm_storeu_ps(&lquantile[i], lquantile_v);
+
+      // Update density estimate.
+      mask = _mm_cmplt_ps(
+          _mm_and_ps(_mm_sub_ps(lmagn_v, lquantile_v), kAbsMask), kWidth);
+      density_v = _mm_or_ps(
+          _mm_and_ps(mask,
+                     _mm_div_ps(_mm_add_ps(_mm_mul_ps(counter_v, density_v),
+                                           density_update_v),
+                                counter_plus_one_v)),
+          _mm_andnot_ps(mask, density_v));
+      _mm_storeu_ps(&density[i], density_v);
+    }
+    for (; i < self->magnLen; i++) {
+      // Compute delta.
+      if (density[i] > 1.0) {
+        delta = FACTOR * 1.f / density[i];
+      } else {
+        delta = FACTOR;
+      }
+
+      // Update log quantile estimate.
+      if (lmagn[i] > lquantile[i]) {
+        lquantile[i] += QUANTILE * delta / counter_plus_one;
+      } else {
+        lquantile[i] -= (1.f - QUANTILE) * delta / counter_plus_one;
+      }
+
+      // Update density estimate.
+      if (fabsf(lmagn[i] - lquantile[i]) < WIDTH) {
+        density[i] = (counter * density[i] + kDensityUpdate) / counter_plus_one;
+      }
+    }  // End loop over magnitude spectrum.
+
+    if (self->counter[s] >= END_STARTUP_LONG) {
+      self->counter[s] = 0;
+      if (self->updates >= END_STARTUP_LONG) {
+        for (i = 0; i + 4 <= self->magnLen; i += 4) {
+          _mm_storeu_ps(&self->quantile[i],
+                        ExpSSE2(_mm_loadu_ps(&lquantile[i])));
+        }
+        for (; i < self->magnLen; i++) {
+          self->quantile[i] = ExpScalarSSE2(lquantile[i]);
+        }
+      }
+    }
+
+    self->counter[s]++;
+  }  // End loop over simultaneous estimates.
+
+  // Sequentially update the noise during startup.
+  if (self->updates < END_STARTUP_LONG) {
+    // Use the last "s" to get noise during startup that differ from zero.
+    for (i = 0; i + 4 <= self->magnLen; i += 4) {
+      _mm_storeu_ps(&self->quantile[i],
+                    ExpSSE2(_mm_loadu_ps(&self->lquantile[offset + i])));
+    }
+    for (; i < self->magnLen; i++) {
+      self->quantile[i] = ExpScalarSSE2(self->lquantile[offset + i]);
+    }
+  }
+
+  for (i = 0; i < self->magnLen; i++) {
+    noise[i] = self->quantile[i];
+  }
+}
+
+void WebRtcNs_ComputeSpectralFlatnessSSE2(NoiseSuppressionC* self,
+                                          const float* magnIn) {
+  const __m128 kZero = _mm_setzero_ps();
+  size_t i;
+  size_t shiftLP = 1;  // Option to remove first bin(s) from spectral measures.
+  float avgSpectralFlatnessNum, avgSpectralFlatnessDen, spectralTmp;
+  __m128 sum = kZero;
+  int non_positive = 0;
+
+  // Compute spectral measures.
+  // For flatness.
+  avgSpectralFlatnessDen = self->sumMagn;
+  for (i = 0; i < shiftLP; i++) {
+    avgSpectralFlatnessDen -= magnIn[i];
+  }
+  // Compute log of ratio of the geometric to arithmetic mean: check for log(0)
+  // case.
+  for (i = shiftLP; i + 4 <= self->magnLen; i += 4) {
+    const __m128 magn_v = _mm_loadu_ps(&magnIn[i]);
+    non_positive |= _mm_movemask_ps(_mm_cmple_ps(magn_v, kZero));
+    sum = _mm_add_ps(sum, LogSSE2(magn_v));
+  }
+  avgSpectralFlatnessNum = HorizontalSumSSE2(sum);
+  for (; i < self->magnLen; i++) {
+    non_positive |= magnIn[i] <= 0.0;
+    avgSpectralFlatnessNum += LogScalarSSE2(magnIn[i]);
+  }
+  if (non_positive) {
+    self->featureData[0] -= SPECT_FL_TAVG * self->featureData[0];
+    return;
+  }
+  // Normalize.
+  avgSpectralFlatnessDen = avgSpectralFlatnessDen / self->magnLen;
+  avgSpectralFlatnessNum = avgSpectralFlatnessNum / self->magnLen;
+
+  // Ratio and inverse log: check for case of log(0).
+  spectralTmp = ExpScalarSSE2(avgSpectralFlatnessNum) / avgSpectralFlatnessDen;
+
+  // Time-avg update of spectral flatness feature.
+  self->featureData[0] += SPECT_FL_TAVG * (spectralTmp - self->featureData[0]);
+  // Done with flatness feature.
+}
+
+void WebRtcNs_ComputeSnrSSE2(const NoiseSuppressionC* self,
+                             const float* magn,
+                             const float* noise,
+                             float* snrLocPrior,
+                             float* snrLocPost) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kFloor = _mm_set1_ps(0.0001f);
+  const __m128 kDdPrSnr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 kOneMinusDdPrSnr = _mm_set1_ps(1.f - DD_PR_SNR);
+  size_t i;
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 magn_v = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_v = _mm_loadu_ps(&noise[i]);
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevAnalyze[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), kFloor)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post SNR.
+    const __m128 post = _mm_and_ps(
+        _mm_cmpgt_ps(magn_v, noise_v),
+        _mm_sub_ps(_mm_div_ps(magn_v, _mm_add_ps(noise_v, kFloor)), kOne));
+    _mm_storeu_ps(&snrLocPost[i], post);
+    // DD estimate is sum of two terms: current estimate and previous estimate.
+    _mm_storeu_ps(&snrLocPrior[i],
+                  _mm_add_ps(_mm_mul_ps(kDdPrSnr, previous_estimate_stsa),
+                             _mm_mul_ps(kOneMinusDdPrSnr, post)));
+  }
+  for (; i < self->magnLen; i++) {
+    float previousEstimateStsa = self->magnPrevAnalyze[i] /
+        (self->noisePrev[i] + 0.0001f) * self->smooth[i];
+    snrLocPost[i] = 0.f;
+    if (magn[i] > noise[i]) {
+      snrLocPost[i] = magn[i] / (noise[i] + 0.0001f) - 1.f;
+    }
+    snrLocPrior[i] =
+        DD_PR_SNR * previousEstimateStsa + (1.f - DD_PR_SNR) * snrLocPost[i];
+  }
+}
+
+float WebRtcNs_UpdateLogLrtTimeAvgSSE2(NoiseSuppressionC* self,
+                                       const float* snrLocPrior,
+                                       const float* snrLocPost) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kTwo = _mm_set1_ps(2.f);
+  const __m128 kFloor = _mm_set1_ps(0.0001f);
+  const __m128 kLrtTavg = _mm_set1_ps(LRT_TAVG);
+  size_t i;
+  float logLrtTimeAvgKsum, besselTmp;
+  float tmpFloat1, tmpFloat2;
+  __m128 sum = _mm_setzero_ps();
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 prior = _mm_loadu_ps(&snrLocPrior[i]);
+    const __m128 tmp1 = _mm_add_ps(kOne, _mm_mul_ps(kTwo, prior));
+    const __m128 tmp2 =
+        _mm_div_ps(_mm_mul_ps(kTwo, prior), _mm_add_ps(tmp1, kFloor));
+    const __m128 bessel =
+        _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&snrLocPost[i]), kOne), tmp2);
+    __m128 log_lrt = _mm_loadu_ps(&self->logLrtTimeAvg[i]);
+    log_lrt = _mm_add_ps(
+        log_lrt,
+        _mm_mul_ps(kLrtTavg,
+                   _mm_sub_ps(_mm_sub_ps(bessel, LogSSE2(tmp1)), log_lrt)));
+    _mm_storeu_ps(&self->logLrtTimeAvg[i], log_lrt);
+    sum = _mm_add_ps(sum, log_lrt);
+  }
+  logLrtTimeAvgKsum = HorizontalSumSSE2(sum);
+  for (; i < self->magnLen; i++) {
+    tmpFloat1 = 1.f + 2.f * snrLocPrior[i];
+    tmpFloat2 = 2.f * snrLocPrior[i] / (tmpFloat1 + 0.0001f);
+    besselTmp = (snrLocPost[i] + 1.f) * tmpFloat2;
+    self->logLrtTimeAvg[i] += LRT_TAVG * (besselTmp - LogScalarSSE2(tmpFloat1) -
+                                          self->logLrtTimeAvg[i]);
+    logLrtTimeAvgKsum += self->logLrtTimeAvg[i];
+  }
+  return logLrtTimeAvgKsum;
+}
+
+void WebRtcNs_ComputeSpeechProbSSE2(const NoiseSuppressionC* self,
+                                    float gainPrior,
+                                    float* probSpeechFinal) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kSignMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+  const __m128 gain_prior = _mm_set1_ps(gainPrior);
+  size_t i;
+  float invLrt;
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 inv_lrt = _mm_mul_ps(
+        gain_prior,
+        ExpSSE2(_mm_xor_ps(_mm_loadu_ps(&self->logLrtTimeAvg[i]), kSignMask)));
+    _mm_storeu_ps(&probSpeechFinal[i],
+                  _mm_div_ps(kOne, _mm_add_ps(kOne, inv_lrt)));
+  }
+  for (; i < self->magnLen; i++) {
+    invLrt = gainPrior * ExpScalarSSE2(-self->logLrtTimeAvg[i]);
+    probSpeechFinal[i] = 1.f / (1.f + invLrt);
+  }
+}
+
+void WebRtcNs_ComputeDdBasedWienerFilterSSE2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter) {
+  const __m128 kOne = _mm_set1_ps(1.f);
+  const __m128 kFloor = _mm_set1_ps(0.0001f);
+  const __m128 kDdPrSnr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 kOneMinusDdPrSnr = _mm_set1_ps(1.f - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(self->overdrive);
+  size_t i;
+  float snrPrior, previousEstimateStsa, currentEstimateStsa;
+
+  for (i = 0; i + 4 <= self->magnLen; i += 4) {
+    const __m128 magn_v = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_v = _mm_loadu_ps(&self->noise[i]);
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevProcess[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), kFloor)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post and prior SNR.
+    const __m128 current_estimate_stsa = _mm_and_ps(
+        _mm_cmpgt_ps(magn_v, noise_v),
+        _mm_sub_ps(_mm_div_ps(magn_v, _mm_add_ps(noise_v, kFloor)), kOne));
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(kDdPrSnr, previous_estimate_stsa),
+                   _mm_mul_ps(kOneMinusDdPrSnr, current_estimate_stsa));
+    // Gain filter.
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  for (; i < self->magnLen; i++) {
+    previousEstimateStsa = self->magnPrevProcess[i] /
+                           (self->noisePrev[i] + 0.0001f) * self->smooth[i];
+    currentEstimateStsa = 0.f;
+    if (magn[i] > self->noise[i]) {
+      currentEstimateStsa = magn[i] / (self->noise[i] + 0.0001f) - 1.f;
+    }
+    snrPrior = DD_PR_SNR * previousEstimateStsa +
+               (1.f - DD_PR_SNR) * currentEstimateStsa;
+    theFilter[i] = snrPrior / (self->overdrive + snrPrior);
+  }
+}
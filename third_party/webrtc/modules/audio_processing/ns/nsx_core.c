@@ -17,19 +17,16 @@
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/real_fft.h"
 #include "modules/audio_processing/ns/nsx_core.h"
+#include "system_wrappers/include/cpu_features_sse2.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
-#if defined(WEBRTC_HAS_NEON)
-/* Tables are defined in ARM assembly files. */
-extern const int16_t WebRtcNsx_kLogTable[9];
-extern const int16_t WebRtcNsx_kCounterDiv[201];
-extern const int16_t WebRtcNsx_kLogTableFrac[256];
-#else
-static const int16_t WebRtcNsx_kLogTable[9] = {
+#if !defined(WEBRTC_HAS_NEON)
+/* Tables are defined in nsx_core_neon.c for ARM Neon platforms. */
+const int16_t WebRtcNsx_kLogTable[9] = {
   0, 177, 355, 532, 710, 887, 1065, 1242, 1420
 };
 
-static const int16_t WebRtcNsx_kCounterDiv[201] = {
+const int16_t WebRtcNsx_kCounterDiv[201] = {
   32767, 16384, 10923, 8192, 6554, 5461, 4681, 4096, 3641, 3277, 2979, 2731,
   2521, 2341, 2185, 2048, 1928, 1820, 1725, 1638, 1560, 1489, 1425, 1365, 1311,
   1260, 1214, 1170, 1130, 1092, 1057, 1024, 993, 964, 936, 910, 886, 862, 840,
@@ -46,7 +43,7 @@ static const int16_t WebRtcNsx_kCounterDiv[201] = {
   172, 172, 171, 170, 169, 168, 167, 166, 165, 165, 164, 163
 };
 
-static const int16_t WebRtcNsx_kLogTableFrac[256] = {
+const int16_t WebRtcNsx_kLogTableFrac[256] = {
   0,   1,   3,   4,   6,   7,   9,  10,  11,  13,  14,  16,  17,  18,  20,  21,
   22,  24,  25,  26,  28,  29,  30,  32,  33,  34,  36,  37,  38,  40,  41,  42,
   44,  45,  46,  47,  49,  50,  51,  52,  54,  55,  56,  57,  59,  60,  61,  62,
@@ -567,6 +564,18 @@ static void WebRtcNsx_InitNeon(void) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Initialize function pointers for x86 platforms with SSE2.
+static void WebRtcNsx_InitSSE2(void) {
+  WebRtcNsx_NoiseEstimation = WebRtcNsx_NoiseEstimationSSE2;
+  WebRtcNsx_PrepareSpectrum = WebRtcNsx_PrepareSpectrumSSE2;
+  WebRtcNsx_SynthesisUpdate = WebRtcNsx_SynthesisUpdateSSE2;
+  WebRtcNsx_AnalysisUpdate = WebRtcNsx_AnalysisUpdateSSE2;
+  WebRtcNsx_Denormalize = WebRtcNsx_DenormalizeSSE2;
+  WebRtcNsx_NormalizeRealBuffer = WebRtcNsx_NormalizeRealBufferSSE2;
+}
+#endif
+
 #if defined(MIPS32_LE)
 // Initialize function pointers for MIPS platform.
 static void WebRtcNsx_InitMips(void) {
@@ -766,6 +775,12 @@ int32_t WebRtcNsx_InitCore(NoiseSuppressionFixedC* inst, uint32_t fs) {
   WebRtcNsx_InitNeon();
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtcNsx_InitSSE2();
+  }
+#endif
+
 #if defined(MIPS32_LE)
   WebRtcNsx_InitMips();
 #endif
@@ -1193,6 +1208,7 @@ void WebRtcNsx_DataAnalysis(NoiseSuppressionFixedC* inst,
   int16_t   log2 = 0;
   int16_t   matrix_determinant = 0;
   int16_t   maxWinData;
+  WebRtcSpl_VectorStats winDataStats;
 
   size_t i, j;
   int zeros;
@@ -1210,14 +1226,15 @@ void WebRtcNsx_DataAnalysis(NoiseSuppressionFixedC* inst,
   // Update analysis buffer for lower band, and window data before FFT.
   WebRtcNsx_AnalysisUpdate(inst, winData, speechFrame);
 
-  // Get input energy
-  inst->energyIn =
-      WebRtcSpl_Energy(winData, inst->anaLen, &inst->scaleEnergyIn);
+  // Get input energy and the maximum absolute value of winData in one pass.
+  WebRtcSpl_GetVectorStatsW16(winData, inst->anaLen, &winDataStats);
+  inst->energyIn = winDataStats.energy;
+  inst->scaleEnergyIn = winDataStats.energy_scale;
 
   // Reset zero input flag
   inst->zeroInputSignal = 0;
   // Acquire norm for winData
-  maxWinData = WebRtcSpl_MaxAbsValueW16(winData, inst->anaLen);
+  maxWinData = winDataStats.max_abs_value;
   inst->normData = WebRtcSpl_NormW16(maxWinData);
   if (maxWinData == 0) {
     // Treat zero input separately.
@@ -17,6 +17,7 @@
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "modules/audio_processing/ns/nsx_defines.h"
+#include "rtc_base/system/arch.h"
 
 typedef struct NoiseSuppressionFixedC_ {
   uint32_t fs;
@@ -206,6 +207,11 @@ typedef void (*NormalizeRealBuffer)(NoiseSuppressionFixedC* inst,
                                     int16_t* out);
 extern NormalizeRealBuffer WebRtcNsx_NormalizeRealBuffer;
 
+// Tables shared by the generic C code and the platform specific variants.
+extern const int16_t WebRtcNsx_kLogTable[9];
+extern const int16_t WebRtcNsx_kCounterDiv[201];
+extern const int16_t WebRtcNsx_kLogTableFrac[256];
+
 // Compute speech/noise probability.
 // Intended to be private.
 void WebRtcNsx_SpeechNoiseProb(NoiseSuppressionFixedC* inst,
@@ -231,6 +237,30 @@ void WebRtcNsx_PrepareSpectrumNeon(NoiseSuppressionFixedC* inst,
                                    int16_t* freq_buff);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// For the above function pointers, functions for generic platforms are declared
+// and defined as static in file nsx_core.c, while those for x86 platforms with
+// SSE2 are declared below and defined in file nsx_core_sse2.c.
+void WebRtcNsx_NoiseEstimationSSE2(NoiseSuppressionFixedC* inst,
+                                   uint16_t* magn,
+                                   uint32_t* noise,
+                                   int16_t* q_noise);
+void WebRtcNsx_PrepareSpectrumSSE2(NoiseSuppressionFixedC* inst,
+                                   int16_t* freq_buff);
+void WebRtcNsx_SynthesisUpdateSSE2(NoiseSuppressionFixedC* inst,
+                                   int16_t* out_frame,
+                                   int16_t gain_factor);
+void WebRtcNsx_AnalysisUpdateSSE2(NoiseSuppressionFixedC* inst,
+                                  int16_t* out,
+                                  int16_t* new_speech);
+void WebRtcNsx_DenormalizeSSE2(NoiseSuppressionFixedC* inst,
+                               int16_t* in,
+                               int factor);
+void WebRtcNsx_NormalizeRealBufferSSE2(NoiseSuppressionFixedC* inst,
+                                       const int16_t* in,
+                                       int16_t* out);
+#endif
+
 #if defined(MIPS32_LE)
 // For the above function pointers, functions for generic platforms are declared
 // and defined as static in file nsx_core.c, while those for MIPS platforms
@@ -0,0 +1,455 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* This file contains the SSE2 variants of the function pointers in
+ * nsx_core.h, for x86 platforms. Results are bit exact with the c code for
+ * generic platforms.
+ */
+
+#include "modules/audio_processing/ns/nsx_core.h"
+
+#include <emmintrin.h>
+#include <string.h>
+
+#include "rtc_base/checks.h"
+
+// Returns the low 16 bits of (a * b) >> |shift| of the eight 16-bit lanes,
+// with the products in 32 bits and 0 < |shift| < 16.
+static __m128i MulShiftRightW16(__m128i a, __m128i b, int shift) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  const __m128i high = _mm_mulhi_epi16(a, b);
+  return _mm_or_si128(_mm_srli_epi16(low, shift),
+                      _mm_slli_epi16(high, 16 - shift));
+}
+
+// Returns (a * b + (1 << (|shift| - 1))) >> |shift| of the eight 16-bit lanes
+// as in WEBRTC_SPL_MUL_16_16_RSFT_WITH_ROUND(), truncated to 16 bits.
+static __m128i MulShiftRightRoundW16(__m128i a, __m128i b, int shift) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  const __m128i high = _mm_mulhi_epi16(a, b);
+  const __m128i round = _mm_set1_epi32(1 << (shift - 1));
+  __m128i lo32 = _mm_unpacklo_epi16(low, high);
+  __m128i hi32 = _mm_unpackhi_epi16(low, high);
+  lo32 = _mm_srai_epi32(_mm_add_epi32(lo32, round), shift);
+  hi32 = _mm_srai_epi32(_mm_add_epi32(hi32, round), shift);
+  // Sign extend the low 16 bits, so that the saturating pack truncates.
+  lo32 = _mm_srai_epi32(_mm_slli_epi32(lo32, 16), 16);
+  hi32 = _mm_srai_epi32(_mm_slli_epi32(hi32, 16), 16);
+  return _mm_packs_epi32(lo32, hi32);
+}
+
+// Update the noise estimation information.
+static void UpdateNoiseEstimateSSE2(NoiseSuppressionFixedC* inst, int offset) {
+  const int16_t kExp2Const = 11819; // Q13
+  const __m128i kExp2Const16x8 = _mm_set1_epi16(kExp2Const);
+  const __m128i kFracMask = _mm_set1_epi32(0x001FFFFF);
+  const __m128i kOne = _mm_set1_epi32(0x00200000);
+  int16_t* log_quantile = &inst->noiseEstLogQuantile[offset];
+  int32_t tmp32no1 = 0;
+  int32_t tmp32no2 = 0;
+  int16_t tmp16 = 0;
+  size_t i = 0;
+  __m128i shift_offset;
+
+  tmp16 = WebRtcSpl_MaxValueW16(log_quantile, inst->magnLen);
+  // Guarantee a Q-domain as high as possible and still fit in int16
+  inst->qNoise = 14 - (int) WEBRTC_SPL_MUL_16_16_RSFT_WITH_ROUND(
+                   kExp2Const, tmp16, 21);
+  shift_offset = _mm_set1_epi32(inst->qNoise - 21);
+
+  // The shift of the C code, left or right by a different amount in every
+  // lane, is a multiplication with 2^shift in float, which is exact for the
+  // 22-bit values. Shifts right by more than 21 bits give zero, also those by
+  // more than 31 bits, which are undefined in the C code, as in the Neon code.
+  for (i = 0; i + 8 <= inst->magnLen; i += 8) {
+    const __m128i log_quantile16x8 =
+        _mm_loadu_si128((const __m128i*)&log_quantile[i]);
+    const __m128i low = _mm_mullo_epi16(log_quantile16x8, kExp2Const16x8);
+    const __m128i high = _mm_mulhi_epi16(log_quantile16x8, kExp2Const16x8);
+    __m128i quantile[2];
+    int k;
+
+    quantile[0] = _mm_unpacklo_epi16(low, high);
+    quantile[1] = _mm_unpackhi_epi16(low, high);
+    for (k = 0; k < 2; k++) {
+      // 2^21 + frac
+      const __m128i value =
+          _mm_or_si128(_mm_and_si128(quantile[k], kFracMask), kOne);
+      // Shift 21 to get result in Q0, then to get result in Q(qNoise).
+      __m128i shift = _mm_add_epi32(_mm_srai_epi32(quantile[k], 21),
+                                    shift_offset);
+      __m128 scaled;
+      // The shifts fit in 16 bits, so that the 16-bit min and max limit them
+      // to the exponent range of float.
+      shift = _mm_min_epi16(_mm_max_epi16(shift, _mm_set1_epi32(-126)),
+                            _mm_set1_epi32(127));
+      scaled = _mm_mul_ps(
+          _mm_cvtepi32_ps(value),
+          _mm_castsi128_ps(_mm_slli_epi32(
+              _mm_add_epi32(shift, _mm_set1_epi32(127)), 23)));
+      scaled = _mm_min_ps(scaled, _mm_set1_ps(32767.f));
+      quantile[k] = _mm_cvttps_epi32(scaled);
+    }
+    _mm_storeu_si128((__m128i*)&inst->noiseEstQuantile[i],
+                     _mm_packs_epi32(quantile[0], quantile[1]));
+  }
+
+  for (; i < inst->magnLen; i++) {
+    // inst->quantile[i]=exp(inst->lquantile[offset+i]);
+    // in Q21
+    tmp32no2 = kExp2Const * log_quantile[i];
+    tmp32no1 = (0x00200000 | (tmp32no2 & 0x001FFFFF)); // 2^21 + frac
+    tmp16 = (int16_t)(tmp32no2 >> 21);
+    tmp16 -= 21;// shift 21 to get result in Q0
+    tmp16 += (int16_t) inst->qNoise; //shift to get result in Q(qNoise)
+    if (tmp16 < 0) {
+      tmp32no1 >>= -tmp16;
+    } else {
+      tmp32no1 <<= tmp16;
+    }
+    inst->noiseEstQuantile[i] = WebRtcSpl_SatW32ToW16(tmp32no1);
+  }
+}
+
+// Noise Estimation
+void WebRtcNsx_NoiseEstimationSSE2(NoiseSuppressionFixedC* inst,
+                                   uint16_t* magn,
+                                   uint32_t* noise,
+                                   int16_t* q_noise) {
+  int16_t lmagn[HALF_ANAL_BLOCKL], counter, countDiv;
+  int16_t countProd, delta, zeros, frac;
+  int16_t log2, tabind, logval, tmp16, tmp16no1, tmp16no2;
+  const int16_t log2_const = 22713; // Q15
+  const int16_t width_factor = 21845;
+  int16_t factor = FACTOR_Q7;
+
+  size_t i, s, offset;
+
+  tabind = inst->stages - inst->normData;
+  RTC_DCHECK_LT(tabind, 9);
+  RTC_DCHECK_GT(tabind, -9);
+  if (tabind < 0) {
+    logval = -WebRtcNsx_kLogTable[-tabind];
+  } else {
+    logval = WebRtcNsx_kLogTable[tabind];
+  }
+
+  // lmagn(i)=log(magn(i))=log(2)*log2(magn(i))
+  // magn is in Q(-stages), and the real lmagn values are:
+  // real_lmagn(i)=log(magn(i)*2^stages)=log(magn(i))+log(2^stages)
+  // lmagn in Q8
+  for (i = 0; i < inst->magnLen; i++) {
+    if (magn[i]) {
+      zeros = WebRtcSpl_NormU32((uint32_t)magn[i]);
+      frac = (int16_t)((((uint32_t)magn[i] << zeros)
+                              & 0x7FFFFFFF) >> 23);
+      // log2(magn(i))
+      RTC_DCHECK_LT(frac, 256);
+      log2 = (int16_t)(((31 - zeros) << 8)
+                             + WebRtcNsx_kLogTableFrac[frac]);
+      // log2(magn(i))*log(2)
+      lmagn[i] = (int16_t)((log2 * log2_const) >> 15);
+      // + log(2^stages)
+      lmagn[i] += logval;
+    } else {
+      lmagn[i] = logval;//0;
+    }
+  }
+
+  if (inst->blockIndex < END_STARTUP_LONG) {
+    // Smaller step size during startup. This prevents from using
+    // unrealistic values causing overflow.
+    factor = FACTOR_Q7_STARTUP;
+  }
+
+  // loop over simultaneous estimates
+  for (s = 0; s < SIMULT; s++) {
+    int16_t* log_quantile;
+    int16_t* density;
+    __m128i count_div16x8, count_prod16x8, width_term16x8;
+
+    offset = s * inst->magnLen;
+    log_quantile = &inst->noiseEstLogQuantile[offset];
+    density = &inst->noiseEstDensity[offset];
+
+    // Get counter values from state
+    counter = inst->noiseEstCounter[s];
+    RTC_DCHECK_LT(counter, 201);
+    countDiv = WebRtcNsx_kCounterDiv[counter];
+    countProd = (int16_t)(counter * countDiv);
+    tmp16no2 = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT_WITH_ROUND(
+                 width_factor, countDiv, 15);
+
+    count_div16x8 = _mm_set1_epi16(countDiv);
+    count_prod16x8 = _mm_set1_epi16(countProd);
+    width_term16x8 = _mm_set1_epi16(tmp16no2);
+
+    // quant_est(...)
+    for (i = 0; i + 8 <= inst->magnLen; i += 8) {
+      const __m128i lmagn16x8 = _mm_loadu_si128((const __m128i*)&lmagn[i]);
+      __m128i log_quantile16x8 =
+          _mm_loadu_si128((const __m128i*)&log_quantile[i]);
+      __m128i density16x8 = _mm_loadu_si128((const __m128i*)&density[i]);
+      __m128i delta16x8, step, up, down, mask;
+      int k;
+
+      // Compute delta. For a density in [2^k, 2^(k+1)), with k from 9 to
+      // 14, the C code shifts FACTOR_Q16 right by k.
+      delta16x8 = _mm_set1_epi16(factor);
+      mask = _mm_cmpgt_epi16(density16x8, _mm_set1_epi16(512));
+      delta16x8 = _mm_or_si128(
+          _mm_and_si128(mask, _mm_set1_epi16(FACTOR_Q16 >> 9)),
+          _mm_andnot_si128(mask, delta16x8));
+      for (k = 10; k <= 14; k++) {
+        mask = _mm_cmpgt_epi16(density16x8,
+                               _mm_set1_epi16((int16_t)((1 << k) - 1)));
+        delta16x8 = _mm_or_si128(
+            _mm_and_si128(mask, _mm_set1_epi16(FACTOR_Q16 >> k)),
+            _mm_andnot_si128(mask, delta16x8));
+      }
+
+      // update log quantile estimate
+      step = MulShiftRightW16(delta16x8, count_div16x8, 14);
+      // The step is not negative, so (step + 2) / 4 is
+      // ((step >> 1) + 1) >> 1, and (step + 1) / 2 is an unsigned average.
+      up = _mm_add_epi16(
+          log_quantile16x8,
+          _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(step, 1),
+                                       _mm_set1_epi16(1)), 1));
+      step = _mm_avg_epu16(step, _mm_setzero_si128());
+      step = _mm_srli_epi16(_mm_mullo_epi16(step, _mm_set1_epi16(3)), 1);
+      down = _mm_max_epi16(_mm_sub_epi16(log_quantile16x8, step),
+                           _mm_set1_epi16(logval));
+      mask = _mm_cmpgt_epi16(lmagn16x8, log_quantile16x8);
+      log_quantile16x8 = _mm_or_si128(_mm_and_si128(mask, up),
+                                      _mm_andnot_si128(mask, down));
+      _mm_storeu_si128((__m128i*)&log_quantile[i], log_quantile16x8);
+
+      // update density estimate
+      step = _mm_sub_epi16(lmagn16x8, log_quantile16x8);
+      step = _mm_max_epi16(step, _mm_sub_epi16(_mm_setzero_si128(), step));
+      mask = _mm_cmplt_epi16(step, _mm_set1_epi16(WIDTH_Q8));
+      step = _mm_add_epi16(
+          MulShiftRightRoundW16(density16x8, count_prod16x8, 15),
+          width_term16x8);
+      density16x8 = _mm_or_si128(_mm_and_si128(mask, step),
+                                 _mm_andnot_si128(mask, density16x8));
+      _mm_storeu_si128((__m128i*)&density[i], density16x8);
+    }
+
+    for (; i < inst->magnLen; i++) {
+      // compute delta
+      if (density[i] > 512) {
+        // Get the value for delta by shifting intead of dividing.
+        int norm = WebRtcSpl_NormW16(density[i]);
+        delta = (int16_t)(FACTOR_Q16 >> (14 - norm));
+      } else {
+        delta = factor;
+      }
+
+      // update log quantile estimate
+      tmp16 = (int16_t)((delta * countDiv) >> 14);
+      if (lmagn[i] > log_quantile[i]) {
+        // +=QUANTILE*delta/(inst->counter[s]+1) QUANTILE=0.25, =1 in Q2
+        // CounterDiv=1/(inst->counter[s]+1) in Q15
+        tmp16 += 2;
+        log_quantile[i] += tmp16 / 4;
+      } else {
+        tmp16 += 1;
+        // *(1-QUANTILE), in Q2 QUANTILE=0.25, 1-0.25=0.75=3 in Q2
+        tmp16no1 = (int16_t)((tmp16 / 2) * 3 / 2);
+        log_quantile[i] -= tmp16no1;
+        if (log_quantile[i] < logval) {
+          // This is the smallest fixed point representation we can
+          // have, hence we limit the output.
+          log_quantile[i] = logval;
+        }
+      }
+
+      // update density estimate
+      if (WEBRTC_SPL_ABS_W16(lmagn[i] - log_quantile[i]) < WIDTH_Q8) {
+        tmp16no1 = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT_WITH_ROUND(
+                     density[i], countProd, 15);
+        density[i] = tmp16no1 + tmp16no2;
+      }
+    }  // end loop over magnitude spectrum
+
+    if (counter >= END_STARTUP_LONG) {
+      inst->noiseEstCounter[s] = 0;
+      if (inst->blockIndex >= END_STARTUP_LONG) {
+        UpdateNoiseEstimateSSE2(inst, (int)offset);
+      }
+    }
+    inst->noiseEstCounter[s]++;
+
+  }  // end loop over simultaneous estimates
+
+  // Sequentially update the noise during startup
+  if (inst->blockIndex < END_STARTUP_LONG) {
+    UpdateNoiseEstimateSSE2(inst, (int)offset);
+  }
+
+  for (i = 0; i < inst->magnLen; i++) {
+    noise[i] = (uint32_t)(inst->noiseEstQuantile[i]); // Q(qNoise)
+  }
+  (*q_noise) = (int16_t)inst->qNoise;
+}
+
+// Filter the data in the frequency domain, and create spectrum.
+void WebRtcNsx_PrepareSpectrumSSE2(NoiseSuppressionFixedC* inst,
+                                   int16_t* freq_buf) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+
+  RTC_DCHECK_EQ(1, inst->magnLen % 8);
+  RTC_DCHECK_EQ(0, inst->anaLen2 % 8);
+
+  // (1) Filtering.
+  for (i = 0; i + 8 <= inst->magnLen; i += 8) {
+    const __m128i ns_filter =
+        _mm_loadu_si128((const __m128i*)&inst->noiseSupFilter[i]);
+    const __m128i real = _mm_loadu_si128((const __m128i*)&inst->real[i]);
+    const __m128i imag = _mm_loadu_si128((const __m128i*)&inst->imag[i]);
+    // Q(normData-stages)
+    _mm_storeu_si128((__m128i*)&inst->real[i],
+                     MulShiftRightW16(real, ns_filter, 14));
+    _mm_storeu_si128((__m128i*)&inst->imag[i],
+                     MulShiftRightW16(imag, ns_filter, 14));
+  }
+  for (; i < inst->magnLen; i++) {
+    inst->real[i] = (int16_t)((inst->real[i] *
+        (int16_t)(inst->noiseSupFilter[i])) >> 14);  // Q(normData-stages)
+    inst->imag[i] = (int16_t)((inst->imag[i] *
+        (int16_t)(inst->noiseSupFilter[i])) >> 14);  // Q(normData-stages)
+  }
+
+  // (2) Create spectrum, interleaving the real part and the negated
+  // imaginary part.
+  for (i = 0; i < inst->anaLen2; i += 8) {
+    const __m128i real = _mm_loadu_si128((const __m128i*)&inst->real[i]);
+    const __m128i imag = _mm_sub_epi16(
+        zero, _mm_loadu_si128((const __m128i*)&inst->imag[i]));
+    _mm_storeu_si128((__m128i*)&freq_buf[2 * i],
+                     _mm_unpacklo_epi16(real, imag));
+    _mm_storeu_si128((__m128i*)&freq_buf[2 * i + 8],
+                     _mm_unpackhi_epi16(real, imag));
+  }
+  freq_buf[inst->anaLen] = inst->real[inst->anaLen2];
+  freq_buf[inst->anaLen + 1] = -inst->imag[inst->anaLen2];
+}
+
+// Denormalize the real-valued signal |in|, the output from inverse FFT.
+void WebRtcNsx_DenormalizeSSE2(NoiseSuppressionFixedC* inst,
+                               int16_t* in,
+                               int factor) {
+  const int shift = factor - inst->normData;
+  const __m128i count = _mm_cvtsi32_si128(shift >= 0 ? shift : -shift);
+  size_t i = 0;
+
+  RTC_DCHECK_EQ(0, inst->anaLen % 8);
+
+  for (i = 0; i < inst->anaLen; i += 8) {
+    const __m128i in16x8 = _mm_loadu_si128((const __m128i*)&in[i]);
+    __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(in16x8, in16x8), 16);
+    __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(in16x8, in16x8), 16);
+    if (shift >= 0) {
+      low = _mm_sll_epi32(low, count);
+      high = _mm_sll_epi32(high, count);
+    } else {
+      low = _mm_sra_epi32(low, count);
+      high = _mm_sra_epi32(high, count);
+    }
+    // Q0
+    _mm_storeu_si128((__m128i*)&inst->real[i], _mm_packs_epi32(low, high));
+  }
+}
+
+// For the noise supression process, synthesis, read out fully processed
+// segment, and update synthesis buffer.
+void WebRtcNsx_SynthesisUpdateSSE2(NoiseSuppressionFixedC* inst,
+                                   int16_t* out_frame,
+                                   int16_t gain_factor) {
+  const __m128i gain = _mm_set1_epi16(gain_factor);
+  const __m128i round = _mm_set1_epi32(1 << 12);
+  size_t i = 0;
+
+  RTC_DCHECK_EQ(0, inst->anaLen % 8);
+
+  // synthesis
+  for (i = 0; i < inst->anaLen; i += 8) {
+    // Q0, window in Q14
+    const __m128i windowed = MulShiftRightRoundW16(
+        _mm_loadu_si128((const __m128i*)&inst->window[i]),
+        _mm_loadu_si128((const __m128i*)&inst->real[i]), 14);
+    const __m128i low = _mm_mullo_epi16(windowed, gain);
+    const __m128i high = _mm_mulhi_epi16(windowed, gain);
+    // Q0, down shift with rounding and saturation
+    const __m128i scaled = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(low, high), round), 13),
+        _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(low, high), round),
+                       13));
+    __m128i* synthesis = (__m128i*)&inst->synthesisBuffer[i];
+    _mm_storeu_si128(synthesis,
+                     _mm_adds_epi16(_mm_loadu_si128(synthesis), scaled));
+  }
+
+  // read out fully processed segment
+  memcpy(out_frame, inst->synthesisBuffer,
+         inst->blockLen10ms * sizeof(*inst->synthesisBuffer));
+
+  // update synthesis buffer
+  memcpy(inst->synthesisBuffer, inst->synthesisBuffer + inst->blockLen10ms,
+      (inst->anaLen - inst->blockLen10ms) * sizeof(*inst->synthesisBuffer));
+  WebRtcSpl_ZerosArrayW16(inst->synthesisBuffer
+      + inst->anaLen - inst->blockLen10ms, inst->blockLen10ms);
+}
+
+// Update analysis buffer for lower band, and window data before FFT.
+void WebRtcNsx_AnalysisUpdateSSE2(NoiseSuppressionFixedC* inst,
+                                  int16_t* out,
+                                  int16_t* new_speech) {
+  size_t i = 0;
+
+  RTC_DCHECK_EQ(0, inst->anaLen % 8);
+
+  // For lower band update analysis buffer.
+  memcpy(inst->analysisBuffer, inst->analysisBuffer + inst->blockLen10ms,
+      (inst->anaLen - inst->blockLen10ms) * sizeof(*inst->analysisBuffer));
+  memcpy(inst->analysisBuffer + inst->anaLen - inst->blockLen10ms, new_speech,
+      inst->blockLen10ms * sizeof(*inst->analysisBuffer));
+
+  // Window data before FFT.
+  for (i = 0; i < inst->anaLen; i += 8) {
+    // Q0
+    _mm_storeu_si128(
+        (__m128i*)&out[i],
+        MulShiftRightRoundW16(
+            _mm_loadu_si128((const __m128i*)&inst->window[i]),
+            _mm_loadu_si128((const __m128i*)&inst->analysisBuffer[i]), 14));
+  }
+}
+
+// Normalize the real-valued signal |in|, the input to forward FFT.
+void WebRtcNsx_NormalizeRealBufferSSE2(NoiseSuppressionFixedC* inst,
+                                       const int16_t* in,
+                                       int16_t* out) {
+  const __m128i count = _mm_cvtsi32_si128(inst->normData);
+  size_t i = 0;
+
+  RTC_DCHECK_GE(inst->normData, 0);
+  RTC_DCHECK_EQ(0, inst->anaLen % 8);
+
+  for (i = 0; i < inst->anaLen; i += 8) {
+    // Q(normData)
+    _mm_storeu_si128(
+        (__m128i*)&out[i],
+        _mm_sll_epi16(_mm_loadu_si128((const __m128i*)&in[i]), count));
+  }
+}
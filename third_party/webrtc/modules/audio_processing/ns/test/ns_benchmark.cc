@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Cost of the floating point noise suppressor at every sample rate, in 10 ms
+// frames of WebRtcNs_Analyze() and WebRtcNs_Process(). Every rate is run
+// with the per-frequency loops that WebRtcNs_Init() selects, and again with
+// the loops pointed at the C versions after initialization. Reports the time
+// per frame of both and how far the outputs are apart. The SSE2 loops
+// approximate the logarithms and exponentials, so the outputs are close but
+// not identical.
+//
+// Usage: ns_benchmark <input.pcm> [policy] [loops]
+//
+// The input is 16-bit mono PCM. At every rate it is read as the bands of the
+// band split signal, as passed to WebRtcNs_Process(): 160 samples of every
+// band in turn for every frame above 16000 Hz.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "modules/audio_processing/ns/noise_suppression.h"
+#include "modules/audio_processing/ns/ns_core.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const int kFrameMs = 10;
+const int kRates[] = {8000, 16000, 32000, 48000};
+
+class Ns {
+ public:
+  Ns(int rate, int policy) : handle_(WebRtcNs_Create()) {
+    WebRtcNs_Init(handle_, rate);
+    WebRtcNs_set_policy(handle_, policy);
+  }
+  ~Ns() { WebRtcNs_Free(handle_); }
+
+  NsHandle* handle() { return handle_; }
+
+ private:
+  NsHandle* handle_;
+};
+
+// Points the per-frequency loops at the C versions. The pointers are global,
+// and are set again by the next WebRtcNs_Init().
+void UseC() {
+  WebRtcNs_NoiseEstimation = WebRtcNs_NoiseEstimationC;
+  WebRtcNs_ComputeSpectralFlatness = WebRtcNs_ComputeSpectralFlatnessC;
+  WebRtcNs_ComputeSnr = WebRtcNs_ComputeSnrC;
+  WebRtcNs_UpdateLogLrtTimeAvg = WebRtcNs_UpdateLogLrtTimeAvgC;
+  WebRtcNs_ComputeSpeechProb = WebRtcNs_ComputeSpeechProbC;
+  WebRtcNs_ComputeDdBasedWienerFilter = WebRtcNs_ComputeDdBasedWienerFilterC;
+}
+
+// Runs |input| through the noise suppressor |loops| times, and returns the
+// average time per frame spent in WebRtcNs_Analyze() and WebRtcNs_Process().
+// The output of the last loop is written to |output|.
+int64_t Run(const std::vector<float>& input,
+            int rate,
+            int policy,
+            bool use_c,
+            int loops,
+            std::vector<float>* output) {
+  const size_t num_bands = rate > 16000 ? rate / 16000 : 1;
+  const size_t band_length = (rate / num_bands) / 1000 * kFrameMs;
+  const size_t frame_length = num_bands * band_length;
+  const size_t num_frames = input.size() / frame_length;
+  std::vector<const float*> in_bands(num_bands);
+  std::vector<float*> out_bands(num_bands);
+  output->resize(num_frames * frame_length);
+  int64_t total_ns = 0;
+  for (int loop = 0; loop < loops; ++loop) {
+    Ns ns(rate, policy);
+    if (use_c) {
+      UseC();
+    }
+    for (size_t frame = 0; frame < num_frames; ++frame) {
+      for (size_t band = 0; band < num_bands; ++band) {
+        in_bands[band] = &input[frame * frame_length + band * band_length];
+        out_bands[band] = &(*output)[frame * frame_length + band * band_length];
+      }
+      const int64_t start_ns = rtc::TimeNanos();
+      WebRtcNs_Analyze(ns.handle(), in_bands[0]);
+      WebRtcNs_Process(ns.handle(), in_bands.data(), num_bands,
+                       out_bands.data());
+      total_ns += rtc::TimeNanos() - start_ns;
+    }
+  }
+  return total_ns / static_cast<int64_t>(num_frames * loops);
+}
+
+// Returns the signal to difference ratio of |test| against |reference|, in
+// dB, and the largest absolute difference in |max_difference|.
+double Snr(const std::vector<float>& reference,
+           const std::vector<float>& test,
+           float* max_difference) {
+  double signal = 0;
+  double difference = 0;
+  *max_difference = 0;
+  for (size_t i = 0; i < reference.size(); ++i) {
+    const float d = test[i] - reference[i];
+    signal += static_cast<double>(reference[i]) * reference[i];
+    difference += static_cast<double>(d) * d;
+    *max_difference = std::max(*max_difference, fabsf(d));
+  }
+  return difference > 0 ? 10 * log10(signal / difference) : HUGE_VAL;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <input.pcm> [policy] [loops]\n", argv[0]);
+    return 1;
+  }
+  const int policy = argc > 2 ? atoi(argv[2]) : 0;
+  const int loops = argc > 3 ? atoi(argv[3]) : 3;
+  if (policy < 0 || policy > 3 || loops < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<float> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  // The longest frame, of three bands at 48000 Hz.
+  if (input.size() < 480) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+
+  printf("Policy %d, %d samples, frames of %d ms\n", policy,
+         static_cast<int>(input.size()), webrtc::kFrameMs);
+  printf("%8s %12s %12s %10s %12s\n", "Hz", "ns/frame", "C ns/frame",
+         "SNR dB", "max diff");
+  for (int rate : webrtc::kRates) {
+    std::vector<float> output;
+    std::vector<float> output_c;
+    const int64_t frame_ns =
+        webrtc::Run(input, rate, policy, false, loops, &output);
+    const int64_t frame_c_ns =
+        webrtc::Run(input, rate, policy, true, loops, &output_c);
+    float max_difference;
+    const double snr = webrtc::Snr(output_c, output, &max_difference);
+    printf("%8d %12d %12d %10.1f %12g\n", rate, static_cast<int>(frame_ns),
+           static_cast<int>(frame_c_ns), snr, max_difference);
+  }
+  return 0;
+}
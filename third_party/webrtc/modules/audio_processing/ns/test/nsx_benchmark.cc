@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Throughput benchmark of the fixed point noise suppressor, in 10 ms frames.
+// Reports the time per frame and the number of streams one core can run in
+// real time. The platform specific variants of the kernels in nsx_core.c are
+// bit exact with the generic ones, which is verified by comparing the output
+// of builds with and without them, e.g. with cmp.
+//
+// Usage: nsx_benchmark <input.pcm> [rate] [policy] [output.pcm] [loops]
+//
+// The input is 16-bit mono PCM at |rate|, which defaults to 16000 Hz. Above
+// 16000 Hz it holds the bands of the band split signal, as passed to
+// WebRtcNsx_Process(): 160 samples of every band in turn for every frame. The
+// output has the same layout.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "modules/audio_processing/ns/noise_suppression_x.h"
+#include "rtc_base/timeutils.h"
+
+namespace webrtc {
+namespace {
+
+const int kFrameMs = 10;
+
+class Nsx {
+ public:
+  Nsx(int rate, int policy) : handle_(WebRtcNsx_Create()) {
+    WebRtcNsx_Init(handle_, rate);
+    WebRtcNsx_set_policy(handle_, policy);
+  }
+  ~Nsx() { WebRtcNsx_Free(handle_); }
+
+  NsxHandle* handle() { return handle_; }
+
+ private:
+  NsxHandle* handle_;
+};
+
+// Runs |input| through the noise suppressor |loops| times, and returns the
+// total time spent in WebRtcNsx_Process(). The output of the first loop is
+// written to |output|.
+int64_t Run(const std::vector<int16_t>& input,
+            size_t num_frames,
+            int num_bands,
+            size_t band_length,
+            int rate,
+            int policy,
+            int loops,
+            std::vector<int16_t>* output) {
+  const size_t frame_length = num_bands * band_length;
+  std::vector<const int16_t*> in_bands(num_bands);
+  std::vector<int16_t*> out_bands(num_bands);
+  std::vector<int16_t> out_frame(frame_length);
+  output->resize(num_frames * frame_length);
+  int64_t total_ns = 0;
+  for (int loop = 0; loop < loops; ++loop) {
+    Nsx nsx(rate, policy);
+    for (size_t frame = 0; frame < num_frames; ++frame) {
+      int16_t* out = loop == 0 ? &(*output)[frame * frame_length]
+                               : out_frame.data();
+      for (int band = 0; band < num_bands; ++band) {
+        in_bands[band] = &input[frame * frame_length + band * band_length];
+        out_bands[band] = out + band * band_length;
+      }
+      const int64_t start_ns = rtc::TimeNanos();
+      WebRtcNsx_Process(nsx.handle(), in_bands.data(), num_bands,
+                        out_bands.data());
+      total_ns += rtc::TimeNanos() - start_ns;
+    }
+  }
+  return total_ns;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <input.pcm> [rate] [policy] [output.pcm] [loops]\n",
+            argv[0]);
+    return 1;
+  }
+  const int rate = argc > 2 ? atoi(argv[2]) : 16000;
+  const int policy = argc > 3 ? atoi(argv[3]) : 0;
+  const int loops = argc > 5 ? atoi(argv[5]) : 3;
+  if ((rate != 8000 && rate != 16000 && rate != 32000 && rate != 48000) ||
+      policy < 0 || policy > 3 || loops < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  const int num_bands = rate > 16000 ? rate / 16000 : 1;
+  const size_t band_length =
+      static_cast<size_t>((rate / num_bands) / 1000 * webrtc::kFrameMs);
+
+  FILE* file = fopen(argv[1], "rb");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<int16_t> input;
+  int16_t buffer[1024];
+  size_t read;
+  while ((read = fread(buffer, sizeof(buffer[0]), 1024, file)) > 0) {
+    input.insert(input.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  const size_t num_frames = input.size() / (num_bands * band_length);
+  if (num_frames == 0) {
+    fprintf(stderr, "The input is too short\n");
+    return 1;
+  }
+
+  std::vector<int16_t> output;
+  const int64_t total_ns =
+      webrtc::Run(input, num_frames, num_bands, band_length, rate, policy,
+                  loops, &output);
+
+  if (argc > 4) {
+    file = fopen(argv[4], "wb");
+    if (!file) {
+      fprintf(stderr, "Cannot open %s\n", argv[4]);
+      return 1;
+    }
+    const bool written = fwrite(output.data(), sizeof(output[0]),
+                                output.size(), file) == output.size();
+    fclose(file);
+    if (!written) {
+      fprintf(stderr, "Cannot write %s\n", argv[4]);
+      return 1;
+    }
+  }
+
+  const double per_frame_ns =
+      static_cast<double>(total_ns) / (num_frames * loops);
+  printf("%d Hz, policy %d, %d frames of %d ms\n", rate, policy,
+         static_cast<int>(num_frames), webrtc::kFrameMs);
+  printf("%12s %16s\n", "ns/frame", "streams/core");
+  printf("%12.0f %16.0f\n", per_frame_ns,
+         webrtc::kFrameMs * 1e6 / per_frame_ns);
+  return 0;
+}
@@ -18,6 +18,7 @@
  * -Removed unused include files
  * -Changed to use WebRtc types
  * -Added option to run encoder bitexact with ITU-T reference implementation
+ * -Added block transcoding functions
  */
 
 #include "modules/third_party/g711/g711.h"
@@ -70,3 +71,15 @@ static const uint8_t alaw_to_ulaw_table[256] = {
 uint8_t alaw_to_ulaw(uint8_t alaw) { return alaw_to_ulaw_table[alaw]; }
 
 uint8_t ulaw_to_alaw(uint8_t ulaw) { return ulaw_to_alaw_table[ulaw]; }
+
+void alaw_to_ulaw_block(const uint8_t* alaw, size_t len, uint8_t* ulaw) {
+  size_t i;
+  for (i = 0; i < len; i++)
+    ulaw[i] = alaw_to_ulaw_table[alaw[i]];
+}
+
+void ulaw_to_alaw_block(const uint8_t* ulaw, size_t len, uint8_t* alaw) {
+  size_t i;
+  for (i = 0; i < len; i++)
+    alaw[i] = ulaw_to_alaw_table[ulaw[i]];
+}
@@ -50,6 +50,7 @@ specification by other means.
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
 #if defined(__i386__)
@@ -343,6 +344,20 @@ uint8_t alaw_to_ulaw(uint8_t alaw);
 */
 uint8_t ulaw_to_alaw(uint8_t ulaw);
 
+/*! \brief Transcode a block of A-law samples to u-law, as alaw_to_ulaw().
+    \param alaw The A-law samples to transcode.
+    \param len The number of samples.
+    \param ulaw The u-law samples. May be the same buffer as alaw.
+*/
+void alaw_to_ulaw_block(const uint8_t* alaw, size_t len, uint8_t* ulaw);
+
+/*! \brief Transcode a block of u-law samples to A-law, as ulaw_to_alaw().
+    \param ulaw The u-law samples to transcode.
+    \param len The number of samples.
+    \param alaw The A-law samples. May be the same buffer as ulaw.
+*/
+void ulaw_to_alaw_block(const uint8_t* ulaw, size_t len, uint8_t* alaw);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,10 @@
  * -Changed to use WebRtc types
  * -Changed __inline__ to __inline
  * -Added saturation check on output
+ *
+ * Modifications for WebRtc, 2018:
+ * -Apply the receive QMF to blocks of samples, instead of shifting the
+ *  signal history for every pair
  */
 
 /*! \file */
@@ -35,6 +39,7 @@
 #include <stdlib.h>
 
 #include "modules/third_party/g722/g722_enc_dec.h"
+#include "modules/third_party/g722/g722_qmf.h"
 
 #if !defined(FALSE)
 #define FALSE 0
@@ -179,6 +184,32 @@ int WebRtc_g722_decode_release(G722DecoderState *s)
 }
 /*- End of function --------------------------------------------------------*/
 
+/* Copies the signal history of the receive QMF in front of a block. */
+static void rx_qmf_history(const G722DecoderState *s, int16_t qmf_x[])
+{
+    int i;
+
+    for (i = 0;  i < G722_QMF_HISTORY;  i++)
+        qmf_x[i] = (int16_t) s->x[i + 2];
+}
+/*- End of function --------------------------------------------------------*/
+
+/* Applies the receive QMF to a block of pairs, writing 2*pairs samples to
+   amp[], and moves the signal history on past them. */
+static void rx_qmf_block(G722DecoderState *s, const int16_t qmf_x[],
+                         size_t pairs, int16_t amp[])
+{
+    int i;
+
+    /* We shift by 12 to allow for the QMF filters (DC gain = 4096), less 1
+       to allow for the 15 bit input to the G.722 algorithm. */
+    /* WebRtc, tlegrand: added saturation */
+    WebRtc_g722_rx_qmf(qmf_x, pairs, amp);
+    for (i = 0;  i < 24;  i++)
+        s->x[i] = qmf_x[2*pairs - 2 + i];
+}
+/*- End of function --------------------------------------------------------*/
+
 size_t WebRtc_g722_decode(G722DecoderState *s, int16_t amp[],
                           const uint8_t g722_data[], size_t len)
 {
@@ -233,28 +264,25 @@ size_t WebRtc_g722_decode(G722DecoderState *s, int16_t amp[],
            1688,   1360,   1040,    728,
             432,    136,   -432,   -136
     };
-    static const int qmf_coeffs[12] =
-    {
-           3,  -11,   12,   32, -210,  951, 3876, -805,  362, -156,   53,  -11,
-    };
-
     int dlowt;
     int rlow;
     int ihigh;
     int dhigh;
     int rhigh;
-    int xout1;
-    int xout2;
     int wd1;
     int wd2;
     int wd3;
     int code;
     size_t outlen;
-    int i;
     size_t j;
+    /* Signal history followed by the QMF inputs of a block of pairs, and the
+       number of pairs in it */
+    int16_t qmf_x[G722_QMF_HISTORY + 2*G722_QMF_BLOCK_PAIRS];
+    size_t qmf_len;
 
     outlen = 0;
     rhigh = 0;
+    qmf_len = 0;
     for (j = 0;  j < len;  )
     {
         if (s->packed)
@@ -372,27 +400,27 @@ size_t WebRtc_g722_decode(G722DecoderState *s, int16_t amp[],
             }
             else
             {
-                /* Apply the receive QMF */
-                for (i = 0;  i < 22;  i++)
-                    s->x[i] = s->x[i + 2];
-                s->x[22] = rlow + rhigh;
-                s->x[23] = rlow - rhigh;
-
-                xout1 = 0;
-                xout2 = 0;
-                for (i = 0;  i < 12;  i++)
+                /* Apply the receive QMF, a block of pairs at a time. The sum
+                   and difference of rlow and rhigh fit 16 bits, since both
+                   are limited to 15 bits. */
+                if (qmf_len == 0)
+                    rx_qmf_history(s, qmf_x);
+                qmf_x[G722_QMF_HISTORY + 2*qmf_len] = (int16_t) (rlow + rhigh);
+                qmf_x[G722_QMF_HISTORY + 2*qmf_len + 1] = (int16_t) (rlow - rhigh);
+                if (++qmf_len == G722_QMF_BLOCK_PAIRS)
                 {
-                    xout2 += s->x[2*i]*qmf_coeffs[i];
-                    xout1 += s->x[2*i + 1]*qmf_coeffs[11 - i];
+                    rx_qmf_block(s, qmf_x, qmf_len, &amp[outlen]);
+                    outlen += 2*qmf_len;
+                    qmf_len = 0;
                 }
-                /* We shift by 12 to allow for the QMF filters (DC gain = 4096), less 1
-                   to allow for the 15 bit input to the G.722 algorithm. */
-                /* WebRtc, tlegrand: added saturation */
-                amp[outlen++] = saturate(xout1 >> 11);
-                amp[outlen++] = saturate(xout2 >> 11);
             }
         }
     }
+    if (qmf_len > 0)
+    {
+        rx_qmf_block(s, qmf_x, qmf_len, &amp[outlen]);
+        outlen += 2*qmf_len;
+    }
     return outlen;
 }
 /*- End of function --------------------------------------------------------*/
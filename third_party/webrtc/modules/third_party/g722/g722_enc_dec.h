@@ -23,6 +23,9 @@
  * Modifications for WebRtc, 2011/04/28, by tlegrand:
  * -Changed to use WebRtc types
  * -Added new defines for minimum and maximum values of short int
+ *
+ * Modifications for WebRtc, 2018:
+ * -Added WebRtc_g722_encode_batch()
  */
 
 /*! \file */
@@ -30,6 +33,7 @@
 #ifndef MODULES_THIRD_PARTY_G722_G722_H_
 #define MODULES_THIRD_PARTY_G722_G722_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*! \page g722_page G.722 encoding and decoding
@@ -136,6 +140,15 @@ size_t WebRtc_g722_encode(G722EncoderState* s,
                           uint8_t g722_data[],
                           const int16_t amp[],
                           size_t len);
+/* Encodes |len| samples from each of amp[0], ..., amp[num_states - 1] with
+   the corresponding state, as done by WebRtc_g722_encode(). The number of
+   bytes written to g722_data[k] is returned in g722_bytes[k]. */
+void WebRtc_g722_encode_batch(G722EncoderState* const s[],
+                              uint8_t* const g722_data[],
+                              const int16_t* const amp[],
+                              size_t len,
+                              size_t num_states,
+                              size_t g722_bytes[]);
 
 G722DecoderState* WebRtc_g722_decode_init(G722DecoderState* s,
                                           int rate,
@@ -26,6 +26,11 @@
  * -Removed usage of inttypes.h and tgmath.h
  * -Changed to use WebRtc types
  * -Added option to run encoder bitexact with ITU-T reference implementation
+ *
+ * Modifications for WebRtc, 2018:
+ * -Apply the transmit QMF to blocks of samples, instead of shifting the
+ *  signal history for every pair
+ * -Added WebRtc_g722_encode_batch()
  */
 
 /*! \file */
@@ -35,6 +40,7 @@
 #include <stdlib.h>
 
 #include "modules/third_party/g722/g722_enc_dec.h"
+#include "modules/third_party/g722/g722_qmf.h"
 
 #if !defined(FALSE)
 #define FALSE 0
@@ -197,6 +203,27 @@ int16_t limitValues (int16_t rl)
 }
 #endif
 
+/* Applies the transmit QMF to up to G722_QMF_BLOCK_PAIRS pairs of samples
+   from amp[], writing xlow and xhigh of every pair to qmf_out[], and moves
+   the signal history on past them. Returns the number of pairs filtered. */
+static size_t tx_qmf_block(G722EncoderState *s, const int16_t amp[],
+                           size_t pairs, int16_t qmf_out[])
+{
+    int16_t x[G722_QMF_HISTORY + 2*G722_QMF_BLOCK_PAIRS];
+    int i;
+
+    if (pairs > G722_QMF_BLOCK_PAIRS)
+        pairs = G722_QMF_BLOCK_PAIRS;
+    for (i = 0;  i < G722_QMF_HISTORY;  i++)
+        x[i] = (int16_t) s->x[i + 2];
+    memcpy(&x[G722_QMF_HISTORY], amp, 2*pairs*sizeof(amp[0]));
+    WebRtc_g722_tx_qmf(x, pairs, qmf_out);
+    for (i = 0;  i < 24;  i++)
+        s->x[i] = x[2*pairs - 2 + i];
+    return pairs;
+}
+/*- End of function --------------------------------------------------------*/
+
 size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
                           const int16_t amp[], size_t len)
 {
@@ -281,9 +308,15 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
     int ihigh;
     int ilow;
     int code;
+    /* Block of QMF outputs, and the next pair and number of pairs in it */
+    int16_t qmf_out[2*G722_QMF_BLOCK_PAIRS];
+    size_t qmf_pos;
+    size_t qmf_len;
 
     g722_bytes = 0;
     xhigh = 0;
+    qmf_pos = 0;
+    qmf_len = 0;
     for (j = 0;  j < len;  )
     {
         if (s->itu_test_mode)
@@ -298,9 +331,32 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
                 /* We shift by 1 to allow for the 15 bit input to the G.722 algorithm. */
                 xlow = amp[j++] >> 1;
             }
+            else if (len - j >= 2)
+            {
+                /* Apply the transmit QMF, a block of pairs at a time */
+                if (qmf_pos == qmf_len)
+                {
+                    qmf_len = tx_qmf_block(s, &amp[j], (len - j)/2, qmf_out);
+                    qmf_pos = 0;
+                }
+                xlow = qmf_out[2*qmf_pos];
+                xhigh = qmf_out[2*qmf_pos + 1];
+                qmf_pos++;
+                j += 2;
+
+#ifdef RUN_LIKE_REFERENCE_G722
+                /* The following lines are only used to verify bit-exactness
+                 * with reference implementation of G.722. Higher precision
+                 * is achieved without limiting the values.
+                 */
+                xlow = limitValues(xlow);
+                xhigh = limitValues(xhigh);
+#endif
+            }
             else
             {
-                /* Apply the transmit QMF */
+                /* Apply the transmit QMF to a trailing odd sample, which is
+                   paired with the sample after it */
                 /* Shuffle the buffer down */
                 for (i = 0;  i < 22;  i++)
                     s->x[i] = s->x[i + 2];
@@ -322,10 +378,6 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
                 xhigh = (sumeven - sumodd) >> 14;
 
 #ifdef RUN_LIKE_REFERENCE_G722
-                /* The following lines are only used to verify bit-exactness
-                 * with reference implementation of G.722. Higher precision
-                 * is achieved without limiting the values.
-                 */
                 xlow = limitValues(xlow);
                 xhigh = limitValues(xhigh);
 #endif
@@ -426,4 +478,20 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
     return g722_bytes;
 }
 /*- End of function --------------------------------------------------------*/
+
+void WebRtc_g722_encode_batch(G722EncoderState *const s[],
+                              uint8_t *const g722_data[],
+                              const int16_t *const amp[],
+                              size_t len,
+                              size_t num_states,
+                              size_t g722_bytes[])
+{
+    size_t k;
+
+    /* The states are encoded one after the other. Interleaving them sample
+       by sample does not make the branch bound ADPCM updates any faster. */
+    for (k = 0;  k < num_states;  k++)
+        g722_bytes[k] = WebRtc_g722_encode(s[k], g722_data[k], amp[k], len);
+}
+/*- End of function --------------------------------------------------------*/
 /*- End of file ------------------------------------------------------------*/
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/third_party/g722/g722_qmf.h"
+
+#include "system_wrappers/include/cpu_features_sse2.h"
+
+// The QMF coefficients {3, -11, 12, 32, -210, 951, 3876, -805, 362, -156, 53,
+// -11}, arranged per tap of the 24-sample window of a pair. The transmit QMF
+// sums the even taps (coefficients in order) and the odd taps (in reverse
+// order) to xlow, and subtracts them to xhigh.
+static const int16_t kTxCoeffs[2][24] = {
+    {3, -11, -11, 53, 12, -156, 32, 362, -210, -805, 951, 3876,
+     3876, 951, -805, -210, 362, 32, -156, 12, 53, -11, -11, 3},
+    {-3, -11, 11, 53, -12, -156, -32, 362, 210, -805, -951, 3876,
+     -3876, 951, 805, -210, -362, 32, 156, 12, -53, -11, 11, 3}};
+// The receive QMF outputs the odd taps first, then the even taps.
+static const int16_t kRxCoeffs[2][24] = {
+    {0, -11, 0, 53, 0, -156, 0, 362, 0, -805, 0, 3876,
+     0, 951, 0, -210, 0, 32, 0, 12, 0, -11, 0, 3},
+    {3, 0, -11, 0, 12, 0, 32, 0, -210, 0, 951, 0,
+     3876, 0, -805, 0, 362, 0, -156, 0, 53, 0, -11, 0}};
+
+// Shifts for the QMF filters (DC gain = 4096), the 15 bit input to the G.722
+// algorithm, and for the transmit QMF the summing of two filters.
+enum { kTxShift = 14 };
+enum { kRxShift = 11 };
+
+static __inline int16_t Saturate(int32_t value) {
+  if (value > 32767)
+    return 32767;
+  if (value < -32768)
+    return -32768;
+  return (int16_t)value;
+}
+
+static void QmfC(const int16_t x[],
+                 size_t num_pairs,
+                 const int16_t coeffs[2][24],
+                 int shift,
+                 int16_t out[]) {
+  size_t n = 0;
+  int i = 0;
+
+  for (n = 0; n < num_pairs; n++) {
+    const int16_t* window = &x[2 * n];
+    int32_t sum0 = 0;
+    int32_t sum1 = 0;
+    for (i = 0; i < 24; i++) {
+      sum0 += window[i] * coeffs[0][i];
+      sum1 += window[i] * coeffs[1][i];
+    }
+    out[2 * n] = Saturate(sum0 >> shift);
+    out[2 * n + 1] = Saturate(sum1 >> shift);
+  }
+}
+
+static void Qmf(const int16_t x[],
+                size_t num_pairs,
+                const int16_t coeffs[2][24],
+                int shift,
+                int16_t out[]) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_UseSSE2()) {
+    WebRtc_g722_qmf_sse2(x, num_pairs, coeffs, shift, out);
+    return;
+  }
+#endif
+  QmfC(x, num_pairs, coeffs, shift, out);
+}
+
+void WebRtc_g722_tx_qmf(const int16_t x[], size_t num_pairs, int16_t out[]) {
+  // The sums are at most 32768 * 2 * 6482 in magnitude, so that xlow and
+  // xhigh are never saturated.
+  Qmf(x, num_pairs, kTxCoeffs, kTxShift, out);
+}
+
+void WebRtc_g722_rx_qmf(const int16_t x[], size_t num_pairs, int16_t amp[]) {
+  Qmf(x, num_pairs, kRxCoeffs, kRxShift, amp);
+}
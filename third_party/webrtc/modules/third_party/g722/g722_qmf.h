@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// The 24-tap transmit and receive QMFs of G.722, run over blocks of sample
+// pairs instead of one pair at a time. Only for use by g722_encode.c and
+// g722_decode.c.
+
+#ifndef MODULES_THIRD_PARTY_G722_G722_QMF_H_
+#define MODULES_THIRD_PARTY_G722_G722_QMF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of history samples in front of the new samples of a block.
+enum { G722_QMF_HISTORY = 22 };
+// Number of sample pairs filtered per block by the encoder and decoder.
+enum { G722_QMF_BLOCK_PAIRS = 80 };
+
+// Transmit QMF. |x| holds G722_QMF_HISTORY history samples followed by
+// 2 * |num_pairs| input samples. For every pair n, writes xlow to out[2 * n]
+// and xhigh to out[2 * n + 1], as computed per pair by WebRtc_g722_encode().
+void WebRtc_g722_tx_qmf(const int16_t x[], size_t num_pairs, int16_t out[]);
+
+// Receive QMF. |x| holds G722_QMF_HISTORY history values followed by the
+// pairs rlow + rhigh, rlow - rhigh of |num_pairs| decoded samples. Writes
+// 2 * |num_pairs| output samples to |amp|, saturated to 16 bits.
+void WebRtc_g722_rx_qmf(const int16_t x[], size_t num_pairs, int16_t amp[]);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// For every pair n, computes the dot products of x[2 * n], ..., x[2 * n + 23]
+// with coeffs[0] and coeffs[1], shifts them right by |shift| and writes them,
+// saturated to 16 bits, to out[2 * n] and out[2 * n + 1].
+void WebRtc_g722_qmf_sse2(const int16_t x[],
+                          size_t num_pairs,
+                          const int16_t coeffs[2][24],
+                          int shift,
+                          int16_t out[]);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MODULES_THIRD_PARTY_G722_G722_QMF_H_
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/third_party/g722/g722_qmf.h"
+
+// The four partial sums of the dot product of the 24-sample window at |x|
+// with the coefficients in |c|. No sum can overflow, since the absolute
+// values of the coefficients sum to less than 2^16.
+static __inline __m128i DotProduct(const int16_t* x, const __m128i* c) {
+  const __m128i x0 = _mm_loadu_si128((const __m128i*)&x[0]);
+  const __m128i x1 = _mm_loadu_si128((const __m128i*)&x[8]);
+  const __m128i x2 = _mm_loadu_si128((const __m128i*)&x[16]);
+  return _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(x0, c[0]),
+                                     _mm_madd_epi16(x1, c[1])),
+                       _mm_madd_epi16(x2, c[2]));
+}
+
+// Adds up the partial sums of each of |s0|, ..., |s3| into one lane.
+static __inline __m128i HorizontalSums(__m128i s0,
+                                       __m128i s1,
+                                       __m128i s2,
+                                       __m128i s3) {
+  const __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(s0, s1),
+                                    _mm_unpackhi_epi32(s0, s1));
+  const __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(s2, s3),
+                                    _mm_unpackhi_epi32(s2, s3));
+  return _mm_add_epi32(_mm_unpacklo_epi64(s01, s23),
+                       _mm_unpackhi_epi64(s01, s23));
+}
+
+void WebRtc_g722_qmf_sse2(const int16_t x[],
+                          size_t num_pairs,
+                          const int16_t coeffs[2][24],
+                          int shift,
+                          int16_t out[]) {
+  const __m128i count = _mm_cvtsi32_si128(shift);
+  __m128i c0[3];
+  __m128i c1[3];
+  size_t n = 0;
+  int i = 0;
+
+  for (i = 0; i < 3; i++) {
+    c0[i] = _mm_loadu_si128((const __m128i*)&coeffs[0][8 * i]);
+    c1[i] = _mm_loadu_si128((const __m128i*)&coeffs[1][8 * i]);
+  }
+
+  // Four pairs at a time, with the sums of both outputs interleaved before
+  // they are packed.
+  for (n = 0; n + 4 <= num_pairs; n += 4) {
+    const int16_t* window = &x[2 * n];
+    const __m128i sum0 = HorizontalSums(
+        DotProduct(&window[0], c0), DotProduct(&window[2], c0),
+        DotProduct(&window[4], c0), DotProduct(&window[6], c0));
+    const __m128i sum1 = HorizontalSums(
+        DotProduct(&window[0], c1), DotProduct(&window[2], c1),
+        DotProduct(&window[4], c1), DotProduct(&window[6], c1));
+    const __m128i lo = _mm_sra_epi32(_mm_unpacklo_epi32(sum0, sum1), count);
+    const __m128i hi = _mm_sra_epi32(_mm_unpackhi_epi32(sum0, sum1), count);
+    _mm_storeu_si128((__m128i*)&out[2 * n], _mm_packs_epi32(lo, hi));
+  }
+  for (; n < num_pairs; n++) {
+    const int16_t* window = &x[2 * n];
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sum = HorizontalSums(DotProduct(window, c0),
+                                       DotProduct(window, c1), zero, zero);
+    // Lanes 0 and 1 hold the two sums.
+    const __m128i shifted = _mm_sra_epi32(sum, count);
+    const int32_t packed = _mm_cvtsi128_si32(_mm_packs_epi32(shifted, zero));
+    out[2 * n] = (int16_t)packed;
+    out[2 * n + 1] = (int16_t)(packed >> 16);
+  }
+}
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// The one run time check made by the SSE2 code of the audio signal processing
+// library, the audio codecs and the audio processing modules.
+
+#ifndef SYSTEM_WRAPPERS_INCLUDE_CPU_FEATURES_SSE2_H_
+#define SYSTEM_WRAPPERS_INCLUDE_CPU_FEATURES_SSE2_H_
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+// Returns 1 if SSE2 code can be used, 0 otherwise. SSE2 is always available
+// when the compiler targets it (and on x86-64), in which case no run time
+// check is made.
+static __inline int WebRtc_UseSSE2(void) {
+#if defined(__SSE2__) || defined(_M_X64)
+  return 1;
+#else
+  return WebRtc_GetCPUInfo(kSSE2);
+#endif
+}
+#endif  // WEBRTC_ARCH_X86_FAMILY
+
+#endif  // SYSTEM_WRAPPERS_INCLUDE_CPU_FEATURES_SSE2_H_